@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_CACHEGCPOLICY_HH_
+#define GZ_FUEL_TOOLS_CACHEGCPOLICY_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gz/fuel_tools/Export.hh"
+#include "gz/fuel_tools/ModelIdentifier.hh"
+#include "gz/fuel_tools/WorldIdentifier.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::vector
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace gz::fuel_tools
+{
+  /// \brief Which versions of the cached models and worlds are kept when
+  /// the cache is garbage collected. A version is removed only if none of
+  /// the rules keeps it.
+  /// \sa LocalCache::CollectGarbage
+  struct GZ_FUEL_TOOLS_VISIBLE CacheGcPolicy
+  {
+    /// \brief Number of versions kept per resource, starting from the
+    /// latest one.
+    // cppcheck-suppress unusedStructMember
+    public: std::size_t keepVersions = 1;
+
+    /// \brief Versions used within this period are kept. A version is used
+    /// when it's saved or when one of its top level files, such as
+    /// model.config or the world file, is read. Zero disables the rule.
+    public: std::chrono::seconds keepUsedWithin{std::chrono::hours(24 * 7)};
+
+    /// \brief Models that are never removed. Identifiers without a version
+    /// pin every version.
+    public: std::vector<ModelIdentifier> pinnedModels;
+
+    /// \brief Worlds that are never removed, same as pinnedModels.
+    public: std::vector<WorldIdentifier> pinnedWorlds;
+
+    /// \brief Stop once this much time was spent, so that a collection can
+    /// run in small steps. Resources are removed one at a time, so the
+    /// cache stays consistent. The first resource that wasn't visited is
+    /// recorded in the cache, and the next collection starts from there.
+    /// At least one resource is visited by each collection. Zero means no
+    /// limit.
+    public: std::chrono::milliseconds timeBudget{0};
+
+    /// \brief Only report what would be removed.
+    // cppcheck-suppress unusedStructMember
+    public: bool dryRun = false;
+  };
+
+  /// \brief Outcome of a cache garbage collection.
+  struct GZ_FUEL_TOOLS_VISIBLE CacheGcReport
+  {
+    /// \brief Get the report as a human readable string.
+    /// \param[in] _prefix Optional prefix for every line of the string.
+    /// \return Report string.
+    public: std::string AsString(const std::string &_prefix = "") const;
+
+    /// \brief Number of versions removed, or that would be removed in a
+    /// dry run.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t removedVersions = 0;
+
+    /// \brief Number of versions kept.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t keptVersions = 0;
+
+    /// \brief Number of bytes freed on disk, including blobs no longer
+    /// used by any resource.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t reclaimedBytes = 0;
+
+    /// \brief False if the collection stopped because of the time budget.
+    // cppcheck-suppress unusedStructMember
+    public: bool complete = true;
+  };
+}  // namespace gz::fuel_tools
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif  // GZ_FUEL_TOOLS_CACHEGCPOLICY_HH_
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_CACHESTATISTICS_HH_
+#define GZ_FUEL_TOOLS_CACHESTATISTICS_HH_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gz/fuel_tools/Export.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::array
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace gz::fuel_tools
+{
+  /// \brief Distribution of durations, using power of two buckets.
+  struct GZ_FUEL_TOOLS_VISIBLE DurationHistogram
+  {
+    /// \brief Number of buckets.
+    public: static constexpr std::size_t kBuckets = 32;
+
+    /// \brief Get the bucket of a duration.
+    /// \param[in] _duration A duration.
+    /// \return Bucket index. Bucket 0 holds durations below 1 us, bucket
+    /// i holds durations in [2^(i-1), 2^i) us and the last bucket holds
+    /// everything longer.
+    public: static std::size_t Bucket(std::chrono::microseconds _duration);
+
+    /// \brief Get the upper bound of a bucket.
+    /// \param[in] _bucket Bucket index.
+    /// \return Upper bound of the bucket.
+    public: static std::chrono::microseconds UpperBound(std::size_t _bucket);
+
+    /// \brief Average duration.
+    /// \return Average duration, or zero if there are no samples.
+    public: std::chrono::microseconds Mean() const;
+
+    /// \brief Estimate a percentile from the buckets.
+    /// \param[in] _percentile Percentile, in [0, 100].
+    /// \return Upper bound of the bucket holding the percentile, or zero if
+    /// there are no samples.
+    public: std::chrono::microseconds Percentile(double _percentile) const;
+
+    /// \brief Number of samples in each bucket.
+    public: std::array<std::uint64_t, kBuckets> buckets{};
+
+    /// \brief Number of samples.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t count = 0;
+
+    /// \brief Sum of all the samples.
+    public: std::chrono::microseconds total{0};
+  };
+
+  /// \brief Counters describing how the local cache is used. The counters
+  /// are process-wide: they aggregate every FuelClient and LocalCache.
+  /// \sa FuelClient::CacheStats
+  struct GZ_FUEL_TOOLS_VISIBLE CacheStatistics
+  {
+    /// \brief Fraction of lookups that were served from the cache.
+    /// \return Hit rate in [0, 1], or zero if there were no lookups.
+    public: double HitRate() const;
+
+    /// \brief Get the statistics as a human readable string.
+    /// \param[in] _prefix Optional prefix for every line of the string.
+    /// \return Statistics string.
+    public: std::string AsString(const std::string &_prefix = "") const;
+
+    /// \brief Number of times the cache was asked for a model, world or
+    /// file, e.g. by FuelClient::CachedModel.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t lookups = 0;
+
+    /// \brief Number of lookups found in the cache.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t hits = 0;
+
+    /// \brief Number of lookups not found in the cache.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t misses = 0;
+
+    /// \brief Number of successful model and world downloads.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t downloads = 0;
+
+    /// \brief Number of failed model and world downloads.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t downloadFailures = 0;
+
+    /// \brief Number of compressed bytes downloaded.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t bytesDownloaded = 0;
+
+    /// \brief Number of files extracted from archives.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t filesExtracted = 0;
+
+    /// \brief Number of bytes extracted from archives.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t bytesExtracted = 0;
+
+    /// \brief Number of files left out of extractions by a filter, which
+    /// is also the number of inodes saved.
+    /// \sa ExtractFilter
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t filesSkipped = 0;
+
+    /// \brief Number of uncompressed bytes left out of extractions by a
+    /// filter.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t bytesSkipped = 0;
+
+    /// \brief Number of readResource calls served from memory.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t memoryHits = 0;
+
+    /// \brief Number of readResource calls that loaded the file from disk
+    /// because it wasn't in memory.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t memoryMisses = 0;
+
+    /// \brief Number of files evicted from memory.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t memoryEvictions = 0;
+
+    /// \brief Time taken by downloads, including failed ones.
+    public: DurationHistogram downloadTime;
+
+    /// \brief Time taken to extract downloaded archives.
+    public: DurationHistogram extractTime;
+
+    /// \brief Time taken to rewrite model:// URIs after extraction.
+    public: DurationHistogram fixPathsTime;
+  };
+}  // namespace gz::fuel_tools
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif  // GZ_FUEL_TOOLS_CACHESTATISTICS_HH_
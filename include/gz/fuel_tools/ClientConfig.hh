@@ -18,6 +18,7 @@
 #ifndef GZ_FUEL_TOOLS_CLIENTCONFIG_HH_
 #define GZ_FUEL_TOOLS_CLIENTCONFIG_HH_
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +26,7 @@
 #include <gz/common/URI.hh>
 
 #include "gz/fuel_tools/Export.hh"
+#include "gz/fuel_tools/ExtractFilter.hh"
 #include "gz/fuel_tools/ServerConfig.hh"
 
 #ifdef _WIN32
@@ -102,6 +104,142 @@ namespace gz::fuel_tools
     /// \param[in] _path path on disk where models are saved.
     public: void SetCacheLocation(const std::string &_path);
 
+    /// \brief Add a read-only cache layer, for example a shared cache that
+    /// was populated in advance. Resources are looked up in the cache
+    /// location first, then in each layer in the order they were added.
+    /// New resources are only saved to the cache location. Layers can also
+    /// be set with the GZ_FUEL_CACHE_LAYERS environment variable, a list of
+    /// paths separated by ':' (';' on Windows), or with a "layers" list
+    /// under "cache" in the configuration file.
+    /// \param[in] _path Path to a cache directory.
+    public: void AddCacheLayer(const std::string &_path);
+
+    /// \brief Get the read-only cache layers.
+    /// \return Paths of the layers, in lookup order.
+    /// \sa AddCacheLayer
+    public: std::vector<std::string> CacheLayers() const;
+
+    /// \brief Enable or disable deduplication of cached files. When
+    /// enabled, files with identical content, for example meshes shared by
+    /// several models or unchanged across versions, are stored once in a
+    /// content-addressed blob store inside the cache location and hard
+    /// linked into each resource. It's disabled by default, and can also be
+    /// enabled with the GZ_FUEL_CACHE_DEDUP environment variable.
+    /// \param[in] _enable True to deduplicate files saved from now on.
+    public: void SetCacheDeduplication(bool _enable);
+
+    /// \brief Get whether cached files are deduplicated.
+    /// \return True if deduplication is enabled.
+    /// \sa SetCacheDeduplication
+    public: bool CacheDeduplication() const;
+
+    /// \brief Enable or disable archive mode. In archive mode, downloaded
+    /// archives are kept in the cache and only the description files
+    /// (model.config, metadata.pbtxt, SDF, URDF and world files) are
+    /// extracted. Other files, such as meshes and textures, are extracted the
+    /// first time they're requested through FuelClient::CachedModelFile or
+    /// FuelClient::CachedWorldFile. It's disabled by default, and can also be
+    /// enabled with the GZ_FUEL_CACHE_ARCHIVE environment variable.
+    /// \param[in] _enable True to save resources in archive mode from now
+    /// on.
+    public: void SetCacheArchiveMode(bool _enable);
+
+    /// \brief Get whether resources are saved in archive mode.
+    /// \return True if archive mode is enabled.
+    /// \sa SetCacheArchiveMode
+    public: bool CacheArchiveMode() const;
+
+    /// \brief Enable or disable streaming extraction. With streaming
+    /// extraction, downloaded models and worlds are decompressed while
+    /// they're being received instead of once the download completes, and
+    /// the result is checked against the archive's central directory before
+    /// it's installed. Archives that can't be streamed are extracted the
+    /// regular way. It has no effect in archive mode. It's disabled by
+    /// default, and can also be enabled with the GZ_FUEL_STREAMING_EXTRACT
+    /// environment variable.
+    /// \param[in] _enable True to extract downloads while they're received.
+    public: void SetStreamingExtract(bool _enable);
+
+    /// \brief Get whether downloads are extracted while they're received.
+    /// \return True if streaming extraction is enabled.
+    /// \sa SetStreamingExtract
+    public: bool StreamingExtract() const;
+
+    /// \brief Set which files of downloaded models and worlds are
+    /// extracted into the cache. Files left out are fetched from the
+    /// server when they're requested through the cache. Downloads that
+    /// are filtered aren't extracted while they're received, and the
+    /// filter has no effect in archive mode, which extracts files on
+    /// demand already. Every file is extracted by default. The patterns
+    /// can also be set with the GZ_FUEL_EXTRACT_INCLUDE and
+    /// GZ_FUEL_EXTRACT_EXCLUDE environment variables, as comma separated
+    /// lists.
+    /// \param[in] _filter Include and exclude patterns.
+    public: void SetExtractionFilter(const ExtractFilter &_filter);
+
+    /// \brief Get which files of downloads are extracted.
+    /// \return Include and exclude patterns.
+    /// \sa SetExtractionFilter
+    public: const ExtractFilter &ExtractionFilter() const;
+
+    /// \brief Set how many extracted files are flushed to disk together.
+    /// Flushing makes the cache survive a power loss right after a
+    /// download, and batching it costs much less than flushing every file.
+    /// It's only supported on POSIX systems. It's disabled by default,
+    /// leaving it to the operating system, and can also be set with the
+    /// GZ_FUEL_EXTRACT_SYNC_BATCH environment variable.
+    /// \param[in] _files Number of files per batch, at most 256, 0 to
+    /// disable flushing.
+    public: void SetExtractSyncBatch(unsigned int _files);
+
+    /// \brief Get how many extracted files are flushed to disk together.
+    /// \return Number of files per batch, 0 if flushing is disabled.
+    /// \sa SetExtractSyncBatch
+    public: unsigned int ExtractSyncBatch() const;
+
+    /// \brief Set the number of threads used to extract each downloaded
+    /// archive. Downloads of collections run several extractions at once,
+    /// one per download job, so the threads add up. It's 1 by default.
+    /// \param[in] _jobs Number of threads, 0 to use the hardware
+    /// concurrency.
+    public: void SetExtractJobs(unsigned int _jobs);
+
+    /// \brief Get the number of threads used to extract each downloaded
+    /// archive.
+    /// \return Number of threads, 0 means the hardware concurrency.
+    /// \sa SetExtractJobs
+    public: unsigned int ExtractJobs() const;
+
+    /// \brief Enable or disable lazy URI rewriting. By default, the
+    /// model:// URIs of downloaded models and worlds are rewritten to Fuel
+    /// URLs in their SDF and URDF files. With lazy rewriting, the files are
+    /// left as they were on the server, and the Fuel URL of each URI is
+    /// recorded next to the resource instead. Consumers then resolve the
+    /// URIs they find with resolveUri. It's disabled by default, and can
+    /// also be enabled with the GZ_FUEL_LAZY_URI_REWRITE environment
+    /// variable.
+    /// \param[in] _enable True to record URIs instead of rewriting them.
+    public: void SetLazyUriRewrite(bool _enable);
+
+    /// \brief Get whether URIs are recorded instead of being rewritten.
+    /// \return True if lazy URI rewriting is enabled.
+    /// \sa SetLazyUriRewrite
+    public: bool LazyUriRewrite() const;
+
+    /// \brief Set the size of the in-memory tier used by readResource.
+    /// Files read through it are kept in memory, least recently used first
+    /// out, until their total size reaches this bound. The tier is shared by
+    /// every client in the process. It's disabled by default, and can also
+    /// be set with the GZ_FUEL_MEMORY_CACHE_SIZE environment variable.
+    /// \param[in] _bytes Maximum number of bytes kept in memory, zero to
+    /// disable the tier.
+    public: void SetMemoryCacheSize(std::size_t _bytes);
+
+    /// \brief Get the size of the in-memory tier.
+    /// \return Maximum number of bytes kept in memory, zero if disabled.
+    /// \sa SetMemoryCacheSize
+    public: std::size_t MemoryCacheSize() const;
+
     /// \brief Returns all the client information as a string.
     /// \param[in] _prefix Optional prefix for every line of the string.
     /// \return Client information string
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_FUEL_TOOLS_EXTRACTFILTER_HH_
+#define GZ_FUEL_TOOLS_EXTRACTFILTER_HH_
+
+#include <string>
+#include <vector>
+
+#include "gz/fuel_tools/Export.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::vector
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace gz::fuel_tools
+{
+  /// \brief Glob patterns selecting which files of a downloaded model or
+  /// world are extracted into the cache, for example to leave out
+  /// thumbnails or source assets that a simulation never loads.
+  ///
+  /// Patterns are matched against the path of a file inside the resource,
+  /// using '/' separators. `*` matches any characters but '/', `**` also
+  /// matches '/' and `?` matches a single character but '/'. A pattern
+  /// without '/' is matched against every component of the path, so
+  /// `thumbnails` or `*.blend` apply at any depth. A pattern with '/'
+  /// matches the path or one of its parent directories, so
+  /// `materials/textures` covers every file below that directory.
+  ///
+  /// Description files such as model.config and SDF files are always
+  /// extracted. Files left out are recorded in the cache, and fetched from
+  /// the server when they're requested later on.
+  /// \sa ClientConfig::SetExtractionFilter
+  struct GZ_FUEL_TOOLS_VISIBLE ExtractFilter
+  {
+    /// \brief Whether the filter extracts every file.
+    /// \return True if there are no patterns.
+    public: bool Empty() const;
+
+    /// \brief Whether a file is extracted: it matches one of the include
+    /// patterns, or there are none, and it doesn't match any exclude
+    /// pattern.
+    /// \param[in] _path Path of the file relative to the resource, using
+    /// '/' separators.
+    /// \return True if the file is extracted.
+    public: bool Extracts(const std::string &_path) const;
+
+    /// \brief Whether a path matches a pattern, following the rules above.
+    /// \param[in] _pattern Glob pattern.
+    /// \param[in] _path Path using '/' separators.
+    /// \return True if the path matches.
+    public: static bool Matches(const std::string &_pattern,
+                const std::string &_path);
+
+    /// \brief Only files matching one of these patterns are extracted.
+    /// Empty to extract every file that isn't excluded.
+    public: std::vector<std::string> include;
+
+    /// \brief Files matching one of these patterns aren't extracted.
+    public: std::vector<std::string> exclude;
+  };
+}  // namespace gz::fuel_tools
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif  // GZ_FUEL_TOOLS_EXTRACTFILTER_HH_
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_FILEBUFFER_HH_
+#define GZ_FUEL_TOOLS_FILEBUFFER_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "gz/fuel_tools/Export.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace gz::fuel_tools
+{
+  /// \brief Forward declaration
+  class FileBufferPrivate;
+
+  /// \brief Immutable contents of a file. The file is memory mapped when
+  /// the platform supports it, and read into memory otherwise. Buffers are
+  /// usually shared, e.g. through readResource. Files replaced on disk
+  /// keep their old contents in existing buffers, but a mapped file that is
+  /// modified in place shows the modifications.
+  class GZ_FUEL_TOOLS_VISIBLE FileBuffer
+  {
+    /// \brief Constructor, loads a file.
+    /// \param[in] _path Path to the file.
+    /// \sa Valid
+    public: explicit FileBuffer(const std::string &_path);
+
+    /// \brief Destructor, releases the contents.
+    public: ~FileBuffer();
+
+    /// \brief Whether the file was loaded.
+    /// \return True if the file was loaded.
+    public: bool Valid() const;
+
+    /// \brief Get the path of the file.
+    /// \return Path passed to the constructor.
+    public: const std::string &Path() const;
+
+    /// \brief Get the contents of the file.
+    /// \return Pointer to the contents, null if the file is empty or wasn't
+    /// loaded.
+    public: const char *Data() const;
+
+    /// \brief Get the size of the file.
+    /// \return Size in bytes.
+    public: std::size_t Size() const;
+
+    /// \brief Get the contents of the file as a view.
+    /// \return View of the contents.
+    public: std::string_view View() const;
+
+    /// \brief Whether the contents are memory mapped.
+    /// \return True if the file is memory mapped.
+    public: bool Mapped() const;
+
+    /// \brief Private data.
+    private: std::unique_ptr<FileBufferPrivate> dataPtr;
+  };
+}  // namespace gz::fuel_tools
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif  // GZ_FUEL_TOOLS_FILEBUFFER_HH_
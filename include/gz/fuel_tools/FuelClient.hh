@@ -18,12 +18,16 @@
 #ifndef GZ_FUEL_TOOLS_FUELCLIENT_HH_
 #define GZ_FUEL_TOOLS_FUELCLIENT_HH_
 
+#include <future>
 #include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
 #include <gz/common/URI.hh>
 
+#include "gz/fuel_tools/CacheGcPolicy.hh"
+#include "gz/fuel_tools/CacheStatistics.hh"
+#include "gz/fuel_tools/ExtractFilter.hh"
 #include "gz/fuel_tools/ModelIter.hh"
 #include "gz/fuel_tools/RestClient.hh"
 #include "gz/fuel_tools/Result.hh"
@@ -245,6 +249,33 @@ namespace gz::fuel_tools
                 const std::vector<std::string> &_headers,
                 std::vector<ModelIdentifier> &_dependencies);
 
+    /// \brief Download a model and its dependencies from Gazebo Fuel,
+    /// extracting only some of their files. This will override an existing
+    /// local copy of the model.
+    /// \param[in] _id The model identifier.
+    /// \param[in] _headers Headers to set on the HTTP request.
+    /// \param[in] _filter Files to extract, instead of the filter of the
+    /// client configuration. Files left out are fetched by
+    /// CachedModelFile when they're requested.
+    /// \return Result of the download operation
+    /// \sa ClientConfig::SetExtractionFilter
+    public: Result DownloadModel(const ModelIdentifier &_id,
+                const std::vector<std::string> &_headers,
+                const ExtractFilter &_filter);
+
+    /// \brief Download a model from Gazebo Fuel, extracting only some of
+    /// its files. This will override an existing local copy of the model.
+    /// \param[in] _id The model identifier.
+    /// \param[in] _headers Headers to set on the HTTP request.
+    /// \param[out] _dependencies List of models that this model depends on.
+    /// \param[in] _filter Files to extract, instead of the filter of the
+    /// client configuration.
+    /// \return Result of the download operation
+    public: Result DownloadModel(const ModelIdentifier &_id,
+                const std::vector<std::string> &_headers,
+                std::vector<ModelIdentifier> &_dependencies,
+                const ExtractFilter &_filter);
+
     /// \brief Retrieve the list of dependencies for a model.
     /// \param[in] _id The model identifier.
     /// \param[out] _dependencies The list of dependencies.
@@ -274,6 +305,19 @@ namespace gz::fuel_tools
     public: Result DownloadWorld(WorldIdentifier &_id,
                 const std::vector<std::string> &_headers);
 
+    /// \brief Download a world from Gazebo Fuel, extracting only some of
+    /// its files. This will override an existing local copy of the world.
+    /// \param[out] _id The world identifier, with local path updated.
+    /// \param[in] _headers Headers to set on the HTTP request.
+    /// \param[in] _filter Files to extract, instead of the filter of the
+    /// client configuration. Files left out are fetched by
+    /// CachedWorldFile when they're requested.
+    /// \return Result of the download operation
+    /// \sa ClientConfig::SetExtractionFilter
+    public: Result DownloadWorld(WorldIdentifier &_id,
+                const std::vector<std::string> &_headers,
+                const ExtractFilter &_filter);
+
     /// \brief Download a model from Gazebo Fuel. This will override an
     /// existing local copy of the model.
     /// \param[in] _modelUrl The unique URL of the model to download.
@@ -355,6 +399,8 @@ namespace gz::fuel_tools
     /// https://server.org/1.0/owner/models/model/files/meshes/mesh.dae
     /// \param[out] _path Local path where the file can be found.
     /// \return FETCH_ERROR if not cached, FETCH_ALREADY_EXISTS if cached.
+    /// A file left out by the extraction filter is fetched from the server
+    /// first.
     public: Result CachedModelFile(const common::URI &_fileUrl,
                                    std::string &_path);
 
@@ -364,9 +410,33 @@ namespace gz::fuel_tools
     /// https://server.org/1.0/owner/worlds/world/files/name.world
     /// \param[out] _path Local path where the file can be found.
     /// \return FETCH_ERROR if not cached, FETCH_ALREADY_EXISTS if cached.
+    /// A file left out by the extraction filter is fetched from the server
+    /// first.
     public: Result CachedWorldFile(const common::URI &_fileUrl,
                                    std::string &_path);
 
+    /// \brief Get the Fuel URL of a model:// URI found in a cached model
+    /// or world saved with lazy URI rewriting. The URLs recorded for the
+    /// most recently used resources are kept in memory by this client.
+    /// \param[in] _uri URI found in one of the resource's files.
+    /// \param[in] _resourcePath Path to the cached resource, or to a file
+    /// within it.
+    /// \return Fuel URL recorded for the URI, or _uri if there's none.
+    /// \sa ClientConfig::SetLazyUriRewrite
+    public: std::string ResolveUri(const std::string &_uri,
+                const std::string &_resourcePath);
+
+    /// \brief Get the cache statistics: lookups, hits and misses of the
+    /// Cached* functions, downloads, and the time spent downloading,
+    /// extracting and fixing paths. The statistics are process-wide, they
+    /// aggregate all the clients.
+    /// \return Snapshot of the statistics.
+    public: static CacheStatistics CacheStats();
+
+    /// \brief Reset the process-wide cache statistics.
+    /// \sa CacheStats
+    public: static void ResetCacheStats();
+
     /// \brief Parse model identifier from model URL or unique name.
     /// \param[in] _modelUrl The unique URL of a model. It may also be a
     /// unique name, which is a URL without the server version.
@@ -481,6 +551,21 @@ namespace gz::fuel_tools
     /// \return True if everything updated successfully.
     public: bool UpdateWorlds(const std::vector<std::string> &_headers);
 
+    /// \brief Remove superseded versions of the cached models and worlds
+    /// in a background thread, for example after UpdateModels() and
+    /// UpdateWorlds(). The collection uses a copy of this client's
+    /// configuration, so the client may be destroyed before it completes.
+    ///
+    /// The caller must keep the returned future for as long as the
+    /// collection should run in the background: like any future from
+    /// std::async, its destructor waits for the collection to complete.
+    /// Discarding it right away makes the call synchronous.
+    /// \param[in] _policy Versions to keep.
+    /// \return Future holding the report of the collection.
+    /// \sa LocalCache::CollectGarbage
+    public: [[nodiscard]] std::future<CacheGcReport> CollectCacheGarbage(
+                const CacheGcPolicy &_policy) const;
+
     /// \brief Checked if there is any header already specify
     /// \param[in] _serverConfig Server configuration
     /// \param[in,out] _headers Vector with headers to check
@@ -18,14 +18,33 @@
 #ifndef GZ_FUEL_TOOLS_INTERFACE_HH_
 #define GZ_FUEL_TOOLS_INTERFACE_HH_
 
+#include <memory>
 #include <string>
 #include "gz/fuel_tools/Export.hh"
+#include "gz/fuel_tools/FileBuffer.hh"
 #include "gz/fuel_tools/FuelClient.hh"
 
 namespace gz::fuel_tools
 {
+  /// \brief Get the client used by fetchResource and readResource. It's
+  /// created with the default configuration on first use and shared by
+  /// the whole process, so resolving many URIs doesn't pay for a new
+  /// client each time. Several threads may look up cached resources
+  /// through it at once, as long as its configuration isn't changed; call
+  /// resetSharedClient instead. Downloads of the same resource aren't
+  /// coordinated between threads, though, each thread may download it.
+  /// \return The shared client.
+  GZ_FUEL_TOOLS_VISIBLE std::shared_ptr<FuelClient> sharedClient();
+
+  /// \brief Drop the shared client, so the next call to sharedClient
+  /// creates a new one. Use it after changing the environment variables
+  /// or config file the default configuration is read from. Callers that
+  /// still hold the previous client can keep using it.
+  GZ_FUEL_TOOLS_VISIBLE void resetSharedClient();
+
   /// \brief Download the specified resource into the default configuration of
   /// fuel tools. This will place the asset in ~/.gz/fuel.
+  /// The shared client is used, see sharedClient.
   /// \param[in] _uri URI to the asset.
   /// \return Path to the downloaded asset. Empty on error.
   GZ_FUEL_TOOLS_VISIBLE std::string fetchResource(
@@ -39,6 +58,46 @@ namespace gz::fuel_tools
   GZ_FUEL_TOOLS_VISIBLE std::string fetchResourceWithClient(
       const std::string &_uri, gz::fuel_tools::FuelClient &_client);
 
+  /// \brief Download a file resource, if needed, and read it. Files are
+  /// served from an in-memory tier when ClientConfig::MemoryCacheSize is
+  /// set, so repeated reads of the same file within a process don't go
+  /// back to disk. The shared client is used, see sharedClient.
+  /// \param[in] _uri URI to a model or world file.
+  /// \return Contents of the file, null on error.
+  GZ_FUEL_TOOLS_VISIBLE std::shared_ptr<const FileBuffer> readResource(
+      const std::string &_uri);
+
+  /// \brief Download a file resource, if needed, and read it using the
+  /// ClientConfig contained in the FuelClient parameter.
+  /// \param[in] _uri URI to a model or world file.
+  /// \param[in] _client Custom FuelClient configuration.
+  /// \return Contents of the file, null on error.
+  /// \sa readResource
+  GZ_FUEL_TOOLS_VISIBLE std::shared_ptr<const FileBuffer>
+  readResourceWithClient(const std::string &_uri,
+      gz::fuel_tools::FuelClient &_client);
+
+  /// \brief Resolve a model:// URI found in a model or world fetched with
+  /// fetchResource. Resources downloaded with lazy URI rewriting keep the
+  /// model:// URIs of their SDF and URDF files, and the Fuel URL recorded
+  /// for each of them is returned here. Here is a typical use case:
+  ///
+  ///   1. Fetch a Fuel resource:
+  ///   `std::string resourcePath = fetchResource("https://...")`
+  ///   2. Parse its SDF file, see sdfFromPath.
+  ///   3. Resolve each URI found in it:
+  ///   `std::string url = resolveUri(uri, resourcePath)`
+  ///   4. Fetch the resulting URL with fetchResource.
+  ///
+  /// \param[in] _uri URI found in one of the resource's files.
+  /// \param[in] _resourcePath Path returned by fetchResource, or the path
+  /// of a file within the resource.
+  /// \return Fuel URL of the URI, or _uri if the resource's URIs were
+  /// rewritten when it was downloaded or none was recorded for it.
+  /// \sa ClientConfig::SetLazyUriRewrite
+  GZ_FUEL_TOOLS_VISIBLE std::string resolveUri(const std::string &_uri,
+      const std::string &_resourcePath);
+
   /// \brief Get the SDF file path for a model or world based on a directory
   /// containing a Fuel model or world. Here is a typical use case:
   ///
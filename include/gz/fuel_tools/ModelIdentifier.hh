@@ -57,6 +57,17 @@ namespace gz::fuel_tools
     /// \return Reference to this object.
     public: ModelIdentifier &operator=(const ModelIdentifier &_orig);
 
+    /// \brief Move constructor.
+    /// \param[in] _orig ModelIdentifier to move. It can only be assigned to or
+    /// destroyed afterwards.
+    public: ModelIdentifier(ModelIdentifier &&_orig) noexcept;
+
+    /// \brief Move assignment operator.
+    /// \param[in] _orig ModelIdentifier to move. It can only be assigned to or
+    /// destroyed afterwards.
+    /// \return Reference to this object.
+    public: ModelIdentifier &operator=(ModelIdentifier &&_orig) noexcept;
+
     /// \brief Equality operator.
     /// \param[in] _rhs ModelIdentifier to compare.
     /// \return True if the ModelIdentifier names are equal.
@@ -17,6 +17,8 @@
 #ifndef GZ_FUEL_TOOLS_RESTCLIENT_HH_
 #define GZ_FUEL_TOOLS_RESTCLIENT_HH_
 
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -61,6 +63,11 @@ namespace gz::fuel_tools
     ///            E.g.: "GET"
     /// \param[in] _url The url to request.
     ///            E.g.: "http://localhost:8000/"
+    ///            A "file://" URL reads GET requests from a mirror of the
+    ///            REST API on the local filesystem. Mirrored directories
+    ///            answer with their "index.json" file, or "index-N.json" for
+    ///            page N, and a "tip" version resolves to the highest
+    ///            numbered version directory.
     /// \param[in] _version The protocol version.
     ///            E.g.: "1.0"
     /// \param[in] _path The path to request.
@@ -90,6 +97,32 @@ namespace gz::fuel_tools
         const std::multimap<std::string, std::string> &_form =
         std::multimap<std::string, std::string>()) const;
 
+    /// \brief Trigger a REST request, and see the body of the response
+    /// while it's being received, for example to process a download as it
+    /// arrives. The body is still returned in full.
+    /// \param[in] _method The HTTP method.
+    /// \param[in] _url The url to request.
+    /// \param[in] _version The protocol version.
+    /// \param[in] _path The path to request.
+    /// \param[in] _queryStrings All the query strings to be requested.
+    /// \param[in] _headers All the headers to be included in the request.
+    /// \param[in] _data Data to be included in the HTTP request.
+    /// \param[in] _form Multi-part / form data to be used with
+    /// Method::POST_FORM.
+    /// \param[in] _dataCallback Called with each chunk of the body.
+    /// Returning false stops further calls. May be empty.
+    /// \sa Request
+    public: RestResponse Request(const HttpMethod _method,
+        const std::string &_url,
+        const std::string &_version,
+        const std::string &_path,
+        const std::vector<std::string> &_queryStrings,
+        const std::vector<std::string> &_headers,
+        const std::string &_data,
+        const std::multimap<std::string, std::string> &_form,
+        const std::function<bool(const char *, std::size_t)> &_dataCallback)
+        const;
+
     /// \brief Set the user agent name.
     /// \param[in] _agent User agent name.
     public: void SetUserAgent(const std::string &_agent);
@@ -38,6 +38,12 @@ namespace gz::fuel_tools
   class ServerConfigPrivate;
 
   /// \brief Describes options needed for a server.
+  ///
+  /// Copies share the same immutable data until one of them is modified,
+  /// so identifiers, iterators and the cache can hold the server of every
+  /// resource without copying its URL and key. Like other value types,
+  /// distinct objects can be used from different threads, but an object
+  /// must not be modified while another thread uses or copies it.
   class GZ_FUEL_TOOLS_VISIBLE ServerConfig
   {
     /// \brief Constructor.
@@ -54,6 +54,17 @@ namespace gz::fuel_tools
     /// \return Reference to this object.
     public: WorldIdentifier &operator=(const WorldIdentifier &_orig);
 
+    /// \brief Move constructor.
+    /// \param[in] _orig WorldIdentifier to move. It can only be assigned to or
+    /// destroyed afterwards.
+    public: WorldIdentifier(WorldIdentifier &&_orig) noexcept;
+
+    /// \brief Move assignment operator.
+    /// \param[in] _orig WorldIdentifier to move. It can only be assigned to or
+    /// destroyed afterwards.
+    /// \return Reference to this object.
+    public: WorldIdentifier &operator=(WorldIdentifier &&_orig) noexcept;
+
     /// \brief Equality operator.
     /// \param[in] _rhs WorldIdentifier to compare.
     /// \return True if the WorldIdentifier names are equal.
@@ -17,29 +17,139 @@
 #ifndef GZ_FUEL_TOOLS_ZIP_HH_
 #define GZ_FUEL_TOOLS_ZIP_HH_
 
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "gz/fuel_tools/Export.hh"
 
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::set and std::function
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
 namespace gz::fuel_tools
 {
+  /// \brief Options of Zip::Compress.
+  struct GZ_FUEL_TOOLS_VISIBLE ZipCompressOptions
+  {
+    /// \brief Compression level, as in zlib: from 1 (fastest) to 9
+    /// (smallest), 0 to store every file without compression, and -1 for
+    /// zlib's default level.
+    public: int level = -1;
+
+    /// \brief Extensions of files stored without compression, lowercase
+    /// and including the dot. Deflating formats that are compressed
+    /// already, such as PNG or JPEG images, costs time and saves nothing.
+    /// Empty by default, so every file is deflated.
+    /// \sa Zip::StoredExtensions
+    public: std::set<std::string> storedExtensions;
+
+    /// \brief Maximum number of threads compressing files, 0 to use the
+    /// hardware concurrency, 1 to compress sequentially. Workers deflate
+    /// files in memory a bounded amount ahead of the archive being
+    /// written, so memory use doesn't grow with the size of the files.
+    public: unsigned int jobs = 1u;
+  };
+
+  /// \brief Options of Zip::Extract.
+  struct GZ_FUEL_TOOLS_VISIBLE ZipExtractOptions
+  {
+    /// \brief Maximum number of threads, 0 to use the hardware
+    /// concurrency, 1 to extract sequentially.
+    public: unsigned int jobs = 1u;
+
+    /// \brief Called on the calling thread with the name of each entry as
+    /// stored in the archive, using '/' separators, and returning false
+    /// for entries to skip. Empty to extract everything.
+    /// \sa ExtractFilter
+    public: std::function<bool(const std::string &)> filter;
+
+    /// \brief Number of extracted files flushed to disk together, 0 to
+    /// leave it to the operating system. Flushing in batches makes an
+    /// extraction durable at a fraction of the cost of flushing each file.
+    /// It's only supported on POSIX systems, and batches are capped at 256
+    /// files.
+    public: unsigned int syncBatch = 0u;
+  };
+
   /// \brief A helper class for making REST requests.
   class GZ_FUEL_TOOLS_VISIBLE Zip
   {
-    /// \brief Compress a file or directory
+    /// \brief Compress a file or directory. Every file is deflated, use
+    /// the overload with options to store some of them as is.
     /// \param[in] _src Path to file or directory to compress
     /// \param[in] _dst Output compressed file path
+    /// \return True if every file was added to the archive.
     public: static bool Compress(const std::string &_src,
         const std::string &_dst);
 
-    /// \brief Extract a compressed file
+    /// \brief Compress a file or directory with options.
+    /// \param[in] _src Path to file or directory to compress
+    /// \param[in] _dst Output compressed file path
+    /// \param[in] _options Compression level, files stored as is and
+    /// number of threads.
+    /// \return True if every file was added to the archive.
+    public: static bool Compress(const std::string &_src,
+        const std::string &_dst, const ZipCompressOptions &_options);
+
+    /// \brief Get the extensions of common formats that are compressed
+    /// already: images, compressed textures, audio, video and archives.
+    /// \return Lowercase extensions, including the dot.
+    /// \sa ZipCompressOptions::storedExtensions
+    public: static const std::set<std::string> &StoredExtensions();
+
+    /// \brief Extract a compressed file. Entries are streamed through a
+    /// fixed size buffer, so memory use doesn't depend on their size, and
+    /// entries larger than 4 GiB (Zip64) are supported.
     /// \param[in] _src Path to compressed file
     /// \param[in] _dst Output extracted file path
     public: static bool Extract(const std::string &_src,
         const std::string &_dst);
+
+    /// \brief Extract a compressed file with options. With several
+    /// threads, directories are created first, and then file entries are
+    /// extracted by a pool of workers, each with its own handle to the
+    /// archive. Archives with little data are extracted on the calling
+    /// thread.
+    /// \param[in] _src Path to compressed file
+    /// \param[in] _dst Output extracted file path
+    /// \param[in] _options Number of threads, entries to skip and
+    /// flushing to disk.
+    /// \return True on success.
+    public: static bool Extract(const std::string &_src,
+        const std::string &_dst, const ZipExtractOptions &_options);
+
+    /// \brief Extract a compressed archive held in memory, such as a
+    /// downloaded one, without writing it to disk first.
+    /// \param[in] _data Archive data, which must outlive the call.
+    /// \param[in] _size Size of the archive data.
+    /// \param[in] _dst Output extracted file path
+    /// \return True on success.
+    /// \sa Extract
+    public: static bool ExtractFromMemory(const char *_data,
+        std::size_t _size, const std::string &_dst);
+
+    /// \brief Extract a compressed archive held in memory with options.
+    /// \param[in] _data Archive data, which must outlive the call.
+    /// \param[in] _size Size of the archive data.
+    /// \param[in] _dst Output extracted file path
+    /// \param[in] _options Number of threads, entries to skip and
+    /// flushing to disk.
+    /// \return True on success.
+    public: static bool ExtractFromMemory(const char *_data,
+        std::size_t _size, const std::string &_dst,
+        const ZipExtractOptions &_options);
   };
 }  // namespace gz::fuel_tools
 
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
 #endif  // GZ_FUEL_TOOLS_ZIP_HH_
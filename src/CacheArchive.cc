@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <zip.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/StringUtils.hh>
+
+#include "CacheArchive.hh"
+#include "CachePack.hh"
+#include "CacheStatisticsRecorder.hh"
+
+namespace fs = std::filesystem;
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /// \brief Size of the buffer used to stream files out of an archive.
+  constexpr std::size_t kExtractBufferSize = 64u * 1024u;
+
+  /// \brief Maximum number of archive indexes kept in memory.
+  constexpr std::size_t kMaxIndexes = 4096u;
+
+  /// \brief Files of an archive, from its central directory.
+  struct ArchiveIndex
+  {
+    /// \brief Modification time of the archive when it was indexed.
+    fs::file_time_type mtime;
+
+    /// \brief Size of the archive when it was indexed.
+    std::uintmax_t size = 0;
+
+    /// \brief Entry index of each file, by name.
+    std::unordered_map<std::string, zip_uint64_t> entries;
+  };
+
+  /// \brief Indexes of the archives accessed by this process.
+  std::unordered_map<std::string, std::shared_ptr<const ArchiveIndex>>
+    gIndexes;
+
+  /// \brief Protects gIndexes.
+  std::mutex gIndexesMutex;
+
+  /// \brief Check if an entry is a regular file with a safe name.
+  /// \param[in] _name Entry name.
+  /// \return True for files that can be extracted.
+  bool isFileEntry(const std::string &_name)
+  {
+    return !_name.empty() && _name.back() != '/' &&
+      CachePackReader::ValidPath(_name);
+  }
+
+  /// \brief Get the index of an archive, building it if the archive wasn't
+  /// indexed yet or changed since.
+  /// \param[in] _archive Path to the archive.
+  /// \return The index, null if the archive can't be read.
+  std::shared_ptr<const ArchiveIndex> archiveIndex(const std::string &_archive)
+  {
+    std::error_code ec;
+    auto mtime = fs::last_write_time(_archive, ec);
+    if (ec)
+      return nullptr;
+    auto size = fs::file_size(_archive, ec);
+    if (ec)
+      return nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(gIndexesMutex);
+      auto it = gIndexes.find(_archive);
+      if (it != gIndexes.end() && it->second->mtime == mtime &&
+          it->second->size == size)
+      {
+        return it->second;
+      }
+    }
+
+    int err = 0;
+    zip_t *archive = zip_open(_archive.c_str(), ZIP_RDONLY, &err);
+    if (!archive)
+    {
+      gzerr << "Unable to open archive [" << _archive << "]" << std::endl;
+      return nullptr;
+    }
+
+    auto index = std::make_shared<ArchiveIndex>();
+    index->mtime = mtime;
+    index->size = size;
+    zip_int64_t count = zip_get_num_entries(archive, 0);
+    for (zip_int64_t i = 0; i < count; ++i)
+    {
+      const char *name = zip_get_name(archive, i, 0);
+      if (name && isFileEntry(name))
+        index->entries.emplace(name, static_cast<zip_uint64_t>(i));
+    }
+    zip_discard(archive);
+
+    std::lock_guard<std::mutex> lock(gIndexesMutex);
+    if (gIndexes.size() >= kMaxIndexes)
+      gIndexes.clear();
+    gIndexes[_archive] = index;
+    return index;
+  }
+
+  /// \brief Stream an archive entry to a file. The data is written to a
+  /// temporary file first, then renamed.
+  /// \param[in] _archive Open archive.
+  /// \param[in] _entry Entry index.
+  /// \param[in] _dst Path of the extracted file.
+  /// \return True on success.
+  bool extractEntry(zip_t *_archive, zip_uint64_t _entry,
+      const std::string &_dst)
+  {
+    zip_file_t *zf = zip_fopen_index(_archive, _entry, 0);
+    if (!zf)
+    {
+      gzerr << "Unable to open archive entry [" << _entry << "]"
+            << std::endl;
+      return false;
+    }
+
+    common::createDirectories(common::parentPath(_dst));
+    std::string tmp = _dst + ".tmp" + std::to_string(
+        std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    std::vector<char> buffer(kExtractBufferSize);
+    std::uint64_t written = 0;
+    zip_int64_t n = 0;
+    {
+      std::ofstream out(tmp, std::ios::out | std::ios::binary |
+          std::ios::trunc);
+      while ((n = zip_fread(zf, buffer.data(), buffer.size())) > 0)
+      {
+        out.write(buffer.data(), n);
+        written += static_cast<std::uint64_t>(n);
+      }
+      if (!out)
+        n = -1;
+    }
+    zip_fclose(zf);
+
+    std::error_code ec;
+    if (n < 0)
+    {
+      gzerr << "Unable to extract [" << _dst << "]" << std::endl;
+      fs::remove(tmp, ec);
+      return false;
+    }
+
+    fs::rename(tmp, _dst, ec);
+    if (ec)
+    {
+      gzerr << "Unable to write [" << _dst << "]: " << ec.message()
+            << std::endl;
+      fs::remove(tmp, ec);
+      return false;
+    }
+
+    auto &stats = CacheStatisticsRecorder::Instance();
+    stats.Add(CacheStatisticsRecorder::Counter::FILES_EXTRACTED);
+    stats.Add(CacheStatisticsRecorder::Counter::BYTES_EXTRACTED, written);
+    return true;
+  }
+
+  /// \brief Extract the files of an archive that match a predicate.
+  /// \param[in] _archive Path to the archive.
+  /// \param[in] _dst Directory where the files are written.
+  /// \param[in] _filter Called with the entry name and destination path,
+  /// returns true to extract the entry.
+  /// \return True on success.
+  bool extractIf(const std::string &_archive, const std::string &_dst,
+      const std::function<bool(const std::string &, const std::string &)>
+        &_filter)
+  {
+    auto index = archiveIndex(_archive);
+    if (!index)
+      return false;
+
+    int err = 0;
+    zip_t *archive = zip_open(_archive.c_str(), ZIP_RDONLY, &err);
+    if (!archive)
+    {
+      gzerr << "Unable to open archive [" << _archive << "]" << std::endl;
+      return false;
+    }
+
+    bool result = true;
+    for (const auto &[name, entry] : index->entries)
+    {
+      std::string rel = name;
+      common::changeFromUnixPath(rel);
+      std::string dst = common::joinPaths(_dst, rel);
+      if (_filter(name, dst) && !extractEntry(archive, entry, dst))
+        result = false;
+    }
+    zip_discard(archive);
+    return result;
+  }
+}
+
+//////////////////////////////////////////////////
+std::string CacheArchive::Path(const std::string &_versionedDir)
+{
+  return _versionedDir + ".zip";
+}
+
+//////////////////////////////////////////////////
+bool CacheArchive::IsDescriptionFile(const std::string &_name)
+{
+  std::string name = common::lowercase(_name);
+  std::string base = name.substr(name.find_last_of("/\\") + 1);
+  if (base == "model.config" || base == "metadata.pbtxt")
+    return true;
+
+  for (const char *ext : {".sdf", ".urdf", ".world"})
+  {
+    if (common::EndsWith(base, ext))
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool CacheArchive::ExtractDescriptions(const std::string &_archive,
+    const std::string &_dst)
+{
+  return extractIf(_archive, _dst,
+      [](const std::string &_name, const std::string &)
+      {
+        return IsDescriptionFile(_name);
+      });
+}
+
+//////////////////////////////////////////////////
+bool CacheArchive::Contains(const std::string &_archive,
+    const std::string &_name)
+{
+  auto index = archiveIndex(_archive);
+  return index && index->entries.count(_name) > 0;
+}
+
+//////////////////////////////////////////////////
+bool CacheArchive::ExtractFile(const std::string &_archive,
+    const std::string &_name, const std::string &_dst)
+{
+  auto index = archiveIndex(_archive);
+  if (!index)
+    return false;
+
+  auto it = index->entries.find(_name);
+  if (it == index->entries.end())
+    return false;
+
+  int err = 0;
+  zip_t *archive = zip_open(_archive.c_str(), ZIP_RDONLY, &err);
+  if (!archive)
+  {
+    gzerr << "Unable to open archive [" << _archive << "]" << std::endl;
+    return false;
+  }
+
+  bool result = extractEntry(archive, it->second, _dst);
+  zip_discard(archive);
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool CacheArchive::ExtractMissing(const std::string &_archive,
+    const std::string &_dst)
+{
+  return extractIf(_archive, _dst,
+      [](const std::string &, const std::string &_path)
+      {
+        return !common::exists(_path);
+      });
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_CACHEARCHIVE_HH_
+#define GZ_FUEL_TOOLS_CACHEARCHIVE_HH_
+
+#include <string>
+
+#include "gz/fuel_tools/Export.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Access to the archives kept by resources saved in archive mode.
+  ///
+  /// The archive of a resource is stored next to its versioned directory.
+  /// Only description files are extracted when the resource is saved, the
+  /// other files are extracted one at a time when requested. The central
+  /// directory of each archive is indexed once per process, so looking up
+  /// a file doesn't scan the archive.
+  /// \sa ClientConfig::SetCacheArchiveMode
+  class GZ_FUEL_TOOLS_VISIBLE CacheArchive
+  {
+    /// \brief Get the path of the archive kept for a resource.
+    /// \param[in] _versionedDir Path to a versioned resource directory.
+    /// \return Path to the archive.
+    public: static std::string Path(const std::string &_versionedDir);
+
+    /// \brief Check if a file is a description file, which is extracted
+    /// when the resource is saved: model.config, metadata.pbtxt, and SDF,
+    /// URDF and world files.
+    /// \param[in] _name Path of the file inside the archive.
+    /// \return True for description files.
+    public: static bool IsDescriptionFile(const std::string &_name);
+
+    /// \brief Extract the description files of an archive.
+    /// \param[in] _archive Path to the archive.
+    /// \param[in] _dst Directory where the files are written.
+    /// \return True on success.
+    public: static bool ExtractDescriptions(const std::string &_archive,
+                                            const std::string &_dst);
+
+    /// \brief Check if an archive holds a file.
+    /// \param[in] _archive Path to the archive.
+    /// \param[in] _name Path of the file inside the archive, using '/'
+    /// separators.
+    /// \return True if the file is in the archive.
+    public: static bool Contains(const std::string &_archive,
+                                 const std::string &_name);
+
+    /// \brief Extract a single file. The file is written to a temporary
+    /// path and renamed, so concurrent readers never see a partial file.
+    /// \param[in] _archive Path to the archive.
+    /// \param[in] _name Path of the file inside the archive, using '/'
+    /// separators.
+    /// \param[in] _dst Path of the extracted file.
+    /// \return True on success.
+    public: static bool ExtractFile(const std::string &_archive,
+                                    const std::string &_name,
+                                    const std::string &_dst);
+
+    /// \brief Extract every file that is not already in a directory.
+    /// \param[in] _archive Path to the archive.
+    /// \param[in] _dst Directory where the files are written.
+    /// \return True on success.
+    public: static bool ExtractMissing(const std::string &_archive,
+                                       const std::string &_dst);
+  };
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_CACHEARCHIVE_HH_
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/Zip.hh"
+
+#include "CacheArchive.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+TEST(CacheArchive, IsDescriptionFile)
+{
+  EXPECT_TRUE(CacheArchive::IsDescriptionFile("model.config"));
+  EXPECT_TRUE(CacheArchive::IsDescriptionFile("box/metadata.pbtxt"));
+  EXPECT_TRUE(CacheArchive::IsDescriptionFile("model.sdf"));
+  EXPECT_TRUE(CacheArchive::IsDescriptionFile("robot/robot.URDF"));
+  EXPECT_TRUE(CacheArchive::IsDescriptionFile("worlds/empty.world"));
+  EXPECT_FALSE(CacheArchive::IsDescriptionFile("meshes/box.dae"));
+  EXPECT_FALSE(CacheArchive::IsDescriptionFile("materials/box.png"));
+  EXPECT_FALSE(CacheArchive::IsDescriptionFile("sdf/readme.txt"));
+}
+
+/////////////////////////////////////////////////
+TEST(CacheArchive, Extract)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  std::string src = common::joinPaths(tempDir->Path(), "box");
+  ASSERT_TRUE(common::createDirectories(common::joinPaths(src, "meshes")));
+  {
+    std::ofstream out(common::joinPaths(src, "model.config"));
+    out << "<model/>";
+  }
+  {
+    std::ofstream out(common::joinPaths(src, "meshes", "box.dae"));
+    out << "<COLLADA/>";
+  }
+
+  std::string versionedDir = common::joinPaths(tempDir->Path(), "1");
+  std::string archive = CacheArchive::Path(versionedDir);
+  EXPECT_EQ(versionedDir + ".zip", archive);
+  ASSERT_TRUE(Zip::Compress(src, archive));
+
+  EXPECT_TRUE(CacheArchive::Contains(archive, "box/model.config"));
+  EXPECT_TRUE(CacheArchive::Contains(archive, "box/meshes/box.dae"));
+  EXPECT_FALSE(CacheArchive::Contains(archive, "box/meshes"));
+  EXPECT_FALSE(CacheArchive::Contains(archive, "box/banana.dae"));
+  EXPECT_FALSE(CacheArchive::Contains(
+      common::joinPaths(tempDir->Path(), "missing.zip"), "box/model.config"));
+
+  ASSERT_TRUE(CacheArchive::ExtractDescriptions(archive, versionedDir));
+  EXPECT_TRUE(common::isFile(
+      common::joinPaths(versionedDir, "box", "model.config")));
+  std::string mesh = common::joinPaths(versionedDir, "box", "meshes",
+      "box.dae");
+  EXPECT_FALSE(common::exists(mesh));
+
+  EXPECT_TRUE(CacheArchive::ExtractFile(archive, "box/meshes/box.dae", mesh));
+  EXPECT_TRUE(common::isFile(mesh));
+  EXPECT_FALSE(CacheArchive::ExtractFile(archive, "box/banana.dae",
+      common::joinPaths(versionedDir, "banana.dae")));
+
+  // Only missing files are extracted
+  ASSERT_TRUE(common::removeFile(mesh));
+  {
+    std::ofstream out(common::joinPaths(versionedDir, "box", "model.config"));
+    out << "<modified/>";
+  }
+  ASSERT_TRUE(CacheArchive::ExtractMissing(archive, versionedDir));
+  EXPECT_TRUE(common::isFile(mesh));
+  std::ifstream in(common::joinPaths(versionedDir, "box", "model.config"));
+  std::string content;
+  std::getline(in, content);
+  EXPECT_EQ("<modified/>", content);
+}
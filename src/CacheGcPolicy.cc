@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+
+#include "gz/fuel_tools/CacheGcPolicy.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+//////////////////////////////////////////////////
+std::string CacheGcReport::AsString(const std::string &_prefix) const
+{
+  std::ostringstream out;
+  out << _prefix << "Removed versions: " << this->removedVersions
+      << std::endl
+      << _prefix << "Kept versions: " << this->keptVersions << std::endl
+      << _prefix << "Reclaimed bytes: " << this->reclaimedBytes << std::endl
+      << _prefix << "Complete: " << (this->complete ? "yes" : "no")
+      << std::endl;
+  return out.str();
+}
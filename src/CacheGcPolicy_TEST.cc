@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "gz/fuel_tools/CacheGcPolicy.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+TEST(CacheGcReport, AsString)
+{
+  CacheGcReport report;
+  report.removedVersions = 2;
+  report.keptVersions = 5;
+  report.reclaimedBytes = 1024;
+  report.complete = false;
+
+  std::string str = report.AsString("  ");
+  EXPECT_NE(std::string::npos, str.find("  Removed versions: 2\n"));
+  EXPECT_NE(std::string::npos, str.find("  Kept versions: 5\n"));
+  EXPECT_NE(std::string::npos, str.find("  Reclaimed bytes: 1024\n"));
+  EXPECT_NE(std::string::npos, str.find("  Complete: no\n"));
+}
@@ -0,0 +1,420 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <zip.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+
+#include "CachePack.hh"
+#include "CacheStatisticsRecorder.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /// \brief Name of the archive entry holding the index.
+  const char kIndexName[] = ".gz-fuel-pack/index";
+
+  /// \brief First line of the index.
+  const char kIndexHeader[] = "gz-fuel-pack 1";
+
+  /// \brief Size of the buffer used to stream files out of the pack.
+  constexpr std::size_t kExtractBufferSize = 64u * 1024u;
+
+  /// \brief Recursively list the regular files in a directory.
+  /// \param[in] _dir Directory to list.
+  /// \param[in] _prefix Relative path of _dir, prepended to the results.
+  /// \param[out] _files Relative paths of the files, using '/' separators.
+  void listFiles(const std::string &_dir, const std::string &_prefix,
+      std::vector<std::string> &_files)
+  {
+    common::DirIter end;
+    for (common::DirIter iter(_dir); iter != end; ++iter)
+    {
+      std::string rel = _prefix + common::basename(*iter);
+      if (common::isDirectory(*iter))
+        listFiles(*iter, rel + "/", _files);
+      else if (common::isFile(*iter))
+        _files.push_back(rel);
+    }
+  }
+
+  /// \brief Split a path on '/' and '\' separators.
+  /// \param[in] _path Path to split.
+  /// \return Path components, including empty ones.
+  std::vector<std::string> splitPath(const std::string &_path)
+  {
+    std::vector<std::string> parts(1);
+    for (char c : _path)
+    {
+      if (c == '/' || c == '\\')
+        parts.emplace_back();
+      else
+        parts.back().push_back(c);
+    }
+    return parts;
+  }
+}
+
+/// \brief Private data for CachePackWriter.
+class gz::fuel_tools::CachePackWriterPrivate
+{
+  /// \brief Archive being written.
+  public: zip_t *archive = nullptr;
+
+  /// \brief Resources added so far.
+  public: std::vector<CachePackResource> resources;
+
+  /// \brief Serialized index. libzip reads it when the archive is closed,
+  /// so it must outlive the archive.
+  public: std::string index;
+};
+
+/// \brief Private data for CachePackReader.
+class gz::fuel_tools::CachePackReaderPrivate
+{
+  /// \brief Archive being read.
+  public: zip_t *archive = nullptr;
+
+  /// \brief Resources listed in the index.
+  public: std::vector<CachePackResource> resources;
+};
+
+//////////////////////////////////////////////////
+CachePackWriter::CachePackWriter()
+  : dataPtr(new CachePackWriterPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+CachePackWriter::~CachePackWriter()
+{
+  if (this->dataPtr->archive)
+    zip_discard(this->dataPtr->archive);
+}
+
+//////////////////////////////////////////////////
+bool CachePackWriter::Open(const std::string &_path)
+{
+  if (this->dataPtr->archive)
+  {
+    gzerr << "Pack already open" << std::endl;
+    return false;
+  }
+
+  int err = 0;
+  this->dataPtr->archive =
+    zip_open(_path.c_str(), ZIP_CREATE | ZIP_TRUNCATE, &err);
+  if (!this->dataPtr->archive)
+  {
+    gzerr << "Unable to create pack [" << _path << "]" << std::endl;
+    return false;
+  }
+  this->dataPtr->resources.clear();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool CachePackWriter::AddResource(const std::string &_type,
+    const std::string &_path, const std::string &_dir)
+{
+  if (!this->dataPtr->archive)
+    return false;
+
+  if (!CachePackReader::ValidPath(_path))
+  {
+    gzerr << "Invalid resource path [" << _path << "]" << std::endl;
+    return false;
+  }
+
+  std::vector<std::string> files;
+  listFiles(_dir, "", files);
+  std::sort(files.begin(), files.end());
+
+  CachePackResource resource;
+  resource.type = _type;
+  resource.path = _path;
+  for (const auto &file : files)
+  {
+    std::string full = common::joinPaths(_dir, file);
+    zip_source_t *source =
+      zip_source_file(this->dataPtr->archive, full.c_str(), 0, 0);
+    if (!source)
+    {
+      gzerr << "Unable to read [" << full << "]" << std::endl;
+      return false;
+    }
+
+    std::string name = _path + "/" + file;
+    zip_int64_t index = zip_file_add(this->dataPtr->archive, name.c_str(),
+        source, ZIP_FL_ENC_UTF_8);
+    if (index < 0)
+    {
+      gzerr << "Unable to add [" << full << "] to pack: "
+            << zip_strerror(this->dataPtr->archive) << std::endl;
+      zip_source_free(source);
+      return false;
+    }
+
+    if (resource.entryCount == 0)
+      resource.firstEntry = static_cast<std::uint64_t>(index);
+    ++resource.entryCount;
+  }
+
+  this->dataPtr->resources.push_back(resource);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool CachePackWriter::Close()
+{
+  if (!this->dataPtr->archive)
+    return false;
+
+  std::ostringstream index;
+  index << kIndexHeader << "\n";
+  for (const auto &resource : this->dataPtr->resources)
+  {
+    index << resource.type << "\t" << resource.firstEntry << "\t"
+          << resource.entryCount << "\t" << resource.path << "\n";
+  }
+  this->dataPtr->index = index.str();
+
+  zip_source_t *source = zip_source_buffer(this->dataPtr->archive,
+      this->dataPtr->index.data(), this->dataPtr->index.size(), 0);
+  if (!source || zip_file_add(this->dataPtr->archive, kIndexName, source,
+        ZIP_FL_ENC_UTF_8) < 0)
+  {
+    gzerr << "Unable to add the pack index" << std::endl;
+    if (source)
+      zip_source_free(source);
+    return false;
+  }
+
+  if (zip_close(this->dataPtr->archive) < 0)
+  {
+    gzerr << "Unable to write pack: "
+          << zip_strerror(this->dataPtr->archive) << std::endl;
+    return false;
+  }
+  this->dataPtr->archive = nullptr;
+  return true;
+}
+
+//////////////////////////////////////////////////
+CachePackReader::CachePackReader()
+  : dataPtr(new CachePackReaderPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+CachePackReader::~CachePackReader()
+{
+  if (this->dataPtr->archive)
+    zip_discard(this->dataPtr->archive);
+}
+
+//////////////////////////////////////////////////
+bool CachePackReader::Open(const std::string &_path)
+{
+  if (this->dataPtr->archive)
+  {
+    gzerr << "Pack already open" << std::endl;
+    return false;
+  }
+
+  int err = 0;
+  this->dataPtr->archive = zip_open(_path.c_str(), ZIP_RDONLY, &err);
+  if (!this->dataPtr->archive)
+  {
+    gzerr << "Unable to open pack [" << _path << "]" << std::endl;
+    return false;
+  }
+
+  zip_int64_t indexEntry =
+    zip_name_locate(this->dataPtr->archive, kIndexName, 0);
+  struct zip_stat sb;
+  if (indexEntry < 0 ||
+      zip_stat_index(this->dataPtr->archive, indexEntry, 0, &sb) != 0)
+  {
+    gzerr << "[" << _path << "] is not a pack, it has no index" << std::endl;
+    return false;
+  }
+
+  std::string data(static_cast<std::size_t>(sb.size), '\0');
+  zip_file_t *file = zip_fopen_index(this->dataPtr->archive, indexEntry, 0);
+  if (!file ||
+      zip_fread(file, &data[0], data.size()) !=
+        static_cast<zip_int64_t>(data.size()))
+  {
+    gzerr << "Unable to read the index of [" << _path << "]" << std::endl;
+    if (file)
+      zip_fclose(file);
+    return false;
+  }
+  zip_fclose(file);
+
+  auto entries = static_cast<std::uint64_t>(
+      zip_get_num_entries(this->dataPtr->archive, 0));
+
+  std::istringstream in(data);
+  std::string line;
+  if (!std::getline(in, line) || line != kIndexHeader)
+  {
+    gzerr << "Unsupported pack format [" << line << "]" << std::endl;
+    return false;
+  }
+
+  while (std::getline(in, line))
+  {
+    if (line.empty())
+      continue;
+
+    std::istringstream fields(line);
+    CachePackResource resource;
+    std::string first;
+    std::string count;
+    if (!std::getline(fields, resource.type, '\t') ||
+        !std::getline(fields, first, '\t') ||
+        !std::getline(fields, count, '\t') ||
+        !std::getline(fields, resource.path))
+    {
+      gzerr << "Invalid pack index line [" << line << "]" << std::endl;
+      return false;
+    }
+
+    try
+    {
+      resource.firstEntry = std::stoull(first);
+      resource.entryCount = std::stoull(count);
+    }
+    catch (...)
+    {
+      gzerr << "Invalid pack index line [" << line << "]" << std::endl;
+      return false;
+    }
+
+    if ((resource.type != "model" && resource.type != "world") ||
+        !ValidPath(resource.path) ||
+        resource.firstEntry + resource.entryCount > entries)
+    {
+      gzerr << "Invalid pack index line [" << line << "]" << std::endl;
+      return false;
+    }
+    this->dataPtr->resources.push_back(resource);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+const std::vector<CachePackResource> &CachePackReader::Resources() const
+{
+  return this->dataPtr->resources;
+}
+
+//////////////////////////////////////////////////
+bool CachePackReader::Extract(const CachePackResource &_resource,
+    const std::string &_dst)
+{
+  if (!this->dataPtr->archive)
+    return false;
+
+  auto &stats = CacheStatisticsRecorder::Instance();
+  std::vector<char> buffer(kExtractBufferSize);
+  const std::string prefix = _resource.path + "/";
+  for (std::uint64_t i = _resource.firstEntry;
+       i < _resource.firstEntry + _resource.entryCount; ++i)
+  {
+    struct zip_stat sb;
+    if (zip_stat_index(this->dataPtr->archive, i, 0, &sb) != 0)
+    {
+      gzerr << "Unable to read pack entry " << i << std::endl;
+      return false;
+    }
+
+    // Entries of a resource all live under its directory
+    std::string name(sb.name);
+    if (name.compare(0, prefix.size(), prefix) != 0 ||
+        !ValidPath(name.substr(prefix.size())))
+    {
+      gzerr << "Pack entry [" << name << "] is outside of ["
+            << _resource.path << "]" << std::endl;
+      return false;
+    }
+
+    std::string rel = name.substr(prefix.size());
+    common::changeFromUnixPath(rel);
+    std::string dst = common::joinPaths(_dst, rel);
+    common::createDirectories(common::parentPath(dst));
+
+    zip_file_t *zf = zip_fopen_index(this->dataPtr->archive, i, 0);
+    if (!zf)
+    {
+      gzerr << "Unable to open pack entry [" << name << "]" << std::endl;
+      return false;
+    }
+
+    std::ofstream out(dst, std::ios::out | std::ios::binary | std::ios::trunc);
+    std::uint64_t written = 0;
+    zip_int64_t n = 0;
+    while ((n = zip_fread(zf, buffer.data(), buffer.size())) > 0)
+    {
+      out.write(buffer.data(), n);
+      written += static_cast<std::uint64_t>(n);
+    }
+    zip_fclose(zf);
+
+    if (n < 0 || !out)
+    {
+      gzerr << "Unable to extract [" << name << "] to [" << dst << "]"
+            << std::endl;
+      return false;
+    }
+    stats.Add(CacheStatisticsRecorder::Counter::FILES_EXTRACTED);
+    stats.Add(CacheStatisticsRecorder::Counter::BYTES_EXTRACTED, written);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool CachePackReader::ValidPath(const std::string &_path)
+{
+  auto parts = splitPath(_path);
+  for (const auto &part : parts)
+  {
+    if (part.empty() || part == "." || part == "..")
+      return false;
+  }
+
+  // Windows drive, e.g. "C:"
+  const auto &first = parts.front();
+  if (first.size() == 2 && first[1] == ':' &&
+      std::isalpha(static_cast<unsigned char>(first[0])))
+  {
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_CACHEPACK_HH_
+#define GZ_FUEL_TOOLS_CACHEPACK_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gz/fuel_tools/Export.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Forward declarations
+  class CachePackReaderPrivate;
+  class CachePackWriterPrivate;
+
+  /// \brief A model or world version stored in a pack file.
+  struct CachePackResource
+  {
+    /// \brief "model" or "world".
+    public: std::string type;
+
+    /// \brief Path of the versioned directory relative to the cache root,
+    /// e.g. "fuel.gazebosim.org/openrobotics/models/box/2", using '/'
+    /// separators.
+    public: std::string path;
+
+    /// \brief Index of the first archive entry of the resource.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t firstEntry = 0;
+
+    /// \brief Number of archive entries of the resource.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t entryCount = 0;
+  };
+
+  /// \brief Write cached resources to a pack file.
+  ///
+  /// A pack is a zip archive holding the versioned directories of several
+  /// resources, laid out as in the cache, followed by an index that maps
+  /// each resource to its range of archive entries. Unzipping a pack in a
+  /// cache directory gives the same result as importing it.
+  class GZ_FUEL_TOOLS_VISIBLE CachePackWriter
+  {
+    /// \brief Constructor.
+    public: CachePackWriter();
+
+    /// \brief Destructor. Discards the pack if Close() wasn't called.
+    public: ~CachePackWriter();
+
+    /// \brief Start a new pack, replacing any existing file.
+    /// \param[in] _path Path of the pack file.
+    /// \return True on success.
+    public: bool Open(const std::string &_path);
+
+    /// \brief Add a resource to the pack. Files are read when the pack is
+    /// closed, so they must not be removed before.
+    /// \param[in] _type "model" or "world".
+    /// \param[in] _path Path of the resource relative to the cache root.
+    /// \param[in] _dir Versioned directory holding the resource files.
+    /// \return True on success.
+    public: bool AddResource(const std::string &_type,
+                             const std::string &_path,
+                             const std::string &_dir);
+
+    /// \brief Write the index and the pack file.
+    /// \return True on success.
+    public: bool Close();
+
+    /// \brief Private data.
+    private: std::unique_ptr<CachePackWriterPrivate> dataPtr;
+  };
+
+  /// \brief Read resources from a pack file. A reader must not be shared
+  /// between threads, open one reader per thread instead.
+  /// \sa CachePackWriter
+  class GZ_FUEL_TOOLS_VISIBLE CachePackReader
+  {
+    /// \brief Constructor.
+    public: CachePackReader();
+
+    /// \brief Destructor.
+    public: ~CachePackReader();
+
+    /// \brief Open a pack file and read its index.
+    /// \param[in] _path Path of the pack file.
+    /// \return True if the file is a valid pack.
+    public: bool Open(const std::string &_path);
+
+    /// \brief Get the resources in the pack.
+    /// \return Resources, in pack order.
+    public: const std::vector<CachePackResource> &Resources() const;
+
+    /// \brief Extract the files of a resource, streaming them through a
+    /// fixed size buffer.
+    /// \param[in] _resource A resource of this pack.
+    /// \param[in] _dst Directory where the files are written.
+    /// \return True on success.
+    public: bool Extract(const CachePackResource &_resource,
+                         const std::string &_dst);
+
+    /// \brief Check that a resource path can be safely joined to a cache
+    /// root: relative, without "." or ".." components.
+    /// \param[in] _path Resource path.
+    /// \return True if the path is safe.
+    public: static bool ValidPath(const std::string &_path);
+
+    /// \brief Private data.
+    private: std::unique_ptr<CachePackReaderPrivate> dataPtr;
+  };
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_CACHEPACK_HH_
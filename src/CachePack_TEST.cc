@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/Zip.hh"
+
+#include "CachePack.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+/// \brief Write a file, creating its parent directories.
+void writeFile(const std::string &_path, const std::string &_content)
+{
+  common::createDirectories(common::parentPath(_path));
+  std::ofstream out(_path, std::ios::binary);
+  out << _content;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file.
+std::string readFile(const std::string &_path)
+{
+  std::ifstream in(_path, std::ios::binary);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+/////////////////////////////////////////////////
+TEST(CachePack, WriteRead)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  std::string modelDir = common::joinPaths(tempDir->Path(), "model");
+  writeFile(common::joinPaths(modelDir, "model.config"), "<model/>");
+  writeFile(common::joinPaths(modelDir, "meshes", "box.dae"),
+      std::string(200000, 'b'));
+  std::string worldDir = common::joinPaths(tempDir->Path(), "world");
+  writeFile(common::joinPaths(worldDir, "empty.sdf"), "<sdf/>");
+
+  std::string pack = common::joinPaths(tempDir->Path(), "test.pack");
+  {
+    CachePackWriter writer;
+    ASSERT_TRUE(writer.Open(pack));
+    EXPECT_TRUE(writer.AddResource("model",
+        "fuel.gazebosim.org/alice/models/box/2", modelDir));
+    EXPECT_TRUE(writer.AddResource("world",
+        "fuel.gazebosim.org/alice/worlds/empty/1", worldDir));
+    EXPECT_FALSE(writer.AddResource("model", "../escape/1", modelDir));
+    EXPECT_TRUE(writer.Close());
+  }
+
+  CachePackReader reader;
+  ASSERT_TRUE(reader.Open(pack));
+  const auto &resources = reader.Resources();
+  ASSERT_EQ(2u, resources.size());
+  EXPECT_EQ("model", resources[0].type);
+  EXPECT_EQ("fuel.gazebosim.org/alice/models/box/2", resources[0].path);
+  EXPECT_EQ(2u, resources[0].entryCount);
+  EXPECT_EQ("world", resources[1].type);
+  EXPECT_EQ(1u, resources[1].entryCount);
+
+  std::string out = common::joinPaths(tempDir->Path(), "out");
+  ASSERT_TRUE(reader.Extract(resources[0], out));
+  EXPECT_EQ("<model/>", readFile(common::joinPaths(out, "model.config")));
+  EXPECT_EQ(std::string(200000, 'b'),
+      readFile(common::joinPaths(out, "meshes", "box.dae")));
+  EXPECT_FALSE(common::exists(common::joinPaths(out, "empty.sdf")));
+}
+
+/////////////////////////////////////////////////
+TEST(CachePack, NotAPack)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  CachePackReader reader;
+  EXPECT_FALSE(reader.Open(common::joinPaths(tempDir->Path(), "missing")));
+
+  // A plain zip archive has no index
+  std::string dir = common::joinPaths(tempDir->Path(), "dir");
+  writeFile(common::joinPaths(dir, "file.txt"), "content");
+  std::string zip = common::joinPaths(tempDir->Path(), "plain.zip");
+  ASSERT_TRUE(Zip::Compress(dir, zip));
+
+  CachePackReader zipReader;
+  EXPECT_FALSE(zipReader.Open(zip));
+}
+
+/////////////////////////////////////////////////
+TEST(CachePack, ValidPath)
+{
+  EXPECT_TRUE(CachePackReader::ValidPath("server/owner/models/name/1"));
+  EXPECT_TRUE(CachePackReader::ValidPath("meshes/mesh.dae"));
+  EXPECT_TRUE(CachePackReader::ValidPath("localhost:8000/a/models/b/1"));
+  EXPECT_FALSE(CachePackReader::ValidPath(""));
+  EXPECT_FALSE(CachePackReader::ValidPath("/etc/passwd"));
+  EXPECT_FALSE(CachePackReader::ValidPath("a/../../b"));
+  EXPECT_FALSE(CachePackReader::ValidPath("a/./b"));
+  EXPECT_FALSE(CachePackReader::ValidPath("a//b"));
+  EXPECT_FALSE(CachePackReader::ValidPath("a\\..\\b"));
+  EXPECT_FALSE(CachePackReader::ValidPath("C:\\Windows"));
+}
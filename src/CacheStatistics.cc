@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "gz/fuel_tools/CacheStatistics.hh"
+
+#include "CacheStatisticsRecorder.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /// \brief Number of shards. A power of two larger than the usual number
+  /// of download and extraction threads.
+  constexpr std::size_t kShards = 16;
+
+  /// \brief Number of counters.
+  constexpr std::size_t kCounters =
+    static_cast<std::size_t>(CacheStatisticsRecorder::Counter::COUNT);
+
+  /// \brief Number of timers.
+  constexpr std::size_t kTimers =
+    static_cast<std::size_t>(CacheStatisticsRecorder::Timer::COUNT);
+
+  /// \brief Histogram made of atomics.
+  struct AtomicHistogram
+  {
+    /// \brief Samples per bucket.
+    std::array<std::atomic<std::uint64_t>, DurationHistogram::kBuckets>
+      buckets{};
+
+    /// \brief Number of samples.
+    std::atomic<std::uint64_t> count{0};
+
+    /// \brief Sum of the samples in microseconds.
+    std::atomic<std::uint64_t> total{0};
+  };
+
+  /// \brief Counters updated by a subset of the threads. Aligned so that
+  /// two shards never share a cache line.
+  struct alignas(64) Shard
+  {
+    /// \brief Counters.
+    std::array<std::atomic<std::uint64_t>, kCounters> counters{};
+
+    /// \brief Timers.
+    std::array<AtomicHistogram, kTimers> timers{};
+  };
+
+  /// \brief Shard used by the calling thread. Threads are given shards in
+  /// turn, so the first kShards threads each have their own.
+  /// \return Shard index.
+  std::size_t shardIndex()
+  {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t index =
+      next.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return index;
+  }
+
+  /// \brief Format a duration for display.
+  /// \param[in] _duration Duration.
+  /// \return Duration in milliseconds.
+  std::string formatMs(std::chrono::microseconds _duration)
+  {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3)
+        << static_cast<double>(_duration.count()) / 1000.0 << " ms";
+    return out.str();
+  }
+
+  /// \brief Print a histogram summary.
+  /// \param[in] _out Output stream.
+  /// \param[in] _prefix Line prefix.
+  /// \param[in] _name Histogram name.
+  /// \param[in] _hist Histogram.
+  void printHistogram(std::ostream &_out, const std::string &_prefix,
+      const std::string &_name, const DurationHistogram &_hist)
+  {
+    _out << _prefix << _name << ": " << _hist.count << " samples";
+    if (_hist.count > 0)
+    {
+      _out << ", total " << formatMs(_hist.total)
+           << ", mean " << formatMs(_hist.Mean())
+           << ", p50 <= " << formatMs(_hist.Percentile(50))
+           << ", p99 <= " << formatMs(_hist.Percentile(99));
+    }
+    _out << std::endl;
+  }
+}
+
+/// \brief Private data for CacheStatisticsRecorder.
+class gz::fuel_tools::CacheStatisticsRecorderPrivate
+{
+  /// \brief Shards.
+  public: std::array<Shard, kShards> shards;
+};
+
+//////////////////////////////////////////////////
+std::size_t DurationHistogram::Bucket(std::chrono::microseconds _duration)
+{
+  if (_duration.count() <= 0)
+    return 0u;
+
+  // Position of the highest set bit, plus one.
+  auto value = static_cast<std::uint64_t>(_duration.count());
+  std::size_t bucket = 0;
+  while (value > 0)
+  {
+    value >>= 1;
+    ++bucket;
+  }
+  return std::min(bucket, kBuckets - 1);
+}
+
+//////////////////////////////////////////////////
+std::chrono::microseconds DurationHistogram::UpperBound(std::size_t _bucket)
+{
+  _bucket = std::min(_bucket, kBuckets - 1);
+  return std::chrono::microseconds(
+      static_cast<std::chrono::microseconds::rep>(1) << _bucket);
+}
+
+//////////////////////////////////////////////////
+std::chrono::microseconds DurationHistogram::Mean() const
+{
+  if (this->count == 0)
+    return std::chrono::microseconds(0);
+  return std::chrono::microseconds(
+      this->total.count() /
+      static_cast<std::chrono::microseconds::rep>(this->count));
+}
+
+//////////////////////////////////////////////////
+std::chrono::microseconds DurationHistogram::Percentile(
+    double _percentile) const
+{
+  std::uint64_t samples = 0;
+  for (auto b : this->buckets)
+    samples += b;
+  if (samples == 0)
+    return std::chrono::microseconds(0);
+
+  _percentile = std::clamp(_percentile, 0.0, 100.0);
+  auto rank = static_cast<std::uint64_t>(
+      std::ceil(_percentile / 100.0 * static_cast<double>(samples)));
+  rank = std::max<std::uint64_t>(rank, 1u);
+
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < kBuckets; ++i)
+  {
+    seen += this->buckets[i];
+    if (seen >= rank)
+      return UpperBound(i);
+  }
+  return UpperBound(kBuckets - 1);
+}
+
+//////////////////////////////////////////////////
+double CacheStatistics::HitRate() const
+{
+  if (this->lookups == 0)
+    return 0.0;
+  return static_cast<double>(this->hits) /
+    static_cast<double>(this->lookups);
+}
+
+//////////////////////////////////////////////////
+std::string CacheStatistics::AsString(const std::string &_prefix) const
+{
+  std::ostringstream out;
+  out << _prefix << "Lookups: " << this->lookups << std::endl
+      << _prefix << "Hits: " << this->hits << std::endl
+      << _prefix << "Misses: " << this->misses << std::endl
+      << _prefix << "Hit rate: " << std::fixed << std::setprecision(1)
+      << this->HitRate() * 100.0 << "%" << std::endl
+      << _prefix << "Downloads: " << this->downloads << std::endl
+      << _prefix << "Failed downloads: " << this->downloadFailures
+      << std::endl
+      << _prefix << "Bytes downloaded: " << this->bytesDownloaded << std::endl
+      << _prefix << "Files extracted: " << this->filesExtracted << std::endl
+      << _prefix << "Bytes extracted: " << this->bytesExtracted << std::endl
+      << _prefix << "Files skipped: " << this->filesSkipped << std::endl
+      << _prefix << "Bytes skipped: " << this->bytesSkipped << std::endl
+      << _prefix << "Memory hits: " << this->memoryHits << std::endl
+      << _prefix << "Memory misses: " << this->memoryMisses << std::endl
+      << _prefix << "Memory evictions: " << this->memoryEvictions
+      << std::endl;
+  printHistogram(out, _prefix, "Download time", this->downloadTime);
+  printHistogram(out, _prefix, "Extraction time", this->extractTime);
+  printHistogram(out, _prefix, "Path fixing time", this->fixPathsTime);
+  return out.str();
+}
+
+//////////////////////////////////////////////////
+CacheStatisticsRecorder::CacheStatisticsRecorder()
+  : dataPtr(new CacheStatisticsRecorderPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+CacheStatisticsRecorder::~CacheStatisticsRecorder() = default;
+
+//////////////////////////////////////////////////
+CacheStatisticsRecorder &CacheStatisticsRecorder::Instance()
+{
+  static CacheStatisticsRecorder recorder;
+  return recorder;
+}
+
+//////////////////////////////////////////////////
+void CacheStatisticsRecorder::Add(Counter _counter, std::uint64_t _value)
+{
+  auto &shard = this->dataPtr->shards[shardIndex()];
+  shard.counters[static_cast<std::size_t>(_counter)].fetch_add(
+      _value, std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+void CacheStatisticsRecorder::Record(Timer _timer,
+    std::chrono::microseconds _duration)
+{
+  auto &hist =
+    this->dataPtr->shards[shardIndex()].timers[static_cast<std::size_t>(
+        _timer)];
+  hist.buckets[DurationHistogram::Bucket(_duration)].fetch_add(
+      1u, std::memory_order_relaxed);
+  hist.count.fetch_add(1u, std::memory_order_relaxed);
+  hist.total.fetch_add(
+      static_cast<std::uint64_t>(std::max<std::chrono::microseconds::rep>(
+          _duration.count(), 0)), std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+CacheStatistics CacheStatisticsRecorder::Snapshot() const
+{
+  std::array<std::uint64_t, kCounters> counters{};
+  std::array<DurationHistogram, kTimers> timers{};
+
+  for (const auto &shard : this->dataPtr->shards)
+  {
+    for (std::size_t c = 0; c < kCounters; ++c)
+      counters[c] += shard.counters[c].load(std::memory_order_relaxed);
+
+    for (std::size_t t = 0; t < kTimers; ++t)
+    {
+      const auto &src = shard.timers[t];
+      auto &dst = timers[t];
+      for (std::size_t b = 0; b < DurationHistogram::kBuckets; ++b)
+        dst.buckets[b] += src.buckets[b].load(std::memory_order_relaxed);
+      dst.count += src.count.load(std::memory_order_relaxed);
+      dst.total += std::chrono::microseconds(
+          static_cast<std::chrono::microseconds::rep>(
+            src.total.load(std::memory_order_relaxed)));
+    }
+  }
+
+  auto counter = [&counters](Counter _c)
+  {
+    return counters[static_cast<std::size_t>(_c)];
+  };
+  auto timer = [&timers](Timer _t)
+  {
+    return timers[static_cast<std::size_t>(_t)];
+  };
+
+  CacheStatistics stats;
+  stats.lookups = counter(Counter::LOOKUPS);
+  stats.hits = counter(Counter::HITS);
+  stats.misses = counter(Counter::MISSES);
+  stats.downloads = counter(Counter::DOWNLOADS);
+  stats.downloadFailures = counter(Counter::DOWNLOAD_FAILURES);
+  stats.bytesDownloaded = counter(Counter::BYTES_DOWNLOADED);
+  stats.filesExtracted = counter(Counter::FILES_EXTRACTED);
+  stats.bytesExtracted = counter(Counter::BYTES_EXTRACTED);
+  stats.filesSkipped = counter(Counter::FILES_SKIPPED);
+  stats.bytesSkipped = counter(Counter::BYTES_SKIPPED);
+  stats.memoryHits = counter(Counter::MEMORY_HITS);
+  stats.memoryMisses = counter(Counter::MEMORY_MISSES);
+  stats.memoryEvictions = counter(Counter::MEMORY_EVICTIONS);
+  stats.downloadTime = timer(Timer::DOWNLOAD);
+  stats.extractTime = timer(Timer::EXTRACT);
+  stats.fixPathsTime = timer(Timer::FIX_PATHS);
+  return stats;
+}
+
+//////////////////////////////////////////////////
+void CacheStatisticsRecorder::Reset()
+{
+  for (auto &shard : this->dataPtr->shards)
+  {
+    for (auto &c : shard.counters)
+      c.store(0u, std::memory_order_relaxed);
+    for (auto &hist : shard.timers)
+    {
+      for (auto &b : hist.buckets)
+        b.store(0u, std::memory_order_relaxed);
+      hist.count.store(0u, std::memory_order_relaxed);
+      hist.total.store(0u, std::memory_order_relaxed);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+ScopedCacheTimer::ScopedCacheTimer(CacheStatisticsRecorder::Timer _timer)
+  : timer(_timer), start(std::chrono::steady_clock::now())
+{
+}
+
+//////////////////////////////////////////////////
+ScopedCacheTimer::~ScopedCacheTimer()
+{
+  CacheStatisticsRecorder::Instance().Record(this->timer,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - this->start));
+}
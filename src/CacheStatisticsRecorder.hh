@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_CACHESTATISTICSRECORDER_HH_
+#define GZ_FUEL_TOOLS_CACHESTATISTICSRECORDER_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "gz/fuel_tools/CacheStatistics.hh"
+#include "gz/fuel_tools/Export.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Forward declaration
+  class CacheStatisticsRecorderPrivate;
+
+  /// \brief Lock-free recorder of cache statistics.
+  ///
+  /// Counters are split in cache line aligned shards, and every thread
+  /// updates its own shard with relaxed atomics, so that parallel
+  /// downloads and extractions do not contend on a single line. Threads
+  /// are given shards in turn, they only share one once there are more
+  /// threads than shards. Shards are only summed when a snapshot is taken.
+  class GZ_FUEL_TOOLS_VISIBLE CacheStatisticsRecorder
+  {
+    /// \brief Counters.
+    public: enum class Counter
+    {
+      /// \brief Cache lookups.
+      LOOKUPS,
+
+      /// \brief Lookups found in the cache.
+      HITS,
+
+      /// \brief Lookups not found in the cache.
+      MISSES,
+
+      /// \brief Successful downloads.
+      DOWNLOADS,
+
+      /// \brief Failed downloads.
+      DOWNLOAD_FAILURES,
+
+      /// \brief Bytes downloaded.
+      BYTES_DOWNLOADED,
+
+      /// \brief Files extracted.
+      FILES_EXTRACTED,
+
+      /// \brief Bytes extracted.
+      BYTES_EXTRACTED,
+
+      /// \brief Files left out by an extraction filter.
+      FILES_SKIPPED,
+
+      /// \brief Uncompressed bytes left out by an extraction filter.
+      BYTES_SKIPPED,
+
+      /// \brief Reads served by the in-memory tier.
+      MEMORY_HITS,
+
+      /// \brief Reads that loaded the file from disk.
+      MEMORY_MISSES,
+
+      /// \brief Files evicted from the in-memory tier.
+      MEMORY_EVICTIONS,
+
+      /// \brief Number of counters.
+      COUNT
+    };
+
+    /// \brief Timers.
+    public: enum class Timer
+    {
+      /// \brief Download time.
+      DOWNLOAD,
+
+      /// \brief Extraction time.
+      EXTRACT,
+
+      /// \brief Path fixing time.
+      FIX_PATHS,
+
+      /// \brief Number of timers.
+      COUNT
+    };
+
+    /// \brief Constructor.
+    public: CacheStatisticsRecorder();
+
+    /// \brief Destructor.
+    public: ~CacheStatisticsRecorder();
+
+    /// \brief Get the process-wide recorder.
+    /// \return The recorder.
+    public: static CacheStatisticsRecorder &Instance();
+
+    /// \brief Increment a counter.
+    /// \param[in] _counter Counter to increment.
+    /// \param[in] _value Increment.
+    public: void Add(Counter _counter, std::uint64_t _value = 1u);
+
+    /// \brief Record a duration.
+    /// \param[in] _timer Timer to update.
+    /// \param[in] _duration Duration to record.
+    public: void Record(Timer _timer, std::chrono::microseconds _duration);
+
+    /// \brief Sum the shards.
+    /// \return Current statistics.
+    public: CacheStatistics Snapshot() const;
+
+    /// \brief Reset all the counters and timers. Updates made concurrently
+    /// with the reset may be lost.
+    public: void Reset();
+
+    /// \brief Private data.
+    private: std::unique_ptr<CacheStatisticsRecorderPrivate> dataPtr;
+  };
+
+  /// \brief Record the lifetime of the object in a timer of the
+  /// process-wide recorder.
+  class GZ_FUEL_TOOLS_VISIBLE ScopedCacheTimer
+  {
+    /// \brief Constructor, starts the timer.
+    /// \param[in] _timer Timer to update.
+    public: explicit ScopedCacheTimer(CacheStatisticsRecorder::Timer _timer);
+
+    /// \brief Destructor, records the elapsed time.
+    public: ~ScopedCacheTimer();
+
+    /// \brief Timer to update.
+    private: CacheStatisticsRecorder::Timer timer;
+
+    /// \brief Start time.
+    private: std::chrono::steady_clock::time_point start;
+  };
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_CACHESTATISTICSRECORDER_HH_
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gz/fuel_tools/CacheStatistics.hh"
+
+#include "CacheStatisticsRecorder.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+using std::chrono::microseconds;
+
+/////////////////////////////////////////////////
+TEST(CacheStatistics, HistogramBuckets)
+{
+  EXPECT_EQ(0u, DurationHistogram::Bucket(microseconds(0)));
+  EXPECT_EQ(1u, DurationHistogram::Bucket(microseconds(1)));
+  EXPECT_EQ(2u, DurationHistogram::Bucket(microseconds(2)));
+  EXPECT_EQ(2u, DurationHistogram::Bucket(microseconds(3)));
+  EXPECT_EQ(11u, DurationHistogram::Bucket(microseconds(1024)));
+  EXPECT_EQ(DurationHistogram::kBuckets - 1,
+      DurationHistogram::Bucket(microseconds(1ll << 40)));
+
+  EXPECT_EQ(microseconds(1), DurationHistogram::UpperBound(0));
+  EXPECT_EQ(microseconds(2048), DurationHistogram::UpperBound(11));
+}
+
+/////////////////////////////////////////////////
+TEST(CacheStatistics, Percentile)
+{
+  DurationHistogram hist;
+  EXPECT_EQ(microseconds(0), hist.Mean());
+  EXPECT_EQ(microseconds(0), hist.Percentile(50));
+
+  CacheStatisticsRecorder recorder;
+  for (int i = 0; i < 90; ++i)
+    recorder.Record(CacheStatisticsRecorder::Timer::EXTRACT, microseconds(3));
+  for (int i = 0; i < 10; ++i)
+  {
+    recorder.Record(CacheStatisticsRecorder::Timer::EXTRACT,
+        microseconds(1000));
+  }
+
+  hist = recorder.Snapshot().extractTime;
+  EXPECT_EQ(100u, hist.count);
+  EXPECT_EQ(microseconds(90 * 3 + 10 * 1000), hist.total);
+  EXPECT_EQ(microseconds(102), hist.Mean());
+  EXPECT_EQ(microseconds(4), hist.Percentile(50));
+  EXPECT_EQ(microseconds(4), hist.Percentile(90));
+  EXPECT_EQ(microseconds(1024), hist.Percentile(99));
+  EXPECT_EQ(microseconds(1024), hist.Percentile(100));
+}
+
+/////////////////////////////////////////////////
+TEST(CacheStatistics, ConcurrentUpdates)
+{
+  CacheStatisticsRecorder recorder;
+  const int kThreads = 8;
+  const int kIterations = 10000;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t)
+  {
+    threads.emplace_back([&recorder]()
+    {
+      for (int i = 0; i < kIterations; ++i)
+      {
+        recorder.Add(CacheStatisticsRecorder::Counter::LOOKUPS);
+        recorder.Add(CacheStatisticsRecorder::Counter::HITS);
+        recorder.Add(CacheStatisticsRecorder::Counter::BYTES_EXTRACTED, 10);
+        recorder.Record(CacheStatisticsRecorder::Timer::DOWNLOAD,
+            microseconds(5));
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  auto stats = recorder.Snapshot();
+  EXPECT_EQ(static_cast<uint64_t>(kThreads * kIterations), stats.lookups);
+  EXPECT_EQ(static_cast<uint64_t>(kThreads * kIterations), stats.hits);
+  EXPECT_EQ(0u, stats.misses);
+  EXPECT_EQ(static_cast<uint64_t>(kThreads * kIterations * 10),
+      stats.bytesExtracted);
+  EXPECT_EQ(static_cast<uint64_t>(kThreads * kIterations),
+      stats.downloadTime.count);
+  EXPECT_DOUBLE_EQ(1.0, stats.HitRate());
+}
+
+/////////////////////////////////////////////////
+TEST(CacheStatistics, Reset)
+{
+  CacheStatisticsRecorder recorder;
+  recorder.Add(CacheStatisticsRecorder::Counter::LOOKUPS, 4);
+  recorder.Add(CacheStatisticsRecorder::Counter::HITS, 1);
+  recorder.Add(CacheStatisticsRecorder::Counter::MISSES, 3);
+  recorder.Record(CacheStatisticsRecorder::Timer::FIX_PATHS,
+      microseconds(20));
+
+  auto stats = recorder.Snapshot();
+  EXPECT_DOUBLE_EQ(0.25, stats.HitRate());
+  EXPECT_EQ(1u, stats.fixPathsTime.count);
+  EXPECT_NE(std::string::npos, stats.AsString().find("Hit rate: 25.0%"));
+
+  recorder.Reset();
+  stats = recorder.Snapshot();
+  EXPECT_EQ(0u, stats.lookups);
+  EXPECT_EQ(0u, stats.fixPathsTime.count);
+  EXPECT_DOUBLE_EQ(0.0, stats.HitRate());
+}
@@ -23,6 +23,8 @@
 #include <vector>
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
+#include <gz/common/StringUtils.hh>
+#include <gz/common/SystemPaths.hh>
 #include <gz/common/Util.hh>
 
 #include "gz/fuel_tools/ClientConfig.hh"
@@ -50,7 +52,16 @@ class ClientConfigPrivate
           {
             this->servers.clear();
             this->cacheLocation = "";
+            this->cacheLayers.clear();
             this->configPath = "";
+            this->cacheDeduplication = false;
+            this->cacheArchiveMode = false;
+            this->streamingExtract = false;
+            this->extractFilter = ExtractFilter();
+            this->extractSyncBatch = 0u;
+            this->extractJobs = 1u;
+            this->lazyUriRewrite = false;
+            this->memoryCacheSize = 0u;
             this->userAgent =
               "GazeboFuelTools-" GZ_FUEL_TOOLS_VERSION_FULL;
           }
@@ -61,9 +72,36 @@ class ClientConfigPrivate
   /// \brief a path on disk to where data is cached.
   public: std::string cacheLocation = "";
 
+  /// \brief Read-only cache directories, searched after cacheLocation.
+  public: std::vector<std::string> cacheLayers;
+
   /// \brief The path where the configuration file is located.
   public: std::string configPath = "";
 
+  /// \brief Whether identical cached files are stored once.
+  public: bool cacheDeduplication = false;
+
+  /// \brief Whether downloaded archives are kept and extracted on demand.
+  public: bool cacheArchiveMode = false;
+
+  /// \brief Whether downloads are extracted while they're received.
+  public: bool streamingExtract = false;
+
+  /// \brief Which files of downloads are extracted.
+  public: ExtractFilter extractFilter;
+
+  /// \brief Number of extracted files flushed to disk together.
+  public: unsigned int extractSyncBatch = 0u;
+
+  /// \brief Number of threads extracting each download.
+  public: unsigned int extractJobs = 1u;
+
+  /// \brief Whether URIs are recorded instead of being rewritten.
+  public: bool lazyUriRewrite = false;
+
+  /// \brief Maximum number of bytes kept in the in-memory file tier.
+  public: std::size_t memoryCacheSize = 0u;
+
   /// \brief Name of the user agent.
   public: std::string userAgent =
           "GazeboFuelTools-" GZ_FUEL_TOOLS_VERSION_FULL;
@@ -72,6 +110,97 @@ class ClientConfigPrivate
 //////////////////////////////////////////////////
 ClientConfig::ClientConfig() : dataPtr(new ClientConfigPrivate)
 {
+  std::string gzFuelDedup = "";
+  if (gz::common::env("GZ_FUEL_CACHE_DEDUP", gzFuelDedup))
+  {
+    gzFuelDedup = common::lowercase(gzFuelDedup);
+    this->SetCacheDeduplication(gzFuelDedup == "1" || gzFuelDedup == "true");
+  }
+
+  std::string gzFuelArchive = "";
+  if (gz::common::env("GZ_FUEL_CACHE_ARCHIVE", gzFuelArchive))
+  {
+    gzFuelArchive = common::lowercase(gzFuelArchive);
+    this->SetCacheArchiveMode(gzFuelArchive == "1" || gzFuelArchive == "true");
+  }
+
+  std::string gzFuelStreaming = "";
+  if (gz::common::env("GZ_FUEL_STREAMING_EXTRACT", gzFuelStreaming))
+  {
+    gzFuelStreaming = common::lowercase(gzFuelStreaming);
+    this->SetStreamingExtract(
+        gzFuelStreaming == "1" || gzFuelStreaming == "true");
+  }
+
+  // Comma separated glob patterns
+  auto patterns = [](const std::string &_value)
+  {
+    std::vector<std::string> result;
+    for (auto pattern : common::Split(_value, ','))
+    {
+      pattern = common::trimmed(pattern);
+      if (!pattern.empty())
+        result.push_back(pattern);
+    }
+    return result;
+  };
+  ExtractFilter filter;
+  std::string gzFuelExtract = "";
+  if (gz::common::env("GZ_FUEL_EXTRACT_INCLUDE", gzFuelExtract))
+    filter.include = patterns(gzFuelExtract);
+  if (gz::common::env("GZ_FUEL_EXTRACT_EXCLUDE", gzFuelExtract))
+    filter.exclude = patterns(gzFuelExtract);
+  this->SetExtractionFilter(filter);
+
+  std::string gzFuelSync = "";
+  if (gz::common::env("GZ_FUEL_EXTRACT_SYNC_BATCH", gzFuelSync) &&
+      !gzFuelSync.empty())
+  {
+    try
+    {
+      this->SetExtractSyncBatch(
+          static_cast<unsigned int>(std::stoul(gzFuelSync)));
+    }
+    catch (...)
+    {
+      gzerr << "Invalid GZ_FUEL_EXTRACT_SYNC_BATCH [" << gzFuelSync
+            << "], it must be a number of files" << std::endl;
+    }
+  }
+
+  std::string gzFuelLazy = "";
+  if (gz::common::env("GZ_FUEL_LAZY_URI_REWRITE", gzFuelLazy))
+  {
+    gzFuelLazy = common::lowercase(gzFuelLazy);
+    this->SetLazyUriRewrite(gzFuelLazy == "1" || gzFuelLazy == "true");
+  }
+
+  std::string gzFuelMemory = "";
+  if (gz::common::env("GZ_FUEL_MEMORY_CACHE_SIZE", gzFuelMemory) &&
+      !gzFuelMemory.empty())
+  {
+    try
+    {
+      this->SetMemoryCacheSize(std::stoull(gzFuelMemory));
+    }
+    catch (...)
+    {
+      gzerr << "Invalid GZ_FUEL_MEMORY_CACHE_SIZE [" << gzFuelMemory
+            << "], it must be a number of bytes" << std::endl;
+    }
+  }
+
+  std::string gzFuelLayers = "";
+  if (gz::common::env("GZ_FUEL_CACHE_LAYERS", gzFuelLayers))
+  {
+    for (const auto &layer : common::Split(gzFuelLayers,
+        common::SystemPaths::Delimiter()))
+    {
+      if (!layer.empty())
+        this->AddCacheLayer(layer);
+    }
+  }
+
   std::string gzFuelPath = "";
   if (!gz::common::env("GZ_FUEL_CACHE_PATH", gzFuelPath))
   {
@@ -268,6 +397,15 @@ bool ClientConfig::LoadConfig(const std::string &_file)
           cacheLocationConfig = path;
           tokens.pop();
         }
+        else if (!tokens.empty() && tokens.top() == "layers")
+        {
+          // Items of the list of cache layers. The key is popped at the end
+          // of the sequence.
+          std::string layer(
+            reinterpret_cast<const char *>(event.data.scalar.value));
+          if (!layer.empty())
+            this->AddCacheLayer(layer);
+        }
         else if (!tokens.empty() && tokens.top() == "private-token")
         {
           std::string token(
@@ -358,6 +496,114 @@ void ClientConfig::SetCacheLocation(const std::string &_path)
   this->dataPtr->cacheLocation = _path;
 }
 
+//////////////////////////////////////////////////
+void ClientConfig::AddCacheLayer(const std::string &_path)
+{
+  this->dataPtr->cacheLayers.push_back(_path);
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> ClientConfig::CacheLayers() const
+{
+  return this->dataPtr->cacheLayers;
+}
+
+//////////////////////////////////////////////////
+void ClientConfig::SetCacheDeduplication(bool _enable)
+{
+  this->dataPtr->cacheDeduplication = _enable;
+}
+
+//////////////////////////////////////////////////
+bool ClientConfig::CacheDeduplication() const
+{
+  return this->dataPtr->cacheDeduplication;
+}
+
+//////////////////////////////////////////////////
+void ClientConfig::SetCacheArchiveMode(bool _enable)
+{
+  this->dataPtr->cacheArchiveMode = _enable;
+}
+
+//////////////////////////////////////////////////
+bool ClientConfig::CacheArchiveMode() const
+{
+  return this->dataPtr->cacheArchiveMode;
+}
+
+//////////////////////////////////////////////////
+void ClientConfig::SetStreamingExtract(bool _enable)
+{
+  this->dataPtr->streamingExtract = _enable;
+}
+
+//////////////////////////////////////////////////
+bool ClientConfig::StreamingExtract() const
+{
+  return this->dataPtr->streamingExtract;
+}
+
+//////////////////////////////////////////////////
+void ClientConfig::SetExtractionFilter(const ExtractFilter &_filter)
+{
+  this->dataPtr->extractFilter = _filter;
+}
+
+//////////////////////////////////////////////////
+const ExtractFilter &ClientConfig::ExtractionFilter() const
+{
+  return this->dataPtr->extractFilter;
+}
+
+//////////////////////////////////////////////////
+void ClientConfig::SetExtractSyncBatch(unsigned int _files)
+{
+  this->dataPtr->extractSyncBatch = _files;
+}
+
+//////////////////////////////////////////////////
+unsigned int ClientConfig::ExtractSyncBatch() const
+{
+  return this->dataPtr->extractSyncBatch;
+}
+
+//////////////////////////////////////////////////
+void ClientConfig::SetExtractJobs(unsigned int _jobs)
+{
+  this->dataPtr->extractJobs = _jobs;
+}
+
+//////////////////////////////////////////////////
+unsigned int ClientConfig::ExtractJobs() const
+{
+  return this->dataPtr->extractJobs;
+}
+
+//////////////////////////////////////////////////
+void ClientConfig::SetLazyUriRewrite(bool _enable)
+{
+  this->dataPtr->lazyUriRewrite = _enable;
+}
+
+//////////////////////////////////////////////////
+bool ClientConfig::LazyUriRewrite() const
+{
+  return this->dataPtr->lazyUriRewrite;
+}
+
+//////////////////////////////////////////////////
+void ClientConfig::SetMemoryCacheSize(std::size_t _bytes)
+{
+  this->dataPtr->memoryCacheSize = _bytes;
+}
+
+//////////////////////////////////////////////////
+std::size_t ClientConfig::MemoryCacheSize() const
+{
+  return this->dataPtr->memoryCacheSize;
+}
+
 //////////////////////////////////////////////////
 void ClientConfig::SetUserAgent(const std::string &_agent)
 {
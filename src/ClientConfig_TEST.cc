@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <fstream>
 #include <string>
+#include <vector>
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include <gz/common/TempDirectory.hh>
@@ -136,6 +137,44 @@ TEST_F(ClientConfigTest, CustomConfiguration)
   EXPECT_EQ(cachePath(), config.CacheLocation());
 }
 
+/////////////////////////////////////////////////
+/// \brief Read-only cache layers can be listed in a configuration file.
+TEST_F(ClientConfigTest, CacheLayersConfiguration)
+{
+  ClientConfig config;
+  config.Clear();
+  EXPECT_TRUE(config.CacheLayers().empty());
+
+  // Create a temporary file with the configuration.
+  std::ofstream ofs;
+  std::string testPath = "test_conf.yaml";
+  ofs.open(testPath, std::ofstream::out | std::ofstream::app);
+
+  ofs << "---"                                    << std::endl
+      << "cache:"                                 << std::endl
+      << "  path: " + cachePath()                 << std::endl
+      << "  layers:"                              << std::endl
+      << "    - /shared/fuel"                     << std::endl
+      << "    - /other/fuel"                      << std::endl
+      << std::endl;
+  ofs.close();
+
+  EXPECT_TRUE(config.LoadConfig(testPath));
+  EXPECT_EQ(cachePath(), config.CacheLocation());
+
+  auto layers = config.CacheLayers();
+  ASSERT_EQ(2u, layers.size());
+  EXPECT_EQ("/shared/fuel", layers[0]);
+  EXPECT_EQ("/other/fuel", layers[1]);
+
+  config.AddCacheLayer("/third/fuel");
+  ASSERT_EQ(3u, config.CacheLayers().size());
+  EXPECT_EQ("/third/fuel", config.CacheLayers().back());
+
+  config.Clear();
+  EXPECT_TRUE(config.CacheLayers().empty());
+}
+
 /////////////////////////////////////////////////
 /// \brief A server contains an already used URL.
 TEST_F(ClientConfigTest, RepeatedServerConfiguration)
@@ -259,6 +298,111 @@ TEST_F(ClientConfigTest, UserAgent)
   EXPECT_EQ("my_user_agent", config.UserAgent());
 }
 
+/////////////////////////////////////////////////
+TEST_F(ClientConfigTest, MemoryCacheSize)
+{
+  {
+    ClientConfig config;
+    EXPECT_EQ(0u, config.MemoryCacheSize());
+    config.SetMemoryCacheSize(1024u);
+    EXPECT_EQ(1024u, config.MemoryCacheSize());
+  }
+
+  ASSERT_TRUE(gz::common::setenv("GZ_FUEL_MEMORY_CACHE_SIZE", "4096"));
+  {
+    ClientConfig config;
+    EXPECT_EQ(4096u, config.MemoryCacheSize());
+  }
+
+  ASSERT_TRUE(gz::common::setenv("GZ_FUEL_MEMORY_CACHE_SIZE", "banana"));
+  {
+    ClientConfig config;
+    EXPECT_EQ(0u, config.MemoryCacheSize());
+  }
+  EXPECT_TRUE(gz::common::unsetenv("GZ_FUEL_MEMORY_CACHE_SIZE"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ClientConfigTest, ExtractionFilter)
+{
+  {
+    ClientConfig config;
+    EXPECT_TRUE(config.ExtractionFilter().Empty());
+    ExtractFilter filter;
+    filter.exclude = {"thumbnails"};
+    config.SetExtractionFilter(filter);
+    EXPECT_EQ(filter.exclude, config.ExtractionFilter().exclude);
+  }
+
+  ASSERT_TRUE(gz::common::setenv("GZ_FUEL_EXTRACT_EXCLUDE",
+      "thumbnails, *.blend,,"));
+  ASSERT_TRUE(gz::common::setenv("GZ_FUEL_EXTRACT_INCLUDE", "meshes"));
+  {
+    ClientConfig config;
+    EXPECT_EQ(std::vector<std::string>({"thumbnails", "*.blend"}),
+        config.ExtractionFilter().exclude);
+    EXPECT_EQ(std::vector<std::string>({"meshes"}),
+        config.ExtractionFilter().include);
+  }
+  EXPECT_TRUE(gz::common::unsetenv("GZ_FUEL_EXTRACT_EXCLUDE"));
+  EXPECT_TRUE(gz::common::unsetenv("GZ_FUEL_EXTRACT_INCLUDE"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ClientConfigTest, ExtractSyncBatch)
+{
+  {
+    ClientConfig config;
+    EXPECT_EQ(0u, config.ExtractSyncBatch());
+    config.SetExtractSyncBatch(64u);
+    EXPECT_EQ(64u, config.ExtractSyncBatch());
+  }
+
+  ASSERT_TRUE(gz::common::setenv("GZ_FUEL_EXTRACT_SYNC_BATCH", "32"));
+  {
+    ClientConfig config;
+    EXPECT_EQ(32u, config.ExtractSyncBatch());
+  }
+
+  ASSERT_TRUE(gz::common::setenv("GZ_FUEL_EXTRACT_SYNC_BATCH", "banana"));
+  {
+    ClientConfig config;
+    EXPECT_EQ(0u, config.ExtractSyncBatch());
+  }
+  EXPECT_TRUE(gz::common::unsetenv("GZ_FUEL_EXTRACT_SYNC_BATCH"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ClientConfigTest, ExtractJobs)
+{
+  ClientConfig config;
+  EXPECT_EQ(1u, config.ExtractJobs());
+  config.SetExtractJobs(4u);
+  EXPECT_EQ(4u, config.ExtractJobs());
+  config.SetExtractJobs(0u);
+  EXPECT_EQ(0u, config.ExtractJobs());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ClientConfigTest, LazyUriRewrite)
+{
+  {
+    ClientConfig config;
+    EXPECT_FALSE(config.LazyUriRewrite());
+    config.SetLazyUriRewrite(true);
+    EXPECT_TRUE(config.LazyUriRewrite());
+    config.Clear();
+    EXPECT_FALSE(config.LazyUriRewrite());
+  }
+
+  ASSERT_TRUE(gz::common::setenv("GZ_FUEL_LAZY_URI_REWRITE", "True"));
+  {
+    ClientConfig config;
+    EXPECT_TRUE(config.LazyUriRewrite());
+  }
+  EXPECT_TRUE(gz::common::unsetenv("GZ_FUEL_LAZY_URI_REWRITE"));
+}
+
 /////////////////////////////////////////////////
 TEST_F(ClientConfigTest, AsString)
 {
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstddef>
+#include <string>
+
+#include "gz/fuel_tools/ExtractFilter.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /////////////////////////////////////////////////
+  /// \brief Match the rest of a glob pattern against the rest of a path.
+  /// \param[in] _pattern Glob pattern.
+  /// \param[in] _p Position in the pattern.
+  /// \param[in] _path Path.
+  /// \param[in] _s Position in the path.
+  /// \return True if they match.
+  bool glob(const std::string &_pattern, std::size_t _p,
+      const std::string &_path, std::size_t _s)
+  {
+    while (_p < _pattern.size())
+    {
+      char c = _pattern[_p];
+      if (c == '*')
+      {
+        bool any = _p + 1 < _pattern.size() && _pattern[_p + 1] == '*';
+        _p += any ? 2 : 1;
+
+        // "a/**/b" also matches "a/b"
+        if (any && _p < _pattern.size() && _pattern[_p] == '/' &&
+            glob(_pattern, _p + 1, _path, _s))
+        {
+          return true;
+        }
+
+        for (std::size_t end = _s; end <= _path.size(); ++end)
+        {
+          if (glob(_pattern, _p, _path, end))
+            return true;
+          if (end < _path.size() && _path[end] == '/' && !any)
+            break;
+        }
+        return false;
+      }
+
+      if (_s >= _path.size() || (c == '?' ? _path[_s] == '/' :
+          c != _path[_s]))
+      {
+        return false;
+      }
+      ++_p;
+      ++_s;
+    }
+    return _s == _path.size();
+  }
+}
+
+/////////////////////////////////////////////////
+bool ExtractFilter::Empty() const
+{
+  return this->include.empty() && this->exclude.empty();
+}
+
+/////////////////////////////////////////////////
+bool ExtractFilter::Extracts(const std::string &_path) const
+{
+  bool included = this->include.empty();
+  for (const auto &pattern : this->include)
+  {
+    if (Matches(pattern, _path))
+    {
+      included = true;
+      break;
+    }
+  }
+  if (!included)
+    return false;
+
+  for (const auto &pattern : this->exclude)
+  {
+    if (Matches(pattern, _path))
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ExtractFilter::Matches(const std::string &_pattern,
+    const std::string &_path)
+{
+  std::string pattern = _pattern;
+  while (!pattern.empty() && pattern.back() == '/')
+    pattern.pop_back();
+  while (!pattern.empty() && pattern.front() == '/')
+    pattern.erase(0, 1);
+  if (pattern.empty())
+    return false;
+
+  // A bare name matches any component of the path
+  if (pattern.find('/') == std::string::npos)
+  {
+    std::size_t start = 0;
+    while (start <= _path.size())
+    {
+      std::size_t end = _path.find('/', start);
+      if (end == std::string::npos)
+        end = _path.size();
+      if (glob(pattern, 0, _path.substr(start, end - start), 0))
+        return true;
+      start = end + 1;
+    }
+    return false;
+  }
+
+  // Otherwise the path or one of its parent directories has to match
+  for (std::size_t end = _path.find('/'); end != std::string::npos;
+       end = _path.find('/', end + 1))
+  {
+    if (glob(pattern, 0, _path.substr(0, end), 0))
+      return true;
+  }
+  return glob(pattern, 0, _path, 0);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gz/fuel_tools/ExtractFilter.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+TEST(ExtractFilter, Matches)
+{
+  // Bare names match any component
+  EXPECT_TRUE(ExtractFilter::Matches("*.blend", "source/box.blend"));
+  EXPECT_TRUE(ExtractFilter::Matches("*.blend", "box.blend"));
+  EXPECT_TRUE(ExtractFilter::Matches("thumbnails", "thumbnails/1.png"));
+  EXPECT_TRUE(ExtractFilter::Matches("thumbnails/", "a/thumbnails/1.png"));
+  EXPECT_TRUE(ExtractFilter::Matches("mesh?.dae", "meshes/mesh1.dae"));
+  EXPECT_FALSE(ExtractFilter::Matches("*.blend", "box.blend1"));
+  EXPECT_FALSE(ExtractFilter::Matches("mesh?.dae", "meshes/mesh10.dae"));
+
+  // Patterns with a separator match from the root of the resource
+  EXPECT_TRUE(ExtractFilter::Matches("materials/textures",
+      "materials/textures/a.png"));
+  EXPECT_TRUE(ExtractFilter::Matches("/materials/*/a.png",
+      "materials/textures/a.png"));
+  EXPECT_FALSE(ExtractFilter::Matches("materials/textures",
+      "other/materials/textures/a.png"));
+  EXPECT_FALSE(ExtractFilter::Matches("materials/*.png",
+      "materials/textures/a.png"));
+  EXPECT_FALSE(ExtractFilter::Matches("materials/tex",
+      "materials/textures/a.png"));
+
+  // ** crosses directories, including none
+  EXPECT_TRUE(ExtractFilter::Matches("materials/**/*.png",
+      "materials/textures/hd/a.png"));
+  EXPECT_TRUE(ExtractFilter::Matches("materials/**/*.png",
+      "materials/a.png"));
+  EXPECT_TRUE(ExtractFilter::Matches("**/hd/*", "materials/hd/a.png"));
+  EXPECT_FALSE(ExtractFilter::Matches("meshes/**/*.png",
+      "materials/textures/a.png"));
+
+  EXPECT_FALSE(ExtractFilter::Matches("", "model.config"));
+  EXPECT_FALSE(ExtractFilter::Matches("/", "model.config"));
+}
+
+/////////////////////////////////////////////////
+TEST(ExtractFilter, Extracts)
+{
+  ExtractFilter filter;
+  EXPECT_TRUE(filter.Empty());
+  EXPECT_TRUE(filter.Extracts("meshes/box.dae"));
+
+  filter.exclude = {"thumbnails", "*.blend"};
+  EXPECT_FALSE(filter.Empty());
+  EXPECT_TRUE(filter.Extracts("meshes/box.dae"));
+  EXPECT_FALSE(filter.Extracts("thumbnails/1.png"));
+  EXPECT_FALSE(filter.Extracts("source/box.blend"));
+
+  // Exclusions win over inclusions
+  filter.include = {"meshes", "materials/**/*.png"};
+  EXPECT_TRUE(filter.Extracts("meshes/box.dae"));
+  EXPECT_TRUE(filter.Extracts("materials/textures/a.png"));
+  EXPECT_FALSE(filter.Extracts("materials/textures/a.jpg"));
+  EXPECT_FALSE(filter.Extracts("meshes/box.blend"));
+  EXPECT_FALSE(filter.Extracts("model.config"));
+}
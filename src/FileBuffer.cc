@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gz/fuel_tools/FileBuffer.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Private data for FileBuffer.
+class gz::fuel_tools::FileBufferPrivate
+{
+  /// \brief Read a whole file into memory.
+  /// \return True on success.
+  public: bool Read()
+          {
+            std::ifstream in(this->path, std::ios::binary | std::ios::ate);
+            if (!in)
+              return false;
+
+            auto size = in.tellg();
+            if (size < 0)
+              return false;
+            this->contents.resize(static_cast<std::size_t>(size));
+            in.seekg(0);
+            if (!this->contents.empty() &&
+                !in.read(this->contents.data(), size))
+            {
+              return false;
+            }
+            this->data = this->contents.data();
+            this->size = this->contents.size();
+            return true;
+          }
+
+#ifndef _WIN32
+  /// \brief Memory map a file, falling back to reading it if it can't be
+  /// mapped.
+  /// \return True on success.
+  public: bool Map()
+          {
+            int fd = open(this->path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+              return false;
+
+            struct stat st;
+            if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+            {
+              close(fd);
+              return false;
+            }
+
+            // Empty files can't be mapped
+            this->size = static_cast<std::size_t>(st.st_size);
+            if (this->size > 0)
+            {
+              void *addr = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE,
+                  fd, 0);
+              if (addr == MAP_FAILED)
+              {
+                close(fd);
+                this->size = 0;
+                return this->Read();
+              }
+              this->data = static_cast<const char *>(addr);
+              this->mapped = true;
+            }
+            close(fd);
+            return true;
+          }
+#endif
+
+  /// \brief Path to the file.
+  public: std::string path;
+
+  /// \brief Contents, when the file isn't mapped.
+  public: std::vector<char> contents;
+
+  /// \brief Start of the contents.
+  public: const char *data = nullptr;
+
+  /// \brief Size of the contents.
+  public: std::size_t size = 0;
+
+  /// \brief Whether data points to a mapping.
+  public: bool mapped = false;
+
+  /// \brief Whether the file was loaded.
+  public: bool valid = false;
+};
+
+//////////////////////////////////////////////////
+FileBuffer::FileBuffer(const std::string &_path)
+  : dataPtr(new FileBufferPrivate)
+{
+  this->dataPtr->path = _path;
+#ifndef _WIN32
+  this->dataPtr->valid = this->dataPtr->Map();
+#else
+  this->dataPtr->valid = this->dataPtr->Read();
+#endif
+}
+
+//////////////////////////////////////////////////
+FileBuffer::~FileBuffer()
+{
+#ifndef _WIN32
+  if (this->dataPtr->mapped)
+  {
+    munmap(const_cast<char *>(this->dataPtr->data), this->dataPtr->size);
+  }
+#endif
+}
+
+//////////////////////////////////////////////////
+bool FileBuffer::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+//////////////////////////////////////////////////
+const std::string &FileBuffer::Path() const
+{
+  return this->dataPtr->path;
+}
+
+//////////////////////////////////////////////////
+const char *FileBuffer::Data() const
+{
+  return this->dataPtr->data;
+}
+
+//////////////////////////////////////////////////
+std::size_t FileBuffer::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+std::string_view FileBuffer::View() const
+{
+  if (!this->dataPtr->data)
+    return std::string_view();
+  return std::string_view(this->dataPtr->data, this->dataPtr->size);
+}
+
+//////////////////////////////////////////////////
+bool FileBuffer::Mapped() const
+{
+  return this->dataPtr->mapped;
+}
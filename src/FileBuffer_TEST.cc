@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/FileBuffer.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+TEST(FileBuffer, Load)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  std::string path = common::joinPaths(tempDir->Path(), "file.bin");
+  std::string content(100000, '\0');
+  for (std::size_t i = 0; i < content.size(); ++i)
+    content[i] = static_cast<char>(i % 256);
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+  }
+
+  FileBuffer buffer(path);
+  ASSERT_TRUE(buffer.Valid());
+  EXPECT_EQ(path, buffer.Path());
+  EXPECT_EQ(content.size(), buffer.Size());
+  EXPECT_EQ(content, buffer.View());
+#ifndef _WIN32
+  EXPECT_TRUE(buffer.Mapped());
+#endif
+}
+
+/////////////////////////////////////////////////
+TEST(FileBuffer, EmptyAndMissing)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  std::string path = common::joinPaths(tempDir->Path(), "empty");
+  {
+    std::ofstream out(path);
+  }
+
+  FileBuffer empty(path);
+  EXPECT_TRUE(empty.Valid());
+  EXPECT_EQ(0u, empty.Size());
+  EXPECT_TRUE(empty.View().empty());
+
+  FileBuffer missing(common::joinPaths(tempDir->Path(), "missing"));
+  EXPECT_FALSE(missing.Valid());
+  EXPECT_EQ(0u, missing.Size());
+  EXPECT_EQ(nullptr, missing.Data());
+
+  FileBuffer dir(tempDir->Path());
+  EXPECT_FALSE(dir.Valid());
+}
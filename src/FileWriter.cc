@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+  #include <errno.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+
+#include "FileWriter.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /// \brief Largest number of files flushed together, each one keeps a
+  /// descriptor open until then.
+  constexpr unsigned int kMaxSyncBatch = 256u;
+
+  /// \brief Files smaller than this aren't preallocated, the extra system
+  /// call costs more than it saves.
+  constexpr std::uint64_t kPreallocateMinBytes = 64 * 1024;
+}
+
+/// \brief Private data for FileWriter.
+class gz::fuel_tools::FileWriterPrivate
+{
+  /// \brief Number of files flushed together, 0 to never flush.
+  public: unsigned int syncBatch = 0u;
+
+  /// \brief Path of the current file.
+  public: std::string path;
+
+  /// \brief Whether a write to the current file failed.
+  public: bool failed = false;
+
+#ifndef _WIN32
+  /// \brief Descriptor of the current file, -1 if none.
+  public: int fd = -1;
+
+  /// \brief Bytes written to the current file.
+  public: std::uint64_t written = 0;
+
+  /// \brief Bytes preallocated for the current file.
+  public: std::uint64_t preallocated = 0;
+
+  /// \brief Closed files waiting to be flushed.
+  public: std::vector<int> pending;
+#else
+  /// \brief Current file.
+  public: std::ofstream file;
+#endif
+};
+
+//////////////////////////////////////////////////
+FileWriter::FileWriter(unsigned int _syncBatch)
+  : dataPtr(std::make_unique<FileWriterPrivate>())
+{
+  this->dataPtr->syncBatch = std::min(_syncBatch, kMaxSyncBatch);
+}
+
+//////////////////////////////////////////////////
+FileWriter::~FileWriter()
+{
+  this->Discard();
+  this->Sync();
+}
+
+#ifndef _WIN32
+//////////////////////////////////////////////////
+bool FileWriter::Open(const std::string &_path, std::uint64_t _size)
+{
+  auto &d = *this->dataPtr;
+  this->Discard();
+  d.path = _path;
+  d.failed = false;
+  d.written = 0;
+  d.preallocated = 0;
+
+  // Fresh extractions never find a file, so they don't pay for a lookup
+  // before the open
+  const int flags = O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC;
+  d.fd = open(_path.c_str(), flags, 0644);
+  if (d.fd < 0 && errno == EEXIST && unlink(_path.c_str()) == 0)
+    d.fd = open(_path.c_str(), flags, 0644);
+  if (d.fd < 0)
+    return false;
+
+#ifdef __linux__
+  // Reserve the blocks without changing the size, so a short write never
+  // leaves zeros at the end. Filesystems without support just skip it.
+  if (_size >= kPreallocateMinBytes &&
+      fallocate(d.fd, FALLOC_FL_KEEP_SIZE, 0,
+                static_cast<off_t>(_size)) == 0)
+  {
+    d.preallocated = _size;
+  }
+#else
+  (void)_size;
+#endif
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool FileWriter::Write(const char *_data, std::size_t _size)
+{
+  auto &d = *this->dataPtr;
+  while (d.fd >= 0 && !d.failed && _size > 0)
+  {
+    ssize_t n = write(d.fd, _data, _size);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+    {
+      d.failed = true;
+      break;
+    }
+    _data += n;
+    _size -= static_cast<std::size_t>(n);
+    d.written += static_cast<std::uint64_t>(n);
+  }
+  return d.fd >= 0 && !d.failed;
+}
+
+//////////////////////////////////////////////////
+bool FileWriter::Close()
+{
+  auto &d = *this->dataPtr;
+  if (d.fd < 0)
+    return false;
+
+  if (d.failed)
+  {
+    this->Discard();
+    return false;
+  }
+
+  // Give back what was preallocated for a file that came out smaller
+  if (d.preallocated > d.written &&
+      ftruncate(d.fd, static_cast<off_t>(d.written)) != 0)
+  {
+    gzwarn << "Unable to trim [" << d.path << "]" << std::endl;
+  }
+
+  int fd = d.fd;
+  d.fd = -1;
+  if (d.syncBatch == 0u)
+  {
+    if (close(fd) != 0)
+    {
+      unlink(d.path.c_str());
+      return false;
+    }
+    return true;
+  }
+
+#ifdef __linux__
+  // Start the write back now, the batch flush then mostly waits for it
+  sync_file_range(fd, 0, 0, SYNC_FILE_RANGE_WRITE);
+#endif
+  d.pending.push_back(fd);
+  if (d.pending.size() >= d.syncBatch)
+    return this->Sync();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void FileWriter::Discard()
+{
+  auto &d = *this->dataPtr;
+  if (d.fd < 0)
+    return;
+
+  close(d.fd);
+  d.fd = -1;
+  unlink(d.path.c_str());
+}
+
+//////////////////////////////////////////////////
+bool FileWriter::IsOpen() const
+{
+  return this->dataPtr->fd >= 0;
+}
+
+//////////////////////////////////////////////////
+bool FileWriter::Sync()
+{
+  auto &d = *this->dataPtr;
+  bool ok = true;
+  for (int fd : d.pending)
+  {
+#ifdef __linux__
+    ok = fdatasync(fd) == 0 && ok;
+#else
+    ok = fsync(fd) == 0 && ok;
+#endif
+    ok = close(fd) == 0 && ok;
+  }
+  if (!ok)
+  {
+    gzerr << "Unable to flush " << d.pending.size() << " files to disk"
+          << std::endl;
+  }
+  d.pending.clear();
+  return ok;
+}
+#else
+//////////////////////////////////////////////////
+bool FileWriter::Open(const std::string &_path, std::uint64_t)
+{
+  auto &d = *this->dataPtr;
+  this->Discard();
+  d.path = _path;
+  d.failed = false;
+
+  if (common::isFile(_path))
+    common::removeFile(_path);
+  d.file.open(_path, std::ios::out | std::ios::binary);
+  return d.file.is_open();
+}
+
+//////////////////////////////////////////////////
+bool FileWriter::Write(const char *_data, std::size_t _size)
+{
+  auto &d = *this->dataPtr;
+  if (!d.file.is_open())
+    return false;
+  d.file.write(_data, static_cast<std::streamsize>(_size));
+  d.failed = d.failed || d.file.fail();
+  return !d.failed;
+}
+
+//////////////////////////////////////////////////
+bool FileWriter::Close()
+{
+  auto &d = *this->dataPtr;
+  if (!d.file.is_open())
+    return false;
+
+  d.file.close();
+  if (d.failed || d.file.fail())
+  {
+    common::removeFile(d.path);
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void FileWriter::Discard()
+{
+  auto &d = *this->dataPtr;
+  if (!d.file.is_open())
+    return;
+
+  d.file.close();
+  common::removeFile(d.path);
+}
+
+//////////////////////////////////////////////////
+bool FileWriter::IsOpen() const
+{
+  return this->dataPtr->file.is_open();
+}
+
+//////////////////////////////////////////////////
+bool FileWriter::Sync()
+{
+  // Standard streams can't flush to disk
+  return true;
+}
+#endif
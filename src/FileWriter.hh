@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_FILEWRITER_HH_
+#define GZ_FUEL_TOOLS_FILEWRITER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gz/fuel_tools/Export.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Private data.
+  class FileWriterPrivate;
+
+  /// \brief Writes extracted files one after the other with as few system
+  /// calls as possible, for archives made of many small files.
+  ///
+  /// On POSIX systems a file costs an exclusive open, its writes and a
+  /// close: existing files are only unlinked when the open finds one, and
+  /// there's no stream buffering in between. Files of known size are
+  /// preallocated, so large ones aren't fragmented. Files can be flushed to
+  /// disk in batches, which lets the kernel write a whole batch back at
+  /// once instead of waiting for each file. Other systems use a standard
+  /// file stream.
+  ///
+  /// A writer handles one file at a time, use one writer per thread.
+  class GZ_FUEL_TOOLS_VISIBLE FileWriter
+  {
+    /// \brief Constructor.
+    /// \param[in] _syncBatch Number of files flushed to disk together, 0
+    /// to leave it to the operating system. Files of a batch are kept open
+    /// until they're flushed, so the batch is capped at 256 files.
+    public: explicit FileWriter(unsigned int _syncBatch = 0u);
+
+    /// \brief Destructor. Flushes the last batch and removes the current
+    /// file if it wasn't closed.
+    public: ~FileWriter();
+
+    /// \brief Create a file, replacing an existing one. Existing files are
+    /// unlinked rather than overwritten, they may be hard links shared
+    /// with other cached resources.
+    /// \param[in] _path Path of the file. Its directory must exist.
+    /// \param[in] _size Expected size of the file, used to preallocate it,
+    /// 0 if unknown.
+    /// \return True if the file was created.
+    public: bool Open(const std::string &_path, std::uint64_t _size = 0u);
+
+    /// \brief Append data to the current file.
+    /// \param[in] _data Data to write.
+    /// \param[in] _size Number of bytes.
+    /// \return True if all the data was written.
+    public: bool Write(const char *_data, std::size_t _size);
+
+    /// \brief Close the current file. With batching, it's flushed to disk
+    /// with the rest of its batch. The file is removed if a write failed.
+    /// \return True if the file was written completely.
+    public: bool Close();
+
+    /// \brief Close and remove the current file, e.g. after an error.
+    public: void Discard();
+
+    /// \brief Whether a file is open.
+    /// \return True between Open and Close or Discard.
+    public: bool IsOpen() const;
+
+    /// \brief Flush the files of the current batch to disk.
+    /// \return True if every file was flushed.
+    public: bool Sync();
+
+    /// \brief Private data.
+    private: std::unique_ptr<FileWriterPrivate> dataPtr;
+  };
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_FILEWRITER_HH_
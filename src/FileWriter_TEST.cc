@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "FileWriter.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file.
+std::string readFile(const std::string &_path)
+{
+  std::ifstream in(_path, std::ios::binary);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+/////////////////////////////////////////////////
+TEST(FileWriter, Write)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  for (unsigned int batch : {0u, 3u})
+  {
+    FileWriter writer(batch);
+    for (int i = 0; i < 8; ++i)
+    {
+      std::string path = common::joinPaths(tempDir->Path(),
+          "file" + std::to_string(i));
+      std::string content(i * 30000, static_cast<char>('a' + i));
+
+      // A size hint larger than the content doesn't make the file larger
+      ASSERT_TRUE(writer.Open(path, content.size() + (i == 5 ? 100000 : 0)));
+      EXPECT_TRUE(writer.IsOpen());
+      EXPECT_TRUE(writer.Write(content.data(), content.size()));
+      EXPECT_TRUE(writer.Close());
+      EXPECT_FALSE(writer.IsOpen());
+    }
+    EXPECT_TRUE(writer.Sync());
+
+    for (int i = 0; i < 8; ++i)
+    {
+      EXPECT_EQ(std::string(i * 30000, static_cast<char>('a' + i)),
+          readFile(common::joinPaths(tempDir->Path(),
+              "file" + std::to_string(i))));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(FileWriter, Replace)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  std::string path = common::joinPaths(tempDir->Path(), "file");
+  std::string link = common::joinPaths(tempDir->Path(), "link");
+
+  FileWriter writer;
+  ASSERT_TRUE(writer.Open(path));
+  EXPECT_TRUE(writer.Write("old", 3));
+  EXPECT_TRUE(writer.Close());
+
+  // Hard links to the file keep their content
+  std::error_code ec;
+  std::filesystem::create_hard_link(path, link, ec);
+  ASSERT_TRUE(writer.Open(path));
+  EXPECT_TRUE(writer.Write("new", 3));
+  EXPECT_TRUE(writer.Close());
+  EXPECT_EQ("new", readFile(path));
+  if (!ec)
+  {
+    EXPECT_EQ("old", readFile(link));
+  }
+
+  // Discarded files are removed
+  std::string discarded = common::joinPaths(tempDir->Path(), "discarded");
+  ASSERT_TRUE(writer.Open(discarded));
+  EXPECT_TRUE(writer.Write("x", 1));
+  writer.Discard();
+  EXPECT_FALSE(writer.IsOpen());
+  EXPECT_FALSE(common::exists(discarded));
+
+  // Missing directories aren't created
+  EXPECT_FALSE(writer.Open(common::joinPaths(tempDir->Path(), "a", "b")));
+  EXPECT_FALSE(writer.Write("x", 1));
+  EXPECT_FALSE(writer.Close());
+}
@@ -25,12 +25,16 @@
 #endif
 
 #include <algorithm>
+#include <chrono>
 #include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <memory>
-#include <regex>
 #include <string>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
@@ -50,137 +54,19 @@
 #include "gz/fuel_tools/WorldIdentifier.hh"
 #include "gz/fuel_tools/WorldIter.hh"
 
+#include "CacheStatisticsRecorder.hh"
+#include "FuelUrlParser.hh"
+#include "IdentifierKey.hh"
 #include "LocalCache.hh"
 #include "ModelIterPrivate.hh"
+#include "StreamingUnzip.hh"
 #include "WorldIterPrivate.hh"
 
-namespace std
-{
-  template<> struct hash<gz::fuel_tools::ModelIdentifier>
-  {
-    std::size_t operator()(
-      const gz::fuel_tools::ModelIdentifier &_id) const noexcept
-    {
-      return std::hash<std::string>{}(_id.AsString());
-    }
-  };
-}  // namespace std
-
 namespace gz::fuel_tools
 {
 /// \brief Private Implementation
 class FuelClientPrivate
 {
-  /// \brief A model URL,
-  /// E.g.: https://fuel.gazebosim.org/1.0/caguero/models/Beer/2
-  /// Where the API version and the model version are optional.
-  public: const std::string kModelUrlRegexStr{
-    // Method
-    "^([[:alnum:]\\.\\+\\-]+):\\/\\/"
-    // Server
-    "([^\\/\\s]+)\\/+"
-    // API Version
-    "([0-9]+[.][0-9]+)?\\/*"
-    // Owner
-    "([^\\/\\s]+)\\/+"
-    // "models"
-    "models\\/+"
-    // Name
-    "([^\\/]+)\\/*"
-    // Version
-    "([0-9]*|tip)"
-    // Trailing /
-    "/?"};
-
-  /// \brief A world URL,
-  /// E.g.: https://fuel.gazebosim.org/1.0/OpenRobotics/worlds/Empty/1
-  /// Where the API version and the world version are optional.
-  public: const std::string kWorldUrlRegexStr{
-    // Method
-    "^([[:alnum:]\\.\\+\\-]+):\\/\\/"
-    // Server
-    "([^\\/\\s]+)\\/+"
-    // API Version
-    "([0-9]+[.][0-9]+)?\\/*"
-    // Owner
-    "([^\\/\\s]+)\\/+"
-    // "worlds"
-    "worlds\\/+"
-    // Name
-    "([^\\/]+)\\/*"
-    // Version
-    "([0-9]*|tip)"
-    // Trailing /
-    "/?"};
-
-  /// \brief A model file URL,
-  /// E.g.: https://server.org/1.0/owner/models/modelname/files/meshes/mesh.dae
-  /// Where the API version is optional, but the model version is required.
-  public: const std::string kModelFileUrlRegexStr{
-    // Method
-    "^([[:alnum:]\\.\\+\\-]+):\\/\\/"
-    // Server
-    "([^\\/\\s]+)\\/+"
-    // API Version
-    "([0-9]+[.][0-9]+)?\\/*"
-    // Owner
-    "([^\\/\\s]+)\\/+"
-    // "models"
-    "models\\/+"
-    // Model
-    "([^\\/]+)\\/+"
-    // Version
-    "([0-9]*|tip)\\/+"
-    // "files"
-    "files\\/+"
-    // File path
-    "(.*)"
-    // Trailing /
-    "/?"};
-
-  /// \brief A world file URL,
-  /// E.g.: https://server.org/1.0/owner/worlds/worldname/files/meshes/mesh.dae
-  /// Where the API version is optional, but the world version is required.
-  public: const std::string kWorldFileUrlRegexStr{
-    // Method
-    "^([[:alnum:]\\.\\+\\-]+):\\/\\/"
-    // Server
-    "([^\\/\\s]+)\\/+"
-    // API Version
-    "([0-9]+[.][0-9]+)?\\/*"
-    // Owner
-    "([^\\/\\s]+)\\/+"
-    // "worlds"
-    "worlds\\/+"
-    // World
-    "([^\\/]+)\\/+"
-    // Version
-    "([0-9]*|tip)\\/+"
-    // "files"
-    "files\\/+"
-    // File path
-    "(.*)"
-    // Trailing /
-    "/?"};
-
-  /// \brief A collection URL,
-  /// E.g.:
-  /// https://fuel.gazebosim.org/1.0/OpenRobotics/collections/TestColl
-  /// Where the API version is optional
-  public: const std::string kCollectionUrlRegexStr{
-    // Method
-    "^([[:alnum:]\\.\\+\\-]+):\\/\\/"
-    // Server
-    "([^\\/\\s]+)\\/+"
-    // API Version
-    "([0-9]+[.][0-9]+)?\\/*"
-    // Owner
-    "([^\\/\\s]+)\\/+"
-    // "collections"
-    "collections\\/+"
-    // Name
-    "([^\\/]+)\\/*"};
-
   /// \brief Recursively get all the files in the given path.
   /// \param[in] _path Path to process.
   /// \param[out] _files All the files in the given _path.
@@ -214,8 +100,53 @@ class FuelClientPrivate
 
   /// \brief Get zip data from a REST response. This is used by world and
   /// model download.
+  /// \param[in] _resp Response of the download request.
+  /// \param[out] _zip Zip data.
+  /// \param[in] _dataCallback Callback seeing the body of the archive
+  /// while it's received when following a referral link, may be empty.
   public: void ZipFromResponse(const RestResponse &_resp,
-              std::string &_zip);
+              std::string &_zip,
+              const std::function<bool(const char *, std::size_t)>
+                &_dataCallback = {});
+
+  /// \brief Get zip data from a REST response, extracting it while it's
+  /// received if streaming extraction is enabled.
+  /// \param[in] _resp Response of the download request.
+  /// \param[out] _zip Zip data.
+  /// \param[out] _dir Staging directory the archive was extracted to and
+  /// verified in, or empty if _zip still has to be extracted.
+  /// \param[in] _filter Files to extract. Filtered downloads aren't
+  /// streamed.
+  /// \sa ClientConfig::SetStreamingExtract
+  public: void DownloadZip(const RestResponse &_resp, std::string &_zip,
+              std::string &_dir, const ExtractFilter &_filter);
+
+  /// \brief Fetch a single file of a resource, one that was left out by
+  /// the extraction filter when the resource was saved.
+  /// \param[in] _server Server of the resource.
+  /// \param[in] _route Route of the file, e.g.
+  /// owner/models/name/1/files/meshes/mesh.dae
+  /// \param[in] _headers Headers to set on the HTTP request.
+  /// \param[in] _dst Path the file is saved to, see
+  /// LocalCache::FetchedFilePath.
+  /// \return True if the file was fetched and saved.
+  /// \sa LocalCache::IsExcluded
+  public: bool FetchExcludedFile(const ServerConfig &_server,
+              const common::URIPath &_route,
+              const std::vector<std::string> &_headers,
+              const std::string &_dst);
+
+  /// \brief Record a cache lookup in the cache statistics.
+  /// \param[in] _hit True if the resource was found in the cache.
+  public: static void RecordLookup(bool _hit);
+
+  /// \brief Record a download in the cache statistics.
+  /// \param[in] _start Time the download started.
+  /// \param[in] _bytes Size of the downloaded archive, 0 if the download
+  /// failed.
+  public: static void RecordDownload(
+              std::chrono::steady_clock::time_point _start,
+              std::size_t _bytes);
 
   /// \brief Client configuration
   public: ClientConfig config;
@@ -226,21 +157,6 @@ class FuelClientPrivate
   /// \brief Local Cache
   public: std::shared_ptr<LocalCache> cache;
 
-  /// \brief Regex to parse Gazebo Fuel model URLs.
-  public: std::unique_ptr<std::regex> urlModelRegex;
-
-  /// \brief Regex to parse Gazebo Fuel world URLs.
-  public: std::unique_ptr<std::regex> urlWorldRegex;
-
-  /// \brief Regex to parse Gazebo Fuel model file URLs.
-  public: std::unique_ptr<std::regex> urlModelFileRegex;
-
-  /// \brief Regex to parse Gazebo Fuel world file URLs.
-  public: std::unique_ptr<std::regex> urlWorldFileRegex;
-
-  /// \brief Regex to parse Gazebo Fuel Collection URLs.
-  public: std::unique_ptr<std::regex> urlCollectionRegex;
-
   /// \brief The set of licenses where the key is the name of the license
   /// and the value is the license ID on a Fuel server. See the
   /// PopulateLicenses function.
@@ -263,16 +179,6 @@ FuelClient::FuelClient(const ClientConfig &_config, const Rest &_rest)
 
   this->dataPtr->cache = std::make_unique<LocalCache>(&(this->dataPtr->config));
 
-  this->dataPtr->urlModelRegex.reset(new std::regex(
-    this->dataPtr->kModelUrlRegexStr));
-  this->dataPtr->urlWorldRegex.reset(new std::regex(
-    this->dataPtr->kWorldUrlRegexStr));
-  this->dataPtr->urlModelFileRegex.reset(new std::regex(
-    this->dataPtr->kModelFileUrlRegexStr));
-  this->dataPtr->urlWorldFileRegex.reset(new std::regex(
-    this->dataPtr->kWorldFileUrlRegexStr));
-  this->dataPtr->urlCollectionRegex.reset(new std::regex(
-    this->dataPtr->kCollectionUrlRegexStr));
 }
 
 //////////////////////////////////////////////////
@@ -639,9 +545,17 @@ Result FuelClient::DownloadModel(const ModelIdentifier &_id)
 //////////////////////////////////////////////////
 Result FuelClient::DownloadModel(const ModelIdentifier &_id,
     const std::vector<std::string> &_headers)
+{
+  return this->DownloadModel(_id, _headers,
+      this->dataPtr->config.ExtractionFilter());
+}
+
+//////////////////////////////////////////////////
+Result FuelClient::DownloadModel(const ModelIdentifier &_id,
+    const std::vector<std::string> &_headers, const ExtractFilter &_filter)
 {
   std::vector<ModelIdentifier> dependencies;
-  auto res = this->DownloadModel(_id, _headers, dependencies);
+  auto res = this->DownloadModel(_id, _headers, dependencies, _filter);
 
   if(!res)
     return res;
@@ -651,7 +565,7 @@ Result FuelClient::DownloadModel(const ModelIdentifier &_id,
     // Download dependency if not in the local cache
     if (!this->dataPtr->cache->MatchingModel(dep))
     {
-      auto depRes = this->DownloadModel(dep, _headers);
+      auto depRes = this->DownloadModel(dep, _headers, _filter);
 
       if(!depRes)
         return depRes;
@@ -665,6 +579,16 @@ Result FuelClient::DownloadModel(const ModelIdentifier &_id,
 Result FuelClient::DownloadModel(const ModelIdentifier &_id,
     const std::vector<std::string> &_headers,
     std::vector<ModelIdentifier> &_dependencies)
+{
+  return this->DownloadModel(_id, _headers, _dependencies,
+      this->dataPtr->config.ExtractionFilter());
+}
+
+//////////////////////////////////////////////////
+Result FuelClient::DownloadModel(const ModelIdentifier &_id,
+    const std::vector<std::string> &_headers,
+    std::vector<ModelIdentifier> &_dependencies,
+    const ExtractFilter &_filter)
 {
   // Server config
   if (!_id.Server().Url().Valid() || _id.Server().Version().empty())
@@ -680,6 +604,7 @@ Result FuelClient::DownloadModel(const ModelIdentifier &_id,
         (_id.Name() + ".zip");
 
   gzmsg << "Downloading model [" << _id.UniqueName() << "]" << std::endl;
+  auto downloadStart = std::chrono::steady_clock::now();
 
   std::vector<std::string> headersIncludingServerConfig = _headers;
   AddServerConfigParametersToHeaders(
@@ -696,6 +621,7 @@ Result FuelClient::DownloadModel(const ModelIdentifier &_id,
            << "  Server: " << _id.Server().Url().Str() << std::endl
            << "  Route: " << route.Str() << std::endl
            << "  REST response code: " << resp.statusCode << std::endl;
+    FuelClientPrivate::RecordDownload(downloadStart, 0u);
     return Result(ResultType::FETCH_ERROR);
   }
 
@@ -723,11 +649,16 @@ Result FuelClient::DownloadModel(const ModelIdentifier &_id,
   newId.SetVersion(version);
 
   std::string zipData;
-  this->dataPtr->ZipFromResponse(resp, zipData);
+  std::string extractedDir;
+  this->dataPtr->DownloadZip(resp, zipData, extractedDir, _filter);
+  FuelClientPrivate::RecordDownload(downloadStart, zipData.size());
 
   // Save
   // Note that the save function doesn't return the path
-  if (zipData.empty() || !this->dataPtr->cache->SaveModel(newId, zipData, true))
+  bool saved = !zipData.empty() && (extractedDir.empty() ?
+      this->dataPtr->cache->SaveModel(newId, zipData, true, _filter) :
+      this->dataPtr->cache->InstallModel(newId, extractedDir, true));
+  if (!saved)
     return Result(ResultType::FETCH_ERROR);
 
   return this->ModelDependencies(_id, _dependencies);
@@ -743,8 +674,10 @@ Result FuelClient::ModelDependencies(const ModelIdentifier &_id,
   std::string path;
   gz::msgs::FuelMetadata meta;
 
-  if (this->CachedModel(_id, path))
+  auto model = this->dataPtr->cache->MatchingModel(_id);
+  if (model)
   {
+    path = model.PathToModel();
     std::string metadataPath =
       gz::common::joinPaths(path, "metadata.pbtxt");
     std::string modelConfigPath =
@@ -842,6 +775,14 @@ Result FuelClient::DownloadWorld(WorldIdentifier &_id)
 //////////////////////////////////////////////////
 Result FuelClient::DownloadWorld(WorldIdentifier &_id,
     const std::vector<std::string> &_headers)
+{
+  return this->DownloadWorld(_id, _headers,
+      this->dataPtr->config.ExtractionFilter());
+}
+
+//////////////////////////////////////////////////
+Result FuelClient::DownloadWorld(WorldIdentifier &_id,
+    const std::vector<std::string> &_headers, const ExtractFilter &_filter)
 {
   // Server config
   if (!_id.Server().Url().Valid() || _id.Server().Version().empty())
@@ -857,6 +798,7 @@ Result FuelClient::DownloadWorld(WorldIdentifier &_id,
         (_id.Name() + ".zip");
 
   gzmsg << "Downloading world [" << _id.UniqueName() << "]" << std::endl;
+  auto downloadStart = std::chrono::steady_clock::now();
 
   std::vector<std::string> headersIncludingServerConfig = _headers;
   AddServerConfigParametersToHeaders(
@@ -874,6 +816,7 @@ Result FuelClient::DownloadWorld(WorldIdentifier &_id,
            << "  Server: " << _id.Server().Url().Str() << std::endl
            << "  Route: " << route.Str() << std::endl
            << "  REST response code: " << resp.statusCode << std::endl;
+    FuelClientPrivate::RecordDownload(downloadStart, 0u);
     return Result(ResultType::FETCH_ERROR);
   }
 
@@ -901,10 +844,15 @@ Result FuelClient::DownloadWorld(WorldIdentifier &_id,
   _id.SetVersion(version);
 
   std::string zipData;
-  this->dataPtr->ZipFromResponse(resp, zipData);
+  std::string extractedDir;
+  this->dataPtr->DownloadZip(resp, zipData, extractedDir, _filter);
+  FuelClientPrivate::RecordDownload(downloadStart, zipData.size());
 
   // Save
-  if (zipData.empty() || !this->dataPtr->cache->SaveWorld(_id, zipData, true))
+  bool saved = !zipData.empty() && (extractedDir.empty() ?
+      this->dataPtr->cache->SaveWorld(_id, zipData, true, _filter) :
+      this->dataPtr->cache->InstallWorld(_id, extractedDir, true));
+  if (!saved)
       return Result(ResultType::FETCH_ERROR);
 
   return Result(ResultType::FETCH);
@@ -920,7 +868,9 @@ std::vector<FuelClient::ModelResult> FuelClient::DownloadModels(
 
   std::mutex idsMutex;
   std::deque<ModelIdentifier> idsToDownload(_ids.begin(), _ids.end());
-  std::unordered_set<ModelIdentifier> uniqueIds(_ids.begin(), _ids.end());
+  std::unordered_set<IdentifierKey, IdentifierKeyHash> uniqueIds;
+  for (const auto &id : _ids)
+    uniqueIds.emplace(id);
 
   std::atomic<bool> running = true;
 
@@ -958,11 +908,8 @@ std::vector<FuelClient::ModelResult> FuelClient::DownloadModels(
           << " model dependencies to queue from " << id.Name() << "\n";
         for (const auto &dep : dependencies)
         {
-          if (uniqueIds.count(dep) == 0)
-          {
+          if (uniqueIds.emplace(dep).second)
             idsToDownload.push_back(dep);
-            uniqueIds.insert(dep);
-          }
         }
       }
     }
@@ -1077,30 +1024,16 @@ bool FuelClient::ParseModelUrl(const common::URI &_modelUrl,
 
   auto urlStr = _modelUrl.Str();
 
-  std::smatch match;
-  std::string scheme;
-  std::string server;
-  std::string apiVersion;
-  std::string owner;
-  std::string modelName;
-  std::string modelVersion;
-
-  if (std::regex_match(urlStr, match, *this->dataPtr->urlModelRegex) &&
-      match.size() >= 5u)
-  {
-    unsigned int i{1};
-
-    scheme = match[i++];
-    server = match[i++];
-    apiVersion = match[i++];
-    owner = match[i++];
-    modelName = match[i++];
-    modelVersion = match[i++];
-  }
-  else
-  {
+  FuelUrlParts parts;
+  if (FuelUrlParser::Classify(urlStr, parts) != FuelUrlType::MODEL)
     return false;
-  }
+
+  std::string scheme(parts.scheme);
+  std::string server(parts.server);
+  std::string apiVersion(parts.apiVersion);
+  std::string owner(parts.owner);
+  std::string modelName(parts.name);
+  std::string modelVersion(parts.version);
 
   // Get remaining server information from config
   common::URI serverUri;
@@ -1147,30 +1080,16 @@ bool FuelClient::ParseWorldUrl(const common::URI &_worldUrl,
 
   auto urlStr = _worldUrl.Str();
 
-  std::smatch match;
-  std::string scheme;
-  std::string server;
-  std::string apiVersion;
-  std::string owner;
-  std::string worldName;
-  std::string worldVersion;
-
-  if (std::regex_match(urlStr, match, *this->dataPtr->urlWorldRegex) &&
-      match.size() >= 5u)
-  {
-    unsigned int i{1};
-
-    scheme = match[i++];
-    server = match[i++];
-    apiVersion = match[i++];
-    owner = match[i++];
-    worldName = match[i++];
-    worldVersion = match[i++];
-  }
-  else
-  {
+  FuelUrlParts parts;
+  if (FuelUrlParser::Classify(urlStr, parts) != FuelUrlType::WORLD)
     return false;
-  }
+
+  std::string scheme(parts.scheme);
+  std::string server(parts.server);
+  std::string apiVersion(parts.apiVersion);
+  std::string owner(parts.owner);
+  std::string worldName(parts.name);
+  std::string worldVersion(parts.version);
 
   // Get remaining server information from config
   common::URI serverUri;
@@ -1217,32 +1136,17 @@ bool FuelClient::ParseModelFileUrl(const common::URI &_modelFileUrl,
 
   auto urlStr = _modelFileUrl.Str();
 
-  std::smatch match;
-  std::string scheme;
-  std::string server;
-  std::string apiVersion;
-  std::string owner;
-  std::string modelName;
-  std::string modelVersion;
-  std::string file;
-
-  if (std::regex_match(urlStr, match, *this->dataPtr->urlModelFileRegex) &&
-      match.size() == 8u)
-  {
-    unsigned int i{1};
-
-    scheme = match[i++];
-    server = match[i++];
-    apiVersion = match[i++];
-    owner = match[i++];
-    modelName = match[i++];
-    modelVersion = match[i++];
-    file = match[i++];
-  }
-  else
-  {
+  FuelUrlParts parts;
+  if (FuelUrlParser::Classify(urlStr, parts) != FuelUrlType::MODEL_FILE)
     return false;
-  }
+
+  std::string scheme(parts.scheme);
+  std::string server(parts.server);
+  std::string apiVersion(parts.apiVersion);
+  std::string owner(parts.owner);
+  std::string modelName(parts.name);
+  std::string modelVersion(parts.version);
+  std::string file(parts.file);
 
   // Get remaining server information from config
   common::URI serverUri;
@@ -1290,32 +1194,17 @@ bool FuelClient::ParseWorldFileUrl(const common::URI &_worldFileUrl,
 
   auto urlStr = _worldFileUrl.Str();
 
-  std::smatch match;
-  std::string scheme;
-  std::string server;
-  std::string apiVersion;
-  std::string owner;
-  std::string worldName;
-  std::string worldVersion;
-  std::string file;
-
-  if (std::regex_match(urlStr, match, *this->dataPtr->urlWorldFileRegex) &&
-      match.size() == 8u)
-  {
-    unsigned int i{1};
-
-    scheme = match[i++];
-    server = match[i++];
-    apiVersion = match[i++];
-    owner = match[i++];
-    worldName = match[i++];
-    worldVersion = match[i++];
-    file = match[i++];
-  }
-  else
-  {
+  FuelUrlParts parts;
+  if (FuelUrlParser::Classify(urlStr, parts) != FuelUrlType::WORLD_FILE)
     return false;
-  }
+
+  std::string scheme(parts.scheme);
+  std::string server(parts.server);
+  std::string apiVersion(parts.apiVersion);
+  std::string owner(parts.owner);
+  std::string worldName(parts.name);
+  std::string worldVersion(parts.version);
+  std::string file(parts.file);
 
   // Get remaining server information from config
   common::URI serverUri;
@@ -1363,30 +1252,15 @@ bool FuelClient::ParseCollectionUrl(const common::URI &_url,
 
   auto urlStr = _url.Str();
 
-  std::smatch match;
-  std::string scheme;
-  std::string server;
-  std::string apiVersion;
-  std::string owner;
-  std::string collectionName;
-
-  bool result =
-      std::regex_match(urlStr, match, *this->dataPtr->urlCollectionRegex);
-
-  if (result && match.size() >= 5u)
-  {
-    unsigned int i{1};
-
-    scheme = match[i++];
-    server = match[i++];
-    apiVersion = match[i++];
-    owner = match[i++];
-    collectionName = match[i++];
-  }
-  else
-  {
+  FuelUrlParts parts;
+  if (FuelUrlParser::Classify(urlStr, parts) != FuelUrlType::COLLECTION)
     return false;
-  }
+
+  std::string scheme(parts.scheme);
+  std::string server(parts.server);
+  std::string apiVersion(parts.apiVersion);
+  std::string owner(parts.owner);
+  std::string collectionName(parts.name);
 
   // Get remaining server information from config
   common::URI serverUri;
@@ -1447,8 +1321,17 @@ Result FuelClient::DownloadModel(const common::URI &_modelUrl,
     id.SetVersion(model.Identification().Version());
   }
 
-  _path = gz::common::joinPaths(this->Config().CacheLocation(),
-      id.UniqueName(), id.VersionStr());
+  // The model may live in a read-only cache layer
+  Model model = this->dataPtr->cache->MatchingModel(id);
+  if (model)
+  {
+    _path = model.PathToModel();
+  }
+  else
+  {
+    _path = gz::common::joinPaths(this->Config().CacheLocation(),
+        id.UniqueName(), id.VersionStr());
+  }
 
   return result;
 }
@@ -1479,6 +1362,7 @@ Result FuelClient::CachedModel(const ModelIdentifier &_id,
                                std::string &_path)
 {
   auto modelIter = this->dataPtr->cache->MatchingModel(_id);
+  FuelClientPrivate::RecordLookup(modelIter);
   if (modelIter)
   {
     _path = modelIter.PathToModel();
@@ -1517,7 +1401,9 @@ bool FuelClient::CachedWorld(const common::URI &_worldUrl)
     return Result(ResultType::FETCH_ERROR);
 
   // Check local cache
-  return this->dataPtr->cache->MatchingWorld(id);
+  bool found = this->dataPtr->cache->MatchingWorld(id);
+  FuelClientPrivate::RecordLookup(found);
+  return found;
 }
 
 //////////////////////////////////////////////////
@@ -1533,6 +1419,7 @@ Result FuelClient::CachedWorld(const common::URI &_worldUrl,
 
   // Check local cache
   auto success = this->dataPtr->cache->MatchingWorld(id);
+  FuelClientPrivate::RecordLookup(success);
   if (success)
   {
     _path = id.LocalPath();
@@ -1559,9 +1446,13 @@ Result FuelClient::CachedModelFile(const common::URI &_fileUrl,
   auto modelIter = this->dataPtr->cache->MatchingModel(id);
 
   if (!modelIter)
+  {
+    FuelClientPrivate::RecordLookup(false);
     return Result(ResultType::FETCH_ERROR);
+  }
 
   auto modelPath = modelIter.PathToModel();
+  std::string relPath = filePath;
 
   // Check if file exists
   filePath = common::joinPaths(modelPath, filePath);
@@ -1572,7 +1463,29 @@ Result FuelClient::CachedModelFile(const common::URI &_fileUrl,
     sTemp = gz::common::joinPaths(sTemp, s);
   filePath = sTemp;
 
-  if (common::exists(filePath))
+  // Models saved in archive mode extract their files on demand, and files
+  // left out by the extraction filter are fetched on demand
+  bool found = common::exists(filePath) ||
+    this->dataPtr->cache->MaterializeFile(modelPath, relPath);
+  if (!found && this->dataPtr->cache->IsExcluded(modelPath, relPath))
+  {
+    // Files of models in read-only layers are fetched to the cache location
+    filePath = this->dataPtr->cache->FetchedFilePath(modelPath, relPath);
+    found = !filePath.empty() && common::exists(filePath);
+    if (!found && !filePath.empty())
+    {
+      ModelIdentifier cachedId = modelIter.Identification();
+      common::URIPath route;
+      route = route / cachedId.Owner() / "models" / cachedId.Name() /
+          cachedId.VersionStr() / "files" / relPath;
+      std::vector<std::string> headers;
+      this->AddServerConfigParametersToHeaders(id.Server(), headers);
+      found = this->dataPtr->FetchExcludedFile(id.Server(), route, headers,
+          filePath);
+    }
+  }
+  FuelClientPrivate::RecordLookup(found);
+  if (found)
   {
     _path = filePath;
     return Result(ResultType::FETCH_ALREADY_EXISTS);
@@ -1598,14 +1511,39 @@ Result FuelClient::CachedWorldFile(const common::URI &_fileUrl,
   auto success = this->dataPtr->cache->MatchingWorld(id);
 
   if (!success)
+  {
+    FuelClientPrivate::RecordLookup(false);
     return Result(ResultType::FETCH_ERROR);
+  }
 
   auto worldPath = id.LocalPath();
+  std::string relPath = filePath;
 
   // Check if file exists
   filePath = common::joinPaths(worldPath, filePath);
 
-  if (common::exists(filePath))
+  // Worlds saved in archive mode extract their files on demand, and files
+  // left out by the extraction filter are fetched on demand
+  bool found = common::exists(filePath) ||
+    this->dataPtr->cache->MaterializeFile(worldPath, relPath);
+  if (!found && this->dataPtr->cache->IsExcluded(worldPath, relPath))
+  {
+    // Files of worlds in read-only layers are fetched to the cache location
+    filePath = this->dataPtr->cache->FetchedFilePath(worldPath, relPath);
+    found = !filePath.empty() && common::exists(filePath);
+    if (!found && !filePath.empty())
+    {
+      common::URIPath route;
+      route = route / id.Owner() / "worlds" / id.Name() / id.VersionStr() /
+          "files" / relPath;
+      std::vector<std::string> headers;
+      this->AddServerConfigParametersToHeaders(id.Server(), headers);
+      found = this->dataPtr->FetchExcludedFile(id.Server(), route, headers,
+          filePath);
+    }
+  }
+  FuelClientPrivate::RecordLookup(found);
+  if (found)
   {
     _path = filePath;
     return Result(ResultType::FETCH_ALREADY_EXISTS);
@@ -1956,9 +1894,48 @@ bool FuelClient::UpdateWorlds(const std::vector<std::string> &_headers)
   return true;
 }
 
+//////////////////////////////////////////////////
+void FuelClientPrivate::DownloadZip(const RestResponse &_resp,
+    std::string &_zip, std::string &_dir, const ExtractFilter &_filter)
+{
+  _dir.clear();
+
+  // Only the request following a referral link can be streamed, other
+  // responses have been received already
+  auto contentTypeIter = _resp.headers.find("Content-Type");
+  bool referral = contentTypeIter != _resp.headers.end() &&
+      contentTypeIter->second.find("text/plain") != std::string::npos;
+  if (!referral || !this->config.StreamingExtract() ||
+      this->config.CacheArchiveMode() || !_filter.Empty())
+  {
+    this->ZipFromResponse(_resp, _zip);
+    return;
+  }
+
+  // The archive is decompressed from curl's write callback, so extraction
+  // overlaps with the transfer instead of following it
+  std::string stagingDir = this->cache->StagingDirectory();
+  StreamingUnzip unzip(stagingDir, this->config.ExtractSyncBatch());
+  this->ZipFromResponse(_resp, _zip,
+      [&unzip](const char *_data, std::size_t _size)
+      {
+        return unzip.Write(_data, _size);
+      });
+
+  if (!_zip.empty() && unzip.Finish(_zip.data(), _zip.size()))
+  {
+    _dir = stagingDir;
+    return;
+  }
+
+  common::removeAll(stagingDir);
+  common::removeDirectory(common::parentPath(stagingDir));
+}
+
 //////////////////////////////////////////////////
 void FuelClientPrivate::ZipFromResponse(const RestResponse &_resp,
-    std::string &_zip)
+    std::string &_zip,
+    const std::function<bool(const char *, std::size_t)> &_dataCallback)
 {
   // Check the content-type which could be empty (ideally not):
   //   * text/plain indicates the data is a download link.
@@ -1977,7 +1954,7 @@ void FuelClientPrivate::ZipFromResponse(const RestResponse &_resp,
       {
         gzdbg << "Downloading from a referral link [" << linkUri << "]\n";
         // Get the zip data.
-        RestResponse linkResp = rest.Request(HttpMethod::GET,
+        RestResponse linkResp = this->rest.Request(HttpMethod::GET,
             // URL
             linkUri,
             // Version
@@ -1989,9 +1966,13 @@ void FuelClientPrivate::ZipFromResponse(const RestResponse &_resp,
             // Headers
             {},
             // Data
-            "");
+            "",
+            // Form
+            {},
+            // Data callback
+            _dataCallback);
 
-        return this->ZipFromResponse(linkResp, _zip);
+        return this->ZipFromResponse(linkResp, _zip, _dataCallback);
       }
       else
       {
@@ -2018,5 +1999,85 @@ void FuelClientPrivate::ZipFromResponse(const RestResponse &_resp,
     _zip = std::move(_resp.data);
   }
 }
-}  // namespace gz::fuel_tools
+//////////////////////////////////////////////////
+void FuelClientPrivate::RecordLookup(bool _hit)
+{
+  auto &stats = CacheStatisticsRecorder::Instance();
+  stats.Add(CacheStatisticsRecorder::Counter::LOOKUPS);
+  stats.Add(_hit ? CacheStatisticsRecorder::Counter::HITS :
+                   CacheStatisticsRecorder::Counter::MISSES);
+}
+
+//////////////////////////////////////////////////
+bool FuelClientPrivate::FetchExcludedFile(const ServerConfig &_server,
+    const common::URIPath &_route, const std::vector<std::string> &_headers,
+    const std::string &_dst)
+{
+  gzmsg << "Fetching [" << _route.Str() << "], left out of the cache by "
+        << "the extraction filter" << std::endl;
+  auto start = std::chrono::steady_clock::now();
+  RestResponse resp = this->rest.Request(HttpMethod::GET,
+      _server.Url().Str(), _server.Version(), _route.Str(), {}, _headers, "");
+  if (resp.statusCode != 200)
+  {
+    gzerr << "Failed to fetch file." << std::endl
+          << "  Server: " << _server.Url().Str() << std::endl
+          << "  Route: " << _route.Str() << std::endl
+          << "  REST response code: " << resp.statusCode << std::endl;
+    RecordDownload(start, 0u);
+    return false;
+  }
+  RecordDownload(start, resp.data.size());
+  return this->cache->SaveFetchedFile(_dst, resp.data);
+}
+
+//////////////////////////////////////////////////
+void FuelClientPrivate::RecordDownload(
+    std::chrono::steady_clock::time_point _start, std::size_t _bytes)
+{
+  auto &stats = CacheStatisticsRecorder::Instance();
+  stats.Record(CacheStatisticsRecorder::Timer::DOWNLOAD,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _start));
+  if (_bytes == 0u)
+  {
+    stats.Add(CacheStatisticsRecorder::Counter::DOWNLOAD_FAILURES);
+    return;
+  }
+  stats.Add(CacheStatisticsRecorder::Counter::DOWNLOADS);
+  stats.Add(CacheStatisticsRecorder::Counter::BYTES_DOWNLOADED, _bytes);
+}
 
+//////////////////////////////////////////////////
+std::future<CacheGcReport> FuelClient::CollectCacheGarbage(
+    const CacheGcPolicy &_policy) const
+{
+  return std::async(std::launch::async,
+      [config = this->dataPtr->config,
+       jobs = this->dataPtr->cache->Jobs(), _policy]()
+      {
+        LocalCache cache(&config);
+        cache.SetJobs(jobs);
+        return cache.CollectGarbage(_policy);
+      });
+}
+
+//////////////////////////////////////////////////
+std::string FuelClient::ResolveUri(const std::string &_uri,
+    const std::string &_resourcePath)
+{
+  return this->dataPtr->cache->ResolveUri(_resourcePath, _uri);
+}
+
+//////////////////////////////////////////////////
+CacheStatistics FuelClient::CacheStats()
+{
+  return CacheStatisticsRecorder::Instance().Snapshot();
+}
+
+//////////////////////////////////////////////////
+void FuelClient::ResetCacheStats()
+{
+  CacheStatisticsRecorder::Instance().Reset();
+}
+}  // namespace gz::fuel_tools
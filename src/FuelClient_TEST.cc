@@ -16,7 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <fstream>
+#include <future>
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include <gz/utils/ExtraTestMacros.hh>
@@ -26,6 +28,7 @@
 #include "gz/fuel_tools/Helpers.hh"
 #include "gz/fuel_tools/Result.hh"
 #include "gz/fuel_tools/WorldIdentifier.hh"
+#include "gz/fuel_tools/Zip.hh"
 
 #include <gz/common/testing/TestPaths.hh>
 
@@ -825,6 +828,143 @@ TEST_F(FuelClientTest, CachedModel)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(FuelClientTest, CacheStats)
+{
+  ClientConfig config;
+  config.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  createLocalModel(config);
+
+  FuelClient client(config);
+  FuelClient::ResetCacheStats();
+
+  std::string path;
+  EXPECT_TRUE(client.CachedModel(common::URI(
+      "http://localhost:8007/1.0/alice/models/My Model", true), path));
+  EXPECT_TRUE(client.CachedModelFile(common::URI(
+      "http://localhost:8007/1.0/alice/models/My Model/tip/files/model.sdf",
+      true), path));
+  EXPECT_FALSE(client.CachedModel(common::URI(
+      "http://localhost:8007/1.0/alice/models/Banana", true), path));
+  EXPECT_FALSE(client.CachedModelFile(common::URI(
+      "http://localhost:8007/1.0/alice/models/My Model/tip/files/"
+      "banana.dae", true), path));
+
+  // Invalid URLs are not lookups
+  EXPECT_FALSE(client.CachedModel(common::URI("banana"), path));
+
+  auto stats = FuelClient::CacheStats();
+  EXPECT_EQ(4u, stats.lookups);
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(2u, stats.misses);
+  EXPECT_DOUBLE_EQ(0.5, stats.HitRate());
+
+  // Failed downloads are recorded too
+  ModelIdentifier modelId;
+  modelId.SetOwner("alice");
+  modelId.SetName("Banana");
+  ServerConfig badServer;
+  badServer.SetUrl(common::URI("http://localhost:1"));
+  modelId.SetServer(badServer);
+  EXPECT_FALSE(client.DownloadModel(modelId));
+  stats = FuelClient::CacheStats();
+  EXPECT_EQ(0u, stats.downloads);
+  EXPECT_EQ(1u, stats.downloadFailures);
+  EXPECT_EQ(1u, stats.downloadTime.count);
+
+  FuelClient::ResetCacheStats();
+  stats = FuelClient::CacheStats();
+  EXPECT_EQ(0u, stats.lookups);
+  EXPECT_EQ(0u, stats.downloadFailures);
+}
+
+/////////////////////////////////////////////////
+TEST_F(FuelClientTest, CollectCacheGarbage)
+{
+  ClientConfig config;
+  config.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  createLocalModel(config);
+
+  auto modelPath = common::joinPaths(common::cwd(), "test_cache",
+      sanitizeAuthority("localhost:8007"), "alice", "models", "My Model");
+
+  std::future<CacheGcReport> future;
+  {
+    FuelClient client(config);
+    CacheGcPolicy policy;
+    policy.keepUsedWithin = std::chrono::seconds(0);
+    future = client.CollectCacheGarbage(policy);
+  }
+
+  // The collection outlives the client
+  auto report = future.get();
+  EXPECT_TRUE(report.complete);
+  EXPECT_EQ(1u, report.removedVersions);
+  EXPECT_FALSE(common::exists(common::joinPaths(modelPath, "2")));
+  EXPECT_TRUE(common::isDirectory(common::joinPaths(modelPath, "3")));
+}
+
+/////////////////////////////////////////////////
+TEST_F(FuelClientTest, LocalMirror)
+{
+  // A mirror laid out like the REST API
+  auto apiRoot = common::joinPaths(common::cwd(), "mirror", "1.0");
+  auto modelRoot = common::joinPaths(apiRoot, "alice", "models", "Box");
+  ASSERT_TRUE(common::createDirectories(common::joinPaths(modelRoot, "3")));
+  ASSERT_TRUE(common::createDirectories(common::joinPaths(apiRoot, "models")));
+  ASSERT_TRUE(common::createDirectories(common::joinPaths("src", "Box")));
+  {
+    std::ofstream fout(common::joinPaths("src", "Box", "model.config"));
+    fout << "<?xml version=\"1.0\"?><model><name>Box</name></model>";
+  }
+  ASSERT_TRUE(Zip::Compress(common::joinPaths("src", "Box"),
+      common::joinPaths(modelRoot, "3", "Box.zip")));
+  {
+    std::ofstream fout(common::joinPaths(modelRoot, "index.json"));
+    fout << "{\"name\":\"Box\",\"owner\":\"alice\",\"version\":3,"
+         << "\"description\":\"A box\"}";
+  }
+  {
+    std::ofstream fout(common::joinPaths(apiRoot, "models", "index.json"));
+    fout << "[{\"name\":\"Box\",\"owner\":\"alice\"}]";
+  }
+
+  std::string url = "file://" + common::joinPaths(common::cwd(), "mirror");
+  common::copyToUnixPath(url);
+  ServerConfig server;
+  server.SetUrl(common::URI(url, true));
+
+  ClientConfig config;
+  config.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  config.AddServer(server);
+  FuelClient client(config);
+
+  ModelIdentifier id;
+  id.SetServer(server);
+  id.SetOwner("alice");
+  id.SetName("Box");
+
+  // Details
+  ModelIdentifier details;
+  ASSERT_TRUE(client.ModelDetails(id, details));
+  EXPECT_EQ("A box", details.Description());
+  EXPECT_EQ(3u, details.Version());
+
+  // Listing
+  ModelIter iter = client.Models(server);
+  ASSERT_TRUE(iter);
+  EXPECT_EQ("Box", iter->Identification().Name());
+  ++iter;
+  EXPECT_FALSE(iter);
+
+  // Download of the latest version
+  ASSERT_TRUE(client.DownloadModel(id));
+  std::string path;
+  id.SetVersion(3);
+  ASSERT_TRUE(client.CachedModel(id, path));
+  EXPECT_TRUE(common::isFile(common::joinPaths(path, "Box", "model.config")));
+}
+
 /////////////////////////////////////////////////
 /// \brief Nothing crashes
 TEST_F(FuelClientTest, ParseWorldUrl)
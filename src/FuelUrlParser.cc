@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstddef>
+#include <string_view>
+
+#include "FuelUrlParser.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /// \brief Character classes used by the shapes.
+  enum class CharClass
+  {
+    /// \brief [[:alnum:].+-]
+    SCHEME,
+
+    /// \brief [^/\s]
+    SEGMENT,
+
+    /// \brief [^/]
+    NOT_SLASH,
+
+    /// \brief /
+    SLASH,
+
+    /// \brief . which excludes line terminators
+    ANY,
+  };
+
+  /// \brief Kinds of elements.
+  enum class Op
+  {
+    /// \brief A run of a character class, greedy.
+    RUN,
+
+    /// \brief A literal string.
+    LITERAL,
+
+    /// \brief The optional API version, ([0-9]+[.][0-9]+)?
+    API_VERSION,
+
+    /// \brief The resource version, ([0-9]*|tip)
+    VERSION,
+  };
+
+  /// \brief Element of a shape.
+  struct Element
+  {
+    /// \brief Kind of element.
+    Op op;
+
+    /// \brief Character class of a run.
+    CharClass cls;
+
+    /// \brief Minimum length of a run.
+    std::size_t min;
+
+    /// \brief Maximum length of a run, 0 for no limit.
+    std::size_t max;
+
+    /// \brief Literal string.
+    std::string_view literal;
+
+    /// \brief Part captured by the element, nullptr if none.
+    std::string_view FuelUrlParts::*capture;
+  };
+
+  /// \brief A run of a class.
+  constexpr Element run(CharClass _cls, std::size_t _min, std::size_t _max,
+      std::string_view FuelUrlParts::*_capture = nullptr)
+  {
+    return {Op::RUN, _cls, _min, _max, {}, _capture};
+  }
+
+  /// \brief A literal.
+  constexpr Element literal(std::string_view _literal)
+  {
+    return {Op::LITERAL, CharClass::ANY, 0, 0, _literal, nullptr};
+  }
+
+  /// \brief Scheme, server and optional API version shared by all shapes:
+  /// ^([[:alnum:]\.\+\-]+):\/\/([^\/\s]+)\/+([0-9]+[.][0-9]+)?\/*
+  #define GZ_FUEL_URL_PREFIX \
+    run(CharClass::SCHEME, 1, 0, &FuelUrlParts::scheme), \
+    literal("://"), \
+    run(CharClass::SEGMENT, 1, 0, &FuelUrlParts::server), \
+    run(CharClass::SLASH, 1, 0), \
+    Element{Op::API_VERSION, CharClass::ANY, 0, 0, {}, \
+        &FuelUrlParts::apiVersion}, \
+    run(CharClass::SLASH, 0, 0), \
+    run(CharClass::SEGMENT, 1, 0, &FuelUrlParts::owner), \
+    run(CharClass::SLASH, 1, 0)
+
+  /// \brief ([0-9]*|tip)
+  constexpr Element kVersion{Op::VERSION, CharClass::ANY, 0, 0, {},
+      &FuelUrlParts::version};
+
+  /// \brief models\/+([^\/]+)\/*([0-9]*|tip)/?
+  constexpr Element kModel[] = {
+    GZ_FUEL_URL_PREFIX,
+    literal("models"),
+    run(CharClass::SLASH, 1, 0),
+    run(CharClass::NOT_SLASH, 1, 0, &FuelUrlParts::name),
+    run(CharClass::SLASH, 0, 0),
+    kVersion,
+    run(CharClass::SLASH, 0, 1),
+  };
+
+  /// \brief worlds\/+([^\/]+)\/*([0-9]*|tip)/?
+  constexpr Element kWorld[] = {
+    GZ_FUEL_URL_PREFIX,
+    literal("worlds"),
+    run(CharClass::SLASH, 1, 0),
+    run(CharClass::NOT_SLASH, 1, 0, &FuelUrlParts::name),
+    run(CharClass::SLASH, 0, 0),
+    kVersion,
+    run(CharClass::SLASH, 0, 1),
+  };
+
+  /// \brief models\/+([^\/]+)\/+([0-9]*|tip)\/+files\/+(.*)/?
+  constexpr Element kModelFile[] = {
+    GZ_FUEL_URL_PREFIX,
+    literal("models"),
+    run(CharClass::SLASH, 1, 0),
+    run(CharClass::NOT_SLASH, 1, 0, &FuelUrlParts::name),
+    run(CharClass::SLASH, 1, 0),
+    kVersion,
+    run(CharClass::SLASH, 1, 0),
+    literal("files"),
+    run(CharClass::SLASH, 1, 0),
+    run(CharClass::ANY, 0, 0, &FuelUrlParts::file),
+    run(CharClass::SLASH, 0, 1),
+  };
+
+  /// \brief worlds\/+([^\/]+)\/+([0-9]*|tip)\/+files\/+(.*)/?
+  constexpr Element kWorldFile[] = {
+    GZ_FUEL_URL_PREFIX,
+    literal("worlds"),
+    run(CharClass::SLASH, 1, 0),
+    run(CharClass::NOT_SLASH, 1, 0, &FuelUrlParts::name),
+    run(CharClass::SLASH, 1, 0),
+    kVersion,
+    run(CharClass::SLASH, 1, 0),
+    literal("files"),
+    run(CharClass::SLASH, 1, 0),
+    run(CharClass::ANY, 0, 0, &FuelUrlParts::file),
+    run(CharClass::SLASH, 0, 1),
+  };
+
+  /// \brief collections\/+([^\/]+)\/*
+  constexpr Element kCollection[] = {
+    GZ_FUEL_URL_PREFIX,
+    literal("collections"),
+    run(CharClass::SLASH, 1, 0),
+    run(CharClass::NOT_SLASH, 1, 0, &FuelUrlParts::name),
+    run(CharClass::SLASH, 0, 0),
+  };
+
+  #undef GZ_FUEL_URL_PREFIX
+
+  //////////////////////////////////////////////////
+  /// \brief Whether a character is a digit.
+  bool isDigit(char _c)
+  {
+    return _c >= '0' && _c <= '9';
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Whether a character belongs to a class, as the "C" locale
+  /// classifies it.
+  bool inClass(CharClass _cls, char _c)
+  {
+    switch (_cls)
+    {
+      case CharClass::SCHEME:
+        return isDigit(_c) || (_c >= 'a' && _c <= 'z') ||
+            (_c >= 'A' && _c <= 'Z') || _c == '.' || _c == '+' || _c == '-';
+      case CharClass::SEGMENT:
+        return _c != '/' && _c != ' ' && _c != '\t' && _c != '\n' &&
+            _c != '\v' && _c != '\f' && _c != '\r';
+      case CharClass::NOT_SLASH:
+        return _c != '/';
+      case CharClass::SLASH:
+        return _c == '/';
+      case CharClass::ANY:
+      default:
+        return _c != '\n' && _c != '\r';
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Length of the run of a class starting at a position.
+  std::size_t runLength(CharClass _cls, std::string_view _s, std::size_t _pos,
+      std::size_t _max)
+  {
+    std::size_t end = _pos;
+    while (end < _s.size() && (_max == 0 || end - _pos < _max) &&
+           inClass(_cls, _s[end]))
+    {
+      ++end;
+    }
+    return end - _pos;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Match elements from a position, trying the alternatives of
+  /// each element in the order of an ECMAScript backtracking matcher:
+  /// greedy runs from longest to shortest, optional groups before skipping
+  /// them, and alternations from left to right.
+  /// \param[in] _elems Elements of the shape.
+  /// \param[in] _count Number of elements.
+  /// \param[in] _i Index of the element to match.
+  /// \param[in] _s URL.
+  /// \param[in] _pos Position in the URL.
+  /// \param[out] _parts Captured parts.
+  /// \return True if the rest of the URL matches the rest of the elements.
+  bool matchFrom(const Element *_elems, std::size_t _count, std::size_t _i,
+      std::string_view _s, std::size_t _pos, FuelUrlParts &_parts)
+  {
+    if (_i == _count)
+      return _pos == _s.size();
+
+    const Element &elem = _elems[_i];
+    auto next = [&](std::size_t _end)
+    {
+      if (elem.capture)
+        _parts.*(elem.capture) = _s.substr(_pos, _end - _pos);
+      return matchFrom(_elems, _count, _i + 1, _s, _end, _parts);
+    };
+
+    switch (elem.op)
+    {
+      case Op::RUN:
+      {
+        std::size_t len = runLength(elem.cls, _s, _pos, elem.max);
+        if (len < elem.min)
+          return false;
+        for (std::size_t n = len + 1; n-- > elem.min;)
+        {
+          if (next(_pos + n))
+            return true;
+        }
+        return false;
+      }
+      case Op::LITERAL:
+      {
+        if (_s.substr(_pos, elem.literal.size()) != elem.literal)
+          return false;
+        return matchFrom(_elems, _count, _i + 1, _s,
+            _pos + elem.literal.size(), _parts);
+      }
+      case Op::API_VERSION:
+      {
+        // [0-9]+ can only be followed by [.] at its longest
+        std::size_t major = 0;
+        while (_pos + major < _s.size() && isDigit(_s[_pos + major]))
+          ++major;
+        std::size_t dot = _pos + major;
+        if (major > 0 && dot < _s.size() && _s[dot] == '.')
+        {
+          std::size_t minor = 0;
+          while (dot + 1 + minor < _s.size() && isDigit(_s[dot + 1 + minor]))
+            ++minor;
+          for (std::size_t n = minor; n > 0; --n)
+          {
+            if (next(dot + 1 + n))
+              return true;
+          }
+        }
+
+        // Skip the group, leaving it unmatched
+        _parts.apiVersion = {};
+        return matchFrom(_elems, _count, _i + 1, _s, _pos, _parts);
+      }
+      case Op::VERSION:
+      {
+        std::size_t digits = 0;
+        while (_pos + digits < _s.size() && isDigit(_s[_pos + digits]))
+          ++digits;
+        for (std::size_t n = digits + 1; n-- > 0;)
+        {
+          if (next(_pos + n))
+            return true;
+        }
+        if (_s.substr(_pos, 3) == "tip")
+          return next(_pos + 3);
+        return false;
+      }
+    }
+    return false;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Match a shape.
+  template<std::size_t N>
+  bool matchShape(const Element (&_elems)[N], std::string_view _url,
+      FuelUrlParts &_parts)
+  {
+    _parts = FuelUrlParts();
+    if (!matchFrom(_elems, N, 0, _url, 0, _parts))
+    {
+      _parts = FuelUrlParts();
+      return false;
+    }
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Keywords a URL has between slashes, which the shapes require.
+  struct Keywords
+  {
+    /// \brief "/models/"
+    bool models{false};
+
+    /// \brief "/worlds/"
+    bool worlds{false};
+
+    /// \brief "/files/"
+    bool files{false};
+
+    /// \brief "/collections/"
+    bool collections{false};
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Find the keywords of a URL in a single scan of its segments.
+  Keywords findKeywords(std::string_view _url)
+  {
+    Keywords result;
+    std::size_t start = _url.find('/');
+    while (start != std::string_view::npos)
+    {
+      std::size_t end = _url.find('/', start + 1);
+      if (end == std::string_view::npos)
+        break;
+
+      std::string_view segment = _url.substr(start + 1, end - start - 1);
+      if (segment == "models")
+        result.models = true;
+      else if (segment == "worlds")
+        result.worlds = true;
+      else if (segment == "files")
+        result.files = true;
+      else if (segment == "collections")
+        result.collections = true;
+      start = end;
+    }
+    return result;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Match a URL against one shape, skipping shapes whose
+  /// keywords it doesn't have.
+  bool matchType(FuelUrlType _type, std::string_view _url,
+      const Keywords &_keywords, FuelUrlParts &_parts)
+  {
+    switch (_type)
+    {
+      case FuelUrlType::MODEL:
+        return _keywords.models && matchShape(kModel, _url, _parts);
+      case FuelUrlType::WORLD:
+        return _keywords.worlds && matchShape(kWorld, _url, _parts);
+      case FuelUrlType::MODEL_FILE:
+        return _keywords.models && _keywords.files &&
+            matchShape(kModelFile, _url, _parts);
+      case FuelUrlType::WORLD_FILE:
+        return _keywords.worlds && _keywords.files &&
+            matchShape(kWorldFile, _url, _parts);
+      case FuelUrlType::COLLECTION:
+        return _keywords.collections &&
+            matchShape(kCollection, _url, _parts);
+      case FuelUrlType::NONE:
+      default:
+        return false;
+    }
+  }
+
+  /// \brief Order in which Classify tries the shapes, which is the order
+  /// fetchResource has always resolved URLs in.
+  constexpr FuelUrlType kPriority[] = {
+    FuelUrlType::MODEL,
+    FuelUrlType::MODEL_FILE,
+    FuelUrlType::WORLD,
+    FuelUrlType::WORLD_FILE,
+    FuelUrlType::COLLECTION,
+  };
+}
+
+//////////////////////////////////////////////////
+bool FuelUrlParser::Match(FuelUrlType _type, std::string_view _url,
+    FuelUrlParts &_parts)
+{
+  return matchType(_type, _url, findKeywords(_url), _parts);
+}
+
+//////////////////////////////////////////////////
+FuelUrlType FuelUrlParser::Classify(std::string_view _url,
+    FuelUrlParts &_parts)
+{
+  const Keywords keywords = findKeywords(_url);
+  for (FuelUrlType type : kPriority)
+  {
+    if (matchType(type, _url, keywords, _parts))
+      return type;
+  }
+  _parts = FuelUrlParts();
+  return FuelUrlType::NONE;
+}
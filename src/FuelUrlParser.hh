@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_FUELURLPARSER_HH_
+#define GZ_FUEL_TOOLS_FUELURLPARSER_HH_
+
+#include <string_view>
+
+#include "gz/fuel_tools/Export.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Shapes of Fuel URLs.
+  enum class FuelUrlType
+  {
+    /// \brief Not a Fuel URL.
+    NONE,
+
+    /// \brief A model, e.g. https://server.org/1.0/owner/models/name/2
+    MODEL,
+
+    /// \brief A world, e.g. https://server.org/1.0/owner/worlds/name/2
+    WORLD,
+
+    /// \brief A model file, e.g.
+    /// https://server.org/1.0/owner/models/name/2/files/meshes/mesh.dae
+    MODEL_FILE,
+
+    /// \brief A world file, e.g.
+    /// https://server.org/1.0/owner/worlds/name/2/files/meshes/mesh.dae
+    WORLD_FILE,
+
+    /// \brief A collection, e.g.
+    /// https://server.org/1.0/owner/collections/name
+    COLLECTION,
+  };
+
+  /// \brief Parts of a Fuel URL. The parts are views into the parsed URL,
+  /// empty when a shape doesn't have them.
+  struct FuelUrlParts
+  {
+    /// \brief Scheme, e.g. "https".
+    std::string_view scheme;
+
+    /// \brief Server authority, e.g. "fuel.gazebosim.org".
+    std::string_view server;
+
+    /// \brief Optional API version, e.g. "1.0".
+    std::string_view apiVersion;
+
+    /// \brief Owner.
+    std::string_view owner;
+
+    /// \brief Name of the model, world or collection.
+    std::string_view name;
+
+    /// \brief Resource version, a number, "tip" or empty.
+    std::string_view version;
+
+    /// \brief Path of the file inside the resource.
+    std::string_view file;
+  };
+
+  /// \brief Parser of Fuel URLs.
+  ///
+  /// Each shape is described by a small table of elements, matched with
+  /// the same backtracking order as the ECMAScript regular expressions the
+  /// parser replaces, so results are identical, including their corner
+  /// cases. Matching doesn't allocate, and a single scan for the keywords
+  /// of the shapes, such as "/models/", rules out the shapes a URL can't
+  /// have before any of them is matched.
+  class GZ_FUEL_TOOLS_VISIBLE FuelUrlParser
+  {
+    /// \brief Match a URL against one shape.
+    /// \param[in] _type Shape to match.
+    /// \param[in] _url Full URL.
+    /// \param[out] _parts Parts of the URL, only valid while _url is.
+    /// \return True if the URL has the shape.
+    public: static bool Match(FuelUrlType _type, std::string_view _url,
+                              FuelUrlParts &_parts);
+
+    /// \brief Find the shape of a URL. A few contrived URLs have more than
+    /// one shape, such as https://server.org/1.0/worlds/models/2, which is
+    /// both model "2" of owner "worlds" and world "models" of owner "1.0".
+    /// The first shape in the order MODEL, MODEL_FILE, WORLD, WORLD_FILE,
+    /// COLLECTION wins.
+    /// \param[in] _url Full URL.
+    /// \param[out] _parts Parts of the URL, only valid while _url is.
+    /// \return Shape of the URL, NONE if it isn't a Fuel URL.
+    public: static FuelUrlType Classify(std::string_view _url,
+                                        FuelUrlParts &_parts);
+  };
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_FUELURLPARSER_HH_
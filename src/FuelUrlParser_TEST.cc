@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "FuelUrlParser.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Regular expressions FuelClient used before the parser, kept as
+/// the reference the parser must agree with.
+static const char kPrefix[] =
+    "^([[:alnum:]\\.\\+\\-]+):\\/\\/"
+    "([^\\/\\s]+)\\/+"
+    "([0-9]+[.][0-9]+)?\\/*"
+    "([^\\/\\s]+)\\/+";
+
+/// \brief Reference regular expression of each shape.
+static const std::vector<std::pair<FuelUrlType, std::string>> kShapes = {
+  {FuelUrlType::MODEL, std::string(kPrefix) +
+      "models\\/+([^\\/]+)\\/*([0-9]*|tip)/?"},
+  {FuelUrlType::WORLD, std::string(kPrefix) +
+      "worlds\\/+([^\\/]+)\\/*([0-9]*|tip)/?"},
+  {FuelUrlType::MODEL_FILE, std::string(kPrefix) +
+      "models\\/+([^\\/]+)\\/+([0-9]*|tip)\\/+files\\/+(.*)/?"},
+  {FuelUrlType::WORLD_FILE, std::string(kPrefix) +
+      "worlds\\/+([^\\/]+)\\/+([0-9]*|tip)\\/+files\\/+(.*)/?"},
+  {FuelUrlType::COLLECTION, std::string(kPrefix) +
+      "collections\\/+([^\\/]+)\\/*"},
+};
+
+/////////////////////////////////////////////////
+/// \brief Check that the parser and the reference regular expressions
+/// agree on a URL, for every shape, and that Classify picks the first
+/// shape the URL has.
+/// \param[in] _url URL to check.
+void expectParity(const std::string &_url)
+{
+  static const std::vector<std::regex> regexes = []
+  {
+    std::vector<std::regex> result;
+    for (const auto &shape : kShapes)
+      result.emplace_back(shape.second);
+    return result;
+  }();
+
+  static const std::vector<FuelUrlType> priority = {FuelUrlType::MODEL,
+      FuelUrlType::MODEL_FILE, FuelUrlType::WORLD, FuelUrlType::WORLD_FILE,
+      FuelUrlType::COLLECTION};
+
+  std::vector<FuelUrlType> matched;
+  for (std::size_t s = 0; s < kShapes.size(); ++s)
+  {
+    FuelUrlType type = kShapes[s].first;
+    std::smatch match;
+    bool expected = std::regex_match(_url, match, regexes[s]);
+    if (expected)
+      matched.push_back(type);
+
+    FuelUrlParts parts;
+    bool actual = FuelUrlParser::Match(type, _url, parts);
+    ASSERT_EQ(expected, actual) << "[" << _url << "] shape "
+                                << static_cast<int>(type);
+    if (!expected)
+      continue;
+
+    std::vector<std::string_view> captured = {parts.scheme, parts.server,
+        parts.apiVersion, parts.owner, parts.name};
+    if (type != FuelUrlType::COLLECTION)
+      captured.push_back(parts.version);
+    if (type == FuelUrlType::MODEL_FILE || type == FuelUrlType::WORLD_FILE)
+      captured.push_back(parts.file);
+
+    ASSERT_EQ(match.size(), captured.size() + 1) << _url;
+    for (std::size_t i = 0; i < captured.size(); ++i)
+    {
+      EXPECT_EQ(match[i + 1].str(), std::string(captured[i]))
+          << "[" << _url << "] shape " << static_cast<int>(type)
+          << " group " << i + 1;
+    }
+  }
+
+  FuelUrlType expectedType = FuelUrlType::NONE;
+  for (auto type : priority)
+  {
+    if (std::find(matched.begin(), matched.end(), type) != matched.end())
+    {
+      expectedType = type;
+      break;
+    }
+  }
+
+  FuelUrlParts parts;
+  FuelUrlParts matchParts;
+  FuelUrlType actualType = FuelUrlParser::Classify(_url, parts);
+  ASSERT_EQ(expectedType, actualType) << "[" << _url << "]";
+  if (actualType == FuelUrlType::NONE)
+    return;
+
+  FuelUrlParser::Match(actualType, _url, matchParts);
+  EXPECT_EQ(matchParts.owner, parts.owner) << _url;
+  EXPECT_EQ(matchParts.name, parts.name) << _url;
+  EXPECT_EQ(matchParts.version, parts.version) << _url;
+  EXPECT_EQ(matchParts.file, parts.file) << _url;
+}
+
+/////////////////////////////////////////////////
+TEST(FuelUrlParser, Model)
+{
+  FuelUrlParts parts;
+  std::string url = "https://fuel.gazebosim.org/1.0/caguero/models/Beer/2";
+  ASSERT_TRUE(FuelUrlParser::Match(FuelUrlType::MODEL, url, parts));
+  EXPECT_EQ("https", parts.scheme);
+  EXPECT_EQ("fuel.gazebosim.org", parts.server);
+  EXPECT_EQ("1.0", parts.apiVersion);
+  EXPECT_EQ("caguero", parts.owner);
+  EXPECT_EQ("Beer", parts.name);
+  EXPECT_EQ("2", parts.version);
+  EXPECT_TRUE(parts.file.empty());
+
+  EXPECT_FALSE(FuelUrlParser::Match(FuelUrlType::WORLD, url, parts));
+  EXPECT_FALSE(FuelUrlParser::Match(FuelUrlType::MODEL_FILE, url, parts));
+  EXPECT_FALSE(FuelUrlParser::Match(FuelUrlType::NONE, url, parts));
+}
+
+/////////////////////////////////////////////////
+TEST(FuelUrlParser, File)
+{
+  FuelUrlParts parts;
+  std::string url =
+      "https://fuel.gazebosim.org/1.0/o/worlds/w/tip/files/meshes/a.dae";
+  ASSERT_TRUE(FuelUrlParser::Match(FuelUrlType::WORLD_FILE, url, parts));
+  EXPECT_EQ("o", parts.owner);
+  EXPECT_EQ("w", parts.name);
+  EXPECT_EQ("tip", parts.version);
+  EXPECT_EQ("meshes/a.dae", parts.file);
+}
+
+/////////////////////////////////////////////////
+TEST(FuelUrlParser, Classify)
+{
+  FuelUrlParts parts;
+  EXPECT_EQ(FuelUrlType::MODEL, FuelUrlParser::Classify(
+      "https://fuel.gazebosim.org/1.0/caguero/models/Beer/2", parts));
+  EXPECT_EQ("Beer", parts.name);
+
+  EXPECT_EQ(FuelUrlType::MODEL_FILE, FuelUrlParser::Classify(
+      "https://fuel.gazebosim.org/1.0/caguero/models/Beer/2/files/a.dae",
+      parts));
+  EXPECT_EQ("a.dae", parts.file);
+
+  EXPECT_EQ(FuelUrlType::WORLD, FuelUrlParser::Classify(
+      "https://fuel.gazebosim.org/1.0/o/worlds/Empty", parts));
+  EXPECT_EQ(FuelUrlType::WORLD_FILE, FuelUrlParser::Classify(
+      "https://fuel.gazebosim.org/1.0/o/worlds/Empty/1/files/a.sdf", parts));
+  EXPECT_EQ(FuelUrlType::COLLECTION, FuelUrlParser::Classify(
+      "https://fuel.gazebosim.org/1.0/o/collections/Coll", parts));
+
+  // Both a model and a world, the model wins
+  EXPECT_EQ(FuelUrlType::MODEL, FuelUrlParser::Classify(
+      "https://server.org/1.0/worlds/models/2", parts));
+  EXPECT_EQ("worlds", parts.owner);
+  EXPECT_EQ("2", parts.name);
+
+  EXPECT_EQ(FuelUrlType::NONE, FuelUrlParser::Classify(
+      "https://fuel.gazebosim.org/1.0/caguero/models", parts));
+  EXPECT_TRUE(parts.owner.empty());
+  EXPECT_EQ(FuelUrlType::NONE, FuelUrlParser::Classify("model://sun", parts));
+}
+
+/////////////////////////////////////////////////
+TEST(FuelUrlParser, ParityCorpus)
+{
+  const std::vector<std::string> urls = {
+    "https://fuel.gazebosim.org/1.0/caguero/models/Beer/2",
+    "https://fuel.gazebosim.org/1.0/caguero/models/Beer",
+    "https://fuel.gazebosim.org/1.0/caguero/models/Beer/",
+    "https://fuel.gazebosim.org/1.0/caguero/models/Beer/tip",
+    "https://fuel.gazebosim.org/1.0/caguero/models/Beer/tip/",
+    "https://fuel.gazebosim.org/caguero/models/Beer",
+    "https://fuel.gazebosim.org//1.0//caguero//models//Beer//3//",
+    "https://fuel.gazebosim.org/1.0/OpenRobotics/worlds/Empty/1",
+    "https://fuel.gazebosim.org/1.0/OpenRobotics/worlds/Empty%20World",
+    "https://fuel.gazebosim.org/1.0/o/collections/TestColl",
+    "https://fuel.gazebosim.org/1.0/o/collections/TestColl/",
+    "https://fuel.gazebosim.org/1.0/o/collections/TestColl/extra",
+    "https://server.org/1.0/owner/models/name/1/files/meshes/mesh.dae",
+    "https://server.org/1.0/owner/models/name/tip/files/meshes/mesh.dae",
+    "https://server.org/1.0/owner/models/name//files/model.sdf",
+    "https://server.org/1.0/owner/models/name/files/model.sdf",
+    "https://server.org/1.0/owner/models/name/1/files/",
+    "https://server.org/1.0/owner/models/name/1/files/dir/",
+    "https://server.org/1.0/owner/worlds/name/2/files/a/b/c.sdf",
+    "https://server.org/1.0/owner/models/files/1/files/files",
+    "https://server.org/1.0/models/models/models/1",
+    "https://server.org/1.0/owner/models/Beer2",
+    "https://server.org/1.0/owner/models/Beer/2a",
+    "https://server.org/1.0/owner/models/Beer/tipx",
+    "https://server.org/1.0/owner/models/Beer/123tip",
+    "https://server.org/1.0abc/models/Beer",
+    "https://server.org/1.05/owner/models/Beer",
+    "https://server.org/1.0/models/Beer",
+    "https://server.org/12.34owner/models/Beer",
+    "https://server.org/1./owner/models/Beer",
+    "https://server.org/.1/owner/models/Beer",
+    "https://server.org/1.0.1/owner/models/Beer",
+    "https://server.org/1.0/1.0/models/Beer",
+    "http://localhost:8000/1.0/owner/models/Beer/1",
+    "file://localhost/1.0/owner/models/Beer/1",
+    "file:///1.0/owner/models/Beer/1",
+    "git+ssh://server/owner/models/Beer",
+    "https:/server.org/owner/models/Beer",
+    "://server.org/owner/models/Beer",
+    "ht tps://server.org/owner/models/Beer",
+    "https://ser ver.org/owner/models/Beer",
+    "https://server.org/own er/models/Beer",
+    "https://server.org/owner/models/Be er",
+    "https://server.org/owner/models/Be\ter/1",
+    "https://server.org/owner/models/Beer/1/files/a\nb",
+    "https://server.org/owner/models/Beer/1/files/a\rb",
+    "https://server.org/owner/models/Beer/1/files/a\tb",
+    "https://server.org/owner/models",
+    "https://server.org/owner/models/",
+    "https://server.org/owner/Models/Beer",
+    "https://server.org/owner/models/Beer/1/2",
+    "https://server.org/owner/models/Beer/1//",
+    "https://server.org/owner/models/Beer/1/files",
+    "https://server.org/owner/models/Beer/files/x",
+    "https://server.org/owner/worlds/models/Beer",
+    "",
+    "https://",
+    "models",
+    "/models/",
+    "https://server.org/1.0/worlds/models/2",
+    "https://server.org/1.0/models/worlds/files/1/files/a",
+  };
+  for (const auto &url : urls)
+    expectParity(url);
+}
+
+/////////////////////////////////////////////////
+TEST(FuelUrlParser, ParityRandom)
+{
+  // URLs built from the tokens of the shapes, so a good share of them
+  // match and exercise the backtracking
+  const std::vector<std::string> tokens = {
+    "https", "://", "/", "//", "server.org", "1.0", "1.", "12.345", "0",
+    "42", "tip", "owner", "models", "worlds", "files", "collections", "a.b",
+    " ", "\t", "\n", "x", ":", "+", "-", "%20",
+  };
+
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<std::size_t> pick(0, tokens.size() - 1);
+  std::uniform_int_distribution<int> length(1, 16);
+  for (int i = 0; i < 3000; ++i)
+  {
+    std::string url = "https://server.org/";
+    int count = length(rng);
+    for (int j = 0; j < count; ++j)
+      url += tokens[pick(rng)];
+    expectParity(url);
+  }
+
+  // Mutations of valid URLs
+  const std::vector<std::string> seeds = {
+    "https://fuel.gazebosim.org/1.0/caguero/models/Beer/2/files/a/b.dae",
+    "https://fuel.gazebosim.org/1.0/o/worlds/Empty/tip/files/x.sdf",
+    "https://fuel.gazebosim.org/1.0/o/collections/Coll",
+  };
+  const std::string alphabet = "/.0123tip sx\t";
+  std::uniform_int_distribution<std::size_t> letter(0, alphabet.size() - 1);
+  for (const auto &seed : seeds)
+  {
+    std::uniform_int_distribution<std::size_t> where(0, seed.size() - 1);
+    for (int i = 0; i < 1000; ++i)
+    {
+      std::string url = seed;
+      int edits = length(rng) % 4 + 1;
+      for (int j = 0; j < edits; ++j)
+      {
+        std::size_t pos = where(rng) % url.size();
+        switch (rng() % 3)
+        {
+          case 0:
+            url[pos] = alphabet[letter(rng)];
+            break;
+          case 1:
+            url.insert(pos, 1, alphabet[letter(rng)]);
+            break;
+          default:
+            url.erase(pos, 1);
+            break;
+        }
+      }
+      expectParity(url);
+    }
+  }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include "gz/fuel_tools/Helpers.hh"
+#include "gz/fuel_tools/ServerConfig.hh"
+
+#include "IdentifierKey.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Combine a pointer into a hash.
+  /// \param[in] _seed Hash so far.
+  /// \param[in] _ptr Pointer to combine.
+  /// \return Combined hash.
+  std::size_t combine(std::size_t _seed, const std::string *_ptr)
+  {
+    return _seed ^ (std::hash<const std::string *>{}(_ptr) +
+        0x9e3779b9 + (_seed << 6) + (_seed >> 2));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Hash of the interned components of a key.
+  /// \param[in] _server Server path.
+  /// \param[in] _owner Owner.
+  /// \param[in] _name Name.
+  /// \param[in] _type Resource type.
+  /// \return Combined hash.
+  std::size_t hashKey(const std::string *_server, const std::string *_owner,
+      const std::string *_name, const std::string *_type)
+  {
+    std::size_t seed = combine(0, _server);
+    seed = combine(seed, _owner);
+    seed = combine(seed, _name);
+    return combine(seed, _type);
+  }
+}
+
+//////////////////////////////////////////////////
+const std::string *IdentifierKey::Intern(const std::string &_str)
+{
+  // Nodes of an unordered_set never move, so the addresses stay valid
+  static std::mutex mutex;
+  static std::unordered_set<std::string> pool;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return &*pool.insert(_str).first;
+}
+
+//////////////////////////////////////////////////
+IdentifierKey::IdentifierKey()
+  : server(Intern("")), owner(server), name(server), type(server),
+    hash(hashKey(server, owner, name, type))
+{
+}
+
+//////////////////////////////////////////////////
+IdentifierKey::IdentifierKey(const ModelIdentifier &_id)
+  : server(Intern(uriToPath(_id.Server().Url()))), owner(Intern(_id.Owner())),
+    name(Intern(_id.Name())), type(Intern("models")),
+    hash(hashKey(server, owner, name, type))
+{
+}
+
+//////////////////////////////////////////////////
+IdentifierKey::IdentifierKey(const WorldIdentifier &_id)
+  : server(Intern(uriToPath(_id.Server().Url()))), owner(Intern(_id.Owner())),
+    name(Intern(_id.Name())), type(Intern("worlds")),
+    hash(hashKey(server, owner, name, type))
+{
+}
+
+//////////////////////////////////////////////////
+bool IdentifierKey::operator==(const IdentifierKey &_rhs) const
+{
+  return this->hash == _rhs.hash && this->name == _rhs.name &&
+      this->owner == _rhs.owner && this->server == _rhs.server &&
+      this->type == _rhs.type;
+}
+
+//////////////////////////////////////////////////
+bool IdentifierKey::operator!=(const IdentifierKey &_rhs) const
+{
+  return !(*this == _rhs);
+}
+
+//////////////////////////////////////////////////
+std::size_t IdentifierKey::Hash() const
+{
+  return this->hash;
+}
+
+//////////////////////////////////////////////////
+const std::string &IdentifierKey::Server() const
+{
+  return *this->server;
+}
+
+//////////////////////////////////////////////////
+const std::string &IdentifierKey::Owner() const
+{
+  return *this->owner;
+}
+
+//////////////////////////////////////////////////
+const std::string &IdentifierKey::Name() const
+{
+  return *this->name;
+}
+
+//////////////////////////////////////////////////
+const std::string &IdentifierKey::Type() const
+{
+  return *this->type;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_IDENTIFIERKEY_HH_
+#define GZ_FUEL_TOOLS_IDENTIFIERKEY_HH_
+
+#include <cstddef>
+#include <string>
+
+#include "gz/fuel_tools/Export.hh"
+#include "gz/fuel_tools/ModelIdentifier.hh"
+#include "gz/fuel_tools/WorldIdentifier.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Compact key of a model or world, for sets and maps.
+  ///
+  /// The server, owner and name are interned in a process-wide pool, so
+  /// keys are three pointers and a hash computed once on construction.
+  /// Copying, hashing and comparing keys never allocates. Two keys are
+  /// equal when the identifiers they were built from are equal, so the
+  /// version is ignored.
+  class GZ_FUEL_TOOLS_VISIBLE IdentifierKey
+  {
+    /// \brief Constructor, an empty key.
+    public: IdentifierKey();
+
+    /// \brief Constructor from a model.
+    /// \param[in] _id Model identifier.
+    public: explicit IdentifierKey(const ModelIdentifier &_id);
+
+    /// \brief Constructor from a world.
+    /// \param[in] _id World identifier.
+    public: explicit IdentifierKey(const WorldIdentifier &_id);
+
+    /// \brief Equality operator.
+    /// \param[in] _rhs Key to compare.
+    /// \return True if both keys identify the same resource.
+    public: bool operator==(const IdentifierKey &_rhs) const;
+
+    /// \brief Inequality operator.
+    /// \param[in] _rhs Key to compare.
+    /// \return True if the keys identify different resources.
+    public: bool operator!=(const IdentifierKey &_rhs) const;
+
+    /// \brief Get the hash of the key.
+    /// \return Hash computed on construction.
+    public: std::size_t Hash() const;
+
+    /// \brief Get the server, as a cache path.
+    /// \return Interned server path.
+    public: const std::string &Server() const;
+
+    /// \brief Get the owner.
+    /// \return Interned owner.
+    public: const std::string &Owner() const;
+
+    /// \brief Get the name.
+    /// \return Interned name.
+    public: const std::string &Name() const;
+
+    /// \brief Get the resource type.
+    /// \return "models" or "worlds", empty for an empty key.
+    public: const std::string &Type() const;
+
+    /// \brief Get the interned copy of a string. Interned strings live for
+    /// the whole process, so the pool only holds names that were seen.
+    /// \param[in] _str String to intern.
+    /// \return Interned string, equal strings share the same address.
+    public: static const std::string *Intern(const std::string &_str);
+
+    /// \brief Server path.
+    private: const std::string *server;
+
+    /// \brief Owner.
+    private: const std::string *owner;
+
+    /// \brief Name.
+    private: const std::string *name;
+
+    /// \brief Resource type.
+    private: const std::string *type;
+
+    /// \brief Hash of the components.
+    private: std::size_t hash = 0;
+  };
+
+  /// \brief Hash functor for IdentifierKey.
+  struct IdentifierKeyHash
+  {
+    /// \brief Get the hash of a key.
+    /// \param[in] _key Key to hash.
+    /// \return Hash of the key.
+    std::size_t operator()(const IdentifierKey &_key) const noexcept
+    {
+      return _key.Hash();
+    }
+  };
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_IDENTIFIERKEY_HH_
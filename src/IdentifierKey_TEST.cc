@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_set>
+
+#include "gz/fuel_tools/ModelIdentifier.hh"
+#include "gz/fuel_tools/ServerConfig.hh"
+#include "gz/fuel_tools/WorldIdentifier.hh"
+
+#include "IdentifierKey.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+TEST(IdentifierKey, Intern)
+{
+  std::string a = "alice";
+  std::string b = "ali";
+  b += "ce";
+  EXPECT_EQ(IdentifierKey::Intern(a), IdentifierKey::Intern(b));
+  EXPECT_NE(IdentifierKey::Intern(a), IdentifierKey::Intern("bob"));
+  EXPECT_EQ("alice", *IdentifierKey::Intern(a));
+}
+
+/////////////////////////////////////////////////
+TEST(IdentifierKey, MatchesIdentifierEquality)
+{
+  ServerConfig server;
+  server.SetUrl(common::URI("http://localhost:8007/", true));
+  ServerConfig otherServer;
+  otherServer.SetUrl(common::URI("http://localhost:8008", true));
+
+  ModelIdentifier a;
+  a.SetServer(server);
+  a.SetOwner("alice");
+  a.SetName("My Model");
+  a.SetVersion(2);
+  a.SetDescription("Version 2");
+
+  // The version and details don't matter
+  ModelIdentifier b = a;
+  b.SetVersion(3);
+  b.SetDescription("Version 3");
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(IdentifierKey(a), IdentifierKey(b));
+  EXPECT_EQ(IdentifierKey(a).Hash(), IdentifierKey(b).Hash());
+
+  ModelIdentifier c = a;
+  c.SetName("Other Model");
+  EXPECT_NE(a, c);
+  EXPECT_NE(IdentifierKey(a), IdentifierKey(c));
+
+  ModelIdentifier d = a;
+  d.SetOwner("bob");
+  EXPECT_NE(a, d);
+  EXPECT_NE(IdentifierKey(a), IdentifierKey(d));
+
+  ModelIdentifier e = a;
+  e.SetServer(otherServer);
+  EXPECT_NE(a, e);
+  EXPECT_NE(IdentifierKey(a), IdentifierKey(e));
+
+  // Models and worlds with the same name are different resources
+  WorldIdentifier world;
+  world.SetServer(server);
+  world.SetOwner("alice");
+  world.SetName("My Model");
+  EXPECT_NE(IdentifierKey(a), IdentifierKey(world));
+  EXPECT_EQ("models", IdentifierKey(a).Type());
+  EXPECT_EQ("worlds", IdentifierKey(world).Type());
+
+  IdentifierKey key(a);
+  EXPECT_EQ("localhost%3A8007", key.Server());
+  EXPECT_EQ("alice", key.Owner());
+  EXPECT_EQ("My Model", key.Name());
+
+  std::unordered_set<IdentifierKey, IdentifierKeyHash> keys;
+  EXPECT_TRUE(keys.emplace(a).second);
+  EXPECT_FALSE(keys.emplace(b).second);
+  EXPECT_TRUE(keys.emplace(c).second);
+  EXPECT_TRUE(keys.emplace(world).second);
+  EXPECT_EQ(3u, keys.size());
+
+  IdentifierKey empty;
+  EXPECT_TRUE(empty.Owner().empty());
+  EXPECT_TRUE(empty.Type().empty());
+  EXPECT_EQ(empty, IdentifierKey());
+}
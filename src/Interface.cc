@@ -26,18 +26,56 @@
 
 #include <gz/msgs/fuel_metadata.pb.h>
 
+#include <memory>
+#include <mutex>
+#include <string>
+
 #include <gz/msgs/Utility.hh>
 #include "gz/common/Console.hh"
+#include "gz/fuel_tools/ClientConfig.hh"
 #include "gz/fuel_tools/Interface.hh"
 #include "gz/fuel_tools/WorldIdentifier.hh"
 
+#include "FuelUrlParser.hh"
+#include "MemoryCache.hh"
+
 namespace gz::fuel_tools
 {
+  namespace
+  {
+    /// \brief Mutex guarding the shared client.
+    std::mutex sharedClientMutex;
+
+    /// \brief Client shared by the free functions, null until first use.
+    std::shared_ptr<FuelClient> sharedClientInstance;
+  }
+
+  //////////////////////////////////////////////
+  std::shared_ptr<FuelClient> sharedClient()
+  {
+    std::lock_guard<std::mutex> lock(sharedClientMutex);
+    if (!sharedClientInstance)
+      sharedClientInstance = std::make_shared<FuelClient>();
+    return sharedClientInstance;
+  }
+
+  //////////////////////////////////////////////
+  void resetSharedClient()
+  {
+    std::shared_ptr<FuelClient> previous;
+    {
+      std::lock_guard<std::mutex> lock(sharedClientMutex);
+      previous.swap(sharedClientInstance);
+    }
+    // The previous client is destroyed here, outside of the lock, unless
+    // another thread is still using it
+  }
+
   //////////////////////////////////////////////
   std::string fetchResource(const std::string &_uri)
   {
-    gz::fuel_tools::FuelClient client;
-    return fetchResourceWithClient(_uri, client);
+    auto client = sharedClient();
+    return fetchResourceWithClient(_uri, *client);
   }
 
   //////////////////////////////////////////////
@@ -50,41 +88,107 @@ namespace gz::fuel_tools
     gz::fuel_tools::WorldIdentifier world;
     std::string fileUrl;
     gz::common::URI uri(_uri);
-    // Download the model, if it is a model URI
-    if (_client.ParseModelUrl(uri, model) &&
-        !_client.CachedModel(uri, result))
-    {
-      _client.DownloadModel(uri, result);
-    }
-    // Download the model, if it's a model file URI
-    else if (_client.ParseModelFileUrl(uri, model, fileUrl) &&
-        !_client.CachedModelFile(uri, result))
-    {
-      auto modelUri = _uri.substr(0,
-          _uri.find("files", model.UniqueName().size())-1);
-      _client.DownloadModel(common::URI(modelUri), result);
-      result = common::joinPaths(result, fileUrl);
-    }
-    // Download the world, if it is a world URI
-    else if (_client.ParseWorldUrl(uri, world) &&
-             !_client.CachedWorld(uri, result))
-    {
-      _client.DownloadWorld(uri, result);
-    }
-    // Download the world, if it's a world file URI
-    else if (_client.ParseWorldFileUrl(uri, world, fileUrl) &&
-        !_client.CachedWorldFile(uri, result))
+
+    // Classify the URI once, instead of trying each kind of URL in turn
+    FuelUrlParts parts;
+    switch (FuelUrlParser::Classify(_uri, parts))
     {
-      auto worldUri = _uri.substr(0,
-          _uri.find("files", world.UniqueName().size())-1);
-      _client.DownloadWorld(common::URI(worldUri), result);
-      result = common::joinPaths(result, fileUrl);
+      // Download the model, if it is a model URI
+      case FuelUrlType::MODEL:
+      {
+        if (_client.ParseModelUrl(uri, model) &&
+            !_client.CachedModel(uri, result))
+        {
+          _client.DownloadModel(uri, result);
+        }
+        break;
+      }
+      // Download the model, if it's a model file URI
+      case FuelUrlType::MODEL_FILE:
+      {
+        if (_client.ParseModelFileUrl(uri, model, fileUrl) &&
+            !_client.CachedModelFile(uri, result))
+        {
+          auto modelUri = _uri.substr(0,
+              _uri.find("files", model.UniqueName().size())-1);
+          _client.DownloadModel(common::URI(modelUri), result);
+          result = common::joinPaths(result, fileUrl);
+
+          // In archive mode, only description files are extracted on
+          // download
+          if (!common::exists(result))
+            _client.CachedModelFile(uri, result);
+        }
+        break;
+      }
+      // Download the world, if it is a world URI
+      case FuelUrlType::WORLD:
+      {
+        if (_client.ParseWorldUrl(uri, world) &&
+            !_client.CachedWorld(uri, result))
+        {
+          _client.DownloadWorld(uri, result);
+        }
+        break;
+      }
+      // Download the world, if it's a world file URI
+      case FuelUrlType::WORLD_FILE:
+      {
+        if (_client.ParseWorldFileUrl(uri, world, fileUrl) &&
+            !_client.CachedWorldFile(uri, result))
+        {
+          auto worldUri = _uri.substr(0,
+              _uri.find("files", world.UniqueName().size())-1);
+          _client.DownloadWorld(common::URI(worldUri), result);
+          result = common::joinPaths(result, fileUrl);
 
+          // In archive mode, only description files are extracted on
+          // download
+          if (!common::exists(result))
+            _client.CachedWorldFile(uri, result);
+        }
+        break;
+      }
+      case FuelUrlType::COLLECTION:
+      case FuelUrlType::NONE:
+      default:
+        break;
     }
 
     return result;
   }
 
+  //////////////////////////////////////////////
+  std::shared_ptr<const FileBuffer> readResource(const std::string &_uri)
+  {
+    auto client = sharedClient();
+    return readResourceWithClient(_uri, *client);
+  }
+
+  //////////////////////////////////////////////
+  std::shared_ptr<const FileBuffer> readResourceWithClient(
+      const std::string &_uri, gz::fuel_tools::FuelClient &_client)
+  {
+    std::string path = fetchResourceWithClient(_uri, _client);
+    if (path.empty() || !common::isFile(path))
+      return nullptr;
+
+    std::size_t capacity = _client.Config().MemoryCacheSize();
+    if (capacity == 0u)
+    {
+      auto buffer = std::make_shared<const FileBuffer>(path);
+      return buffer->Valid() ? buffer : nullptr;
+    }
+    return MemoryCache::Instance().Read(path, capacity);
+  }
+
+  //////////////////////////////////////////////
+  std::string resolveUri(const std::string &_uri,
+      const std::string &_resourcePath)
+  {
+    return sharedClient()->ResolveUri(_uri, _resourcePath);
+  }
+
   //////////////////////////////////////////////
   std::string sdfFromPath(const std::string &_path)
   {
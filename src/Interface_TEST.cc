@@ -16,8 +16,10 @@
 */
 
 #include <gtest/gtest.h>
+#include <fstream>
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 #include "gz/fuel_tools/ClientConfig.hh"
 #include "gz/fuel_tools/FuelClient.hh"
@@ -283,3 +285,78 @@ TEST_F(InterfaceTest, FetchResources)
      }
   }
 }
+
+/////////////////////////////////////////////////
+TEST_F(InterfaceTest, ReadResource)
+{
+  ClientConfig config;
+  config.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  config.SetMemoryCacheSize(1024u * 1024u);
+  FuelClient client(config);
+
+  // A model already in the cache
+  std::string modelPath = common::joinPaths(common::cwd(), "test_cache",
+      "fuel.gazebosim.org", "alice", "models", "box", "1");
+  ASSERT_TRUE(common::createDirectories(common::joinPaths(modelPath,
+      "meshes")));
+  {
+    std::ofstream fout(common::joinPaths(modelPath, "model.config"));
+    fout << "<?xml version=\"1.0\"?>";
+  }
+  {
+    std::ofstream fout(common::joinPaths(modelPath, "meshes", "box.dae"));
+    fout << "<COLLADA/>";
+  }
+
+  const std::string fileUrl =
+    "https://fuel.gazebosim.org/1.0/alice/models/box/1/files/meshes/box.dae";
+  auto first = readResourceWithClient(fileUrl, client);
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ("<COLLADA/>", first->View());
+  EXPECT_EQ(common::joinPaths(modelPath, "meshes", "box.dae"),
+      first->Path());
+
+  // The second read is served from memory
+  auto stats = FuelClient::CacheStats();
+  auto second = readResourceWithClient(fileUrl, client);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(stats.memoryHits + 1u, FuelClient::CacheStats().memoryHits);
+
+  // Directories can't be read
+  EXPECT_EQ(nullptr, readResourceWithClient(
+      "https://fuel.gazebosim.org/1.0/alice/models/box/1", client));
+}
+
+/////////////////////////////////////////////////
+TEST_F(InterfaceTest, SharedClient)
+{
+  std::string cachePath = common::joinPaths(common::cwd(), "test_cache");
+  ASSERT_TRUE(common::setenv("GZ_FUEL_CACHE_PATH", cachePath));
+  resetSharedClient();
+
+  auto client = sharedClient();
+  ASSERT_NE(nullptr, client);
+  EXPECT_EQ(client, sharedClient());
+  EXPECT_EQ(cachePath, client->Config().CacheLocation());
+
+  // A model already in the cache is resolved by the shared client
+  std::string modelPath = common::joinPaths(cachePath,
+      "fuel.gazebosim.org", "alice", "models", "box", "1");
+  ASSERT_TRUE(common::createDirectories(modelPath));
+  {
+    std::ofstream fout(common::joinPaths(modelPath, "model.config"));
+    fout << "<?xml version=\"1.0\"?>";
+  }
+  EXPECT_EQ(modelPath,
+      fetchResource("https://fuel.gazebosim.org/1.0/alice/models/box/1"));
+
+  // Reset picks up the new environment, the old client stays usable
+  ASSERT_TRUE(common::unsetenv("GZ_FUEL_CACHE_PATH"));
+  resetSharedClient();
+  auto other = sharedClient();
+  EXPECT_NE(client, other);
+  EXPECT_NE(cachePath, other->Config().CacheLocation());
+  EXPECT_EQ(cachePath, client->Config().CacheLocation());
+
+  resetSharedClient();
+}
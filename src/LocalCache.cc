@@ -16,25 +16,53 @@
 */
 
 #ifndef _WIN32
+  #include <sys/stat.h>
   #include <unistd.h>
+#else
+  #include <process.h>
+#endif
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable: 4251)  // foo needs to have dll-interface
+#endif
+#include <google/protobuf/text_format.h>
+#if defined(_MSC_VER)
+#pragma warning(pop)
 #endif
 
+#include <gz/msgs/fuel_metadata.pb.h>
 #include <stdio.h>
 #include <tinyxml2.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
 #include <regex>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include <gz/common/StringUtils.hh>
 #include <gz/common/Util.hh>
-#include <gz/math/SemanticVersion.hh>
+#include <gz/msgs/Utility.hh>
 
 #include "gz/fuel_tools/ClientConfig.hh"
+#include "gz/fuel_tools/FileBuffer.hh"
 #include "gz/fuel_tools/Helpers.hh"
 #include "gz/fuel_tools/Zip.hh"
 
@@ -42,6 +70,15 @@
 #include "ModelIterPrivate.hh"
 #include "WorldIterPrivate.hh"
 #include "LocalCache.hh"
+#include "CacheArchive.hh"
+#include "CachePack.hh"
+#include "CacheStatisticsRecorder.hh"
+#include "FuelUrlParser.hh"
+#include "Parallel.hh"
+#include "SdfUriRewriter.hh"
+#include "Sha256.hh"
+
+namespace fs = std::filesystem;
 
 namespace gz::fuel_tools
 {
@@ -51,6 +88,72 @@ class LocalCachePrivate
   /// \param[in] _path A directory for the local server cache
   public: std::vector<Model> ModelsInServer(const std::string &_path) const;
 
+  /// \brief Return all owner directories in a server directory.
+  /// \param[in] _path A directory for the local server cache
+  /// \return Full paths to the owner directories, in directory order.
+  public: std::vector<std::string> OwnersInServer(
+      const std::string &_path) const;
+
+  /// \brief Return all models of a single owner.
+  /// \param[in] _ownerPath Path to an owner directory.
+  /// \param[in] _name Only return models with this name, if not empty.
+  public: std::vector<Model> ModelsInOwner(
+      const std::string &_ownerPath, const std::string &_name = "") const;
+
+  /// \brief Return all worlds of a single owner.
+  /// \param[in] _ownerPath Path to an owner directory.
+  /// \param[in] _name Only return worlds with this name, if not empty.
+  public: std::vector<WorldIdentifier> WorldsInOwner(
+      const std::string &_ownerPath, const std::string &_name = "") const;
+
+  /// \brief Collect the owner directories of several servers, in every
+  /// cache layer.
+  /// \param[in] _servers Servers whose cache directories are listed.
+  /// \param[out] _owners Paths to the owner directories.
+  /// \param[out] _ownerServer Index into _servers for each entry of
+  /// _owners.
+  public: void OwnersInServers(const std::vector<ServerConfig> &_servers,
+              std::vector<std::string> &_owners,
+              std::vector<std::size_t> &_ownerServer) const;
+
+  /// \brief Get the cache directories to search, in lookup order: the
+  /// writable cache location followed by the read-only layers.
+  /// \return Paths of the cache directories.
+  public: std::vector<std::string> CacheRoots() const;
+
+  /// \brief Check whether a path is in the writable cache location rather
+  /// than in a read-only layer.
+  /// \param[in] _path Path to check.
+  /// \return True if the path is in the cache location.
+  public: bool InCacheLocation(const std::string &_path) const;
+
+  /// \brief Check whether a path is a directory or within it. Siblings
+  /// sharing a prefix with the directory, such as <dir>-shared, aren't.
+  /// \param[in] _path Absolute path to check.
+  /// \param[in] _dir Absolute path of the directory.
+  /// \return True if the path is _dir or within it.
+  public: static bool IsWithin(const std::string &_path,
+                               const std::string &_dir);
+
+  /// \brief Scan owner directories in parallel, using at most `jobs`
+  /// threads.
+  /// \param[in] _count Number of owner directories.
+  /// \param[in] _scan Function that scans the owner at a given index.
+  /// \return Concatenation of the results, in index order.
+  public: template<typename T, typename ScanFunc>
+          std::vector<T> ScanOwners(std::size_t _count, ScanFunc _scan) const;
+
+  /// \brief Scan the owners of the configured servers in parallel.
+  /// \param[in] _serverUrl Only scan the server with this URL, if not
+  /// empty.
+  /// \param[in] _owner Only scan the owner with this name, if not empty.
+  /// \param[in] _scan Function that scans an owner directory, given its
+  /// path and server.
+  /// \return Concatenation of the results, in lookup order.
+  public: template<typename T, typename ScanFunc>
+          std::vector<T> ScanMatching(const std::string &_serverUrl,
+              const std::string &_owner, ScanFunc _scan) const;
+
   /// \brief Return all worlds in a given directory
   /// \param[in] _path A directory for the local server cache
   public: std::vector<WorldIdentifier> WorldsInServer(
@@ -59,218 +162,822 @@ class LocalCachePrivate
   /// \brief return all models in a given Owner/models directory
   public: std::vector<Model> ModelsInPath(const std::string &_path);
 
-  /// \brief Associate model:// URI paths with Fuel URLs.
+  /// \brief Move an extracted resource into its versioned directory.
+  /// \param[in] _dir Directory the resource was extracted to, removed if
+  /// the resource can't be installed.
+  /// \param[in] _versionedDir Versioned directory in the cache location.
+  /// \param[in] _overwrite Replace the versioned directory if it exists.
+  /// \return True if the resource was installed.
+  public: bool Install(const std::string &_dir,
+      const std::string &_versionedDir, bool _overwrite);
+
+  /// \brief Rewrite the model:// URIs of a model to Fuel URLs, in the SDF
+  /// files listed in its model.config and every other SDF or URDF file.
   /// \param[in] _modelVersionedDir Directory containing the model.
   /// \param[in] _id Model's Fuel URL.
+  /// \param[out] _changed Number of files rewritten.
   /// \return True if the paths were fixed. False could occur if the
   /// `model.config` file is not present or contains XML errors.
+  /// \sa RewritePaths
   public: bool FixPaths(const std::string &_modelVersionedDir,
-      const ModelIdentifier &_id);
-
-  /// \brief Helper function to fix model:// URI paths in geometry elements.
-  /// \param[in] _geomElem Pointer to the geometry element.
-  /// \param[in] _id Model identifier
-  /// \sa FixPaths
-  public: void FixPathsInGeomElement(tinyxml2::XMLElement *_geomElem,
-              const ModelIdentifier &_id);
-
-  /// \brief Helper function to fix model:// URI paths in material elements.
-  /// \param[in] _matElem Pointer to the material element.
+      const ModelIdentifier &_id, std::size_t &_changed) const;
+
+  /// \brief Rewrite the model:// URIs of every SDF file of a world to Fuel
+  /// URLs.
+  /// \param[in] _worldVersionedDir Directory containing the world.
+  /// \param[in] _id World's Fuel URL.
+  /// \param[out] _changed Number of files rewritten.
+  /// \return True if the paths were fixed.
+  /// \sa RewritePaths
+  public: bool FixPaths(const std::string &_worldVersionedDir,
+      const WorldIdentifier &_id, std::size_t &_changed) const;
+
+  /// \brief Rewrite the URIs of the SDF and URDF files of a resource in
+  /// parallel, then mark it as rewritten. Rewriting is idempotent, so a
+  /// resource that isn't marked can be rewritten again. With lazy URI
+  /// rewriting, the URIs are recorded instead, see RecordUris.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \param[in] _files Files rewritten whatever their extension, relative
+  /// to _versionedDir.
+  /// \param[in] _map Replacement of each URI.
+  /// \param[out] _changed Number of files rewritten.
+  /// \return False if a file couldn't be written, the resource isn't
+  /// marked then.
+  public: bool RewritePaths(const std::string &_versionedDir,
+      const std::vector<std::string> &_files,
+      const SdfUriRewriter::UriMap &_map, std::size_t &_changed) const;
+
+  /// \brief Rewrite the URIs of a file.
+  /// \param[in] _path Path to the file.
+  /// \param[in] _map Replacement of each URI.
+  /// \param[out] _changed Whether the file was rewritten.
+  /// \return False if the file can't be written. Files that can't be read
+  /// or parsed are left as they are.
+  public: static bool RewriteFile(const std::string &_path,
+      const SdfUriRewriter::UriMap &_map, bool &_changed);
+
+  /// \brief Scan files of a resource in parallel and record the
+  /// replacement of their URIs next to the resource, leaving the files as
+  /// they are. The record is written last, so a resource without one can
+  /// be scanned again.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \param[in] _files Files scanned, relative to _versionedDir.
+  /// \param[in] _map Replacement of each URI.
+  /// \return False if the record couldn't be written.
+  /// \sa UrisPath
+  public: bool RecordUris(const std::string &_versionedDir,
+      const std::vector<std::string> &_files,
+      const SdfUriRewriter::UriMap &_map) const;
+
+  /// \brief Collect the replacement of the URIs of a file.
+  /// \param[in] _path Path to the file.
+  /// \param[in] _map Replacement of each URI.
+  /// \param[in,out] _uris URIs mapped to their replacement. URIs kept as
+  /// they are aren't added.
+  public: static void ScanFile(const std::string &_path,
+      const SdfUriRewriter::UriMap &_map,
+      std::map<std::string, std::string> &_uris);
+
+  /// \brief Find the models whose owner is known, which a resource can
+  /// refer to by a model:// URI: the dependencies recorded in its
+  /// metadata, then the models of the resource's owner in the cache.
+  /// Shared models such as model://sun are usually neither, so they're
+  /// left to be resolved by name.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \param[in] _server Server of the resource.
+  /// \param[in] _owner Owner of the resource.
+  /// \return Fuel URL of each known model, by name.
+  public: std::map<std::string, std::string> KnownModels(
+              const std::string &_versionedDir, const ServerConfig &_server,
+              const std::string &_owner) const;
+
+  /// \brief Get the Fuel URL of a model included by a model:// URI.
+  /// \param[in] _known Fuel URL of each model whose owner is known.
+  /// \param[in] _uri URI, such as model://box.
+  /// \return URL of the model, or _uri if it isn't a model:// URI or the
+  /// owner of the model isn't known.
+  /// \sa KnownModels
+  public: static std::string FuelModelUri(
+              const std::map<std::string, std::string> &_known,
+              const std::string &_uri);
+
+  /// \brief Get the Fuel URL of a model:// URI found in a model.
+  /// \param[in] _uri URI found in the model's SDF file.
+  /// \param[in] _type Whether the URI is a file or an included model.
   /// \param[in] _id Model identifier
+  /// \param[in] _known Fuel URL of each model whose owner is known, used
+  /// for included models.
+  /// \return URL on the server, or _uri if it isn't a model:// URI.
   /// \sa FixPaths
-  public: void FixPathsInMaterialElement(
-              tinyxml2::XMLElement *_matElem,
-              const ModelIdentifier &_id);
-
-  /// \brief Helper function to fix a single model:// URI that is contained
-  /// in an element.
-  /// \param[in] _elem Pointer to an element that contains a URI.
-  /// \param[in] _id Model identifier
+  public: static std::string FuelUri(const std::string &_uri,
+              SdfUriType _type, const ModelIdentifier &_id,
+              const std::map<std::string, std::string> &_known);
+
+  /// \brief Get the Fuel URL of a model:// URI found in a world.
+  /// \param[in] _uri URI found in one of the world's files.
+  /// \param[in] _type Whether the URI is a file or an included model.
+  /// \param[in] _known Fuel URL of each model whose owner is known.
+  /// \return URL on the server, or _uri if it isn't a model:// URI or the
+  /// owner of the model isn't known.
   /// \sa FixPaths
-  public: void FixPathsInUri(tinyxml2::XMLElement *_elem,
-              const ModelIdentifier &_id);
+  public: static std::string FuelUri(const std::string &_uri,
+              SdfUriType _type,
+              const std::map<std::string, std::string> &_known);
+
+  /// \brief Get the path of the marker written once the URIs of a
+  /// resource are rewritten, stored next to the versioned directory.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \return Path to the marker.
+  public: static std::string RewrittenPath(const std::string &_versionedDir);
+
+  /// \brief Get the path of the URIs recorded by lazy URI rewriting,
+  /// stored next to the versioned directory.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \return Path to the record, one URI and its Fuel URL separated by a
+  /// tab per line.
+  public: static std::string UrisPath(const std::string &_versionedDir);
 
   /// \brief client configuration
   public: const ClientConfig *config = nullptr;
+
+  /// \brief Get the path of the content manifest of a resource. The
+  /// manifest is stored next to the versioned directory so that it's not
+  /// part of the resource itself.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \return Path to the manifest file.
+  public: static std::string ManifestPath(const std::string &_versionedDir);
+
+  /// \brief Get the path of the list of files left out of a resource by an
+  /// extraction filter, stored next to the versioned directory.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \return Path to the list, one file relative to the versioned
+  /// directory per line.
+  public: static std::string ExcludedPath(const std::string &_versionedDir);
+
+  /// \brief Extract a downloaded archive into a versioned directory,
+  /// leaving out the files rejected by a filter, and record them.
+  /// Description files are always extracted.
+  /// \param[in] _data Archive data.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \param[in] _filter Files to extract.
+  /// \return True if the archive was extracted.
+  public: bool Extract(const std::string &_data,
+              const std::string &_versionedDir,
+              const ExtractFilter &_filter) const;
+
+  /// \brief Pairs of file path, relative to the versioned directory, and
+  /// SHA-256 hash.
+  public: using Manifest = std::vector<std::pair<std::string, std::string>>;
+
+  /// \brief Hash every file of a resource and write its manifest. The
+  /// manifest uses the sha256sum format, with paths relative to the
+  /// versioned directory.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \param[out] _entries The manifest entries.
+  /// \return True if the manifest was written.
+  public: bool WriteManifest(const std::string &_versionedDir,
+              Manifest &_entries) const;
+
+  /// \brief Read the manifest of a resource.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \param[out] _entries The manifest entries.
+  /// \return False if there's no manifest or it can't be parsed.
+  public: static bool ReadManifest(const std::string &_versionedDir,
+              Manifest &_entries);
+
+  /// \brief Record the content of a freshly saved resource: write its
+  /// manifest and, if enabled, deduplicate its files.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  public: void RecordContent(const std::string &_versionedDir) const;
+
+  /// \brief Get the path of the blob store.
+  /// \return Path to the blob store, inside the cache location.
+  public: std::string BlobDir() const;
+
+  /// \brief Get the path of the file where a garbage collection stopped by
+  /// its time budget records the next resource to visit.
+  /// \return Path to the file, inside the cache location.
+  public: std::string GcCursorPath() const;
+
+  /// \brief Replace the files of a resource by hard links to blobs with
+  /// the same content. The first copy of a file becomes the blob. Blobs
+  /// are hashed before a file is linked to them, a blob that doesn't match
+  /// is replaced by the file. Files are left untouched if the filesystem
+  /// doesn't support hard links.
+  /// \param[in] _versionedDir Path to a versioned resource directory.
+  /// \param[in] _entries Manifest of the resource.
+  public: void Deduplicate(const std::string &_versionedDir,
+              const Manifest &_entries) const;
+
+  /// \brief Maximum number of threads used to scan the cache. Zero means
+  /// the hardware concurrency.
+  public: unsigned int jobs{0u};
+
+  /// \brief URIs recorded for a resource with lazy URI rewriting, and the
+  /// state of the sidecar they were read from.
+  public: struct RecordedUris
+  {
+    /// \brief Modification time of the sidecar.
+    fs::file_time_type time;
+
+    /// \brief Size of the sidecar, in bytes.
+    std::uintmax_t size{0u};
+
+    /// \brief Fuel URL of each model:// URI.
+    std::map<std::string, std::string> uris;
+
+    /// \brief Value of uriRecordsClock when the record was last used.
+    std::uint64_t lastUse{0u};
+  };
+
+  /// \brief Maximum number of records kept in uriRecords. The least
+  /// recently used one is dropped to make room for a new one.
+  public: static constexpr std::size_t kMaxUriRecords = 64u;
+
+  /// \brief Records read by ResolveUri, by path of their sidecar. A record
+  /// is read again when its sidecar's modification time or size changes.
+  public: std::map<std::string, std::shared_ptr<RecordedUris>> uriRecords;
+
+  /// \brief Counter ordering the uses of uriRecords.
+  public: std::uint64_t uriRecordsClock{0u};
+
+  /// \brief Protects uriRecords and uriRecordsClock.
+  public: std::mutex uriRecordsMutex;
 };
 
 //////////////////////////////////////////////////
-std::vector<Model> LocalCachePrivate::ModelsInServer(
+/// \brief Recursively list the regular files in a directory.
+/// \param[in] _dir Directory to list.
+/// \param[in] _prefix Relative path of _dir, prepended to the results.
+/// \param[out] _files Relative paths of the files, using '/' separators.
+static void listFiles(const std::string &_dir, const std::string &_prefix,
+    std::vector<std::string> &_files)
+{
+  common::DirIter end;
+  for (common::DirIter iter(_dir); iter != end; ++iter)
+  {
+    std::string rel = _prefix + common::basename(*iter);
+    if (common::isDirectory(*iter))
+      listFiles(*iter, rel + "/", _files);
+    else if (common::isFile(*iter))
+      _files.push_back(rel);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Get a temporary path next to a file, unique to the calling
+/// process and thread, so that concurrent writers of the same file never
+/// share one. The file is then moved into place.
+/// \param[in] _path Path of the file to write.
+/// \return Temporary path.
+static std::string tmpPathFor(const std::string &_path)
+{
+#ifndef _WIN32
+  auto pid = getpid();
+#else
+  auto pid = _getpid();
+#endif
+  return _path + ".tmp" + std::to_string(pid) + "-" + std::to_string(
+      std::hash<std::thread::id>()(std::this_thread::get_id()));
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> LocalCachePrivate::OwnersInServer(
     const std::string &_path) const
 {
-  std::vector<Model> models;
+  std::vector<std::string> owners;
   if (!common::isDirectory(_path))
   {
     gzwarn << "Server directory does not exist [" << _path << "]\n";
-    return models;
+    return owners;
   }
 
   common::DirIter end;
-  common::DirIter ownIter(_path);
-  while (ownIter != end)
+  for (common::DirIter ownIter(_path); ownIter != end; ++ownIter)
+  {
+    if (common::isDirectory(*ownIter))
+      owners.push_back(*ownIter);
+  }
+  return owners;
+}
+
+//////////////////////////////////////////////////
+std::vector<Model> LocalCachePrivate::ModelsInOwner(
+    const std::string &_ownerPath, const std::string &_name) const
+{
+  std::vector<Model> models;
+  std::string owner = common::basename(_ownerPath);
+
+  // This is an owner directory, look for models
+  common::DirIter end;
+  common::DirIter modIter(common::joinPaths(_ownerPath, "models"));
+  while (modIter != end)
   {
-    if (!common::isDirectory(*ownIter))
+    if ((!_name.empty() && common::basename(*modIter) != _name) ||
+        !common::isDirectory(*modIter))
     {
-      ++ownIter;
+      ++modIter;
       continue;
     }
 
-    // This is an owner directory, look for models
-    common::DirIter modIter(common::joinPaths(*ownIter, "models"));
-    while (modIter != end)
+    // Go through all versions
+    common::DirIter versionIter(common::absPath(*modIter));
+    while (versionIter != end)
     {
-      if (!common::isDirectory(*modIter))
+      if (!common::isDirectory(*versionIter))
       {
-        ++modIter;
+        ++versionIter;
         continue;
       }
 
-      // Go through all versions
-      common::DirIter versionIter(common::absPath(*modIter));
-      while (versionIter != end)
+      if (common::exists(common::joinPaths(*versionIter, "model.config")))
       {
-        if (!common::isDirectory(*versionIter))
-        {
-          ++versionIter;
-          continue;
-        }
-
-        if (common::exists(common::joinPaths(*versionIter, "model.config")))
-        {
-          std::shared_ptr<ModelPrivate> modPriv(new ModelPrivate);
-          modPriv->id.SetName(common::basename(*modIter));
-          modPriv->id.SetOwner(common::basename(*ownIter));
-          modPriv->id.SetVersionStr(common::basename(*versionIter));
-          modPriv->pathOnDisk = common::absPath(*versionIter);
-          Model model(modPriv);
-          models.push_back(model);
-        }
-        ++versionIter;
+        std::shared_ptr<ModelPrivate> modPriv(new ModelPrivate);
+        modPriv->id.SetName(common::basename(*modIter));
+        modPriv->id.SetOwner(owner);
+        modPriv->id.SetVersionStr(common::basename(*versionIter));
+        modPriv->pathOnDisk = common::absPath(*versionIter);
+        Model model(modPriv);
+        models.push_back(model);
       }
-      ++modIter;
+      ++versionIter;
     }
-    ++ownIter;
+    ++modIter;
   }
   return models;
 }
 
 //////////////////////////////////////////////////
-std::vector<WorldIdentifier> LocalCachePrivate::WorldsInServer(
-    const std::string &_path) const
+std::vector<WorldIdentifier> LocalCachePrivate::WorldsInOwner(
+    const std::string &_ownerPath, const std::string &_name) const
 {
   std::vector<WorldIdentifier> worldIds;
-  if (!common::isDirectory(_path))
-  {
-    gzwarn << "Server directory does not exist [" << _path << "]\n";
-    return worldIds;
-  }
+  std::string owner = common::basename(_ownerPath);
 
+  // This is an owner directory, look for worlds
   common::DirIter end;
-  common::DirIter ownIter(_path);
-  while (ownIter != end)
+  common::DirIter worldIter(common::joinPaths(_ownerPath, "worlds"));
+  while (worldIter != end)
   {
-    if (!common::isDirectory(*ownIter))
+    if ((!_name.empty() && common::basename(*worldIter) != _name) ||
+        !common::isDirectory(*worldIter))
     {
-      ++ownIter;
+      ++worldIter;
       continue;
     }
 
-    // This is an owner directory, look for worlds
-    common::DirIter worldIter(common::joinPaths(*ownIter, "worlds"));
-    while (worldIter != end)
+    // Go through all versions
+    common::DirIter versionIter(common::absPath(*worldIter));
+    while (versionIter != end)
     {
-      if (!common::isDirectory(*worldIter))
+      if (!common::isDirectory(*versionIter))
       {
-        ++worldIter;
+        ++versionIter;
         continue;
       }
 
-      // Go through all versions
-      common::DirIter versionIter(common::absPath(*worldIter));
-      while (versionIter != end)
-      {
-        if (!common::isDirectory(*versionIter))
-        {
-          ++versionIter;
-          continue;
-        }
+      WorldIdentifier id;
+      id.SetName(common::basename(*worldIter));
+      id.SetOwner(owner);
+      id.SetVersionStr(common::basename(*versionIter));
+      id.SetLocalPath(common::absPath(*versionIter));
+      worldIds.push_back(id);
 
-        WorldIdentifier id;
-        id.SetName(common::basename(*worldIter));
-        id.SetOwner(common::basename(*ownIter));
-        id.SetVersionStr(common::basename(*versionIter));
-        id.SetLocalPath(common::absPath(*versionIter));
-        worldIds.push_back(id);
+      ++versionIter;
+    }
+    ++worldIter;
+  }
+  return worldIds;
+}
 
-        ++versionIter;
+//////////////////////////////////////////////////
+void LocalCachePrivate::OwnersInServers(
+    const std::vector<ServerConfig> &_servers,
+    std::vector<std::string> &_owners,
+    std::vector<std::size_t> &_ownerServer) const
+{
+  // Layers are visited in lookup order, so resources of the writable cache
+  // come first.
+  for (const auto &root : this->CacheRoots())
+  {
+    for (std::size_t i = 0; i < _servers.size(); ++i)
+    {
+      std::string path = common::joinPaths(root, uriToPath(_servers[i].Url()));
+
+      // Layers don't need to hold every server
+      if (root != this->config->CacheLocation() && !common::isDirectory(path))
+        continue;
+
+      for (auto &owner : this->OwnersInServer(path))
+      {
+        _owners.push_back(std::move(owner));
+        _ownerServer.push_back(i);
       }
-      ++worldIter;
     }
-    ++ownIter;
   }
-  return worldIds;
 }
 
 //////////////////////////////////////////////////
-LocalCache::LocalCache(const ClientConfig *_config)
-  : dataPtr(new LocalCachePrivate)
+std::vector<std::string> LocalCachePrivate::CacheRoots() const
 {
-  this->dataPtr->config = _config;
+  std::vector<std::string> roots{this->config->CacheLocation()};
+  for (const auto &layer : this->config->CacheLayers())
+    roots.push_back(layer);
+  return roots;
 }
 
 //////////////////////////////////////////////////
-LocalCache::~LocalCache()
+template<typename T, typename ScanFunc>
+std::vector<T> LocalCachePrivate::ScanOwners(const std::size_t _count,
+    ScanFunc _scan) const
 {
+  // Each owner is scanned independently. The results are stored per owner
+  // and concatenated afterwards, so the output has the same order as a
+  // serial walk of the directories.
+  std::vector<std::vector<T>> perOwner(_count);
+  parallelFor(_count, this->jobs, [&](std::size_t _i)
+  {
+    perOwner[_i] = _scan(_i);
+  });
+
+  std::size_t total = 0;
+  for (const auto &items : perOwner)
+    total += items.size();
+
+  std::vector<T> result;
+  result.reserve(total);
+  for (auto &items : perOwner)
+  {
+    std::move(items.begin(), items.end(), std::back_inserter(result));
+  }
+  return result;
 }
 
 //////////////////////////////////////////////////
-ModelIter LocalCache::AllModels()
+std::vector<Model> LocalCachePrivate::ModelsInServer(
+    const std::string &_path) const
 {
-  std::vector<Model> models;
-  if (this->dataPtr->config)
+  auto owners = this->OwnersInServer(_path);
+  return this->ScanOwners<Model>(owners.size(), [&](std::size_t _i)
+      {
+        return this->ModelsInOwner(owners[_i]);
+      });
+}
+
+//////////////////////////////////////////////////
+std::vector<WorldIdentifier> LocalCachePrivate::WorldsInServer(
+    const std::string &_path) const
+{
+  auto owners = this->OwnersInServer(_path);
+  return this->ScanOwners<WorldIdentifier>(owners.size(), [&](std::size_t _i)
+      {
+        return this->WorldsInOwner(owners[_i]);
+      });
+}
+
+//////////////////////////////////////////////////
+std::string LocalCachePrivate::ManifestPath(const std::string &_versionedDir)
+{
+  return _versionedDir + ".sha256";
+}
+
+//////////////////////////////////////////////////
+std::string LocalCachePrivate::ExcludedPath(const std::string &_versionedDir)
+{
+  return _versionedDir + ".excluded";
+}
+
+//////////////////////////////////////////////////
+std::string LocalCachePrivate::RewrittenPath(
+    const std::string &_versionedDir)
+{
+  return _versionedDir + ".rewritten";
+}
+
+//////////////////////////////////////////////////
+std::string LocalCachePrivate::UrisPath(const std::string &_versionedDir)
+{
+  return _versionedDir + ".uris";
+}
+
+//////////////////////////////////////////////////
+bool LocalCachePrivate::Extract(const std::string &_data,
+    const std::string &_versionedDir, const ExtractFilter &_filter) const
+{
+  std::string excludedPath = ExcludedPath(_versionedDir);
+  if (common::isFile(excludedPath))
+    common::removeFile(excludedPath);
+
+  std::vector<std::string> excluded;
+  ZipExtractOptions options;
+  options.jobs = this->config->ExtractJobs();
+  options.syncBatch = this->config->ExtractSyncBatch();
+  if (!_filter.Empty())
   {
-    for (auto &server : this->dataPtr->config->Servers())
+    options.filter = [&](const std::string &_name)
     {
-      std::string path = common::joinPaths(
-          this->dataPtr->config->CacheLocation(), uriToPath(server.Url()));
+      if (CacheArchive::IsDescriptionFile(_name) || _filter.Extracts(_name))
+        return true;
+      if (_name.empty() || _name.back() != '/')
+        excluded.push_back(_name);
+      return false;
+    };
+  }
+
+  ScopedCacheTimer timer(CacheStatisticsRecorder::Timer::EXTRACT);
+  if (!Zip::ExtractFromMemory(_data.data(), _data.size(), _versionedDir,
+      options))
+  {
+    return false;
+  }
+
+  if (excluded.empty())
+    return true;
+
+  // Files that were left out are fetched when they're requested
+  std::ofstream out(excludedPath, std::ios::out | std::ios::trunc);
+  for (const auto &name : excluded)
+    out << name << "\n";
+  if (!out)
+  {
+    gzwarn << "Unable to write [" << excludedPath << "]" << std::endl;
+    return true;
+  }
+  gzmsg << "Left out " << excluded.size() << " files of ["
+        << _versionedDir << "], they'll be fetched if requested."
+        << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LocalCachePrivate::WriteManifest(const std::string &_versionedDir,
+    Manifest &_entries) const
+{
+  std::vector<std::string> files;
+  listFiles(_versionedDir, "", files);
+  std::sort(files.begin(), files.end());
 
-      auto srvModels = this->dataPtr->ModelsInServer(path);
-      for (auto &mod : srvModels)
+  std::vector<std::string> hashes(files.size());
+  std::vector<char> hashed(files.size(), 0);
+  parallelFor(files.size(), this->jobs, [&](std::size_t _i)
+  {
+    hashed[_i] = Sha256::HashFile(
+        common::joinPaths(_versionedDir, files[_i]), hashes[_i]);
+  });
+
+  // Write to a temporary file first so that an interrupted write never
+  // leaves a truncated manifest behind.
+  std::string manifestPath = ManifestPath(_versionedDir);
+  std::string tmpPath = tmpPathFor(manifestPath);
+  {
+    std::ofstream out(tmpPath, std::ios::out | std::ios::trunc);
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+      if (!hashed[i])
       {
-        mod.dataPtr->id.SetServer(server);
+        gzerr << "Unable to hash [" << files[i] << "] in ["
+              << _versionedDir << "]" << std::endl;
+        out.close();
+        common::removeFile(tmpPath);
+        return false;
       }
-      models.insert(models.end(), srvModels.begin(), srvModels.end());
+      out << hashes[i] << "  " << files[i] << "\n";
+      _entries.emplace_back(files[i], hashes[i]);
+    }
+    if (!out)
+    {
+      gzerr << "Unable to write manifest [" << tmpPath << "]" << std::endl;
+      return false;
     }
   }
 
-  return ModelIterFactory::Create(models);
+  if (!common::moveFile(tmpPath, manifestPath))
+  {
+    gzerr << "Unable to write manifest [" << manifestPath << "]" << std::endl;
+    return false;
+  }
+  return true;
 }
 
 //////////////////////////////////////////////////
-WorldIter LocalCache::AllWorlds() const
+bool LocalCachePrivate::ReadManifest(const std::string &_versionedDir,
+    Manifest &_entries)
 {
-  std::vector<WorldIdentifier> worldIds;
-  if (this->dataPtr->config)
+  std::ifstream in(ManifestPath(_versionedDir));
+  if (!in)
+    return false;
+
+  std::string line;
+  while (std::getline(in, line))
+  {
+    if (line.empty())
+      continue;
+
+    // <64 hex characters><two spaces><relative path>
+    if (line.size() < 67 || line[64] != ' ' || line[65] != ' ')
+      return false;
+
+    _entries.emplace_back(line.substr(66), line.substr(0, 64));
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LocalCachePrivate::RecordContent(const std::string &_versionedDir) const
+{
+  Manifest entries;
+  if (!this->WriteManifest(_versionedDir, entries))
+    return;
+
+  if (this->config->CacheDeduplication())
+    this->Deduplicate(_versionedDir, entries);
+}
+
+//////////////////////////////////////////////////
+std::string LocalCachePrivate::BlobDir() const
+{
+  return common::joinPaths(this->config->CacheLocation(), ".blobs");
+}
+
+//////////////////////////////////////////////////
+std::string LocalCachePrivate::GcCursorPath() const
+{
+  return common::joinPaths(this->config->CacheLocation(), ".gc_cursor");
+}
+
+//////////////////////////////////////////////////
+void LocalCachePrivate::Deduplicate(const std::string &_versionedDir,
+    const Manifest &_entries) const
+{
+  std::uintmax_t savedBytes = 0;
+  for (const auto &entry : _entries)
   {
-    // Iterate over servers
-    for (auto &server : this->dataPtr->config->Servers())
+    std::error_code ec;
+    const fs::path file(common::joinPaths(_versionedDir, entry.first));
+    const std::string &hash = entry.second;
+    const fs::path blob(
+        common::joinPaths(this->BlobDir(), hash.substr(0, 2), hash));
+
+    if (!fs::exists(blob, ec))
     {
-      std::string path = common::joinPaths(
-          this->dataPtr->config->CacheLocation(), uriToPath(server.Url()));
+      fs::create_directories(blob.parent_path(), ec);
+      fs::create_hard_link(file, blob, ec);
+      if (!ec)
+        continue;
 
-      // Make sure the server info is correct
-      auto srvWorlds = this->dataPtr->WorldsInServer(path);
-      for (auto &world : srvWorlds)
+      // Another download may have created the blob in the meantime.
+      // Otherwise hard links aren't supported here, so give up.
+      if (!fs::exists(blob, ec))
       {
-        WorldIdentifier id = world;
-        id.SetServer(server);
-
-        worldIds.push_back(id);
+        gzdbg << "Unable to create blob [" << blob.string() << "]: "
+              << ec.message() << std::endl;
+        return;
       }
     }
+
+    if (fs::equivalent(file, blob, ec))
+      continue;
+
+    // A corrupted blob must never replace a good copy. The file was just
+    // hashed, so it takes the blob's place instead.
+    auto size = fs::file_size(file, ec);
+    std::string blobHash;
+    if (ec || size != fs::file_size(blob, ec) || ec ||
+        !Sha256::HashFile(blob.string(), blobHash) || blobHash != hash)
+    {
+      gzwarn << "Blob [" << blob.string() << "] doesn't match ["
+             << file.string() << "], replacing it" << std::endl;
+      fs::path tmp = blob;
+      tmp += ".tmp";
+      fs::remove(tmp, ec);
+      fs::create_hard_link(file, tmp, ec);
+      if (!ec)
+        fs::rename(tmp, blob, ec);
+      if (ec)
+        fs::remove(tmp, ec);
+      continue;
+    }
+
+    // Link next to the file, then rename over it, so the file is never
+    // missing.
+    fs::path tmp = file;
+    tmp += ".blob";
+    fs::create_hard_link(blob, tmp, ec);
+    if (ec)
+    {
+      gzdbg << "Unable to link [" << blob.string() << "]: " << ec.message()
+            << std::endl;
+      continue;
+    }
+    fs::rename(tmp, file, ec);
+    if (ec)
+    {
+      fs::remove(tmp, ec);
+      continue;
+    }
+    savedBytes += size;
+  }
+
+  if (savedBytes > 0)
+  {
+    gzdbg << "Deduplicated " << savedBytes << " bytes in [" << _versionedDir
+          << "]" << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+LocalCache::LocalCache(const ClientConfig *_config)
+  : dataPtr(new LocalCachePrivate)
+{
+  this->dataPtr->config = _config;
+}
+
+//////////////////////////////////////////////////
+LocalCache::~LocalCache()
+{
+}
+
+//////////////////////////////////////////////////
+void LocalCache::SetJobs(unsigned int _jobs)
+{
+  this->dataPtr->jobs = _jobs;
+}
+
+//////////////////////////////////////////////////
+unsigned int LocalCache::Jobs() const
+{
+  return this->dataPtr->jobs;
+}
+
+//////////////////////////////////////////////////
+template<typename T, typename ScanFunc>
+std::vector<T> LocalCachePrivate::ScanMatching(const std::string &_serverUrl,
+    const std::string &_owner, ScanFunc _scan) const
+{
+  if (!this->config)
+    return {};
+
+  // Only the directories of the matching servers and owners are scanned,
+  // so no intermediate list of the whole cache is built.
+  std::vector<ServerConfig> servers;
+  for (const auto &server : this->config->Servers())
+  {
+    if (_serverUrl.empty() || server.Url().Str() == _serverUrl)
+      servers.push_back(server);
+  }
+
+  // Gather the owners of every server first, so that a single bounded set
+  // of workers fans out over all of them.
+  std::vector<std::string> owners;
+  std::vector<std::size_t> ownerServer;
+  this->OwnersInServers(servers, owners, ownerServer);
+  if (!_owner.empty())
+  {
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < owners.size(); ++i)
+    {
+      if (common::basename(owners[i]) != _owner)
+        continue;
+      owners[kept] = std::move(owners[i]);
+      ownerServer[kept] = ownerServer[i];
+      ++kept;
+    }
+    owners.resize(kept);
+    ownerServer.resize(kept);
   }
 
-  return WorldIterFactory::Create(worldIds);
+  return this->ScanOwners<T>(owners.size(), [&](std::size_t _i)
+      {
+        return _scan(owners[_i], servers[ownerServer[_i]]);
+      });
+}
+
+//////////////////////////////////////////////////
+ModelIter LocalCache::AllModels()
+{
+  return ModelIterFactory::Create(this->dataPtr->ScanMatching<Model>(
+      "", "",
+      [this](const std::string &_ownerPath, const ServerConfig &_server)
+      {
+        auto ownerModels = this->dataPtr->ModelsInOwner(_ownerPath);
+        for (auto &mod : ownerModels)
+          mod.dataPtr->id.SetServer(_server);
+        return ownerModels;
+      }));
+}
+
+//////////////////////////////////////////////////
+WorldIter LocalCache::AllWorlds() const
+{
+  return WorldIterFactory::Create(
+      this->dataPtr->ScanMatching<WorldIdentifier>("", "",
+      [this](const std::string &_ownerPath, const ServerConfig &_server)
+      {
+        auto ownerWorlds = this->dataPtr->WorldsInOwner(_ownerPath);
+        for (auto &world : ownerWorlds)
+          world.SetServer(_server);
+        return ownerWorlds;
+      }));
 }
 
 //////////////////////////////////////////////////
@@ -282,115 +989,1122 @@ Model LocalCache::MatchingModel(const ModelIdentifier &_id)
   if (!this->dataPtr->config)
     return tipModel;
 
-  std::string path = common::joinPaths(
-      this->dataPtr->config->CacheLocation(), uriToPath(_id.Server().Url()));
+  // Search the layers in order. The first layer holding the requested
+  // version wins, and ties between tips go to the earliest layer.
+  for (const auto &root : this->dataPtr->CacheRoots())
+  {
+    std::string path = common::joinPaths(root, uriToPath(_id.Server().Url()));
+    if (root != this->dataPtr->config->CacheLocation() &&
+        !common::isDirectory(path))
+    {
+      continue;
+    }
+
+    auto srvModels = this->dataPtr->ModelsInServer(path);
+    for (auto &model : srvModels)
+    {
+      model.dataPtr->id.SetServer(_id.Server());
+      const auto &id = model.dataPtr->id;
+      if (_id == id)
+      {
+        if (_id.Version() == id.Version())
+          return model;
+        else if (tip && id.Version() > tipModel.Identification().Version())
+          tipModel = model;
+      }
+    }
+  }
+
+  return tipModel;
+}
+
+//////////////////////////////////////////////////
+bool LocalCache::MatchingWorld(WorldIdentifier &_id) const
+{
+  // For the tip, we have to find the highest version
+  bool tip = (_id.Version() == 0);
+  WorldIdentifier tipWorld;
+
+  if (!this->dataPtr->config)
+    return false;
+
+  // Search the layers in order, see MatchingModel
+  for (const auto &root : this->dataPtr->CacheRoots())
+  {
+    std::string path = common::joinPaths(root, uriToPath(_id.Server().Url()));
+    if (root != this->dataPtr->config->CacheLocation() &&
+        !common::isDirectory(path))
+    {
+      continue;
+    }
+
+    auto srvWorlds = this->dataPtr->WorldsInServer(path);
+    for (auto id : srvWorlds)
+    {
+      id.SetServer(_id.Server());
+      if (_id == id)
+      {
+        if (_id.Version() == id.Version())
+        {
+          _id = id;
+          return true;
+        }
+        else if (tip && id.Version() > tipWorld.Version())
+        {
+          tipWorld = id;
+        }
+      }
+    }
+  }
+
+  auto foundTip = !(tipWorld == WorldIdentifier());
+  if (foundTip)
+  {
+    _id = tipWorld;
+  }
+
+  return foundTip;
+}
+
+//////////////////////////////////////////////////
+ModelIter LocalCache::MatchingModels(const ModelIdentifier &_id)
+{
+  if (_id.Name().empty() && !_id.Server().Url().Valid() && _id.Owner().empty())
+    return ModelIterFactory::Create();
+
+  const std::string name = _id.Name();
+  return ModelIterFactory::Create(this->dataPtr->ScanMatching<Model>(
+      _id.Server().Url().Valid() ? _id.Server().Url().Str() : "",
+      _id.Owner(),
+      [&](const std::string &_ownerPath, const ServerConfig &_server)
+      {
+        auto ownerModels = this->dataPtr->ModelsInOwner(_ownerPath, name);
+        for (auto &mod : ownerModels)
+          mod.dataPtr->id.SetServer(_server);
+        return ownerModels;
+      }));
+}
+
+//////////////////////////////////////////////////
+WorldIter LocalCache::MatchingWorlds(const WorldIdentifier &_id) const
+{
+  if (_id.Name().empty() && !_id.Server().Url().Valid() && _id.Owner().empty())
+    return WorldIterFactory::Create();
+
+  const std::string name = _id.Name();
+  return WorldIterFactory::Create(
+      this->dataPtr->ScanMatching<WorldIdentifier>(
+      _id.Server().Url().Valid() ? _id.Server().Url().Str() : "",
+      _id.Owner(),
+      [&](const std::string &_ownerPath, const ServerConfig &_server)
+      {
+        auto ownerWorlds = this->dataPtr->WorldsInOwner(_ownerPath, name);
+        for (auto &world : ownerWorlds)
+          world.SetServer(_server);
+        return ownerWorlds;
+      }));
+}
+
+//////////////////////////////////////////////////
+bool LocalCache::Verify(std::vector<ModelIdentifier> &_badModels,
+    std::vector<WorldIdentifier> &_badWorlds)
+{
+  // A resource to verify
+  struct Resource
+  {
+    std::string path;
+    std::optional<ModelIdentifier> model;
+    std::optional<WorldIdentifier> world;
+  };
+
+  // A file to hash, and the resource it belongs to
+  struct FileCheck
+  {
+    std::size_t resource;
+    std::string path;
+    std::string expected;
+  };
+
+  std::vector<Resource> resources;
+  for (auto iter = this->AllModels(); iter; ++iter)
+  {
+    Resource res;
+    res.path = iter->PathToModel();
+    res.model = iter->Identification();
+    resources.push_back(std::move(res));
+  }
+  for (auto iter = this->AllWorlds(); iter; ++iter)
+  {
+    Resource res;
+    res.path = iter->LocalPath();
+    res.world = *iter;
+    resources.push_back(std::move(res));
+  }
+
+  // Gather the files of every resource, so the hashing is spread over all
+  // threads even when a single resource holds most of the data.
+  std::vector<FileCheck> checks;
+  std::vector<char> bad(resources.size(), 0);
+  std::size_t unverified = 0;
+  for (std::size_t r = 0; r < resources.size(); ++r)
+  {
+    LocalCachePrivate::Manifest entries;
+    if (!LocalCachePrivate::ReadManifest(resources[r].path, entries))
+    {
+      if (common::exists(LocalCachePrivate::ManifestPath(resources[r].path)))
+      {
+        gzerr << "Invalid manifest for [" << resources[r].path << "]"
+              << std::endl;
+        bad[r] = 1;
+      }
+      else
+      {
+        gzdbg << "No manifest for [" << resources[r].path
+              << "], skipping" << std::endl;
+        ++unverified;
+      }
+      continue;
+    }
+
+    for (auto &entry : entries)
+    {
+      checks.push_back({r, common::joinPaths(resources[r].path, entry.first),
+          std::move(entry.second)});
+    }
+  }
+
+  std::vector<char> valid(checks.size(), 0);
+  parallelFor(checks.size(), this->dataPtr->jobs, [&](std::size_t _i)
+  {
+    std::string hash;
+    valid[_i] = Sha256::HashFile(checks[_i].path, hash) &&
+        hash == checks[_i].expected;
+  });
+
+  for (std::size_t i = 0; i < checks.size(); ++i)
+  {
+    if (valid[i])
+      continue;
+
+    if (!common::exists(checks[i].path))
+      gzerr << "Missing file [" << checks[i].path << "]" << std::endl;
+    else
+      gzerr << "Corrupted file [" << checks[i].path << "]" << std::endl;
+    bad[checks[i].resource] = 1;
+  }
+
+  std::size_t badCount = 0;
+  for (std::size_t r = 0; r < resources.size(); ++r)
+  {
+    if (!bad[r])
+      continue;
+
+    ++badCount;
+    if (resources[r].model)
+      _badModels.push_back(*resources[r].model);
+    else
+      _badWorlds.push_back(*resources[r].world);
+  }
+
+  gzmsg << "Verified " << checks.size() << " files in "
+        << resources.size() - unverified << " resources, " << badCount
+        << " damaged";
+  if (unverified > 0)
+    gzmsg << ", " << unverified << " without manifest";
+  gzmsg << "." << std::endl;
+
+  return badCount == 0;
+}
+
+//////////////////////////////////////////////////
+BlobStoreStatistics LocalCache::BlobStoreStats() const
+{
+  BlobStoreStatistics stats;
+  std::error_code ec;
+  fs::recursive_directory_iterator iter(this->dataPtr->BlobDir(), ec);
+  for (const fs::recursive_directory_iterator end; !ec && iter != end;
+       iter.increment(ec))
+  {
+    if (!iter->is_regular_file(ec))
+      continue;
+
+    auto size = iter->file_size(ec);
+    auto links = iter->hard_link_count(ec);
+    if (ec)
+      continue;
+
+    ++stats.blobs;
+    stats.bytes += size;
+
+    // One link is the blob itself, the first reference is the copy that
+    // would exist anyway.
+    if (links <= 1)
+      ++stats.unreferenced;
+    else
+      stats.savedBytes += size * (links - 2);
+  }
+  return stats;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t LocalCache::PruneBlobs()
+{
+  // Blobs whose only link is the one in the blob store
+  std::vector<std::pair<fs::path, std::uintmax_t>> unreferenced;
+
+  std::error_code ec;
+  fs::recursive_directory_iterator iter(this->dataPtr->BlobDir(), ec);
+  for (const fs::recursive_directory_iterator end; !ec && iter != end;
+       iter.increment(ec))
+  {
+    if (iter->is_regular_file(ec) && iter->hard_link_count(ec) == 1u)
+      unreferenced.emplace_back(iter->path(), iter->file_size(ec));
+  }
+
+  std::uint64_t reclaimed = 0;
+  std::size_t removed = 0;
+  for (const auto &[blob, size] : unreferenced)
+  {
+    if (!fs::remove(blob, ec))
+    {
+      gzwarn << "Unable to remove blob [" << blob.string() << "]"
+             << std::endl;
+      continue;
+    }
+    reclaimed += size;
+    ++removed;
+  }
+
+  gzmsg << "Removed " << removed << " unreferenced blobs, reclaimed "
+        << reclaimed << " bytes." << std::endl;
+  return reclaimed;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get how long ago a cached resource was last used: saved, or had
+/// one of its top level files read.
+/// \param[in] _versionedDir Path to a versioned resource directory.
+/// \return Time since the last use.
+static std::chrono::seconds timeSinceUsed(const std::string &_versionedDir)
+{
+#ifndef _WIN32
+  // std::filesystem doesn't expose access times
+  struct stat st;
+  if (stat(_versionedDir.c_str(), &st) != 0)
+    return std::chrono::seconds::max();
+
+  time_t latest = st.st_mtime;
+  common::DirIter end;
+  for (common::DirIter iter(_versionedDir); iter != end; ++iter)
+  {
+    if (stat((*iter).c_str(), &st) == 0 && S_ISREG(st.st_mode))
+      latest = std::max({latest, st.st_atime, st.st_mtime});
+  }
+  return std::chrono::seconds(std::max<time_t>(time(nullptr) - latest, 0));
+#else
+  std::error_code ec;
+  auto latest = fs::last_write_time(_versionedDir, ec);
+  if (ec)
+    return std::chrono::seconds::max();
+
+  for (const auto &entry : fs::directory_iterator(_versionedDir, ec))
+  {
+    if (entry.is_regular_file(ec))
+      latest = std::max(latest, entry.last_write_time(ec));
+  }
+  return std::chrono::duration_cast<std::chrono::seconds>(
+      fs::file_time_type::clock::now() - latest);
+#endif
+}
+
+//////////////////////////////////////////////////
+/// \brief Count the bytes freed by removing a cached resource. Files with
+/// other hard links, such as deduplicated files, are only freed once their
+/// blob is pruned.
+/// \param[in] _versionedDir Path to a versioned resource directory.
+/// \return Number of bytes.
+static std::uint64_t reclaimableBytes(const std::string &_versionedDir)
+{
+  std::uint64_t bytes = 0;
+  std::error_code ec;
+  fs::recursive_directory_iterator iter(_versionedDir, ec);
+  for (const fs::recursive_directory_iterator end; !ec && iter != end;
+       iter.increment(ec))
+  {
+    std::error_code fileEc;
+    if (iter->is_regular_file(fileEc) &&
+        iter->hard_link_count(fileEc) <= 1u)
+    {
+      auto size = iter->file_size(fileEc);
+      if (!fileEc)
+        bytes += size;
+    }
+  }
+
+  for (const auto &sidecar : {LocalCachePrivate::ManifestPath(_versionedDir),
+                              LocalCachePrivate::ExcludedPath(_versionedDir),
+                              LocalCachePrivate::RewrittenPath(_versionedDir),
+                              LocalCachePrivate::UrisPath(_versionedDir),
+                              CacheArchive::Path(_versionedDir)})
+  {
+    auto size = fs::file_size(sidecar, ec);
+    if (!ec)
+      bytes += size;
+  }
+  return bytes;
+}
+
+//////////////////////////////////////////////////
+CacheGcReport LocalCache::CollectGarbage(const CacheGcPolicy &_policy)
+{
+  CacheGcReport report;
+  if (!this->dataPtr->config)
+    return report;
+
+  const auto start = std::chrono::steady_clock::now();
+  const std::string cacheLocation = this->dataPtr->config->CacheLocation();
+
+  // Pinned versions by lowercase resource unique name. An empty version
+  // pins every version.
+  std::map<std::string, std::set<std::string>> pinned;
+  auto pin = [&pinned](const std::string &_uniqueName, unsigned int _version)
+  {
+    auto &versions = pinned[common::lowercase(_uniqueName)];
+    if (_version == 0)
+      versions.insert("");
+    else
+      versions.insert(std::to_string(_version));
+  };
+  for (const auto &id : _policy.pinnedModels)
+    pin(id.UniqueName(), id.Version());
+  for (const auto &id : _policy.pinnedWorlds)
+    pin(id.UniqueName(), id.Version());
+
+  auto isPinned = [&pinned](const std::string &_uniqueName,
+      const std::string &_version)
+  {
+    auto it = pinned.find(_uniqueName);
+    return it != pinned.end() &&
+      (it->second.count("") > 0 || it->second.count(_version) > 0);
+  };
+
+  // Owners of every server, only in the writable cache
+  std::vector<std::string> owners;
+  std::vector<std::string> ownerServer;
+  for (const auto &server : this->dataPtr->config->Servers())
+  {
+    std::string serverPath = uriToPath(server.Url());
+    std::string path = common::joinPaths(cacheLocation, serverPath);
+    if (!common::isDirectory(path))
+      continue;
+
+    for (auto &owner : this->dataPtr->OwnersInServer(path))
+    {
+      owners.push_back(std::move(owner));
+      ownerServer.push_back(serverPath);
+    }
+  }
+
+  // Resources of every owner, sorted by unique name so that a collection
+  // stopped by its time budget can be resumed where it stopped
+  struct Resource
+  {
+    std::string uniqueName;
+    std::string path;
+  };
+  std::vector<std::vector<Resource>> ownerResources(owners.size());
+  parallelFor(owners.size(), this->dataPtr->jobs, [&](std::size_t _i)
+  {
+    const std::string owner = common::basename(owners[_i]);
+    for (const std::string type : {"models", "worlds"})
+    {
+      common::DirIter end;
+      for (common::DirIter resIter(common::joinPaths(owners[_i], type));
+           resIter != end; ++resIter)
+      {
+        if (!common::isDirectory(*resIter))
+          continue;
+        ownerResources[_i].push_back({common::lowercase(
+            common::copyToUnixPath(common::joinPaths(ownerServer[_i], owner,
+                type, common::basename(*resIter)))), *resIter});
+      }
+    }
+  });
+  std::vector<Resource> resources;
+  for (auto &list : ownerResources)
+  {
+    std::move(list.begin(), list.end(), std::back_inserter(resources));
+  }
+  std::sort(resources.begin(), resources.end(),
+      [](const Resource &_a, const Resource &_b)
+      {
+        return _a.uniqueName < _b.uniqueName;
+      });
+
+  // Skip the resources visited by the previous collection
+  std::size_t first = 0;
+  const std::string cursorPath = this->dataPtr->GcCursorPath();
+  {
+    std::ifstream in(cursorPath);
+    std::string cursor;
+    if (std::getline(in, cursor) && !cursor.empty())
+    {
+      first = std::lower_bound(resources.begin(), resources.end(), cursor,
+          [](const Resource &_res, const std::string &_name)
+          {
+            return _res.uniqueName < _name;
+          }) - resources.begin();
+    }
+  }
+
+  std::atomic<std::uint64_t> removed{0};
+  std::atomic<std::uint64_t> kept{0};
+  std::atomic<std::uint64_t> reclaimed{0};
+  std::mutex stopMutex;
+  std::size_t stop = resources.size();
+
+  // Resources are handed out in order, so the ones before the first
+  // skipped resource were all visited
+  parallelFor(resources.size() - first, this->dataPtr->jobs,
+      [&](std::size_t _i)
+  {
+    const std::size_t index = first + _i;
+
+    // Every collection visits at least one resource
+    if (_i > 0 && _policy.timeBudget.count() > 0 &&
+        std::chrono::steady_clock::now() - start > _policy.timeBudget)
+    {
+      std::lock_guard<std::mutex> lock(stopMutex);
+      stop = std::min(stop, index);
+      return;
+    }
+
+    // Numbered versions, latest first
+    const Resource &resource = resources[index];
+    std::vector<std::pair<unsigned int, std::string>> versions;
+    common::DirIter end;
+    for (common::DirIter verIter(resource.path); verIter != end; ++verIter)
+    {
+      std::string name = common::basename(*verIter);
+      if (!common::isDirectory(*verIter) || name.empty() ||
+          name.find_first_not_of("0123456789") != std::string::npos)
+      {
+        continue;
+      }
+      try
+      {
+        versions.emplace_back(std::stoul(name), *verIter);
+      }
+      catch (...)
+      {
+      }
+    }
+    std::sort(versions.begin(), versions.end(),
+        [](const auto &_a, const auto &_b)
+        {
+          return _a.first > _b.first;
+        });
+
+    for (std::size_t v = 0; v < versions.size(); ++v)
+    {
+      const auto &[number, dir] = versions[v];
+      if (v < _policy.keepVersions ||
+          isPinned(resource.uniqueName, std::to_string(number)) ||
+          (_policy.keepUsedWithin.count() > 0 &&
+           timeSinceUsed(dir) < _policy.keepUsedWithin))
+      {
+        ++kept;
+        continue;
+      }
+
+      std::uint64_t bytes = reclaimableBytes(dir);
+      if (!_policy.dryRun)
+      {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+        if (ec)
+        {
+          gzwarn << "Unable to remove [" << dir << "]: " << ec.message()
+                 << std::endl;
+          ++kept;
+          continue;
+        }
+        fs::remove(LocalCachePrivate::ManifestPath(dir), ec);
+        fs::remove(LocalCachePrivate::ExcludedPath(dir), ec);
+        fs::remove(LocalCachePrivate::RewrittenPath(dir), ec);
+        fs::remove(LocalCachePrivate::UrisPath(dir), ec);
+        fs::remove(CacheArchive::Path(dir), ec);
+      }
+      gzdbg << (_policy.dryRun ? "Would remove [" : "Removed [") << dir
+            << "]" << std::endl;
+      ++removed;
+      reclaimed += bytes;
+    }
+
+    // Only removes the resource directory if no version is left
+    if (!_policy.dryRun)
+    {
+      std::error_code ec;
+      fs::remove(resource.path, ec);
+    }
+  });
+
+  // The next collection starts with the first resource that wasn't
+  // visited, or from the beginning once every resource was visited
+  const bool complete = stop == resources.size();
+  if (!_policy.dryRun)
+  {
+    std::error_code ec;
+    if (complete)
+    {
+      fs::remove(cursorPath, ec);
+    }
+    else
+    {
+      std::ofstream out(cursorPath, std::ios::trunc);
+      out << resources[stop].uniqueName << std::endl;
+    }
+  }
+
+  report.removedVersions = removed;
+  report.keptVersions = kept;
+  report.reclaimedBytes = reclaimed;
+  report.complete = complete;
+
+  // Blobs only used by the removed versions
+  if (!_policy.dryRun && report.removedVersions > 0 &&
+      common::isDirectory(this->dataPtr->BlobDir()))
+  {
+    report.reclaimedBytes += this->PruneBlobs();
+  }
+
+  gzmsg << (_policy.dryRun ? "Would remove " : "Removed ")
+        << report.removedVersions << " cached versions, "
+        << (_policy.dryRun ? "reclaiming " : "reclaimed ")
+        << report.reclaimedBytes << " bytes." << std::endl;
+  return report;
+}
+
+//////////////////////////////////////////////////
+bool LocalCachePrivate::InCacheLocation(const std::string &_path) const
+{
+  return IsWithin(common::absPath(_path),
+      common::absPath(this->config->CacheLocation()));
+}
+
+//////////////////////////////////////////////////
+bool LocalCachePrivate::IsWithin(const std::string &_path,
+    const std::string &_dir)
+{
+  if (_path.compare(0, _dir.size(), _dir) != 0)
+    return false;
+
+  auto isSeparator = [](char _c) { return _c == '/' || _c == '\\'; };
+  return _path.size() == _dir.size() ||
+      (!_dir.empty() && isSeparator(_dir.back())) ||
+      isSeparator(_path[_dir.size()]);
+}
+
+//////////////////////////////////////////////////
+bool LocalCache::MaterializeFile(const std::string &_versionedDir,
+    const std::string &_path) const
+{
+  std::string archive = CacheArchive::Path(_versionedDir);
+  if (!common::isFile(archive))
+    return false;
+
+  // Layers are read-only
+  if (!this->dataPtr->InCacheLocation(_versionedDir))
+    return false;
+
+  std::string name = _path;
+  std::replace(name.begin(), name.end(), '\\', '/');
+  std::string dst = _path;
+  common::changeFromUnixPath(dst);
+  return CacheArchive::ExtractFile(archive, name,
+      common::joinPaths(_versionedDir, dst));
+}
+
+//////////////////////////////////////////////////
+bool LocalCache::FixPaths(const Model &_model)
+{
+  if (!_model)
+    return false;
+  std::string dir = _model.PathToModel();
+  if (common::isFile(LocalCachePrivate::RewrittenPath(dir)) ||
+      (this->dataPtr->config->LazyUriRewrite() &&
+       common::isFile(LocalCachePrivate::UrisPath(dir))))
+  {
+    return true;
+  }
+
+  // Layers are read-only
+  if (!this->dataPtr->InCacheLocation(dir))
+    return false;
+
+  ScopedCacheTimer timer(CacheStatisticsRecorder::Timer::FIX_PATHS);
+  std::size_t changed = 0;
+  bool result = this->dataPtr->FixPaths(dir, _model.Identification(),
+      changed);
+
+  // Keep the manifest in line with the rewritten files
+  if (changed > 0 && common::isFile(LocalCachePrivate::ManifestPath(dir)))
+    this->dataPtr->RecordContent(dir);
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool LocalCache::FixPaths(const WorldIdentifier &_id)
+{
+  std::string dir = _id.LocalPath();
+  if (dir.empty())
+    return false;
+  if (common::isFile(LocalCachePrivate::RewrittenPath(dir)) ||
+      (this->dataPtr->config->LazyUriRewrite() &&
+       common::isFile(LocalCachePrivate::UrisPath(dir))))
+  {
+    return true;
+  }
+
+  // Layers are read-only
+  if (!this->dataPtr->InCacheLocation(dir))
+    return false;
+
+  ScopedCacheTimer timer(CacheStatisticsRecorder::Timer::FIX_PATHS);
+  std::size_t changed = 0;
+  bool result = this->dataPtr->FixPaths(dir, _id, changed);
+  if (changed > 0 && common::isFile(LocalCachePrivate::ManifestPath(dir)))
+    this->dataPtr->RecordContent(dir);
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool LocalCache::FixAllPaths(std::size_t &_fixed)
+{
+  _fixed = 0;
+  auto done = [this](const std::string &_dir)
+  {
+    return common::isFile(LocalCachePrivate::RewrittenPath(_dir)) ||
+      (this->dataPtr->config->LazyUriRewrite() &&
+       common::isFile(LocalCachePrivate::UrisPath(_dir)));
+  };
+
+  bool result = true;
+  for (auto iter = this->AllModels(); iter; ++iter)
+  {
+    std::string dir = iter->PathToModel();
+    if (!this->dataPtr->InCacheLocation(dir) || done(dir))
+      continue;
+
+    if (this->FixPaths(*iter))
+    {
+      ++_fixed;
+      continue;
+    }
+    gzwarn << "Unable to rewrite the URIs of [" << dir << "]" << std::endl;
+    result = false;
+  }
+  for (auto iter = this->AllWorlds(); iter; ++iter)
+  {
+    std::string dir = iter->LocalPath();
+    if (!this->dataPtr->InCacheLocation(dir) || done(dir))
+      continue;
+
+    if (this->FixPaths(*iter))
+    {
+      ++_fixed;
+      continue;
+    }
+    gzwarn << "Unable to rewrite the URIs of [" << dir << "]" << std::endl;
+    result = false;
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::string LocalCache::ResolveUri(const std::string &_path,
+    const std::string &_uri)
+{
+  using RecordedUris = LocalCachePrivate::RecordedUris;
+
+  // Look for the record of the resource containing the path
+  std::error_code ec;
+  fs::path dir(_path);
+  std::string urisPath;
+  fs::file_time_type time;
+  for (; !dir.empty(); dir = dir.parent_path())
+  {
+    urisPath = LocalCachePrivate::UrisPath(dir.string());
+    time = fs::last_write_time(urisPath, ec);
+    if (!ec || dir == dir.parent_path())
+      break;
+  }
+  if (ec || dir.empty())
+    return _uri;
+  std::uintmax_t size = fs::file_size(urisPath, ec);
+  if (ec)
+    return _uri;
+
+  std::shared_ptr<const RecordedUris> recorded;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->uriRecordsMutex);
+    auto it = this->dataPtr->uriRecords.find(urisPath);
+    if (it != this->dataPtr->uriRecords.end() && it->second->time == time &&
+        it->second->size == size)
+    {
+      it->second->lastUse = ++this->dataPtr->uriRecordsClock;
+      recorded = it->second;
+    }
+  }
+
+  if (!recorded)
+  {
+    // Records are read outside the lock, and records read concurrently
+    // for the same sidecar replace one another
+    auto loaded = std::make_shared<RecordedUris>();
+    loaded->time = time;
+    loaded->size = size;
+    std::ifstream in(urisPath);
+    std::string line;
+    while (std::getline(in, line))
+    {
+      auto tab = line.find('\t');
+      if (tab != std::string::npos)
+        loaded->uris[line.substr(0, tab)] = line.substr(tab + 1);
+    }
+    recorded = loaded;
+
+    std::lock_guard<std::mutex> lock(this->dataPtr->uriRecordsMutex);
+    auto &records = this->dataPtr->uriRecords;
+    if (records.find(urisPath) == records.end() &&
+        records.size() >= LocalCachePrivate::kMaxUriRecords)
+    {
+      auto oldest = std::min_element(records.begin(), records.end(),
+          [](const auto &_a, const auto &_b)
+          {
+            return _a.second->lastUse < _b.second->lastUse;
+          });
+      records.erase(oldest);
+    }
+    loaded->lastUse = ++this->dataPtr->uriRecordsClock;
+    records[urisPath] = loaded;
+  }
+
+  auto it = recorded->uris.find(common::trimmed(_uri));
+  return it == recorded->uris.end() ? _uri : it->second;
+}
+
+//////////////////////////////////////////////////
+bool LocalCache::IsExcluded(const std::string &_versionedDir,
+    const std::string &_path) const
+{
+  std::ifstream in(LocalCachePrivate::ExcludedPath(_versionedDir));
+  if (!in)
+    return false;
+
+  std::string name = _path;
+  std::replace(name.begin(), name.end(), '\\', '/');
+  std::string line;
+  while (std::getline(in, line))
+  {
+    if (line == name)
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+std::string LocalCache::FetchedFilePath(const std::string &_versionedDir,
+    const std::string &_path) const
+{
+  std::string rel = _path;
+  common::changeFromUnixPath(rel);
+  if (this->dataPtr->InCacheLocation(_versionedDir))
+    return common::joinPaths(_versionedDir, rel);
+
+  std::string dir = common::absPath(_versionedDir);
+  for (const auto &layer : this->dataPtr->config->CacheLayers())
+  {
+    std::string root = common::absPath(layer);
+    if (dir.size() > root.size() && LocalCachePrivate::IsWithin(dir, root))
+    {
+      std::string layerRel = dir.substr(root.size());
+      layerRel.erase(0, layerRel.find_first_not_of("/\\"));
+      return common::joinPaths(this->dataPtr->config->CacheLocation(),
+          ".layer_files", layerRel, rel);
+    }
+  }
+  return "";
+}
+
+//////////////////////////////////////////////////
+bool LocalCache::SaveFetchedFile(const std::string &_dst,
+    const std::string &_data) const
+{
+  std::string tmpPath = tmpPathFor(_dst);
+  common::createDirectories(common::parentPath(_dst));
+  {
+    std::ofstream out(tmpPath, std::ios::out | std::ios::binary);
+    out << _data;
+    if (!out)
+    {
+      gzerr << "Unable to write [" << tmpPath << "]" << std::endl;
+      out.close();
+      common::removeFile(tmpPath);
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  fs::rename(tmpPath, _dst, ec);
+  if (ec)
+  {
+    gzerr << "Unable to write [" << _dst << "]: " << ec.message()
+          << std::endl;
+    common::removeFile(tmpPath);
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the path of a resource relative to the cache root, as stored
+/// in pack files.
+/// \param[in] _server Server of the resource.
+/// \param[in] _owner Owner of the resource.
+/// \param[in] _type "models" or "worlds".
+/// \param[in] _name Name of the resource.
+/// \param[in] _version Version of the resource.
+/// \return Relative path, using '/' separators.
+static std::string packPath(const ServerConfig &_server,
+    const std::string &_owner, const std::string &_type,
+    const std::string &_name, const std::string &_version)
+{
+  std::string serverPath = uriToPath(_server.Url());
+  std::replace(serverPath.begin(), serverPath.end(), '\\', '/');
+  return serverPath + "/" + _owner + "/" + _type + "/" + _name + "/" +
+    _version;
+}
+
+//////////////////////////////////////////////////
+bool LocalCache::ExportPack(const std::string &_path,
+    const std::vector<ModelIdentifier> &_models,
+    const std::vector<WorldIdentifier> &_worlds)
+{
+  CachePackWriter writer;
+  if (!writer.Open(_path))
+    return false;
+
+  // Packs hold complete resources. Files only found in the archive of a
+  // resource are extracted next to it, or into a staging copy for
+  // resources in read-only layers. Copies are read when the pack is
+  // closed, so they're kept until then.
+  std::string stagingDir;
+  std::size_t staged = 0;
+  auto complete = [&](const std::string &_dir) -> std::string
+  {
+    std::string archive = CacheArchive::Path(_dir);
+    if (!common::isFile(archive))
+      return _dir;
+    if (this->dataPtr->InCacheLocation(_dir))
+    {
+      CacheArchive::ExtractMissing(archive, _dir);
+      return _dir;
+    }
+
+    if (stagingDir.empty())
+      stagingDir = this->StagingDirectory();
+    std::string copy = common::joinPaths(stagingDir, std::to_string(staged++));
+    std::error_code ec;
+    fs::create_directories(copy, ec);
+    fs::copy(_dir, copy, fs::copy_options::recursive, ec);
+    if (ec || !CacheArchive::ExtractMissing(archive, copy))
+    {
+      gzwarn << "Unable to complete [" << _dir << "] from its archive"
+             << std::endl;
+      return _dir;
+    }
+    return copy;
+  };
+  auto removeStaging = [&]()
+  {
+    if (stagingDir.empty())
+      return;
+    common::removeAll(stagingDir);
+    common::removeDirectory(common::parentPath(stagingDir));
+  };
+
+  bool result = true;
+  for (const auto &id : _models)
+  {
+    auto model = this->MatchingModel(id);
+    if (!model)
+    {
+      gzerr << "Model [" << id.UniqueName() << "] is not cached" << std::endl;
+      result = false;
+      continue;
+    }
+
+    auto modelId = model.Identification();
+    if (!writer.AddResource("model", packPath(id.Server(), modelId.Owner(),
+          "models", modelId.Name(), modelId.VersionStr()),
+          complete(model.PathToModel())))
+    {
+      removeStaging();
+      return false;
+    }
+  }
 
-  auto srvModels = this->dataPtr->ModelsInServer(path);
-  for (auto &model : srvModels)
+  for (auto id : _worlds)
   {
-    model.dataPtr->id.SetServer(_id.Server());
-    auto id = model.Identification();
-    if (_id == id)
+    if (!this->MatchingWorld(id))
+    {
+      gzerr << "World [" << id.UniqueName() << "] is not cached" << std::endl;
+      result = false;
+      continue;
+    }
+
+    if (!writer.AddResource("world", packPath(id.Server(), id.Owner(),
+          "worlds", id.Name(), id.VersionStr()), complete(id.LocalPath())))
     {
-      if (_id.Version() == id.Version())
-        return model;
-      else if (tip && id.Version() > tipModel.Identification().Version())
-        tipModel = model;
+      removeStaging();
+      return false;
     }
   }
 
-  return tipModel;
+  result = writer.Close() && result;
+  removeStaging();
+  return result;
 }
 
 //////////////////////////////////////////////////
-bool LocalCache::MatchingWorld(WorldIdentifier &_id) const
+bool LocalCache::ImportPack(const std::string &_path,
+    std::size_t &_installed, std::size_t &_skipped)
 {
-  // For the tip, we have to find the highest version
-  bool tip = (_id.Version() == 0);
-  WorldIdentifier tipWorld;
+  _installed = 0;
+  _skipped = 0;
 
-  if (!this->dataPtr->config)
+  CachePackReader index;
+  if (!index.Open(_path))
     return false;
+  const auto &resources = index.Resources();
+
+  // Skip what is already available, in the cache or in a layer
+  auto roots = this->dataPtr->CacheRoots();
+  std::vector<std::size_t> pending;
+  for (std::size_t i = 0; i < resources.size(); ++i)
+  {
+    std::string rel = resources[i].path;
+    common::changeFromUnixPath(rel);
+
+    bool cached = std::any_of(roots.begin(), roots.end(),
+        [&rel](const std::string &_root)
+        {
+          return common::isDirectory(common::joinPaths(_root, rel));
+        });
+    if (cached)
+      ++_skipped;
+    else
+      pending.push_back(i);
+  }
 
-  std::string path = common::joinPaths(
-      this->dataPtr->config->CacheLocation(), uriToPath(_id.Server().Url()));
+  // Resources are extracted next to the cache, on the same filesystem, so
+  // that moving them in place is atomic.
+  // Each import gets its own staging directory, so concurrent imports
+  // don't interfere.
+  std::string stagingDir = this->StagingDirectory();
+  std::string stagingRoot = common::parentPath(stagingDir);
+  if (!pending.empty() && !common::createDirectories(stagingDir))
+  {
+    gzerr << "Unable to create directory [" << stagingDir << "]" << std::endl;
+    return false;
+  }
 
-  auto srvWorlds = this->dataPtr->WorldsInServer(path);
-  for (auto id : srvWorlds)
+  // libzip handles can't be shared between threads, so each worker opens
+  // the pack once and then takes resources from a shared queue.
+  unsigned int workers = this->dataPtr->jobs > 0 ?
+    this->dataPtr->jobs : defaultJobs();
+  workers = static_cast<unsigned int>(
+      std::min<std::size_t>(workers, pending.size()));
+
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::size_t> installed{0};
+  std::atomic<std::size_t> skipped{0};
+  std::atomic<bool> ok{true};
+  parallelFor(workers, workers, [&](std::size_t _worker)
   {
-    id.SetServer(_id.Server());
-    if (_id == id)
+    CachePackReader reader;
+    if (!reader.Open(_path))
+    {
+      ok = false;
+      return;
+    }
+
+    for (std::size_t k = next++; k < pending.size(); k = next++)
     {
-      if (_id.Version() == id.Version())
+      const auto &resource = resources[pending[k]];
+      std::string rel = resource.path;
+      common::changeFromUnixPath(rel);
+      std::string finalDir = common::joinPaths(
+          this->dataPtr->config->CacheLocation(), rel);
+      std::string tmpDir = common::joinPaths(stagingDir,
+          std::to_string(_worker) + "-" + std::to_string(pending[k]));
+
+      common::removeAll(tmpDir);
+      if (!common::createDirectories(tmpDir) ||
+          !reader.Extract(resource, tmpDir))
       {
-        _id = id;
-        return true;
+        common::removeAll(tmpDir);
+        ok = false;
+        continue;
       }
-      else if (tip && id.Version() > tipWorld.Version())
+
+      std::error_code ec;
+      fs::create_directories(fs::path(finalDir).parent_path(), ec);
+      fs::rename(tmpDir, finalDir, ec);
+      if (ec)
       {
-        tipWorld = id;
-      }
-    }
-  }
+        common::removeAll(tmpDir);
 
-  auto foundTip = !(tipWorld == WorldIdentifier());
-  if (foundTip)
-  {
-    _id = tipWorld;
-  }
+        // Another process installed it in the meantime
+        if (common::isDirectory(finalDir))
+        {
+          ++skipped;
+          continue;
+        }
+        gzerr << "Unable to install [" << finalDir << "]: " << ec.message()
+              << std::endl;
+        ok = false;
+        continue;
+      }
 
-  return foundTip;
-}
+      this->dataPtr->RecordContent(finalDir);
+      ++installed;
+    }
+  });
 
-//////////////////////////////////////////////////
-ModelIter LocalCache::MatchingModels(const ModelIdentifier &_id)
-{
-  if (_id.Name().empty() && !_id.Server().Url().Valid() && _id.Owner().empty())
-    return ModelIterFactory::Create();
+  common::removeAll(stagingDir);
+  common::removeDirectory(stagingRoot);
 
-  std::vector<Model> models;
-  for (auto iter = this->AllModels(); iter; ++iter)
-  {
-    bool matches = true;
-    if (!_id.Name().empty() && _id.Name() != iter->Identification().Name())
-      matches = false;
-    if (!_id.Owner().empty() && _id.Owner() != iter->Identification().Owner())
-      matches = false;
-    if (_id.Server().Url().Valid() &&
-        _id.Server().Url().Str() != iter->Identification().Server().Url().Str())
-      matches = false;
-    if (matches)
-      models.push_back(*iter);
-  }
-  return ModelIterFactory::Create(models);
+  _installed = installed;
+  _skipped += skipped;
+  gzmsg << "Imported " << _installed << " resources from [" << _path
+        << "], skipped " << _skipped << " already cached." << std::endl;
+  return ok;
 }
 
 //////////////////////////////////////////////////
-WorldIter LocalCache::MatchingWorlds(const WorldIdentifier &_id) const
+bool LocalCache::SaveModel(
+  const ModelIdentifier &_id, const std::string &_data, const bool _overwrite)
 {
-  if (_id.Name().empty() && !_id.Server().Url().Valid() && _id.Owner().empty())
-    return WorldIterFactory::Create();
-
-  std::vector<WorldIdentifier> worldIds;
-  for (auto iter = this->AllWorlds(); iter; ++iter)
-  {
-    bool matches = true;
-    if (!_id.Name().empty() && _id.Name() != iter->Name())
-      matches = false;
-    if (!_id.Owner().empty() && _id.Owner() != iter->Owner())
-      matches = false;
-    if (_id.Server().Url().Valid() &&
-        _id.Server().Url().Str() != iter->Server().Url().Str())
-      matches = false;
-    if (matches)
-      worldIds.push_back(iter);
-  }
-  return WorldIterFactory::Create(worldIds);
+  return this->SaveModel(_id, _data, _overwrite,
+      this->dataPtr->config->ExtractionFilter());
 }
 
 //////////////////////////////////////////////////
-bool LocalCache::SaveModel(
-  const ModelIdentifier &_id, const std::string &_data, const bool _overwrite)
+bool LocalCache::SaveModel(const ModelIdentifier &_id,
+    const std::string &_data, const bool _overwrite,
+    const ExtractFilter &_filter)
 {
   if (_id.Server().Url().Str().empty() || _id.Owner().empty() ||
       _id.Name().empty() || _id.Version() == 0)
@@ -423,193 +2137,499 @@ bool LocalCache::SaveModel(
            << std::endl;
   }
 
-  auto zipFile = common::joinPaths(modelVersionedDir, _id.Name() + ".zip");
-#ifdef _WIN32
-  std::ofstream ofs(zipFile, std::ofstream::out | std::ofstream::binary);
-#else
-  std::ofstream ofs(zipFile, std::ofstream::out);
-#endif
-  ofs << _data;
-  ofs.close();
+  // In archive mode the archive is kept next to the versioned directory and
+  // only the description files are extracted, the others are extracted on
+  // demand whatever the filter. Otherwise the download is extracted
+  // straight from memory.
+  bool archiveMode = this->dataPtr->config->CacheArchiveMode();
+  if (archiveMode)
+  {
+    auto zipFile = CacheArchive::Path(modelVersionedDir);
+    std::ofstream ofs(zipFile, std::ofstream::out | std::ofstream::binary);
+    ofs << _data;
+    ofs.close();
+
+    ScopedCacheTimer timer(CacheStatisticsRecorder::Timer::EXTRACT);
+    if (!CacheArchive::ExtractDescriptions(zipFile, modelVersionedDir))
+    {
+      gzerr << "Unable to unzip [" << zipFile << "]" << std::endl;
+      return false;
+    }
+  }
+  else
+  {
+    if (!this->dataPtr->Extract(_data, modelVersionedDir, _filter))
+    {
+      gzerr << "Unable to unzip model archive into [" << modelVersionedDir
+            << "]" << std::endl;
+      return false;
+    }
+  }
+
+  // Convert model:// URIs to Fuel URLs
+  {
+    ScopedCacheTimer timer(CacheStatisticsRecorder::Timer::FIX_PATHS);
+    std::size_t changed = 0;
+    this->dataPtr->FixPaths(modelVersionedDir, _id, changed);
+  }
+
+  // An archive kept by an earlier save in archive mode is stale now
+  if (!archiveMode && common::isFile(CacheArchive::Path(modelVersionedDir)))
+    common::removeFile(CacheArchive::Path(modelVersionedDir));
+
+  // Record the content hashes, used to verify the cache later on
+  this->dataPtr->RecordContent(modelVersionedDir);
+
+  return true;
+}
 
-  if (!Zip::Extract(zipFile, modelVersionedDir))
+//////////////////////////////////////////////////
+bool LocalCache::InstallModel(const ModelIdentifier &_id,
+    const std::string &_dir, const bool _overwrite)
+{
+  if (_id.Server().Url().Str().empty() || _id.Owner().empty() ||
+      _id.Name().empty() || _id.Version() == 0)
   {
-    gzerr << "Unable to unzip [" << zipFile << "]" << std::endl;
+    gzerr << "Incomplete model identifier, failed to install model."
+          << std::endl << _id.AsString();
+    common::removeAll(_dir);
     return false;
   }
 
+  std::string modelVersionedDir = common::joinPaths(
+      this->dataPtr->config->CacheLocation(), _id.UniqueName(),
+      _id.VersionStr());
+  if (!this->dataPtr->Install(_dir, modelVersionedDir, _overwrite))
+    return false;
+
   // Convert model:// URIs to Fuel URLs
-  this->dataPtr->FixPaths(modelVersionedDir, _id);
+  {
+    ScopedCacheTimer timer(CacheStatisticsRecorder::Timer::FIX_PATHS);
+    std::size_t changed = 0;
+    this->dataPtr->FixPaths(modelVersionedDir, _id, changed);
+  }
+
+  // Record the content hashes, used to verify the cache later on
+  this->dataPtr->RecordContent(modelVersionedDir);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::string LocalCache::StagingDirectory() const
+{
+  std::ostringstream name;
+  name << std::hex << std::random_device()() << "-"
+    << std::chrono::steady_clock::now().time_since_epoch().count();
+  return common::joinPaths(this->dataPtr->config->CacheLocation(),
+      ".staging", name.str());
+}
+
+//////////////////////////////////////////////////
+bool LocalCachePrivate::Install(const std::string &_dir,
+    const std::string &_versionedDir, bool _overwrite)
+{
+  if (common::isDirectory(_versionedDir))
+  {
+    if (!_overwrite)
+    {
+      gzerr << "Directory [" << _versionedDir << "] already exists"
+            << std::endl;
+      common::removeAll(_dir);
+      return false;
+    }
+    common::removeAll(_versionedDir);
+  }
 
-  // Cleanup the zip file.
-  if (!common::removeDirectoryOrFile(zipFile))
+  // The staging directory is on the same filesystem, so the resource
+  // appears at once
+  std::error_code ec;
+  fs::create_directories(fs::path(_versionedDir).parent_path(), ec);
+  fs::rename(_dir, _versionedDir, ec);
+  if (ec)
+    common::removeAll(_dir);
+  common::removeDirectory(common::parentPath(_dir));
+  if (ec)
   {
-    gzwarn << "Unable to remove [" << zipFile << "]" << std::endl;
+    // Another process installed it in the meantime
+    if (common::isDirectory(_versionedDir))
+      return true;
+
+    gzerr << "Unable to install [" << _versionedDir << "]: " << ec.message()
+          << std::endl;
+    return false;
   }
 
+  // An archive kept by an earlier save in archive mode is stale now, and
+  // so are the files left out by an earlier filtered save
+  if (common::isFile(CacheArchive::Path(_versionedDir)))
+    common::removeFile(CacheArchive::Path(_versionedDir));
+  if (common::isFile(ExcludedPath(_versionedDir)))
+    common::removeFile(ExcludedPath(_versionedDir));
+
   return true;
 }
 
 //////////////////////////////////////////////////
 bool LocalCachePrivate::FixPaths(const std::string &_modelVersionedDir,
-    const ModelIdentifier &_id)
+    const ModelIdentifier &_id, std::size_t &_changed) const
 {
+  _changed = 0;
+
   // Get model.config
   std::string modelConfigPath = common::joinPaths(
       _modelVersionedDir, "model.config");
 
-  // Make sure the model config file exits.
+  // Make sure the model config file exits. The other files are rewritten
+  // anyway, so that this isn't tried again.
+  bool result = true;
+  tinyxml2::XMLDocument modelConfigDoc;
   if (!common::exists(modelConfigPath))
   {
     gzerr << "model.config file does not exist in ["
       << _modelVersionedDir << ".\n";
-    return false;
+    result = false;
   }
-
   // Load the model config into tinyxml
-  tinyxml2::XMLDocument modelConfigDoc;
-  if (modelConfigDoc.LoadFile(modelConfigPath.c_str()) !=
+  else if (modelConfigDoc.LoadFile(modelConfigPath.c_str()) !=
       tinyxml2::XML_SUCCESS)
   {
     gzerr << "Unable to load model.config file[" << modelConfigPath << "]\n";
+    result = false;
+  }
+
+  // Every SDF version listed is rewritten, whatever its extension. Get the
+  // first <model> element. There really should only be one, but we are not
+  // being strict.
+  std::vector<std::string> files;
+  tinyxml2::XMLElement *modelElement = result ?
+      modelConfigDoc.FirstChildElement("model") : nullptr;
+  tinyxml2::XMLElement *sdfElement = modelElement ?
+      modelElement->FirstChildElement("sdf") : nullptr;
+  for (; sdfElement; sdfElement = sdfElement->NextSiblingElement("sdf"))
+  {
+    if (sdfElement->GetText())
+      files.push_back(common::trimmed(sdfElement->GetText()));
+  }
+
+  auto known = this->KnownModels(_modelVersionedDir, _id.Server(),
+      _id.Owner());
+  return this->RewritePaths(_modelVersionedDir, files,
+      [&_id, &known](const std::string &_uri, SdfUriType _type)
+      {
+        return FuelUri(_uri, _type, _id, known);
+      }, _changed) && result;
+}
+
+//////////////////////////////////////////////////
+bool LocalCachePrivate::FixPaths(const std::string &_worldVersionedDir,
+    const WorldIdentifier &_id, std::size_t &_changed) const
+{
+  auto known = this->KnownModels(_worldVersionedDir, _id.Server(),
+      _id.Owner());
+  return this->RewritePaths(_worldVersionedDir, {},
+      [&known](const std::string &_uri, SdfUriType _type)
+      {
+        return FuelUri(_uri, _type, known);
+      }, _changed);
+}
+
+//////////////////////////////////////////////////
+bool LocalCachePrivate::RewritePaths(const std::string &_versionedDir,
+    const std::vector<std::string> &_files,
+    const SdfUriRewriter::UriMap &_map, std::size_t &_changed) const
+{
+  _changed = 0;
+
+  // The marker is only written once every file is rewritten, so an
+  // interrupted rewrite is done again. URIs recorded earlier are stale.
+  std::string rewrittenPath = RewrittenPath(_versionedDir);
+  if (common::isFile(rewrittenPath))
+    common::removeFile(rewrittenPath);
+  if (common::isFile(UrisPath(_versionedDir)))
+    common::removeFile(UrisPath(_versionedDir));
+
+  std::set<std::string> unique(_files.begin(), _files.end());
+  std::vector<std::string> all;
+  listFiles(_versionedDir, "", all);
+  for (const auto &file : all)
+  {
+    std::string ext = common::lowercase(file.substr(
+        std::min(file.size(), file.find_last_of('.'))));
+    if (ext == ".sdf" || ext == ".urdf" || ext == ".world")
+      unique.insert(file);
+  }
+  std::vector<std::string> files(unique.begin(), unique.end());
+
+  if (this->config->LazyUriRewrite())
+    return this->RecordUris(_versionedDir, files, _map);
+
+  std::vector<char> fixed(files.size(), 0);
+  std::vector<char> changed(files.size(), 0);
+  parallelFor(files.size(), this->jobs, [&](std::size_t _i)
+  {
+    bool fileChanged = false;
+    fixed[_i] = RewriteFile(common::joinPaths(_versionedDir, files[_i]),
+        _map, fileChanged);
+    changed[_i] = fileChanged;
+  });
+
+  bool result = true;
+  for (std::size_t i = 0; i < files.size(); ++i)
+  {
+    result = result && fixed[i];
+    _changed += changed[i] ? 1u : 0u;
+  }
+  if (!result)
+    return false;
+
+  std::ofstream out(rewrittenPath, std::ios::out | std::ios::trunc);
+  if (!out)
+  {
+    gzwarn << "Unable to write [" << rewrittenPath << "]" << std::endl;
     return false;
   }
+  return true;
+}
 
-  // Get the first <model> element. There really should only be one, but
-  // we are not being strict.
-  tinyxml2::XMLElement *modelElement = modelConfigDoc.FirstChildElement(
-      "model");
+//////////////////////////////////////////////////
+bool LocalCachePrivate::RewriteFile(const std::string &_path,
+    const SdfUriRewriter::UriMap &_map, bool &_changed)
+{
+  _changed = false;
 
-  // Get the <sdf> element with the highest (most recent) version.
-  tinyxml2::XMLElement *sdfElementLatest = nullptr;
-  math::SemanticVersion maxVersion{"0.0"};
-  tinyxml2::XMLElement *sdfElement = modelElement->FirstChildElement("sdf");
-  while (sdfElement)
+  // Most files only use relative paths, they're left as they are
+  FileBuffer sdf(_path);
+  if (!sdf.Valid())
+  {
+    gzerr << "Unable to load SDF file[" << _path << "]\n";
+    return true;
+  }
+  if (!SdfUriRewriter::HasModelUri(sdf.View()))
+    return true;
+
+  // Patch the URIs where they are, documents the scan doesn't handle go
+  // through a DOM
+  std::string rewritten;
+  std::size_t count = 0;
+  if (!SdfUriRewriter::Rewrite(sdf.View(), _map, rewritten, count) &&
+      !SdfUriRewriter::RewriteDom(sdf.View(), _map, rewritten, count))
   {
-    math::SemanticVersion version;
+    gzerr << "Unable to load SDF file[" << _path << "]\n";
+    return true;
+  }
+  if (count == 0)
+    return true;
 
-    auto versionAttribute = sdfElement->Attribute("version");
-    if (nullptr == versionAttribute)
-    {
-      version.Parse("0.0.1");
-      gzwarn << "<sdf> element missing version attribute, assuming version ["
-              << version << "]" << std::endl;
-    }
-    else
+  // Replace the file rather than writing into it, it may be mapped
+  std::string tmpPath = tmpPathFor(_path);
+  {
+    std::ofstream out(tmpPath, std::ios::out | std::ios::binary);
+    out.write(rewritten.data(),
+        static_cast<std::streamsize>(rewritten.size()));
+    if (!out)
     {
-      version.Parse(versionAttribute);
+      gzerr << "Unable to write SDF file[" << tmpPath << "]\n";
+      out.close();
+      common::removeFile(tmpPath);
+      return false;
     }
+  }
+  if (!common::moveFile(tmpPath, _path))
+  {
+    gzerr << "Unable to write SDF file[" << _path << "]\n";
+    return false;
+  }
 
-    if (version > maxVersion)
-    {
-      maxVersion = version;
-      sdfElementLatest = sdfElement;
-    }
+  _changed = true;
+  return true;
+}
 
-    sdfElement = sdfElement->NextSiblingElement("sdf");
-  }
+//////////////////////////////////////////////////
+bool LocalCachePrivate::RecordUris(const std::string &_versionedDir,
+    const std::vector<std::string> &_files,
+    const SdfUriRewriter::UriMap &_map) const
+{
+  std::vector<std::map<std::string, std::string>> fileUris(_files.size());
+  parallelFor(_files.size(), this->jobs, [&](std::size_t _i)
+  {
+    ScanFile(common::joinPaths(_versionedDir, _files[_i]), _map,
+        fileUris[_i]);
+  });
 
-  // Get name of the model SDF file.
-  std::string modelSdfFilePath = common::joinPaths(_modelVersionedDir,
-      sdfElementLatest->GetText());
+  std::map<std::string, std::string> uris;
+  for (const auto &scanned : fileUris)
+    uris.insert(scanned.begin(), scanned.end());
 
-  // Load the model SDF file
-  tinyxml2::XMLDocument modelSdfDoc;
-  if (modelSdfDoc.LoadFile(modelSdfFilePath.c_str()) !=
-      tinyxml2::XML_SUCCESS)
+  std::string urisPath = UrisPath(_versionedDir);
+  std::string tmpPath = tmpPathFor(urisPath);
+  {
+    std::ofstream out(tmpPath, std::ios::out | std::ios::trunc);
+    for (const auto &[uri, url] : uris)
+      out << uri << '\t' << url << '\n';
+    if (!out)
+    {
+      gzwarn << "Unable to write [" << tmpPath << "]" << std::endl;
+      out.close();
+      common::removeFile(tmpPath);
+      return false;
+    }
+  }
+  if (!common::moveFile(tmpPath, urisPath))
   {
-    gzerr << "Unable to load SDF file[" << modelSdfFilePath << "]\n";
+    gzwarn << "Unable to write [" << urisPath << "]" << std::endl;
     return false;
   }
+  return true;
+}
 
-  // Process each <model>
-  tinyxml2::XMLElement *modelElem =
-    modelSdfDoc.RootElement()->FirstChildElement("model");
-  while (modelElem)
+//////////////////////////////////////////////////
+void LocalCachePrivate::ScanFile(const std::string &_path,
+    const SdfUriRewriter::UriMap &_map,
+    std::map<std::string, std::string> &_uris)
+{
+  FileBuffer sdf(_path);
+  if (!sdf.Valid())
   {
-    // Process each <link>
-    tinyxml2::XMLElement *linkElem = modelElem->FirstChildElement("link");
-    while (linkElem)
+    gzerr << "Unable to load SDF file[" << _path << "]\n";
+    return;
+  }
+  if (!SdfUriRewriter::HasModelUri(sdf.View()))
+    return;
+
+  // Every URI is kept, so the rewrite only records them. URIs that
+  // can't be written on a line of the record are left out.
+  std::map<std::string, std::string> found;
+  SdfUriRewriter::UriMap record =
+    [&](const std::string &_uri, SdfUriType _type)
     {
-      // Process each <collision>
-      tinyxml2::XMLElement *collisionElem =
-        linkElem->FirstChildElement("collision");
-      while (collisionElem)
+      std::string uri = common::trimmed(_uri);
+      std::string url = _map(uri, _type);
+      if (url != uri && (uri + url).find_first_of("\t\r\n") ==
+          std::string::npos)
       {
-        this->FixPathsInGeomElement(
-            collisionElem->FirstChildElement("geometry"), _id);
-        // Next collision element.
-        collisionElem = collisionElem->NextSiblingElement("collision");
+        found[uri] = url;
       }
+      return _uri;
+    };
 
-      // Process each <visual>
-      tinyxml2::XMLElement *visualElem =
-        linkElem->FirstChildElement("visual");
-      while (visualElem)
-      {
-        this->FixPathsInGeomElement(
-            visualElem->FirstChildElement("geometry"), _id);
-        this->FixPathsInMaterialElement(
-            visualElem->FirstChildElement("material"), _id);
-        visualElem = visualElem->NextSiblingElement("visual");
-      }
-      linkElem = linkElem->NextSiblingElement("link");
+  std::string unchanged;
+  std::size_t count = 0;
+  if (!SdfUriRewriter::Rewrite(sdf.View(), record, unchanged, count))
+  {
+    found.clear();
+    if (!SdfUriRewriter::RewriteDom(sdf.View(), record, unchanged, count))
+    {
+      gzerr << "Unable to load SDF file[" << _path << "]\n";
+      return;
     }
-    modelElem = modelElem->NextSiblingElement("model");
   }
+  _uris.insert(found.begin(), found.end());
+}
 
-  // Process each <actor>
-  auto actorElem = modelSdfDoc.RootElement()->FirstChildElement("actor");
-  while (actorElem)
+//////////////////////////////////////////////////
+std::map<std::string, std::string> LocalCachePrivate::KnownModels(
+    const std::string &_versionedDir, const ServerConfig &_server,
+    const std::string &_owner) const
+{
+  std::map<std::string, std::string> known;
+
+  // Dependencies name their owner, they're read the way
+  // FuelClient::ModelDependencies reads them
+  gz::msgs::FuelMetadata meta;
+  bool parsed = false;
+  std::string metadataPath = common::joinPaths(_versionedDir,
+      "metadata.pbtxt");
+  std::string modelConfigPath = common::joinPaths(_versionedDir,
+      "model.config");
+  if (common::isFile(metadataPath))
   {
-    // Process each <skin>
-    auto skinElem = actorElem->FirstChildElement("skin");
-    while (skinElem)
-    {
-      // Process <filename>
-      auto filenameElem = skinElem->FirstChildElement("filename");
-      if (filenameElem)
-      {
-        this->FixPathsInUri(filenameElem, _id);
-      }
-      skinElem = skinElem->NextSiblingElement("skin");
-    }
-    // Process each <animation>
-    auto animationElem = actorElem->FirstChildElement("animation");
-    while (animationElem)
+    std::ifstream in(metadataPath);
+    std::string str((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    parsed = google::protobuf::TextFormat::ParseFromString(str, &meta);
+  }
+  else if (common::isFile(modelConfigPath))
+  {
+    std::ifstream in(modelConfigPath);
+    std::string str((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    parsed = gz::msgs::ConvertFuelMetadata(str, meta);
+  }
+  for (int i = 0; parsed && i < meta.dependencies_size(); ++i)
+  {
+    const std::string &uri = meta.dependencies(i).uri();
+    FuelUrlParts parts;
+    if (FuelUrlParser::Classify(uri, parts) != FuelUrlType::MODEL)
+      continue;
+
+    std::string url = std::string(parts.scheme) + "://" +
+        std::string(parts.server) + '/';
+    if (!parts.apiVersion.empty())
+      url += std::string(parts.apiVersion) + '/';
+    known.emplace(std::string(parts.name), url + std::string(parts.owner) +
+        "/models/" + std::string(parts.name));
+  }
+
+  // Models of the same owner that are cached, in any layer
+  for (const auto &root : this->CacheRoots())
+  {
+    std::string modelsDir = common::joinPaths(root,
+        uriToPath(_server.Url()), _owner, "models");
+    if (!common::isDirectory(modelsDir))
+      continue;
+
+    common::DirIter end;
+    for (common::DirIter iter(modelsDir); iter != end; ++iter)
     {
-      // Process <filename>
-      auto filenameElem = animationElem->FirstChildElement("filename");
-      if (filenameElem)
-      {
-        this->FixPathsInUri(filenameElem, _id);
-      }
-      animationElem = animationElem->NextSiblingElement("animation");
+      if (!common::isDirectory(*iter))
+        continue;
+      std::string name = common::basename(*iter);
+      known.emplace(name, _server.Url().Str() + '/' + _server.Version() +
+          '/' + _owner + "/models/" + name);
     }
-    actorElem = actorElem->NextSiblingElement("actor");
   }
-  modelSdfDoc.SaveFile(modelSdfFilePath.c_str());
+  return known;
+}
 
-  return true;
+//////////////////////////////////////////////////
+std::string LocalCachePrivate::FuelModelUri(
+    const std::map<std::string, std::string> &_known,
+    const std::string &_uri)
+{
+  std::string prefix = "model://";
+  std::string uri = common::trimmed(_uri);
+  if (uri.compare(0, prefix.size(), prefix) != 0)
+    return _uri;
+
+  std::string name = uri.substr(prefix.size(),
+      uri.find('/', prefix.size()) - prefix.size());
+  auto it = _known.find(name);
+  if (name.empty() || it == _known.end())
+    return _uri;
+  return it->second;
 }
 
 //////////////////////////////////////////////////
-void LocalCachePrivate::FixPathsInUri(tinyxml2::XMLElement *_elem,
-    const ModelIdentifier &_id)
+std::string LocalCachePrivate::FuelUri(const std::string &_uri,
+    SdfUriType _type, const ModelIdentifier &_id,
+    const std::map<std::string, std::string> &_known)
 {
-  if (!_elem)
-    return;
+  // Included models are only rewritten when their owner is known
+  if (_type == SdfUriType::MODEL)
+    return FuelModelUri(_known, _uri);
 
-  std::string oldUri = _elem->GetText();
   std::string prefix =  "model://";
 
   // Make sure the URI is of the form model://
-  if (oldUri.find(prefix) == std::string::npos)
-    return;
+  if (_uri.find(prefix) == std::string::npos)
+    return _uri;
 
-  int firstSlash = oldUri.find('/', prefix.size()+1);
+  auto firstSlash = _uri.find('/', prefix.size()+1);
+  if (firstSlash == std::string::npos)
+    return _uri;
 
-  auto resourceName = oldUri.substr(prefix.size(), firstSlash - prefix.size());
+  auto resourceName = _uri.substr(prefix.size(), firstSlash - prefix.size());
 
   if (resourceName != _id.Name())
   {
@@ -626,11 +2646,10 @@ void LocalCachePrivate::FixPathsInUri(tinyxml2::XMLElement *_elem,
            << "], fix your SDF file!" << std::endl;
   }
 
-  auto filePath = oldUri.substr(firstSlash);
+  auto filePath = _uri.substr(firstSlash);
 
   // Construct a model file URL used to download from the server
-  auto fuelUrl =
-      _id.Server().Url().Str() + '/' +
+  return _id.Server().Url().Str() + '/' +
       _id.Server().Version() + '/' +
       _id.Owner() +
       "/models/" +
@@ -638,114 +2657,72 @@ void LocalCachePrivate::FixPathsInUri(tinyxml2::XMLElement *_elem,
        _id.VersionStr() +
       "/files" +
        filePath;
-
-  _elem->SetText(fuelUrl.c_str());
 }
 
 //////////////////////////////////////////////////
-void LocalCachePrivate::FixPathsInMaterialElement(
-    tinyxml2::XMLElement *_matElem,
-    const ModelIdentifier &_id)
+std::string LocalCachePrivate::FuelUri(const std::string &_uri,
+    SdfUriType _type, const std::map<std::string, std::string> &_known)
 {
-  if (!_matElem)
-    return;
-
-  // Get the <script> element, if present.
-  tinyxml2::XMLElement *scriptElem = _matElem->FirstChildElement("script");
+  // Models used by a world are only rewritten when their owner is known.
+  // Files are taken from the latest version of their model.
+  std::string modelUrl = FuelModelUri(_known, _uri);
+  if (_type == SdfUriType::MODEL || modelUrl == _uri)
+    return modelUrl;
+
+  std::string uri = common::trimmed(_uri);
+  auto firstSlash = uri.find('/', std::string("model://").size());
+  if (firstSlash == std::string::npos)
+    return _uri;
+  return modelUrl + "/tip/files" + uri.substr(firstSlash);
+}
 
-  if (scriptElem)
+//////////////////////////////////////////////////
+bool LocalCache::InstallWorld(WorldIdentifier &_id, const std::string &_dir,
+    const bool _overwrite)
+{
+  if (!_id.Server().Url().Valid() || _id.Owner().empty() ||
+      _id.Name().empty() || _id.Version() == 0)
   {
-    tinyxml2::XMLElement *uriElem = scriptElem->FirstChildElement("uri");
-    // Convert the "model://" URI pattern to file://
-    while (uriElem)
-    {
-      this->FixPathsInUri(uriElem, _id);
-      uriElem = uriElem->NextSiblingElement("uri");
-    }
+    gzerr << "Incomplete world identifier, failed to install world."
+          << std::endl << _id.AsString();
+    common::removeAll(_dir);
+    return false;
   }
 
-  // Get the <pbr> element, if present.
-  tinyxml2::XMLElement *pbrElem = _matElem->FirstChildElement("pbr");
-  if (pbrElem)
+  auto worldVersionedDir = common::joinPaths(
+      this->dataPtr->config->CacheLocation(), _id.UniqueName(),
+      _id.VersionStr());
+  if (!this->dataPtr->Install(_dir, worldVersionedDir, _overwrite))
+    return false;
+
+  // Convert model:// URIs to Fuel URLs
   {
-    std::vector<std::string> workflows{"metal", "specular"};
-    for (auto workflow : workflows)
-    {
-      tinyxml2::XMLElement *workflowElem =
-          pbrElem->FirstChildElement(workflow.c_str());
-      if (workflowElem)
-      {
-        tinyxml2::XMLElement *albedoElem =
-            workflowElem->FirstChildElement("albedo_map");
-        if (albedoElem)
-          this->FixPathsInUri(albedoElem, _id);
-        tinyxml2::XMLElement *normalElem =
-            workflowElem->FirstChildElement("normal_map");
-        if (normalElem)
-          this->FixPathsInUri(normalElem, _id);
-        tinyxml2::XMLElement *envElem =
-            workflowElem->FirstChildElement("environment_map");
-        if (envElem)
-          this->FixPathsInUri(envElem, _id);
-        tinyxml2::XMLElement *emissiveElem =
-            workflowElem->FirstChildElement("emissive_map");
-        if (emissiveElem)
-          this->FixPathsInUri(emissiveElem, _id);
-        tinyxml2::XMLElement *lightElem =
-            workflowElem->FirstChildElement("light_map");
-        if (lightElem)
-          this->FixPathsInUri(lightElem, _id);
-        // metal workflow specific elements
-        if (workflow == "metal")
-        {
-          tinyxml2::XMLElement *metalnessElem =
-              workflowElem->FirstChildElement("metalness_map");
-          if (metalnessElem)
-            this->FixPathsInUri(metalnessElem, _id);
-          tinyxml2::XMLElement *roughnessElem =
-              workflowElem->FirstChildElement("roughness_map");
-          if (roughnessElem)
-            this->FixPathsInUri(roughnessElem, _id);
-        }
-        // specular workflow specific elements
-        else if (workflow == "specular")
-        {
-          tinyxml2::XMLElement *specularElem =
-              workflowElem->FirstChildElement("specular_map");
-          if (specularElem)
-            this->FixPathsInUri(specularElem, _id);
-          tinyxml2::XMLElement *glossinessElem =
-              workflowElem->FirstChildElement("glossiness_map");
-          if (glossinessElem)
-            this->FixPathsInUri(glossinessElem, _id);
-        }
-      }
-    }
+    ScopedCacheTimer timer(CacheStatisticsRecorder::Timer::FIX_PATHS);
+    std::size_t changed = 0;
+    this->dataPtr->FixPaths(worldVersionedDir, _id, changed);
   }
-}
 
+  // Record the content hashes, used to verify the cache later on
+  this->dataPtr->RecordContent(worldVersionedDir);
 
-//////////////////////////////////////////////////
-void LocalCachePrivate::FixPathsInGeomElement(tinyxml2::XMLElement *_geomElem,
-    const ModelIdentifier &_id)
-{
-  if (!_geomElem)
-    return;
-
-  // Get the mesh element, if present.
-  tinyxml2::XMLElement *meshElem = _geomElem->FirstChildElement("mesh");
+  _id.SetLocalPath(worldVersionedDir);
+  gzmsg << "Saved world at:" << std::endl
+         << "  " << worldVersionedDir << std::endl;
 
-  if (meshElem)
-  {
-    tinyxml2::XMLElement *uriElem = meshElem->FirstChildElement("uri");
-    // Convert the "model://" URI pattern to file://
-    this->FixPathsInUri(uriElem, _id);
-  }
+  return true;
 }
 
 //////////////////////////////////////////////////
 bool LocalCache::SaveWorld(
   WorldIdentifier &_id, const std::string &_data, const bool _overwrite)
+{
+  return this->SaveWorld(_id, _data, _overwrite,
+      this->dataPtr->config->ExtractionFilter());
+}
+
+//////////////////////////////////////////////////
+bool LocalCache::SaveWorld(WorldIdentifier &_id, const std::string &_data,
+    const bool _overwrite, const ExtractFilter &_filter)
 {
   if (!_id.Server().Url().Valid() || _id.Owner().empty() ||
       _id.Name().empty() || _id.Version() == 0)
@@ -774,26 +2751,49 @@ bool LocalCache::SaveWorld(
            << std::endl;
   }
 
-  auto zipFile = common::joinPaths(worldVersionedDir, _id.Name() + ".zip");
-  #ifdef _WIN32
+  // In archive mode the archive is kept next to the versioned directory and
+  // only the description files are extracted, the others are extracted on
+  // demand whatever the filter. Otherwise the download is extracted
+  // straight from memory.
+  bool archiveMode = this->dataPtr->config->CacheArchiveMode();
+  if (archiveMode)
+  {
+    auto zipFile = CacheArchive::Path(worldVersionedDir);
     std::ofstream ofs(zipFile, std::ofstream::out | std::ofstream::binary);
-  #else
-    std::ofstream ofs(zipFile, std::ofstream::out);
-  #endif
-  ofs << _data;
-  ofs.close();
+    ofs << _data;
+    ofs.close();
 
-  if (!Zip::Extract(zipFile, worldVersionedDir))
+    ScopedCacheTimer timer(CacheStatisticsRecorder::Timer::EXTRACT);
+    if (!CacheArchive::ExtractDescriptions(zipFile, worldVersionedDir))
+    {
+      gzerr << "Unable to unzip [" << zipFile << "]" << std::endl;
+      return false;
+    }
+  }
+  else
   {
-    gzerr << "Unable to unzip [" << zipFile << "]" << std::endl;
-    return false;
+    if (!this->dataPtr->Extract(_data, worldVersionedDir, _filter))
+    {
+      gzerr << "Unable to unzip world archive into [" << worldVersionedDir
+            << "]" << std::endl;
+      return false;
+    }
   }
 
-  if (!common::removeDirectoryOrFile(zipFile))
+  // Convert model:// URIs to Fuel URLs
   {
-    gzwarn << "Unable to remove [" << zipFile << "]" << std::endl;
+    ScopedCacheTimer timer(CacheStatisticsRecorder::Timer::FIX_PATHS);
+    std::size_t changed = 0;
+    this->dataPtr->FixPaths(worldVersionedDir, _id, changed);
   }
 
+  // An archive kept by an earlier save in archive mode is stale now
+  if (!archiveMode && common::isFile(CacheArchive::Path(worldVersionedDir)))
+    common::removeFile(CacheArchive::Path(worldVersionedDir));
+
+  // Record the content hashes, used to verify the cache later on
+  this->dataPtr->RecordContent(worldVersionedDir);
+
   _id.SetLocalPath(worldVersionedDir);
   gzmsg << "Saved world at:" << std::endl
          << "  " << worldVersionedDir << std::endl;
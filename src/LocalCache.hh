@@ -18,9 +18,14 @@
 #ifndef GZ_FUEL_TOOLS_LOCALCACHE_HH_
 #define GZ_FUEL_TOOLS_LOCALCACHE_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "gz/fuel_tools/CacheGcPolicy.hh"
+#include "gz/fuel_tools/ExtractFilter.hh"
 #include "gz/fuel_tools/Helpers.hh"
 #include "gz/fuel_tools/Model.hh"
 #include "gz/fuel_tools/ModelIter.hh"
@@ -40,6 +45,28 @@ namespace gz::fuel_tools
   class LocalCachePrivate;
   class ModelIdentifier;
 
+  /// \brief Statistics of the blob store used to deduplicate cached files.
+  /// \sa ClientConfig::SetCacheDeduplication
+  struct GZ_FUEL_TOOLS_VISIBLE BlobStoreStatistics
+  {
+    /// \brief Number of blobs.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t blobs = 0;
+
+    /// \brief Bytes used by the blobs.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t bytes = 0;
+
+    /// \brief Bytes that would be used by duplicated files without the
+    /// blob store.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t savedBytes = 0;
+
+    /// \brief Number of blobs not used by any cached resource.
+    // cppcheck-suppress unusedStructMember
+    public: std::uint64_t unreferenced = 0;
+  };
+
   /// \brief Class for managing stuff in the local cache
   class GZ_FUEL_TOOLS_VISIBLE LocalCache
   {
@@ -50,6 +77,18 @@ namespace gz::fuel_tools
     /// \brief destructor
     public: virtual ~LocalCache();
 
+    /// \brief Set the maximum number of threads used to scan the cache.
+    /// Owner directories are scanned concurrently, which mostly helps on
+    /// large caches and on network filesystems. Downloaded archives are
+    /// extracted with ClientConfig::ExtractJobs() threads instead.
+    /// \param[in] _jobs Number of threads, 0 to use the hardware
+    /// concurrency (the default).
+    public: void SetJobs(unsigned int _jobs);
+
+    /// \brief Get the maximum number of threads used to scan the cache.
+    /// \return Number of threads, 0 means the hardware concurrency.
+    public: unsigned int Jobs() const;
+
     /// \brief Get all models in offline cache
     /// \return Model iterator
     public: virtual ModelIter AllModels();
@@ -92,6 +131,20 @@ namespace gz::fuel_tools
         const std::string &_data,
         const bool _overwrite);
 
+    /// \brief Add a model from packed data to the local cache, extracting
+    /// only some of its files. The others are recorded, see IsExcluded.
+    /// \param[in] _id A completely populated ID
+    /// \param[in] _data Compressed content of the model
+    /// \param[in] _overwrite Overwrite model if already exists.
+    /// \param[in] _filter Files to extract, instead of the filter of the
+    /// client configuration.
+    /// \returns True if the model was successfully added to the local cache.
+    public: bool SaveModel(
+        const ModelIdentifier &_id,
+        const std::string &_data,
+        const bool _overwrite,
+        const ExtractFilter &_filter);
+
     /// \brief Add a world from packed data to the local cache
     /// \param[out] _id A completely populated ID
     /// \param[in] _data Compressed content of the world
@@ -102,6 +155,184 @@ namespace gz::fuel_tools
         const std::string &_data,
         const bool _overwrite);
 
+    /// \brief Add a world from packed data to the local cache, extracting
+    /// only some of its files. The others are recorded, see IsExcluded.
+    /// \param[out] _id A completely populated ID
+    /// \param[in] _data Compressed content of the world
+    /// \param[in] _overwrite Overwrite world if already exists.
+    /// \param[in] _filter Files to extract, instead of the filter of the
+    /// client configuration.
+    /// \returns True if the world was successfully added to the local cache
+    public: bool SaveWorld(
+        WorldIdentifier &_id,
+        const std::string &_data,
+        const bool _overwrite,
+        const ExtractFilter &_filter);
+
+    /// \brief Add a model that was already extracted to the local cache.
+    /// \param[in] _id A completely populated ID
+    /// \param[in] _dir Directory the model was extracted to, usually one
+    /// returned by StagingDirectory. It's moved into the cache, or removed
+    /// if the model can't be added.
+    /// \param[in] _overwrite Overwrite model if already exists.
+    /// \returns True if the model was successfully added to the local cache.
+    /// \sa SaveModel
+    public: bool InstallModel(
+        const ModelIdentifier &_id,
+        const std::string &_dir,
+        const bool _overwrite);
+
+    /// \brief Add a world that was already extracted to the local cache.
+    /// \param[out] _id A completely populated ID
+    /// \param[in] _dir Directory the world was extracted to, usually one
+    /// returned by StagingDirectory. It's moved into the cache, or removed
+    /// if the world can't be added.
+    /// \param[in] _overwrite Overwrite world if already exists.
+    /// \returns True if the world was successfully added to the local cache.
+    /// \sa SaveWorld
+    public: bool InstallWorld(
+        WorldIdentifier &_id,
+        const std::string &_dir,
+        const bool _overwrite);
+
+    /// \brief Get a new directory to prepare resources in before they're
+    /// installed. It's on the same filesystem as the cache and unique, so
+    /// concurrent installs don't interfere. The directory isn't created.
+    /// \return Path of the directory.
+    public: std::string StagingDirectory() const;
+
+    /// \brief Extract a file of a resource saved in archive mode from its
+    /// archive, if it's not on disk yet.
+    /// \param[in] _versionedDir Path to a versioned resource directory in the
+    /// cache location. Files in cache layers aren't extracted.
+    /// \param[in] _path Path of the file relative to _versionedDir.
+    /// \return True if the file was extracted.
+    /// \sa ClientConfig::SetCacheArchiveMode
+    public: bool MaterializeFile(const std::string &_versionedDir,
+                                 const std::string &_path) const;
+
+    /// \brief Whether a file of a resource was left out by the extraction
+    /// filter when the resource was saved, so it has to be fetched from the
+    /// server.
+    /// \param[in] _versionedDir Path to a versioned resource directory.
+    /// \param[in] _path Path of the file relative to _versionedDir.
+    /// \return True if the file was left out.
+    /// \sa ClientConfig::SetExtractionFilter
+    public: bool IsExcluded(const std::string &_versionedDir,
+                            const std::string &_path) const;
+
+    /// \brief Get where a file left out by the extraction filter is kept
+    /// once it's fetched. It's next to the other files of resources in the
+    /// cache location. Layers are read-only, so files of their resources
+    /// are kept in the cache location, under its .layer_files directory.
+    /// \param[in] _versionedDir Path to a versioned resource directory.
+    /// \param[in] _path Path of the file relative to _versionedDir.
+    /// \return Path of the file, or empty if _versionedDir is in neither
+    /// the cache location nor a layer.
+    /// \sa IsExcluded
+    public: std::string FetchedFilePath(const std::string &_versionedDir,
+                                        const std::string &_path) const;
+
+    /// \brief Save a fetched file. It's written to a temporary file of its
+    /// own first, so concurrent saves and lookups never see a partial file.
+    /// \param[in] _dst Path returned by FetchedFilePath.
+    /// \param[in] _data Content of the file.
+    /// \return True if the file was saved.
+    public: bool SaveFetchedFile(const std::string &_dst,
+                                 const std::string &_data) const;
+
+    /// \brief Make sure the model:// URIs of a cached model are rewritten
+    /// to Fuel URLs. Saving a model rewrites them, this finishes a save
+    /// that was interrupted, or a model saved by a version that only
+    /// rewrote its main SDF file. Rewritten models are marked, so this is
+    /// cheap once done. Models in cache layers are left as they are.
+    /// \param[in] _model Cached model.
+    /// \return True if the model's URIs are rewritten.
+    public: bool FixPaths(const Model &_model);
+
+    /// \brief Make sure the model:// URIs of a cached world, such as the
+    /// URIs of the models it includes, are rewritten to Fuel URLs, see
+    /// FixPaths(const Model &).
+    /// \param[in] _id Cached world, with its local path.
+    /// \return True if the world's URIs are rewritten.
+    public: bool FixPaths(const WorldIdentifier &_id);
+
+    /// \brief Rewrite the model:// URIs of every model and world in the
+    /// cache location that isn't rewritten yet, see FixPaths. This migrates
+    /// resources cached by versions that only rewrote the main SDF file of
+    /// models, and finishes saves that were interrupted. Lookups never
+    /// rewrite cached files, so it has to be run explicitly. Resources in
+    /// cache layers are skipped.
+    /// \param[out] _fixed Number of resources whose URIs were rewritten.
+    /// \return True if the URIs of every resource in the cache location
+    /// are rewritten.
+    public: bool FixAllPaths(std::size_t &_fixed);
+
+    /// \brief Get the Fuel URL of a model:// URI found in a cached model
+    /// or world saved with lazy URI rewriting, whose files keep their
+    /// URIs. The URLs recorded for the most recently used resources are
+    /// kept in memory, and read again when their record changes.
+    /// \param[in] _path Path to the versioned directory of the resource,
+    /// or to a file within it.
+    /// \param[in] _uri URI as found in the resource's files.
+    /// \return Fuel URL recorded for the URI, or _uri if there's none.
+    /// \sa ClientConfig::SetLazyUriRewrite
+    public: std::string ResolveUri(const std::string &_path,
+                const std::string &_uri);
+
+    /// \brief Verify the content of the cached models and worlds against
+    /// the manifest of file hashes recorded when they were saved. Files are
+    /// hashed in parallel, see SetJobs(). Resources saved before manifests
+    /// were introduced are skipped.
+    /// \param[out] _badModels Models with missing or modified files.
+    /// \param[out] _badWorlds Worlds with missing or modified files.
+    /// \return True if no damaged resource was found.
+    public: bool Verify(std::vector<ModelIdentifier> &_badModels,
+                        std::vector<WorldIdentifier> &_badWorlds);
+
+    /// \brief Compute statistics of the blob store.
+    /// \return Blob store statistics.
+    public: BlobStoreStatistics BlobStoreStats() const;
+
+    /// \brief Remove the blobs that are no longer used by any cached
+    /// resource, for example after a resource was deleted.
+    /// \return Number of bytes reclaimed.
+    public: std::uint64_t PruneBlobs();
+
+    /// \brief Remove superseded versions of the cached models and worlds.
+    /// Only the cache location is collected, layers are read-only.
+    /// Resources are processed in parallel in order of their unique names,
+    /// see SetJobs(), and each version is removed along with its manifest
+    /// and archive, so the collection can stop at any point and be resumed
+    /// by the next one, see CacheGcPolicy::timeBudget. Blobs left unused by
+    /// the removed versions are pruned.
+    /// \param[in] _policy Versions to keep.
+    /// \return What was removed and how much space was reclaimed.
+    public: CacheGcReport CollectGarbage(const CacheGcPolicy &_policy);
+
+    /// \brief Write cached models and worlds to a single pack file, which
+    /// can be imported in another cache with ImportPack().
+    /// \param[in] _path Path of the pack file.
+    /// \param[in] _models Models to export. Identifiers without a version
+    /// select the latest cached version.
+    /// \param[in] _worlds Worlds to export, same as _models.
+    /// \return True if every resource was found and written.
+    public: bool ExportPack(const std::string &_path,
+                const std::vector<ModelIdentifier> &_models,
+                const std::vector<WorldIdentifier> &_worlds);
+
+    /// \brief Install the resources of a pack file in the cache. Resources
+    /// are extracted in parallel, see SetJobs(), to a staging directory and
+    /// moved in place once complete, so an interrupted import never leaves
+    /// a partial resource behind. Resources already in the cache, or in
+    /// one of its layers, are skipped.
+    /// \param[in] _path Path of the pack file.
+    /// \param[out] _installed Number of resources installed.
+    /// \param[out] _skipped Number of resources that were already cached.
+    /// \return True if every resource was installed or skipped.
+    public: bool ImportPack(const std::string &_path,
+                std::size_t &_installed, std::size_t &_skipped);
+
     /// \brief Internal data.
     private: std::shared_ptr<LocalCachePrivate> dataPtr;
   };
@@ -17,9 +17,15 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <fstream>
+#include <iterator>
 #include <set>
 #include <string>
+#include <thread>
+#include <vector>
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include <gz/common/testing/TestPaths.hh>
@@ -28,7 +34,9 @@
 #include "gz/fuel_tools/ClientConfig.hh"
 #include "gz/fuel_tools/Helpers.hh"
 #include "gz/fuel_tools/WorldIdentifier.hh"
+#include "gz/fuel_tools/Zip.hh"
 
+#include "CacheStatisticsRecorder.hh"
 #include "LocalCache.hh"
 
 using namespace gz;
@@ -256,6 +264,46 @@ TEST_F(LocalCacheTest, AllModels)
       "localhost%3A8001/alice/models/am1"));
 }
 
+/////////////////////////////////////////////////
+/// \brief Scanning with several threads gives the same result, in the same
+/// order, as a serial scan
+TEST_F(LocalCacheTest, AllModelsJobs)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  createLocal6Models(conf);
+  createLocal3Models(conf);
+
+  // Worlds live on the same servers, no need to add them twice
+  ClientConfig worldConf;
+  createLocal6Worlds(worldConf);
+  createLocal3Worlds(worldConf);
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  EXPECT_EQ(0u, cache.Jobs());
+
+  cache.SetJobs(1u);
+  EXPECT_EQ(1u, cache.Jobs());
+  std::vector<std::string> serialModels;
+  for (auto iter = cache.AllModels(); iter; ++iter)
+    serialModels.push_back(iter->Identification().UniqueName());
+  std::vector<std::string> serialWorlds;
+  for (auto iter = cache.AllWorlds(); iter; ++iter)
+    serialWorlds.push_back(iter->UniqueName());
+  EXPECT_EQ(9u, serialModels.size());
+  EXPECT_EQ(9u, serialWorlds.size());
+
+  cache.SetJobs(4u);
+  std::vector<std::string> parallelModels;
+  for (auto iter = cache.AllModels(); iter; ++iter)
+    parallelModels.push_back(iter->Identification().UniqueName());
+  std::vector<std::string> parallelWorlds;
+  for (auto iter = cache.AllWorlds(); iter; ++iter)
+    parallelWorlds.push_back(iter->UniqueName());
+  EXPECT_EQ(serialModels, parallelModels);
+  EXPECT_EQ(serialWorlds, parallelWorlds);
+}
+
 /////////////////////////////////////////////////
 /// \brief Get all models that match some fields
 /// \brief Iterate through all models in cache
@@ -297,6 +345,22 @@ TEST_F(LocalCacheTest, MatchingModels)
     ++iter2;
   }
   EXPECT_EQ(2u, uniqueNames.size());
+  // Owner only, any name
+  ModelIdentifier alice;
+  alice.SetServer(conf.Servers().front());
+  alice.SetOwner("alice");
+  std::set<std::string> aliceNames;
+  for (auto aliceIter = cache.MatchingModels(alice); aliceIter; ++aliceIter)
+  {
+    EXPECT_EQ("alice", aliceIter->Identification().Owner());
+    aliceNames.insert(aliceIter->Identification().Name());
+  }
+  EXPECT_LT(1u, aliceNames.size());
+  EXPECT_EQ(1u, aliceNames.count("am1"));
+
+  // Unknown owner
+  alice.SetOwner("nobody");
+  EXPECT_FALSE(cache.MatchingModels(alice));
 }
 
 /////////////////////////////////////////////////
@@ -457,3 +521,1048 @@ TEST_F(LocalCacheTest, MatchingWorld)
   bogus3.SetName("tm3");
   EXPECT_FALSE(cache.MatchingWorld(bogus3));
 }
+
+/// \brief Packs a small world into a zip archive
+/// \param[out] _zipData Content of the archive
+/// \param[in] _sdf Content of the world file
+void createEmptyWorldZip(std::string &_zipData,
+    const std::string &_sdf =
+    "<?xml version=\"1.0\"?><sdf version=\"1.6\"></sdf>")
+{
+  ASSERT_TRUE(common::createDirectories(common::joinPaths("src", "empty")));
+  {
+    std::ofstream fout(common::joinPaths("src", "empty", "empty.sdf"));
+    fout << _sdf;
+  }
+  common::removeFile("empty.zip");
+  ASSERT_TRUE(Zip::Compress(common::joinPaths("src", "empty"), "empty.zip"));
+  std::ifstream zipFile("empty.zip", std::ios::binary);
+  _zipData.assign((std::istreambuf_iterator<char>(zipFile)),
+      std::istreambuf_iterator<char>());
+}
+
+/////////////////////////////////////////////////
+/// \brief Detect damaged files using the manifest written on save
+TEST_F(LocalCacheTest, Verify)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+
+  std::string zipData;
+  createEmptyWorldZip(zipData);
+
+  WorldIdentifier id;
+  id.SetServer(conf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("empty");
+  id.SetVersion(1);
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+  EXPECT_TRUE(common::exists(id.LocalPath() + ".sha256"));
+
+  std::vector<ModelIdentifier> badModels;
+  std::vector<WorldIdentifier> badWorlds;
+  EXPECT_TRUE(cache.Verify(badModels, badWorlds));
+  EXPECT_TRUE(badModels.empty());
+  EXPECT_TRUE(badWorlds.empty());
+
+  // Modify a file
+  std::string sdfPath = common::joinPaths(id.LocalPath(), "empty",
+      "empty.sdf");
+  ASSERT_TRUE(common::exists(sdfPath));
+  {
+    std::ofstream fout(sdfPath, std::ios::app);
+    fout << " ";
+  }
+  EXPECT_FALSE(cache.Verify(badModels, badWorlds));
+  ASSERT_EQ(1u, badWorlds.size());
+  EXPECT_EQ("alice", badWorlds[0].Owner());
+  EXPECT_EQ("empty", badWorlds[0].Name());
+
+  // Remove a file
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+  EXPECT_TRUE(cache.Verify(badModels, badWorlds));
+  ASSERT_TRUE(common::removeFile(sdfPath));
+  badWorlds.clear();
+  EXPECT_FALSE(cache.Verify(badModels, badWorlds));
+  EXPECT_EQ(1u, badWorlds.size());
+}
+
+/////////////////////////////////////////////////
+/// \brief Identical files are stored once when deduplication is enabled
+TEST_F(LocalCacheTest, Deduplication)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  EXPECT_FALSE(conf.CacheDeduplication());
+  conf.SetCacheDeduplication(true);
+  EXPECT_TRUE(conf.CacheDeduplication());
+
+  std::string zipData;
+  createEmptyWorldZip(zipData);
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  EXPECT_EQ(0u, cache.BlobStoreStats().blobs);
+
+  // Two versions with the same content
+  WorldIdentifier v1;
+  v1.SetServer(conf.Servers().front());
+  v1.SetOwner("alice");
+  v1.SetName("empty");
+  v1.SetVersion(1);
+  ASSERT_TRUE(cache.SaveWorld(v1, zipData, true));
+
+  WorldIdentifier v2 = v1;
+  v2.SetVersion(2);
+  ASSERT_TRUE(cache.SaveWorld(v2, zipData, true));
+
+  std::string sdfPath = common::joinPaths(v1.LocalPath(), "empty",
+      "empty.sdf");
+  std::ifstream sdfFile(sdfPath, std::ios::binary | std::ios::ate);
+  std::uint64_t size = static_cast<std::uint64_t>(sdfFile.tellg());
+  sdfFile.close();
+
+  auto stats = cache.BlobStoreStats();
+  EXPECT_EQ(1u, stats.blobs);
+  EXPECT_EQ(size, stats.bytes);
+  EXPECT_EQ(size, stats.savedBytes);
+  EXPECT_EQ(0u, stats.unreferenced);
+
+  // Linked files still match their manifest
+  std::vector<ModelIdentifier> badModels;
+  std::vector<WorldIdentifier> badWorlds;
+  EXPECT_TRUE(cache.Verify(badModels, badWorlds));
+
+  // Overwriting a version must not write through the shared blob
+  std::string otherZipData;
+  createEmptyWorldZip(otherZipData,
+      "<?xml version=\"1.0\"?><sdf version=\"1.7\"></sdf>");
+  ASSERT_TRUE(cache.SaveWorld(v2, otherZipData, true));
+  EXPECT_TRUE(cache.Verify(badModels, badWorlds));
+  EXPECT_TRUE(badWorlds.empty());
+  EXPECT_EQ(2u, cache.BlobStoreStats().blobs);
+  ASSERT_TRUE(cache.SaveWorld(v2, zipData, true));
+  EXPECT_EQ(1u, cache.BlobStoreStats().unreferenced);
+  EXPECT_GT(cache.PruneBlobs(), 0u);
+
+  // Nothing to prune while the blob is in use
+  ASSERT_TRUE(common::removeAll(v1.LocalPath()));
+  EXPECT_EQ(0u, cache.PruneBlobs());
+  ASSERT_TRUE(common::removeAll(v2.LocalPath()));
+  EXPECT_EQ(1u, cache.BlobStoreStats().unreferenced);
+
+  EXPECT_EQ(size, cache.PruneBlobs());
+  EXPECT_EQ(0u, cache.BlobStoreStats().blobs);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LocalCacheTest, CorruptedBlob)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  conf.SetCacheDeduplication(true);
+
+  std::string zipData;
+  createEmptyWorldZip(zipData);
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  WorldIdentifier v1;
+  v1.SetServer(conf.Servers().front());
+  v1.SetOwner("alice");
+  v1.SetName("empty");
+  v1.SetVersion(1);
+  ASSERT_TRUE(cache.SaveWorld(v1, zipData, true));
+  ASSERT_EQ(1u, cache.BlobStoreStats().blobs);
+
+  // Replace the blob by a file of the same size and different content
+  std::ifstream manifest(v1.LocalPath() + ".sha256");
+  std::string hash;
+  manifest >> hash;
+  ASSERT_EQ(64u, hash.size());
+  std::string blobPath = common::joinPaths(conf.CacheLocation(), ".blobs",
+      hash.substr(0, 2), hash);
+  std::string blob;
+  {
+    std::ifstream in(blobPath, std::ios::binary);
+    blob.assign((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+  }
+  ASSERT_FALSE(blob.empty());
+  ASSERT_TRUE(common::removeFile(blobPath));
+  {
+    std::ofstream out(blobPath, std::ios::binary);
+    out << std::string(blob.size(), 'x');
+  }
+
+  // The new version isn't linked to the corrupted blob, it replaces it
+  WorldIdentifier v2 = v1;
+  v2.SetVersion(2);
+  ASSERT_TRUE(cache.SaveWorld(v2, zipData, true));
+  std::vector<ModelIdentifier> badModels;
+  std::vector<WorldIdentifier> badWorlds;
+  EXPECT_TRUE(cache.Verify(badModels, badWorlds));
+  EXPECT_TRUE(badWorlds.empty());
+
+  std::ifstream in(blobPath, std::ios::binary);
+  std::string replaced((std::istreambuf_iterator<char>(in)),
+      std::istreambuf_iterator<char>());
+  EXPECT_EQ(blob, replaced);
+}
+
+/////////////////////////////////////////////////
+/// \brief Resources are found in read-only layers, and saved to the
+/// writable cache location
+TEST_F(LocalCacheTest, CacheLayers)
+{
+  // Populate a base cache
+  ClientConfig baseConf;
+  baseConf.SetCacheLocation(common::joinPaths(common::cwd(), "base_cache"));
+  std::string zipData;
+  createEmptyWorldZip(zipData);
+
+  WorldIdentifier id;
+  id.SetServer(baseConf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("empty");
+  id.SetVersion(1);
+  {
+    gz::fuel_tools::LocalCache baseCache(&baseConf);
+    ASSERT_TRUE(baseCache.SaveWorld(id, zipData, true));
+  }
+
+  // Layer it below an empty cache
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  conf.AddCacheLayer(baseConf.CacheLocation());
+  gz::fuel_tools::LocalCache cache(&conf);
+
+  WorldIdentifier lookup;
+  lookup.SetServer(conf.Servers().front());
+  lookup.SetOwner("alice");
+  lookup.SetName("empty");
+  EXPECT_TRUE(cache.MatchingWorld(lookup));
+  EXPECT_NE(std::string::npos, lookup.LocalPath().find("base_cache"));
+  EXPECT_EQ(1u, lookup.Version());
+
+  std::size_t count = 0;
+  for (auto iter = cache.AllWorlds(); iter; ++iter)
+    ++count;
+  EXPECT_EQ(1u, count);
+
+  // Saving goes to the writable cache, which is searched first
+  WorldIdentifier v1 = id;
+  ASSERT_TRUE(cache.SaveWorld(v1, zipData, true));
+  EXPECT_NE(std::string::npos, v1.LocalPath().find("test_cache"));
+
+  lookup.SetVersion(1);
+  EXPECT_TRUE(cache.MatchingWorld(lookup));
+  EXPECT_NE(std::string::npos, lookup.LocalPath().find("test_cache"));
+
+  // A newer version in the base layer is still the tip
+  id.SetVersion(2);
+  {
+    gz::fuel_tools::LocalCache baseCache(&baseConf);
+    ASSERT_TRUE(baseCache.SaveWorld(id, zipData, true));
+  }
+  WorldIdentifier tip;
+  tip.SetServer(conf.Servers().front());
+  tip.SetOwner("alice");
+  tip.SetName("empty");
+  EXPECT_TRUE(cache.MatchingWorld(tip));
+  EXPECT_EQ(2u, tip.Version());
+  EXPECT_NE(std::string::npos, tip.LocalPath().find("base_cache"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LocalCacheTest, ExportImportPack)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  createLocal6Models(conf);
+
+  std::string zipData;
+  createEmptyWorldZip(zipData);
+  WorldIdentifier world;
+  world.SetServer(conf.Servers().back());
+  world.SetOwner("alice");
+  world.SetName("empty");
+  world.SetVersion(1);
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  ASSERT_TRUE(cache.SaveWorld(world, zipData, true));
+
+  ModelIdentifier am1;
+  am1.SetServer(conf.Servers().back());
+  am1.SetOwner("alice");
+  am1.SetName("am1");
+  ModelIdentifier am2 = am1;
+  am2.SetName("am2");
+
+  std::string pack = common::joinPaths(common::cwd(), "alice.pack");
+  world.SetVersion(0);
+  EXPECT_TRUE(cache.ExportPack(pack, {am1, am2}, {world}));
+  EXPECT_TRUE(common::isFile(pack));
+
+  // Unknown resources are reported
+  ModelIdentifier missing = am1;
+  missing.SetName("banana");
+  EXPECT_FALSE(cache.ExportPack(
+      common::joinPaths(common::cwd(), "missing.pack"), {missing}, {}));
+
+  // Import in an empty cache
+  ClientConfig otherConf = conf;
+  otherConf.SetCacheLocation(common::joinPaths(common::cwd(), "other_cache"));
+  gz::fuel_tools::LocalCache otherCache(&otherConf);
+  otherCache.SetJobs(4u);
+
+  std::size_t installed = 0;
+  std::size_t skipped = 0;
+  EXPECT_TRUE(otherCache.ImportPack(pack, installed, skipped));
+  EXPECT_EQ(3u, installed);
+  EXPECT_EQ(0u, skipped);
+
+  auto model = otherCache.MatchingModel(am1);
+  ASSERT_TRUE(model);
+  EXPECT_EQ(2u, model.Identification().Version());
+  EXPECT_NE(std::string::npos, model.PathToModel().find("other_cache"));
+  EXPECT_TRUE(common::isFile(
+      common::joinPaths(model.PathToModel(), "model.config")));
+  EXPECT_TRUE(otherCache.MatchingModel(am2));
+
+  WorldIdentifier importedWorld = world;
+  EXPECT_TRUE(otherCache.MatchingWorld(importedWorld));
+  EXPECT_EQ(1u, importedWorld.Version());
+  EXPECT_FALSE(common::exists(
+      common::joinPaths(otherConf.CacheLocation(), ".staging")));
+
+  // Imported resources get a manifest
+  std::vector<ModelIdentifier> badModels;
+  std::vector<WorldIdentifier> badWorlds;
+  EXPECT_TRUE(otherCache.Verify(badModels, badWorlds));
+
+  // Importing again skips everything
+  EXPECT_TRUE(otherCache.ImportPack(pack, installed, skipped));
+  EXPECT_EQ(0u, installed);
+  EXPECT_EQ(3u, skipped);
+
+  EXPECT_FALSE(otherCache.ImportPack(
+      common::joinPaths(common::cwd(), "missing.pack"), installed, skipped));
+}
+
+/////////////////////////////////////////////////
+/// \brief Compress a world with a mesh.
+/// \param[out] _zipData Archive of the world.
+void createMeshWorldZip(std::string &_zipData)
+{
+  std::string srcDir = common::joinPaths("src", "meshworld");
+  ASSERT_TRUE(common::createDirectories(common::joinPaths(srcDir, "meshes")));
+  {
+    std::ofstream fout(common::joinPaths(srcDir, "meshworld.sdf"));
+    fout << "<?xml version=\"1.0\"?><sdf version=\"1.6\"></sdf>";
+  }
+  {
+    std::ofstream fout(common::joinPaths(srcDir, "meshes", "box.dae"));
+    fout << "<COLLADA/>";
+  }
+  ASSERT_TRUE(Zip::Compress(srcDir, "meshworld.zip"));
+  std::ifstream zipFile("meshworld.zip", std::ios::binary);
+  _zipData.assign((std::istreambuf_iterator<char>(zipFile)),
+      std::istreambuf_iterator<char>());
+}
+
+/////////////////////////////////////////////////
+TEST_F(LocalCacheTest, ArchiveMode)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  EXPECT_FALSE(conf.CacheArchiveMode());
+  conf.SetCacheArchiveMode(true);
+  EXPECT_TRUE(conf.CacheArchiveMode());
+
+  std::string zipData;
+  createMeshWorldZip(zipData);
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  WorldIdentifier id;
+  id.SetServer(conf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("meshworld");
+  id.SetVersion(1);
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+
+  // Only the description files are extracted
+  std::string dir = id.LocalPath();
+  EXPECT_TRUE(common::isFile(dir + ".zip"));
+  EXPECT_TRUE(common::isFile(
+      common::joinPaths(dir, "meshworld", "meshworld.sdf")));
+  std::string meshPath = common::joinPaths(dir, "meshworld", "meshes",
+      "box.dae");
+  EXPECT_FALSE(common::exists(meshPath));
+
+  // Other files are extracted on demand
+  EXPECT_TRUE(cache.MaterializeFile(dir, "meshworld/meshes/box.dae"));
+  ASSERT_TRUE(common::isFile(meshPath));
+  std::ifstream mesh(meshPath);
+  std::string content((std::istreambuf_iterator<char>(mesh)),
+      std::istreambuf_iterator<char>());
+  EXPECT_EQ("<COLLADA/>", content);
+  EXPECT_FALSE(cache.MaterializeFile(dir, "meshworld/meshes/banana.dae"));
+
+  // Saving without archive mode extracts everything and drops the archive
+  conf.SetCacheArchiveMode(false);
+  ASSERT_TRUE(common::removeFile(meshPath));
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+  EXPECT_TRUE(common::isFile(meshPath));
+  EXPECT_FALSE(common::exists(dir + ".zip"));
+  EXPECT_FALSE(cache.MaterializeFile(dir, "meshworld/meshes/box.dae"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LocalCacheTest, ExportArchivedLayer)
+{
+  // A world kept in archive mode in a base cache
+  ClientConfig baseConf;
+  baseConf.SetCacheLocation(common::joinPaths(common::cwd(), "base_cache"));
+  baseConf.SetCacheArchiveMode(true);
+  std::string zipData;
+  createMeshWorldZip(zipData);
+
+  WorldIdentifier id;
+  id.SetServer(baseConf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("meshworld");
+  id.SetVersion(1);
+  {
+    gz::fuel_tools::LocalCache baseCache(&baseConf);
+    ASSERT_TRUE(baseCache.SaveWorld(id, zipData, true));
+  }
+  std::string layerMesh = common::joinPaths(id.LocalPath(), "meshworld",
+      "meshes", "box.dae");
+  ASSERT_FALSE(common::exists(layerMesh));
+
+  // Exporting it through a cache that layers it leaves the layer alone
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  conf.AddCacheLayer(baseConf.CacheLocation());
+  gz::fuel_tools::LocalCache cache(&conf);
+
+  std::string pack = common::joinPaths(common::cwd(), "layer.pack");
+  WorldIdentifier world = id;
+  world.SetVersion(0);
+  EXPECT_TRUE(cache.ExportPack(pack, {}, {world}));
+  EXPECT_FALSE(common::exists(layerMesh));
+  EXPECT_FALSE(common::exists(
+      common::joinPaths(conf.CacheLocation(), ".staging")));
+
+  // The pack holds the complete world
+  ClientConfig otherConf;
+  otherConf.SetCacheLocation(common::joinPaths(common::cwd(), "other_cache"));
+  gz::fuel_tools::LocalCache otherCache(&otherConf);
+  std::size_t installed = 0;
+  std::size_t skipped = 0;
+  EXPECT_TRUE(otherCache.ImportPack(pack, installed, skipped));
+  EXPECT_EQ(1u, installed);
+  WorldIdentifier imported = world;
+  ASSERT_TRUE(otherCache.MatchingWorld(imported));
+  EXPECT_TRUE(common::isFile(common::joinPaths(imported.LocalPath(),
+      "meshworld", "meshes", "box.dae")));
+}
+
+/////////////////////////////////////////////////
+/// \brief Files fetched after the extraction filter left them out are saved
+/// in the cache location, even for resources of read-only layers
+TEST_F(LocalCacheTest, FetchedFiles)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  std::string layer = common::joinPaths(common::cwd(), "base_cache");
+  conf.AddCacheLayer(layer);
+  gz::fuel_tools::LocalCache cache(&conf);
+
+  std::string rel = common::joinPaths("fuel.gazebosim.org", "alice",
+      "worlds", "w", "1");
+  std::string cachedDir = common::joinPaths(conf.CacheLocation(), rel);
+  EXPECT_EQ(common::joinPaths(cachedDir, "meshes", "box.dae"),
+      cache.FetchedFilePath(cachedDir, "meshes/box.dae"));
+
+  std::string layerDir = common::joinPaths(layer, rel);
+  std::string dst = cache.FetchedFilePath(layerDir, "meshes/box.dae");
+  EXPECT_EQ(common::joinPaths(conf.CacheLocation(), ".layer_files", rel,
+      "meshes", "box.dae"), dst);
+  EXPECT_TRUE(cache.FetchedFilePath(common::joinPaths(common::cwd(),
+      "elsewhere", rel), "meshes/box.dae").empty());
+
+  // Concurrent saves of the same file each use their own temporary file
+  std::string content(256 * 1024, 'x');
+  std::vector<std::thread> threads;
+  std::atomic<int> saves{0};
+  for (int i = 0; i < 8; ++i)
+  {
+    threads.emplace_back([&]
+    {
+      if (cache.SaveFetchedFile(dst, content))
+        ++saves;
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  EXPECT_EQ(8, saves);
+
+  std::ifstream in(dst, std::ios::binary);
+  std::string fetched((std::istreambuf_iterator<char>(in)),
+      std::istreambuf_iterator<char>());
+  EXPECT_TRUE(content == fetched);
+  for (common::DirIter iter(common::parentPath(dst)), end; iter != end;
+       ++iter)
+  {
+    EXPECT_EQ(std::string::npos, (*iter).find(".tmp")) << *iter;
+  }
+  EXPECT_FALSE(common::exists(layerDir));
+}
+
+/////////////////////////////////////////////////
+/// \brief Downloads are extracted on one thread unless configured otherwise
+TEST_F(LocalCacheTest, ExtractJobs)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  std::string zipData;
+  createMeshWorldZip(zipData);
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  EXPECT_EQ(0u, cache.Jobs());
+  EXPECT_EQ(1u, conf.ExtractJobs());
+
+  WorldIdentifier id;
+  id.SetServer(conf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("meshworld");
+  id.SetVersion(1);
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+  EXPECT_TRUE(common::isFile(common::joinPaths(id.LocalPath(), "meshworld",
+      "meshes", "box.dae")));
+
+  // Saving leaves the scan threads alone
+  EXPECT_EQ(0u, cache.Jobs());
+
+  conf.SetExtractJobs(4u);
+  id.SetVersion(2);
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+  EXPECT_TRUE(common::isFile(common::joinPaths(id.LocalPath(), "meshworld",
+      "meshes", "box.dae")));
+  EXPECT_EQ(0u, cache.Jobs());
+}
+
+/////////////////////////////////////////////////
+/// \brief A layer whose path starts with the cache location is read-only
+TEST_F(LocalCacheTest, PrefixedLayer)
+{
+  ClientConfig baseConf;
+  baseConf.SetCacheLocation(
+      common::joinPaths(common::cwd(), "test_cache-shared"));
+  baseConf.SetCacheArchiveMode(true);
+  std::string zipData;
+  createMeshWorldZip(zipData);
+
+  WorldIdentifier id;
+  id.SetServer(baseConf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("meshworld");
+  id.SetVersion(1);
+  {
+    gz::fuel_tools::LocalCache baseCache(&baseConf);
+    ASSERT_TRUE(baseCache.SaveWorld(id, zipData, true));
+  }
+  std::string layerMesh = common::joinPaths(id.LocalPath(), "meshworld",
+      "meshes", "box.dae");
+  ASSERT_FALSE(common::exists(layerMesh));
+
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  conf.AddCacheLayer(baseConf.CacheLocation());
+  gz::fuel_tools::LocalCache cache(&conf);
+  EXPECT_FALSE(cache.MaterializeFile(id.LocalPath(),
+      "meshworld/meshes/box.dae"));
+  EXPECT_FALSE(common::exists(layerMesh));
+
+  // Nor are its URIs rewritten
+  std::string marker = id.LocalPath() + ".rewritten";
+  common::removeFile(marker);
+  EXPECT_FALSE(cache.FixPaths(id));
+  EXPECT_FALSE(common::exists(marker));
+}
+
+/////////////////////////////////////////////////
+/// \brief Files rejected by the extraction filter are left out and recorded
+TEST_F(LocalCacheTest, ExtractionFilter)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  ExtractFilter filter;
+  filter.exclude = {"thumbnails", "*.sdf"};
+  conf.SetExtractionFilter(filter);
+
+  std::string srcDir = common::joinPaths("src", "thumbworld");
+  ASSERT_TRUE(common::createDirectories(
+      common::joinPaths(srcDir, "thumbnails")));
+  {
+    std::ofstream fout(common::joinPaths(srcDir, "thumbworld.sdf"));
+    fout << "<?xml version=\"1.0\"?><sdf version=\"1.6\"></sdf>";
+  }
+  {
+    std::ofstream fout(common::joinPaths(srcDir, "thumbnails", "1.png"));
+    fout << "0123456789";
+  }
+  ASSERT_TRUE(Zip::Compress(srcDir, "thumbworld.zip"));
+  std::ifstream zipFile("thumbworld.zip", std::ios::binary);
+  std::string zipData((std::istreambuf_iterator<char>(zipFile)),
+      std::istreambuf_iterator<char>());
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  WorldIdentifier id;
+  id.SetServer(conf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("thumbworld");
+  id.SetVersion(1);
+  auto before = CacheStatisticsRecorder::Instance().Snapshot();
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+  auto after = CacheStatisticsRecorder::Instance().Snapshot();
+
+  // Description files are extracted whatever the filter
+  std::string dir = id.LocalPath();
+  EXPECT_TRUE(common::isFile(
+      common::joinPaths(dir, "thumbworld", "thumbworld.sdf")));
+  EXPECT_FALSE(common::exists(common::joinPaths(dir, "thumbworld",
+      "thumbnails", "1.png")));
+  EXPECT_TRUE(cache.IsExcluded(dir, "thumbworld/thumbnails/1.png"));
+  EXPECT_FALSE(cache.IsExcluded(dir, "thumbworld/thumbworld.sdf"));
+  EXPECT_EQ(1u, after.filesSkipped - before.filesSkipped);
+  EXPECT_EQ(10u, after.bytesSkipped - before.bytesSkipped);
+
+  // Verification ignores the files that were left out
+  std::vector<ModelIdentifier> badModels;
+  std::vector<WorldIdentifier> badWorlds;
+  EXPECT_TRUE(cache.Verify(badModels, badWorlds));
+
+  // An explicit filter replaces the configured one
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true, ExtractFilter()));
+  EXPECT_TRUE(common::isFile(common::joinPaths(dir, "thumbworld",
+      "thumbnails", "1.png")));
+  EXPECT_FALSE(cache.IsExcluded(dir, "thumbworld/thumbnails/1.png"));
+  EXPECT_FALSE(common::exists(dir + ".excluded"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LocalCacheTest, CollectGarbage)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  createLocal6Models(conf);
+
+  // A model with 3 versions
+  auto modelPath = common::joinPaths(common::cwd(), "test_cache",
+      sanitizeAuthority("localhost:8001"), "alice", "models", "gcm");
+  for (const std::string version : {"1", "2", "3"})
+  {
+    ASSERT_TRUE(common::createDirectories(
+        common::joinPaths(modelPath, version, "meshes")));
+    std::ofstream config(common::joinPaths(modelPath, version,
+        "model.config"));
+    config << "<?xml version=\"1.0\"?>";
+    std::ofstream mesh(common::joinPaths(modelPath, version, "meshes",
+        "mesh.dae"));
+    mesh << std::string(1000, 'm');
+    std::ofstream manifest(common::joinPaths(modelPath, version + ".sha256"));
+    manifest << "hashes";
+  }
+
+  gz::fuel_tools::LocalCache cache(&conf);
+
+  // Every version was used recently
+  CacheGcPolicy policy;
+  auto report = cache.CollectGarbage(policy);
+  EXPECT_TRUE(report.complete);
+  EXPECT_EQ(0u, report.removedVersions);
+  EXPECT_EQ(9u, report.keptVersions);
+  EXPECT_EQ(0u, report.reclaimedBytes);
+
+  // Dry run
+  policy.keepUsedWithin = std::chrono::seconds(0);
+  policy.dryRun = true;
+  report = cache.CollectGarbage(policy);
+  EXPECT_EQ(2u, report.removedVersions);
+  EXPECT_EQ(7u, report.keptVersions);
+  EXPECT_GT(report.reclaimedBytes, 2000u);
+  EXPECT_TRUE(common::isDirectory(common::joinPaths(modelPath, "1")));
+
+  // Pinned versions are kept
+  ModelIdentifier pinned;
+  pinned.SetServer(conf.Servers().back());
+  pinned.SetOwner("alice");
+  pinned.SetName("gcm");
+  pinned.SetVersion(2);
+  policy.pinnedModels.push_back(pinned);
+  policy.dryRun = false;
+  report = cache.CollectGarbage(policy);
+  EXPECT_EQ(1u, report.removedVersions);
+  EXPECT_EQ(8u, report.keptVersions);
+  EXPECT_GT(report.reclaimedBytes, 1000u);
+  EXPECT_FALSE(common::exists(common::joinPaths(modelPath, "1")));
+  EXPECT_FALSE(common::exists(common::joinPaths(modelPath, "1.sha256")));
+  EXPECT_TRUE(common::isDirectory(common::joinPaths(modelPath, "2")));
+  EXPECT_TRUE(common::isDirectory(common::joinPaths(modelPath, "3")));
+
+  // Lookups still find the latest version
+  pinned.SetVersion(0);
+  auto model = cache.MatchingModel(pinned);
+  ASSERT_TRUE(model);
+  EXPECT_EQ(3u, model.Identification().Version());
+
+  // Keeping no version removes the whole resource
+  policy.keepVersions = 0;
+  policy.pinnedModels.clear();
+  report = cache.CollectGarbage(policy);
+  EXPECT_EQ(8u, report.removedVersions);
+  EXPECT_EQ(0u, report.keptVersions);
+  EXPECT_FALSE(common::exists(modelPath));
+}
+
+/////////////////////////////////////////////////
+/// \brief Compress a world whose SDF file includes models and uses a mesh
+/// of one of them. Only box belongs to the world's owner, sun and table
+/// belong to others.
+/// \param[out] _sdf Content of the SDF file.
+/// \return Archive of the world.
+std::string uriWorldArchive(std::string &_sdf)
+{
+  _sdf = "<?xml version=\"1.0\"?>\n<sdf version=\"1.6\"><world name=\"w\">"
+      "<include><uri>model://sun</uri></include>"
+      "<include><uri>model://box</uri></include>"
+      "<include><uri>model://table</uri></include>"
+      "<model name=\"m\"><link name=\"l\"><visual name=\"v\">"
+      "<geometry><mesh><uri>model://box/meshes/box.dae</uri></mesh>"
+      "</geometry></visual></link></model></world></sdf>\n";
+
+  std::string srcDir = common::joinPaths("src", "uriworld");
+  common::createDirectories(srcDir);
+  {
+    std::ofstream fout(common::joinPaths(srcDir, "uriworld.sdf"));
+    fout << _sdf;
+  }
+  if (!Zip::Compress(srcDir, "uriworld.zip"))
+    return "";
+  std::ifstream zipFile("uriworld.zip", std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(zipFile)),
+      std::istreambuf_iterator<char>());
+}
+
+/////////////////////////////////////////////////
+/// \brief Collections stopped by their time budget resume where they stopped
+TEST_F(LocalCacheTest, CollectGarbageResume)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  std::string ownerPath = common::joinPaths(conf.CacheLocation(),
+      uriToPath(conf.Servers().front().Url()), "alice", "models");
+  std::string cursorPath = common::joinPaths(conf.CacheLocation(),
+      ".gc_cursor");
+
+  // Models with 2 versions, the old one made of many files so that removing
+  // it takes time. Names sort in creation order.
+  const std::size_t count = 200;
+  auto modelName = [](std::size_t _i)
+  {
+    std::string number = std::to_string(_i);
+    return "gc" + std::string(3 - number.size(), '0') + number;
+  };
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    for (const std::string version : {"1", "2"})
+    {
+      std::string dir = common::joinPaths(ownerPath, modelName(i), version);
+      ASSERT_TRUE(common::createDirectories(dir));
+      for (int f = 0; f < (version == "1" ? 20 : 1); ++f)
+      {
+        std::ofstream file(common::joinPaths(dir,
+            "file" + std::to_string(f) + ".txt"));
+        file << "data";
+      }
+    }
+  }
+
+  // Number of models whose old version was removed, checking that they
+  // come first
+  auto collected = [&]()
+  {
+    std::size_t n = 0;
+    while (n < count &&
+        !common::exists(common::joinPaths(ownerPath, modelName(n), "1")))
+    {
+      ++n;
+    }
+    for (std::size_t i = n; i < count; ++i)
+    {
+      EXPECT_TRUE(common::exists(common::joinPaths(ownerPath, modelName(i),
+          "1"))) << modelName(i);
+    }
+    return n;
+  };
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  cache.SetJobs(1);
+  CacheGcPolicy policy;
+  policy.keepUsedWithin = std::chrono::seconds(0);
+  policy.timeBudget = std::chrono::milliseconds(1);
+
+  auto first = cache.CollectGarbage(policy);
+  if (first.complete)
+    GTEST_SKIP() << "The collection finished within its time budget";
+  std::size_t firstCount = collected();
+  EXPECT_LE(1u, firstCount);
+  EXPECT_EQ(firstCount, first.removedVersions);
+  EXPECT_EQ(firstCount, first.keptVersions);
+  EXPECT_TRUE(common::isFile(cursorPath));
+
+  // The next collection only visits the models that follow, every model
+  // visited has its old version removed
+  auto second = cache.CollectGarbage(policy);
+  std::size_t secondCount = collected() - firstCount;
+  EXPECT_LE(1u, secondCount);
+  EXPECT_EQ(secondCount, second.removedVersions);
+  EXPECT_EQ(secondCount, second.keptVersions);
+
+  // A collection without budget visits the rest and starts over next time
+  policy.timeBudget = std::chrono::milliseconds(0);
+  auto last = cache.CollectGarbage(policy);
+  EXPECT_TRUE(last.complete);
+  EXPECT_EQ(count, collected());
+  EXPECT_EQ(count - firstCount - secondCount, last.removedVersions);
+  EXPECT_FALSE(common::exists(cursorPath));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LocalCacheTest, FixWorldPaths)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  std::string original;
+  std::string zipData = uriWorldArchive(original);
+  ASSERT_FALSE(zipData.empty());
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  WorldIdentifier id;
+  id.SetServer(conf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("uriworld");
+  id.SetVersion(1);
+
+  // The world's owner has box in the cache
+  ASSERT_TRUE(common::createDirectories(common::joinPaths(conf.CacheLocation(),
+      uriToPath(id.Server().Url()), "alice", "models", "box", "1")));
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+
+  // Models of the world's owner and their files refer to the server
+  std::string dir = id.LocalPath();
+  std::string sdfPath = common::joinPaths(dir, "uriworld", "uriworld.sdf");
+  auto readSdf = [&sdfPath]
+  {
+    std::ifstream sdfFile(sdfPath);
+    return std::string((std::istreambuf_iterator<char>(sdfFile)),
+        std::istreambuf_iterator<char>());
+  };
+  std::string sdf = readSdf();
+  std::string modelUrl = id.Server().Url().Str() + "/" +
+      id.Server().Version() + "/alice/models/box";
+  EXPECT_NE(std::string::npos, sdf.find("<uri>" + modelUrl + "</uri>"));
+  EXPECT_NE(std::string::npos,
+      sdf.find("<uri>" + modelUrl + "/tip/files/meshes/box.dae</uri>"));
+  EXPECT_EQ(std::string::npos, sdf.find("model://box"));
+
+  // Models of other owners are left to be resolved by name
+  EXPECT_NE(std::string::npos, sdf.find("<uri>model://sun</uri>"));
+  EXPECT_NE(std::string::npos, sdf.find("<uri>model://table</uri>"));
+
+  // The marker stops the rewrite from running again
+  EXPECT_TRUE(common::isFile(dir + ".rewritten"));
+  EXPECT_TRUE(cache.FixPaths(id));
+
+  // An interrupted rewrite is resumed, the owner of a dependency recorded
+  // in the metadata is known
+  std::string tableUrl = "https://fuel.gazebosim.org/1.0/bob/models/table";
+  {
+    std::ofstream fout(common::joinPaths(dir, "metadata.pbtxt"));
+    fout << "name: \"uriworld\"\n"
+         << "dependencies {\n  uri: \"" << tableUrl << "\"\n}\n";
+  }
+  ASSERT_TRUE(common::removeFile(dir + ".rewritten"));
+  EXPECT_TRUE(cache.FixPaths(id));
+  EXPECT_TRUE(common::isFile(dir + ".rewritten"));
+  sdf = readSdf();
+  EXPECT_NE(std::string::npos, sdf.find("<uri>" + tableUrl + "</uri>"));
+  EXPECT_NE(std::string::npos, sdf.find("<uri>model://sun</uri>"));
+  EXPECT_NE(std::string::npos, sdf.find("<uri>" + modelUrl + "</uri>"));
+  std::vector<ModelIdentifier> badModels;
+  std::vector<WorldIdentifier> badWorlds;
+  EXPECT_TRUE(cache.Verify(badModels, badWorlds));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LocalCacheTest, FixAllPaths)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  std::string original;
+  std::string zipData = uriWorldArchive(original);
+  ASSERT_FALSE(zipData.empty());
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  WorldIdentifier id;
+  id.SetServer(conf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("uriworld");
+  id.SetVersion(1);
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+
+  // Saved resources are already rewritten
+  std::size_t fixed = 1;
+  EXPECT_TRUE(cache.FixAllPaths(fixed));
+  EXPECT_EQ(0u, fixed);
+
+  // A resource cached by an earlier version has no marker, it's rewritten
+  // once
+  std::string dir = id.LocalPath();
+  ASSERT_TRUE(common::removeFile(dir + ".rewritten"));
+  EXPECT_TRUE(cache.FixAllPaths(fixed));
+  EXPECT_EQ(1u, fixed);
+  EXPECT_TRUE(common::isFile(dir + ".rewritten"));
+  EXPECT_TRUE(cache.FixAllPaths(fixed));
+  EXPECT_EQ(0u, fixed);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LocalCacheTest, ConcurrentFixPaths)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  std::string original;
+  std::string zipData = uriWorldArchive(original);
+  ASSERT_FALSE(zipData.empty());
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  WorldIdentifier id;
+  id.SetServer(conf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("uriworld");
+  id.SetVersion(1);
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+
+  std::string dir = id.LocalPath();
+  std::string sdfPath = common::joinPaths(dir, "uriworld", "uriworld.sdf");
+  auto readSdf = [&sdfPath]
+  {
+    std::ifstream sdfFile(sdfPath);
+    return std::string((std::istreambuf_iterator<char>(sdfFile)),
+        std::istreambuf_iterator<char>());
+  };
+  std::string rewritten = readSdf();
+
+  // Go back to the files of a world cached before the rewrite existed
+  ASSERT_TRUE(common::removeFile(dir + ".rewritten"));
+  {
+    std::ofstream fout(sdfPath, std::ios::trunc);
+    fout << original;
+  }
+
+  // Lookups from several threads rewrite the same files at once
+  std::vector<std::thread> threads;
+  std::vector<char> results(8, 0);
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    threads.emplace_back([&cache, &id, &results, i]
+    {
+      results[i] = cache.FixPaths(id);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (auto result : results)
+    EXPECT_TRUE(result);
+  EXPECT_EQ(rewritten, readSdf());
+  EXPECT_TRUE(common::isFile(dir + ".rewritten"));
+
+  // No temporary file is left behind
+  for (common::DirIter iter(common::parentPath(sdfPath)), end;
+       iter != end; ++iter)
+  {
+    EXPECT_EQ(std::string::npos, (*iter).find(".tmp")) << *iter;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(LocalCacheTest, LazyUriRewrite)
+{
+  ClientConfig conf;
+  conf.SetCacheLocation(common::joinPaths(common::cwd(), "test_cache"));
+  conf.SetLazyUriRewrite(true);
+  std::string original;
+  std::string zipData = uriWorldArchive(original);
+  ASSERT_FALSE(zipData.empty());
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  WorldIdentifier id;
+  id.SetServer(conf.Servers().front());
+  id.SetOwner("alice");
+  id.SetName("uriworld");
+  id.SetVersion(1);
+  ASSERT_TRUE(common::createDirectories(common::joinPaths(conf.CacheLocation(),
+      uriToPath(id.Server().Url()), "alice", "models", "box", "1")));
+  ASSERT_TRUE(cache.SaveWorld(id, zipData, true));
+
+  // The world is cached as it was on the server
+  std::string dir = id.LocalPath();
+  std::string sdfPath = common::joinPaths(dir, "uriworld", "uriworld.sdf");
+  std::ifstream sdfFile(sdfPath);
+  std::string sdf((std::istreambuf_iterator<char>(sdfFile)),
+      std::istreambuf_iterator<char>());
+  EXPECT_EQ(original, sdf);
+  EXPECT_FALSE(common::exists(dir + ".rewritten"));
+  EXPECT_TRUE(common::isFile(dir + ".uris"));
+  EXPECT_TRUE(cache.FixPaths(id));
+
+  // URIs are resolved from the resource or any of its files
+  std::string modelUrl = id.Server().Url().Str() + "/" +
+      id.Server().Version() + "/alice/models/box";
+  EXPECT_EQ(modelUrl, cache.ResolveUri(dir, "model://box"));
+  EXPECT_EQ(modelUrl + "/tip/files/meshes/box.dae",
+      cache.ResolveUri(sdfPath, " model://box/meshes/box.dae "));
+  EXPECT_EQ("model://other", cache.ResolveUri(dir, "model://other"));
+  EXPECT_EQ("model://sun", cache.ResolveUri(dir, "model://sun"));
+  EXPECT_EQ("model://box", cache.ResolveUri(
+      common::joinPaths(common::cwd(), "src"), "model://box"));
+
+  // A replaced record is read again
+  std::string urisBackup;
+  {
+    std::ifstream in(dir + ".uris");
+    urisBackup.assign((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    std::ofstream out(dir + ".uris", std::ios::app);
+    out << "model://other\thttps://fuel.gazebosim.org/1.0/bob/models/other\n";
+  }
+  EXPECT_EQ("https://fuel.gazebosim.org/1.0/bob/models/other",
+      cache.ResolveUri(dir, "model://other"));
+  {
+    std::ofstream out(dir + ".uris", std::ios::trunc);
+    out << urisBackup;
+  }
+  EXPECT_EQ("model://other", cache.ResolveUri(dir, "model://other"));
+
+  // Switching back rewrites the files on the next FixPaths
+  conf.SetLazyUriRewrite(false);
+  EXPECT_TRUE(cache.FixPaths(id));
+  EXPECT_TRUE(common::isFile(dir + ".rewritten"));
+  EXPECT_FALSE(common::exists(dir + ".uris"));
+  EXPECT_EQ("model://box", cache.ResolveUri(dir, "model://box"));
+}
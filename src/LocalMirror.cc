@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/StringUtils.hh>
+
+#include "LocalMirror.hh"
+
+namespace fs = std::filesystem;
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /// \brief Prefix of the URLs served by the mirror.
+  const std::string kFileScheme = "file://";
+
+  //////////////////////////////////////////////////
+  /// \brief Decode %XX sequences.
+  /// \param[in] _str Encoded string.
+  /// \return Decoded string.
+  std::string percentDecode(const std::string &_str)
+  {
+    std::string out;
+    out.reserve(_str.size());
+    for (std::size_t i = 0; i < _str.size(); ++i)
+    {
+      if (_str[i] == '%' && i + 2 < _str.size() &&
+          std::isxdigit(static_cast<unsigned char>(_str[i + 1])) &&
+          std::isxdigit(static_cast<unsigned char>(_str[i + 2])))
+      {
+        out += static_cast<char>(std::stoi(_str.substr(i + 1, 2), nullptr,
+              16));
+        i += 2;
+      }
+      else
+      {
+        out += _str[i];
+      }
+    }
+    return out;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Whether a string is a version number.
+  /// \param[in] _str String to check.
+  /// \return True if the string is made of digits only.
+  bool isVersion(const std::string &_str)
+  {
+    if (_str.empty())
+      return false;
+    for (const char c : _str)
+    {
+      if (!std::isdigit(static_cast<unsigned char>(c)))
+        return false;
+    }
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Find the highest numbered version directory.
+  /// \param[in] _dir Directory holding the versions of a resource.
+  /// \return Name of the version directory, empty if there's none.
+  std::string latestVersion(const fs::path &_dir)
+  {
+    std::string latest;
+    unsigned long latestNumber = 0;
+    std::error_code ec;
+    for (fs::directory_iterator it(_dir, ec), end; !ec && it != end;
+         it.increment(ec))
+    {
+      auto name = it->path().filename().string();
+      if (!isVersion(name) || !it->is_directory(ec))
+        continue;
+
+      auto number = std::stoul(name);
+      if (latest.empty() || number > latestNumber)
+      {
+        latest = name;
+        latestNumber = number;
+      }
+    }
+    return latest;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Read a whole file straight into a response.
+  /// \param[in] _path Path to the file.
+  /// \param[out] _data File contents.
+  /// \return True if the file was read.
+  bool readFile(const fs::path &_path, std::string &_data)
+  {
+    std::error_code ec;
+    auto size = fs::file_size(_path, ec);
+    if (ec)
+      return false;
+
+    std::ifstream in(_path, std::ios::binary);
+    if (!in)
+      return false;
+
+    // The response owns its data, so the file is read once into its final
+    // buffer without intermediate copies.
+    _data.resize(static_cast<std::size_t>(size));
+    if (size > 0)
+      in.read(&_data[0], static_cast<std::streamsize>(size));
+    return static_cast<bool>(in);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the content type of a file.
+  /// \param[in] _path Path to the file.
+  /// \return Content type, as the Fuel server would send it.
+  std::string contentType(const fs::path &_path)
+  {
+    auto extension = common::lowercase(_path.extension().string());
+    if (extension == ".zip")
+      return "application/zip";
+    if (extension == ".json")
+      return "application/json";
+    return "application/octet-stream";
+  }
+}
+
+//////////////////////////////////////////////////
+bool LocalMirror::Handles(const std::string &_url)
+{
+  return _url.size() >= kFileScheme.size() &&
+      common::lowercase(_url.substr(0, kFileScheme.size())) == kFileScheme;
+}
+
+//////////////////////////////////////////////////
+RestResponse LocalMirror::Request(HttpMethod _method,
+    const std::string &_url, const std::vector<std::string> &_queryStrings)
+{
+  RestResponse res;
+  res.statusCode = 404;
+
+  if (_method != HttpMethod::GET)
+  {
+    gzerr << "Local mirror [" << _url << "] only supports GET requests."
+          << std::endl;
+    res.statusCode = 405;
+    return res;
+  }
+
+  // Drop the scheme and any query, then map to a local path
+  std::string location = _url.substr(kFileScheme.size());
+  location = location.substr(0, location.find('?'));
+  if (location.rfind("localhost/", 0) == 0)
+    location = location.substr(std::string("localhost").size());
+  location = percentDecode(location);
+#ifdef _WIN32
+  // file:///C:/mirror
+  if (location.size() > 2 && location[0] == '/' && location[2] == ':')
+    location = location.substr(1);
+#endif
+
+  fs::path path;
+  std::string resolvedVersion;
+  std::error_code ec;
+  for (const auto &part : fs::path(location))
+  {
+    auto name = part.string();
+    if (name == "..")
+    {
+      gzerr << "Local mirror paths can't contain [..]: " << _url
+            << std::endl;
+      return res;
+    }
+
+    // Resolve the latest version, as the server does
+    if (name == "tip" && !fs::exists(path / name, ec))
+    {
+      name = latestVersion(path);
+      if (name.empty())
+        return res;
+    }
+
+    if (isVersion(name))
+      resolvedVersion = name;
+    path /= name;
+  }
+
+  if (fs::is_directory(path, ec))
+  {
+    // Pages are numbered from 1, requests without a page get the first one
+    unsigned long page = 1;
+    for (const auto &query : _queryStrings)
+    {
+      if (query.rfind("page=", 0) == 0 && isVersion(query.substr(5)))
+        page = std::stoul(query.substr(5));
+    }
+
+    auto pageFile = [&path](unsigned long _page)
+    {
+      return path / (_page <= 1 ? std::string("index.json") :
+          "index-" + std::to_string(_page) + ".json");
+    };
+
+    if (fs::is_regular_file(pageFile(page + 1), ec))
+    {
+      res.headers["Link"] = "<" + _url.substr(0, _url.find('?')) +
+          "?page=" + std::to_string(page + 1) + ">; rel=\"next\"";
+    }
+    path = pageFile(page);
+  }
+
+  if (!readFile(path, res.data))
+  {
+    res.data.clear();
+    res.headers.clear();
+    return res;
+  }
+
+  res.statusCode = 200;
+  res.headers["Content-Type"] = contentType(path);
+  if (path.extension() == ".zip" && isVersion(resolvedVersion))
+    res.headers["X-Ign-Resource-Version"] = resolvedVersion;
+  return res;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_LOCALMIRROR_HH_
+#define GZ_FUEL_TOOLS_LOCALMIRROR_HH_
+
+#include <string>
+#include <vector>
+
+#include "gz/fuel_tools/HttpMethod.hh"
+#include "gz/fuel_tools/RestClient.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Serves REST requests for file:// server URLs from a directory
+  /// tree laid out like the REST API, so no web server is needed.
+  ///
+  /// A request path maps to the same path below the mirror root, e.g.
+  /// file:///mnt/fuel/1.0/alice/models/Box/2/Box.zip. A request for a
+  /// directory is answered with the `index.json` file in it, such as the
+  /// model details in `1.0/alice/models/Box/index.json` or the first page
+  /// of a listing in `1.0/models/index.json`. Page N of a listing is read
+  /// from `index-N.json`. A `tip` version resolves to the highest numbered
+  /// version directory. Only GET requests are supported.
+  class LocalMirror
+  {
+    /// \brief Whether a URL is served from a local mirror.
+    /// \param[in] _url URL of the request.
+    /// \return True if the URL uses the file scheme.
+    public: static bool Handles(const std::string &_url);
+
+    /// \brief Serve a request.
+    /// \param[in] _method HTTP method.
+    /// \param[in] _url Full URL of the resource, without query strings.
+    /// \param[in] _queryStrings Query strings of the request.
+    /// \return Response, with status code 404 if the resource isn't in the
+    /// mirror and 405 if the method isn't supported.
+    public: static RestResponse Request(HttpMethod _method,
+                const std::string &_url,
+                const std::vector<std::string> &_queryStrings);
+  };
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_LOCALMIRROR_HH_
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "CacheStatisticsRecorder.hh"
+#include "MemoryCache.hh"
+
+namespace fs = std::filesystem;
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /// \brief A file held in memory.
+  struct Entry
+  {
+    /// \brief Path to the file.
+    std::string path;
+
+    /// \brief Contents.
+    std::shared_ptr<const FileBuffer> buffer;
+
+    /// \brief Modification time of the file when it was loaded.
+    fs::file_time_type mtime;
+  };
+}
+
+/// \brief Private data for MemoryCache.
+class gz::fuel_tools::MemoryCachePrivate
+{
+  /// \brief Evict the least recently used entries until the tier fits.
+  /// Must be called with the mutex locked.
+  /// \param[in] _capacity Maximum number of bytes.
+  public: void Trim(std::size_t _capacity)
+          {
+            while (this->size > _capacity && !this->entries.empty())
+            {
+              const auto &last = this->entries.back();
+              this->size -= last.buffer->Size();
+              this->index.erase(last.path);
+              this->entries.pop_back();
+              CacheStatisticsRecorder::Instance().Add(
+                  CacheStatisticsRecorder::Counter::MEMORY_EVICTIONS);
+            }
+          }
+
+  /// \brief Entries, most recently used first.
+  public: std::list<Entry> entries;
+
+  /// \brief Entries by path.
+  public: std::unordered_map<std::string, std::list<Entry>::iterator> index;
+
+  /// \brief Total size of the entries.
+  public: std::size_t size = 0;
+
+  /// \brief Protects the members above.
+  public: mutable std::mutex mutex;
+};
+
+//////////////////////////////////////////////////
+MemoryCache::MemoryCache()
+  : dataPtr(new MemoryCachePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+MemoryCache::~MemoryCache() = default;
+
+//////////////////////////////////////////////////
+MemoryCache &MemoryCache::Instance()
+{
+  static MemoryCache cache;
+  return cache;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const FileBuffer> MemoryCache::Read(const std::string &_path,
+    std::size_t _capacity)
+{
+  auto &stats = CacheStatisticsRecorder::Instance();
+
+  std::error_code ec;
+  auto mtime = fs::last_write_time(_path, ec);
+  if (ec)
+    return nullptr;
+  auto size = fs::file_size(_path, ec);
+  if (ec)
+    return nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto it = this->dataPtr->index.find(_path);
+    if (it != this->dataPtr->index.end())
+    {
+      auto entry = it->second;
+      if (entry->mtime == mtime && entry->buffer->Size() == size)
+      {
+        this->dataPtr->entries.splice(this->dataPtr->entries.begin(),
+            this->dataPtr->entries, entry);
+        stats.Add(CacheStatisticsRecorder::Counter::MEMORY_HITS);
+        return entry->buffer;
+      }
+
+      // The file changed on disk
+      this->dataPtr->size -= entry->buffer->Size();
+      this->dataPtr->entries.erase(entry);
+      this->dataPtr->index.erase(it);
+    }
+  }
+  stats.Add(CacheStatisticsRecorder::Counter::MEMORY_MISSES);
+
+  // Load without holding the lock, so that other files can be served
+  auto buffer = std::make_shared<const FileBuffer>(_path);
+  if (!buffer->Valid())
+    return nullptr;
+
+  if (buffer->Size() > _capacity)
+    return buffer;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Another thread may have loaded the same file meanwhile
+  if (this->dataPtr->index.count(_path) > 0)
+    return buffer;
+
+  this->dataPtr->entries.push_front(Entry{_path, buffer, mtime});
+  this->dataPtr->index[_path] = this->dataPtr->entries.begin();
+  this->dataPtr->size += buffer->Size();
+  this->dataPtr->Trim(_capacity);
+  return buffer;
+}
+
+//////////////////////////////////////////////////
+std::size_t MemoryCache::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+std::size_t MemoryCache::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->entries.size();
+}
+
+//////////////////////////////////////////////////
+void MemoryCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->entries.clear();
+  this->dataPtr->index.clear();
+  this->dataPtr->size = 0;
+}
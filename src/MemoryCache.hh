@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_MEMORYCACHE_HH_
+#define GZ_FUEL_TOOLS_MEMORYCACHE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "gz/fuel_tools/Export.hh"
+#include "gz/fuel_tools/FileBuffer.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Forward declaration
+  class MemoryCachePrivate;
+
+  /// \brief In-memory tier in front of the disk cache, keyed by file path.
+  ///
+  /// Buffers are kept in least recently used order and evicted once their
+  /// total size exceeds the capacity passed to Read. A buffer is reloaded
+  /// if the file's size or modification time changed since it was loaded.
+  /// Evicted buffers stay valid for as long as callers hold them.
+  class GZ_FUEL_TOOLS_VISIBLE MemoryCache
+  {
+    /// \brief Constructor.
+    public: MemoryCache();
+
+    /// \brief Destructor.
+    public: ~MemoryCache();
+
+    /// \brief Get the process-wide tier.
+    /// \return The tier.
+    public: static MemoryCache &Instance();
+
+    /// \brief Read a file through the tier.
+    /// \param[in] _path Path to the file.
+    /// \param[in] _capacity Maximum number of bytes kept in memory. Files
+    /// larger than this are loaded but not kept.
+    /// \return The file contents, null if the file can't be read.
+    public: std::shared_ptr<const FileBuffer> Read(const std::string &_path,
+                                                   std::size_t _capacity);
+
+    /// \brief Number of bytes held by the tier.
+    /// \return Total size of the buffers.
+    public: std::size_t Size() const;
+
+    /// \brief Number of files held by the tier.
+    /// \return Number of buffers.
+    public: std::size_t Count() const;
+
+    /// \brief Drop every buffer.
+    public: void Clear();
+
+    /// \brief Private data.
+    private: std::unique_ptr<MemoryCachePrivate> dataPtr;
+  };
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_MEMORYCACHE_HH_
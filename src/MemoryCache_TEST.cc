@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "CacheStatisticsRecorder.hh"
+#include "MemoryCache.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+void writeFile(const std::string &_path, const std::string &_content)
+{
+  std::ofstream out(_path, std::ios::binary | std::ios::trunc);
+  out << _content;
+}
+
+/////////////////////////////////////////////////
+TEST(MemoryCache, HitsAndEvictions)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  std::string a = common::joinPaths(tempDir->Path(), "a");
+  std::string b = common::joinPaths(tempDir->Path(), "b");
+  std::string c = common::joinPaths(tempDir->Path(), "c");
+  writeFile(a, std::string(100, 'a'));
+  writeFile(b, std::string(100, 'b'));
+  writeFile(c, std::string(100, 'c'));
+
+  auto &recorder = CacheStatisticsRecorder::Instance();
+  recorder.Reset();
+
+  MemoryCache cache;
+  auto bufA = cache.Read(a, 250u);
+  ASSERT_NE(nullptr, bufA);
+  EXPECT_EQ(std::string(100, 'a'), bufA->View());
+  EXPECT_EQ(bufA, cache.Read(a, 250u));
+  EXPECT_EQ(1u, recorder.Snapshot().memoryHits);
+  EXPECT_EQ(1u, recorder.Snapshot().memoryMisses);
+
+  ASSERT_NE(nullptr, cache.Read(b, 250u));
+  EXPECT_EQ(2u, cache.Count());
+  EXPECT_EQ(200u, cache.Size());
+
+  // Touch a, so that b is the least recently used
+  EXPECT_EQ(bufA, cache.Read(a, 250u));
+  ASSERT_NE(nullptr, cache.Read(c, 250u));
+  EXPECT_EQ(2u, cache.Count());
+  EXPECT_EQ(200u, cache.Size());
+  EXPECT_EQ(1u, recorder.Snapshot().memoryEvictions);
+  EXPECT_EQ(bufA, cache.Read(a, 250u));
+
+  // Evicted buffers stay valid
+  auto bufB = cache.Read(b, 250u);
+  ASSERT_NE(nullptr, bufB);
+  EXPECT_EQ(std::string(100, 'b'), bufB->View());
+  EXPECT_EQ(3u, recorder.Snapshot().memoryHits);
+  EXPECT_EQ(4u, recorder.Snapshot().memoryMisses);
+
+  // Files larger than the capacity are not kept
+  auto big = cache.Read(a, 50u);
+  ASSERT_NE(nullptr, big);
+  EXPECT_EQ(100u, big->Size());
+
+  EXPECT_EQ(nullptr, cache.Read(
+      common::joinPaths(tempDir->Path(), "missing"), 250u));
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.Count());
+  EXPECT_EQ(0u, cache.Size());
+  EXPECT_EQ(std::string(100, 'a'), bufA->View());
+}
+
+/////////////////////////////////////////////////
+TEST(MemoryCache, ReloadModifiedFile)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  std::string path = common::joinPaths(tempDir->Path(), "file");
+  writeFile(path, "first");
+
+  MemoryCache cache;
+  auto first = cache.Read(path, 1024u);
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ("first", first->View());
+
+  // Replace the file, the way the cache does
+  writeFile(path + ".new", "second version");
+  std::filesystem::rename(path + ".new", path);
+  std::filesystem::last_write_time(path,
+      std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+
+  auto second = cache.Read(path, 1024u);
+  ASSERT_NE(nullptr, second);
+  EXPECT_EQ("second version", second->View());
+  EXPECT_EQ("first", first->View());
+  EXPECT_EQ(1u, cache.Count());
+  EXPECT_EQ(second->Size(), cache.Size());
+}
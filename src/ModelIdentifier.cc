@@ -17,6 +17,7 @@
 
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gz/common/Console.hh>
@@ -125,14 +126,36 @@ ModelIdentifier::ModelIdentifier(const ModelIdentifier &_orig)
 //////////////////////////////////////////////////
 ModelIdentifier &ModelIdentifier::operator=(const ModelIdentifier &_orig)
 {
-  this->dataPtr.reset(new ModelIdentifierPrivate(*(_orig.dataPtr.get())));
+  // Reuse the storage of this identifier, unless it was moved from
+  if (this->dataPtr)
+    *(this->dataPtr) = *(_orig.dataPtr);
+  else
+    this->dataPtr.reset(new ModelIdentifierPrivate(*(_orig.dataPtr.get())));
+  return *this;
+}
+
+//////////////////////////////////////////////////
+ModelIdentifier::ModelIdentifier(ModelIdentifier &&_orig) noexcept
+  : dataPtr(std::move(_orig.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+ModelIdentifier &ModelIdentifier::operator=(ModelIdentifier &&_orig) noexcept
+{
+  this->dataPtr = std::move(_orig.dataPtr);
   return *this;
 }
 
 //////////////////////////////////////////////////
 bool ModelIdentifier::operator==(const ModelIdentifier &_rhs) const
 {
-  return this->UniqueName() == _rhs.UniqueName();
+  // Same as comparing unique names, but the cheap members go first and
+  // the server paths are only built when they match
+  return this->dataPtr->name == _rhs.dataPtr->name &&
+      this->dataPtr->owner == _rhs.dataPtr->owner &&
+      uriToPath(this->dataPtr->server.Url()) ==
+      uriToPath(_rhs.dataPtr->server.Url());
 }
 
 //////////////////////////////////////////////////
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <utility>
 #include <gz/common/Console.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 
@@ -168,6 +169,30 @@ TEST(ModelIdentifier, AssignmentOperatorDeepCopy)
   EXPECT_EQ(std::string("hello2"), id2.Name());
 }
 
+/////////////////////////////////////////////////
+TEST(ModelIdentifier, Move)
+{
+  ModelIdentifier id;
+  id.SetName("hello");
+  id.SetOwner("pineapple");
+  id.SetVersion(3);
+
+  ModelIdentifier moved(std::move(id));
+  EXPECT_EQ(std::string("hello"), moved.Name());
+  EXPECT_EQ(std::string("pineapple"), moved.Owner());
+  EXPECT_EQ(3u, moved.Version());
+
+  ModelIdentifier assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ(std::string("hello"), assigned.Name());
+
+  // Moved from identifiers can be assigned again
+  id = assigned;
+  EXPECT_EQ(std::string("hello"), id.Name());
+  moved = ModelIdentifier();
+  EXPECT_TRUE(moved.Name().empty());
+}
+
 /////////////////////////////////////////////////
 TEST(ModelIdentifier, AsString)
 {
@@ -18,6 +18,7 @@
 #include <memory>
 #include <regex>
 #include <string>
+#include <utility>
 #include <vector>
 #include <gz/common/Console.hh>
 
@@ -40,6 +41,13 @@ ModelIter ModelIterFactory::Create(const std::vector<ModelIdentifier> &_ids)
   return ModelIter(std::move(priv));
 }
 
+//////////////////////////////////////////////////
+ModelIter ModelIterFactory::Create(std::vector<ModelIdentifier> &&_ids)
+{
+  std::unique_ptr<ModelIterPrivate> priv(new IterIds(std::move(_ids)));
+  return ModelIter(std::move(priv));
+}
+
 //////////////////////////////////////////////////
 ModelIter ModelIterFactory::Create(const std::vector<Model> &_models)
 {
@@ -47,6 +55,13 @@ ModelIter ModelIterFactory::Create(const std::vector<Model> &_models)
   return ModelIter(std::move(priv));
 }
 
+//////////////////////////////////////////////////
+ModelIter ModelIterFactory::Create(std::vector<Model> &&_models)
+{
+  std::unique_ptr<ModelIterPrivate> priv(new IterModels(std::move(_models)));
+  return ModelIter(std::move(priv));
+}
+
 //////////////////////////////////////////////////
 ModelIter ModelIterFactory::Create(const Rest &_rest,
     const ServerConfig &_server, const std::string &_api)
@@ -68,6 +83,21 @@ ModelIterPrivate::~ModelIterPrivate()
 {
 }
 
+//////////////////////////////////////////////////
+void ModelIterPrivate::SetCurrent(const ModelIdentifier &_id)
+{
+  if (this->model.dataPtr && this->model.dataPtr.use_count() == 1)
+  {
+    this->model.dataPtr->id = _id;
+    this->model.dataPtr->pathOnDisk.clear();
+    return;
+  }
+
+  std::shared_ptr<ModelPrivate> ptr(new ModelPrivate);
+  ptr->id = _id;
+  this->model = Model(ptr);
+}
+
 //////////////////////////////////////////////////
 IterIds::~IterIds()
 {
@@ -75,15 +105,11 @@ IterIds::~IterIds()
 
 //////////////////////////////////////////////////
 IterIds::IterIds(std::vector<ModelIdentifier> _ids)
-  : ids(_ids)
+  : ids(std::move(_ids))
 {
   this->idIter = this->ids.begin();
   if (!this->ids.empty())
-  {
-    std::shared_ptr<ModelPrivate> ptr(new ModelPrivate);
-    ptr->id = *(this->idIter);
-    this->model = Model(ptr);
-  }
+    this->SetCurrent(*(this->idIter));
 }
 
 //////////////////////////////////////////////////
@@ -94,11 +120,7 @@ void IterIds::Next()
 
   // Update personal model class
   if (this->idIter != this->ids.end())
-  {
-    std::shared_ptr<ModelPrivate> ptr(new ModelPrivate);
-    ptr->id = *(this->idIter);
-    this->model = Model(ptr);
-  }
+    this->SetCurrent(*(this->idIter));
 }
 
 //////////////////////////////////////////////////
@@ -114,7 +136,7 @@ IterModels::~IterModels()
 
 //////////////////////////////////////////////////
 IterModels::IterModels(std::vector<Model> _models)
-  : models(_models)
+  : models(std::move(_models))
 {
   this->modelIter = this->models.begin();
   if (!this->models.empty())
@@ -200,10 +222,8 @@ void IterRestIds::Next()
   // Update personal model class
   if (this->idIter != this->ids.end())
   {
-    std::shared_ptr<ModelPrivate> ptr(new ModelPrivate);
-    ptr->id = *(this->idIter);
-    ptr->id.SetServer(this->config);
-    this->model = Model(ptr);
+    this->idIter->SetServer(this->config);
+    this->SetCurrent(*(this->idIter));
   }
 }
 
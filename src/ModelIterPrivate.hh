@@ -47,11 +47,23 @@ namespace gz::fuel_tools
     /// \return Model iterator
     public: static ModelIter Create(const std::vector<ModelIdentifier> &_ids);
 
+    /// \brief Create a model iterator that takes over a vector of model
+    /// identifiers, without copying it
+    /// \param[in] _ids Model identifiers
+    /// \return Model iterator
+    public: static ModelIter Create(std::vector<ModelIdentifier> &&_ids);
+
     /// \brief Create a model iterator from a vector of models
     /// \param[in] _ids Models
     /// \return Model iterator
     public: static ModelIter Create(const std::vector<Model> &_models);
 
+    /// \brief Create a model iterator that takes over a vector of models,
+    /// without copying it
+    /// \param[in] _models Models
+    /// \return Model iterator
+    public: static ModelIter Create(std::vector<Model> &&_models);
+
     /// \brief Create a model iter that will make Rest api calls
     /// \param[in] _rest a Rest request
     /// \param[in] _server The server to request the operation
@@ -78,6 +90,12 @@ namespace gz::fuel_tools
     /// \return True if reached end.
     public: virtual bool HasReachedEnd() = 0;
 
+    /// \brief Make an identifier the current model. The model data is
+    /// reused when nobody else holds the current model, so that stepping
+    /// through identifiers doesn't allocate a model for each of them.
+    /// \param[in] _id Identifier of the current model.
+    public: void SetCurrent(const ModelIdentifier &_id);
+
     /// \brief Current model for returning references
     public: Model model;
   };
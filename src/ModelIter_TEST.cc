@@ -18,6 +18,8 @@
 #include <gtest/gtest.h>
 #include <cstdio>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gz/fuel_tools/ClientConfig.hh"
 #include "gz/fuel_tools/ModelIter.hh"
@@ -159,3 +161,29 @@ TEST(ModelIterTestFixture, MoveThroughModels)
   ++iter;
   EXPECT_FALSE(iter);
 }
+
+/////////////////////////////////////////////////
+/// \brief Models kept by the caller don't change when the iterator moves
+TEST(ModelIterTestFixture, KeptModelsAreStable)
+{
+  std::vector<ModelIdentifier> ids(3);
+  for (int i = 0; i < 3; ++i)
+    ids[i].SetName("model" + std::to_string(i));
+
+  ModelIter iter = ModelIterFactory::Create(std::move(ids));
+  ASSERT_TRUE(iter);
+  Model first = *iter;
+
+  ++iter;
+  ASSERT_TRUE(iter);
+  EXPECT_EQ("model0", first.Identification().Name());
+  EXPECT_EQ("model1", iter->Identification().Name());
+
+  ++iter;
+  ASSERT_TRUE(iter);
+  EXPECT_EQ("model2", iter->Identification().Name());
+  EXPECT_EQ("model0", first.Identification().Name());
+
+  ++iter;
+  EXPECT_FALSE(iter);
+}
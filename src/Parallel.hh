@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_PARALLEL_HH_
+#define GZ_FUEL_TOOLS_PARALLEL_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace gz::fuel_tools
+{
+  /// \brief Upper bound on the number of worker threads used by default.
+  constexpr unsigned int kMaxDefaultJobs = 16u;
+
+  /// \brief Get the number of worker threads to use when the caller did not
+  /// request a specific amount.
+  /// \return Hardware concurrency, clamped to [1, kMaxDefaultJobs].
+  inline unsigned int defaultJobs()
+  {
+    unsigned int hw = std::thread::hardware_concurrency();
+    return std::clamp(hw, 1u, kMaxDefaultJobs);
+  }
+
+  /// \brief Call _func(i) for every i in [0, _count) using at most _jobs
+  /// threads. Work items are handed out dynamically, so slow items (e.g. a
+  /// directory on a high latency network filesystem) don't stall the others.
+  /// The call blocks until every item has been processed. When _jobs is 0,
+  /// defaultJobs() is used. When a single thread is enough, the work is done
+  /// on the calling thread.
+  /// \param[in] _count Number of work items.
+  /// \param[in] _jobs Maximum number of threads.
+  /// \param[in] _func Callable with signature void(std::size_t).
+  template<typename Func>
+  void parallelFor(const std::size_t _count, unsigned int _jobs, Func &&_func)
+  {
+    if (_jobs == 0u)
+      _jobs = defaultJobs();
+
+    const std::size_t threadCount =
+      std::min(static_cast<std::size_t>(_jobs), _count);
+
+    if (threadCount <= 1u)
+    {
+      for (std::size_t i = 0; i < _count; ++i)
+        _func(i);
+      return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]()
+    {
+      for (std::size_t i = next++; i < _count; i = next++)
+        _func(i);
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (std::size_t t = 1; t < threadCount; ++t)
+      workers.emplace_back(worker);
+
+    // The calling thread does its share of the work too.
+    worker();
+
+    for (auto &w : workers)
+      w.join();
+  }
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_PARALLEL_HH_
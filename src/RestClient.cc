@@ -18,6 +18,7 @@
 #include <curl/curl.h>
 
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -26,6 +27,8 @@
 
 #include "gz/fuel_tools/RestClient.hh"
 
+#include "LocalMirror.hh"
+
 namespace gz::fuel_tools
 {
 
@@ -111,15 +114,35 @@ size_t RestHeaderCallback(char *_ptr, size_t _size, size_t _nmemb, void *_userp)
   return _size;
 }
 
+/////////////////////////////////////////////////
+/// \brief Destination of the response body.
+struct RestBody
+{
+  /// \brief Accumulated body.
+  std::string data;
+
+  /// \brief Callback seeing the body as it arrives, may be empty.
+  const std::function<bool(const char *, std::size_t)> *callback = nullptr;
+
+  /// \brief False once the callback asked for no more data.
+  bool streaming = true;
+};
+
 /////////////////////////////////////////////////
 size_t RestWriteMemoryCallback(void *_buffer, size_t _size, size_t _nmemb,
     void *_userp)
 {
-  std::string *str = static_cast<std::string*>(_userp);
+  RestBody *body = static_cast<RestBody *>(_userp);
   _size *= _nmemb;
 
   // Append the new character data to the string
-  str->append(static_cast<const char*>(_buffer), _size);
+  body->data.append(static_cast<const char*>(_buffer), _size);
+
+  if (body->streaming && body->callback && *body->callback)
+  {
+    body->streaming =
+        (*body->callback)(static_cast<const char *>(_buffer), _size);
+  }
   return _size;
 }
 
@@ -190,6 +213,18 @@ RestResponse Rest::Request(HttpMethod _method,
     const std::string &_path, const std::vector<std::string> &_queryStrings,
     const std::vector<std::string> &_headers, const std::string &_data,
     const std::multimap<std::string, std::string> &_form) const
+{
+  return this->Request(_method, _url, _version, _path, _queryStrings,
+      _headers, _data, _form, {});
+}
+
+/////////////////////////////////////////////////
+RestResponse Rest::Request(HttpMethod _method,
+    const std::string &_url, const std::string &_version,
+    const std::string &_path, const std::vector<std::string> &_queryStrings,
+    const std::vector<std::string> &_headers, const std::string &_data,
+    const std::multimap<std::string, std::string> &_form,
+    const std::function<bool(const char *, std::size_t)> &_dataCallback) const
 {
   RestResponse res;
 
@@ -200,6 +235,16 @@ RestResponse Rest::Request(HttpMethod _method,
   if (!_version.empty())
     url = RestJoinUrl(_url, _version);
 
+  // Mirrors on the local filesystem are read directly
+  if (LocalMirror::Handles(url))
+  {
+    res = LocalMirror::Request(_method, RestJoinUrl(url, _path),
+        _queryStrings);
+    if (_dataCallback && !res.data.empty())
+      _dataCallback(res.data.data(), res.data.size());
+    return res;
+  }
+
   CURL *curl = curl_easy_init();
   char *encodedPath = nullptr;
 
@@ -259,11 +304,12 @@ RestResponse Rest::Request(HttpMethod _method,
   curl_easy_setopt(curl, CURLOPT_USERAGENT, this->userAgent.c_str());
   curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
 
-  std::string responseData;
+  RestBody responseBody;
+  responseBody.callback = &_dataCallback;
   std::map<std::string, std::string> headerData;
   curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
   curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, RestWriteMemoryCallback);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseData);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
 
   curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, RestHeaderCallback);
   curl_easy_setopt(curl, CURLOPT_HEADERDATA, &headerData);
@@ -343,7 +389,7 @@ RestResponse Rest::Request(HttpMethod _method,
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &res.statusCode);
 
   // Update the data.
-  res.data = responseData;
+  res.data = std::move(responseBody.data);
 
   // Update the header data.
   res.headers = headerData;
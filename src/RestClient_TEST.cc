@@ -16,7 +16,10 @@
 */
 
 #include <gtest/gtest.h>
+#include <fstream>
 #include <string>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
 #include "gz/fuel_tools/RestClient.hh"
 
 /////////////////////////////////////////////////
@@ -28,3 +31,90 @@ TEST(RestClient, UserAgent)
   rest.SetUserAgent("my_user_agent");
   EXPECT_EQ("my_user_agent", rest.UserAgent());
 }
+
+/////////////////////////////////////////////////
+TEST(RestClient, LocalMirror)
+{
+  auto tempDir = gz::common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid()) << tempDir->Path();
+
+  auto writeFile = [](const std::string &_path, const std::string &_data)
+  {
+    ASSERT_TRUE(gz::common::createDirectories(
+        gz::common::parentPath(_path)));
+    std::ofstream fout(_path, std::ios::binary);
+    fout << _data;
+  };
+
+  auto root = gz::common::joinPaths(tempDir->Path(), "mirror");
+  auto apiRoot = gz::common::joinPaths(root, "1.0");
+  writeFile(gz::common::joinPaths(apiRoot, "models", "index.json"),
+      "[{\"name\":\"Box\"}]");
+  writeFile(gz::common::joinPaths(apiRoot, "models", "index-2.json"),
+      "[{\"name\":\"Cone\"}]");
+  writeFile(gz::common::joinPaths(apiRoot, "alice", "models", "My Box",
+      "index.json"), "{\"name\":\"My Box\"}");
+  writeFile(gz::common::joinPaths(apiRoot, "alice", "models", "My Box", "2",
+      "My Box.zip"), std::string("PK\0\1", 4));
+  writeFile(gz::common::joinPaths(apiRoot, "alice", "models", "My Box", "10",
+      "My Box.zip"), std::string("PK\0\2", 4));
+
+  gz::fuel_tools::Rest rest;
+  std::string url = "file://" + root;
+  gz::common::copyToUnixPath(url);
+
+  // Details
+  auto res = rest.Request(gz::fuel_tools::HttpMethod::GET, url, "1.0",
+      "alice/models/My%20Box", {}, {}, "");
+  EXPECT_EQ(200, res.statusCode);
+  EXPECT_EQ("{\"name\":\"My Box\"}", res.data);
+  EXPECT_EQ("application/json", res.headers["Content-Type"]);
+
+  // Listing pages
+  res = rest.Request(gz::fuel_tools::HttpMethod::GET, url, "1.0", "models",
+      {"page=1"}, {}, "");
+  EXPECT_EQ(200, res.statusCode);
+  EXPECT_EQ("[{\"name\":\"Box\"}]", res.data);
+  ASSERT_EQ(1u, res.headers.count("Link"));
+  EXPECT_NE(std::string::npos, res.headers["Link"].find("page=2"));
+
+  res = rest.Request(gz::fuel_tools::HttpMethod::GET, url, "1.0", "models",
+      {"page=2"}, {}, "");
+  EXPECT_EQ(200, res.statusCode);
+  EXPECT_EQ("[{\"name\":\"Cone\"}]", res.data);
+  EXPECT_EQ(0u, res.headers.count("Link"));
+
+  res = rest.Request(gz::fuel_tools::HttpMethod::GET, url, "1.0", "models",
+      {"page=3"}, {}, "");
+  EXPECT_EQ(404, res.statusCode);
+
+  // Downloads, tip is the highest version
+  res = rest.Request(gz::fuel_tools::HttpMethod::GET, url, "1.0",
+      "alice/models/My Box/tip/My Box.zip", {"link=true"}, {}, "");
+  EXPECT_EQ(200, res.statusCode);
+  EXPECT_EQ(std::string("PK\0\2", 4), res.data);
+  EXPECT_EQ("application/zip", res.headers["Content-Type"]);
+  EXPECT_EQ("10", res.headers["X-Ign-Resource-Version"]);
+
+  res = rest.Request(gz::fuel_tools::HttpMethod::GET, url, "1.0",
+      "alice/models/My Box/2/My Box.zip", {}, {}, "");
+  EXPECT_EQ(200, res.statusCode);
+  EXPECT_EQ(std::string("PK\0\1", 4), res.data);
+  EXPECT_EQ("2", res.headers["X-Ign-Resource-Version"]);
+
+  // Missing resources, escapes and writes
+  res = rest.Request(gz::fuel_tools::HttpMethod::GET, url, "1.0",
+      "bob/models/Missing", {}, {}, "");
+  EXPECT_EQ(404, res.statusCode);
+  EXPECT_TRUE(res.data.empty());
+
+  res = rest.Request(gz::fuel_tools::HttpMethod::GET, url, "1.0",
+      "../1.0/models", {}, {}, "");
+  EXPECT_EQ(404, res.statusCode);
+
+  res = rest.Request(gz::fuel_tools::HttpMethod::DELETE, url, "1.0",
+      "alice/models/My Box", {}, {}, "");
+  EXPECT_EQ(405, res.statusCode);
+  EXPECT_TRUE(gz::common::exists(gz::common::joinPaths(apiRoot, "alice",
+      "models", "My Box", "index.json")));
+}
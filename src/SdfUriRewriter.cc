@@ -0,0 +1,474 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <tinyxml2.h>
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SdfUriRewriter.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /// \brief Elements leading to URIs. The scopes of the elements holding
+  /// a URI come last.
+  enum class Scope : std::uint8_t
+  {
+    NONE,
+    ROOT,
+    WORLD,
+    MODEL,
+    LINK,
+    COLLISION,
+    VISUAL,
+    GEOMETRY,
+    MESH,
+    MATERIAL,
+    SCRIPT,
+    PBR,
+    METAL,
+    SPECULAR,
+    ACTOR,
+    SKIN,
+    ANIMATION,
+    INCLUDE,
+    ROBOT,
+    URDF_LINK,
+    URDF_VISUAL,
+    URDF_COLLISION,
+    URDF_GEOMETRY,
+    URDF_MATERIAL,
+
+    /// \brief Element whose text is the URI of a file.
+    FILE_URI,
+
+    /// \brief Element whose text is the URI of a model.
+    MODEL_URI,
+
+    /// \brief Element whose filename attribute is the URI of a file.
+    FILENAME,
+  };
+
+  /// \brief Child element leading to a URI.
+  struct Rule
+  {
+    /// \brief Scope of the parent element.
+    Scope parent;
+
+    /// \brief Name of the child element.
+    std::string_view name;
+
+    /// \brief Whether only the first child with that name is considered.
+    bool first;
+
+    /// \brief Scope of the child element.
+    Scope child;
+  };
+
+  /// \brief Paths to the URIs.
+  constexpr Rule kRules[] =
+  {
+    {Scope::ROOT, "model", false, Scope::MODEL},
+    {Scope::ROOT, "actor", false, Scope::ACTOR},
+    {Scope::ROOT, "world", false, Scope::WORLD},
+    {Scope::WORLD, "model", false, Scope::MODEL},
+    {Scope::WORLD, "actor", false, Scope::ACTOR},
+    {Scope::WORLD, "include", false, Scope::INCLUDE},
+    {Scope::MODEL, "link", false, Scope::LINK},
+    {Scope::MODEL, "model", false, Scope::MODEL},
+    {Scope::MODEL, "include", false, Scope::INCLUDE},
+    {Scope::INCLUDE, "uri", true, Scope::MODEL_URI},
+    {Scope::LINK, "collision", false, Scope::COLLISION},
+    {Scope::LINK, "visual", false, Scope::VISUAL},
+    {Scope::COLLISION, "geometry", true, Scope::GEOMETRY},
+    {Scope::VISUAL, "geometry", true, Scope::GEOMETRY},
+    {Scope::VISUAL, "material", true, Scope::MATERIAL},
+    {Scope::GEOMETRY, "mesh", true, Scope::MESH},
+    {Scope::MESH, "uri", true, Scope::FILE_URI},
+    {Scope::MATERIAL, "script", true, Scope::SCRIPT},
+    {Scope::MATERIAL, "pbr", true, Scope::PBR},
+    {Scope::SCRIPT, "uri", false, Scope::FILE_URI},
+    {Scope::PBR, "metal", true, Scope::METAL},
+    {Scope::PBR, "specular", true, Scope::SPECULAR},
+    {Scope::METAL, "albedo_map", true, Scope::FILE_URI},
+    {Scope::METAL, "normal_map", true, Scope::FILE_URI},
+    {Scope::METAL, "environment_map", true, Scope::FILE_URI},
+    {Scope::METAL, "emissive_map", true, Scope::FILE_URI},
+    {Scope::METAL, "light_map", true, Scope::FILE_URI},
+    {Scope::METAL, "metalness_map", true, Scope::FILE_URI},
+    {Scope::METAL, "roughness_map", true, Scope::FILE_URI},
+    {Scope::SPECULAR, "albedo_map", true, Scope::FILE_URI},
+    {Scope::SPECULAR, "normal_map", true, Scope::FILE_URI},
+    {Scope::SPECULAR, "environment_map", true, Scope::FILE_URI},
+    {Scope::SPECULAR, "emissive_map", true, Scope::FILE_URI},
+    {Scope::SPECULAR, "light_map", true, Scope::FILE_URI},
+    {Scope::SPECULAR, "specular_map", true, Scope::FILE_URI},
+    {Scope::SPECULAR, "glossiness_map", true, Scope::FILE_URI},
+    {Scope::ACTOR, "skin", false, Scope::SKIN},
+    {Scope::ACTOR, "animation", false, Scope::ANIMATION},
+    {Scope::SKIN, "filename", true, Scope::FILE_URI},
+    {Scope::ANIMATION, "filename", true, Scope::FILE_URI},
+    {Scope::ROBOT, "link", false, Scope::URDF_LINK},
+    {Scope::ROBOT, "material", false, Scope::URDF_MATERIAL},
+    {Scope::URDF_LINK, "visual", false, Scope::URDF_VISUAL},
+    {Scope::URDF_LINK, "collision", false, Scope::URDF_COLLISION},
+    {Scope::URDF_VISUAL, "geometry", true, Scope::URDF_GEOMETRY},
+    {Scope::URDF_VISUAL, "material", true, Scope::URDF_MATERIAL},
+    {Scope::URDF_COLLISION, "geometry", true, Scope::URDF_GEOMETRY},
+    {Scope::URDF_GEOMETRY, "mesh", true, Scope::FILENAME},
+    {Scope::URDF_MATERIAL, "texture", true, Scope::FILENAME},
+  };
+  static_assert(std::size(kRules) <= 64, "Rules don't fit the seen mask");
+
+  /// \brief Element being scanned.
+  struct Frame
+  {
+    /// \brief Name of the element.
+    std::string_view name;
+
+    /// \brief Scope of the element.
+    Scope scope;
+
+    /// \brief Rules already matched by a child, for the first only rules.
+    std::uint64_t seen;
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Whether a character is XML white space.
+  /// \param[in] _c Character.
+  /// \return True for spaces, tabs and line breaks.
+  bool isSpace(char _c)
+  {
+    return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\r';
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Scope of the root element of a document.
+  /// \param[in] _name Name of the root element.
+  /// \return ROBOT for URDF files, ROOT otherwise.
+  Scope rootScope(std::string_view _name)
+  {
+    return _name == "robot" ? Scope::ROBOT : Scope::ROOT;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Scope of a child element, marking first only rules as seen.
+  /// \param[in,out] _parent Parent element.
+  /// \param[in] _name Name of the child.
+  /// \return Scope of the child.
+  Scope childScope(Frame &_parent, std::string_view _name)
+  {
+    if (_parent.scope == Scope::NONE || _parent.scope >= Scope::FILE_URI)
+      return Scope::NONE;
+
+    for (std::size_t i = 0; i < std::size(kRules); ++i)
+    {
+      const Rule &rule = kRules[i];
+      if (rule.parent != _parent.scope || rule.name != _name)
+        continue;
+      if (!rule.first)
+        return rule.child;
+
+      std::uint64_t bit = std::uint64_t{1} << i;
+      if (_parent.seen & bit)
+        return Scope::NONE;
+      _parent.seen |= bit;
+      return rule.child;
+    }
+    return Scope::NONE;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Append text to a document, escaping it.
+  /// \param[in] _text Text.
+  /// \param[out] _out Document.
+  void appendEscaped(const std::string &_text, std::string &_out)
+  {
+    for (char c : _text)
+    {
+      switch (c)
+      {
+        case '&': _out += "&amp;"; break;
+        case '<': _out += "&lt;"; break;
+        case '>': _out += "&gt;"; break;
+        case '"': _out += "&quot;"; break;
+        case '\'': _out += "&apos;"; break;
+        default: _out += c;
+      }
+    }
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Replace the URIs below an element of a DOM.
+  /// \param[in] _elem Element.
+  /// \param[in] _scope Scope of the element.
+  /// \param[in] _map Replacement of each URI.
+  /// \param[in,out] _rewritten Incremented for each URI replaced.
+  void fixElement(tinyxml2::XMLElement *_elem, Scope _scope,
+      const SdfUriRewriter::UriMap &_map, std::size_t &_rewritten)
+  {
+    if (_scope == Scope::FILENAME)
+    {
+      const char *value = _elem->Attribute("filename");
+      if (!value)
+        return;
+      std::string uri = value;
+      std::string fixed = _map(uri, SdfUriType::FILE);
+      if (fixed != uri)
+      {
+        _elem->SetAttribute("filename", fixed.c_str());
+        ++_rewritten;
+      }
+      return;
+    }
+
+    if (_scope == Scope::FILE_URI || _scope == Scope::MODEL_URI)
+    {
+      if (!_elem->GetText())
+        return;
+      std::string uri = _elem->GetText();
+      std::string fixed = _map(uri, _scope == Scope::FILE_URI ?
+          SdfUriType::FILE : SdfUriType::MODEL);
+      if (fixed != uri)
+      {
+        _elem->SetText(fixed.c_str());
+        ++_rewritten;
+      }
+      return;
+    }
+
+    Frame frame{_elem->Name(), _scope, 0};
+    for (tinyxml2::XMLElement *child = _elem->FirstChildElement(); child;
+         child = child->NextSiblingElement())
+    {
+      Scope scope = childScope(frame, child->Name());
+      if (scope != Scope::NONE)
+        fixElement(child, scope, _map, _rewritten);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+bool SdfUriRewriter::HasModelUri(std::string_view _xml)
+{
+  return _xml.find("model://") != std::string_view::npos;
+}
+
+/////////////////////////////////////////////////
+bool SdfUriRewriter::Rewrite(std::string_view _xml, const UriMap &_map,
+    std::string &_out, std::size_t &_rewritten)
+{
+  constexpr auto npos = std::string_view::npos;
+
+  _out.clear();
+  _rewritten = 0;
+
+  // Bytes of _xml up to this position are already copied to _out
+  std::size_t copied = 0;
+  std::vector<Frame> stack;
+  bool rootSeen = false;
+
+  // Replace a span of _xml
+  auto replace = [&](std::size_t _start, std::size_t _end,
+      SdfUriType _type)
+  {
+    std::string uri(_xml.substr(_start, _end - _start));
+    std::string fixed = _map(uri, _type);
+    if (fixed == uri)
+      return;
+    _out.append(_xml.data() + copied, _start - copied);
+    appendEscaped(fixed, _out);
+    copied = _end;
+    ++_rewritten;
+  };
+
+  std::size_t pos = _xml.find('<');
+  while (pos != npos)
+  {
+    std::size_t end = npos;
+    char next = pos + 1 < _xml.size() ? _xml[pos + 1] : '\0';
+
+    if (next == '?')
+    {
+      end = _xml.find("?>", pos + 2);
+      if (end == npos)
+        return false;
+      pos = _xml.find('<', end + 2);
+      continue;
+    }
+    if (next == '!')
+    {
+      // A DOCTYPE may declare entities
+      std::string_view close;
+      if (_xml.compare(pos, 4, "<!--") == 0)
+        close = "-->";
+      else if (_xml.compare(pos, 9, "<![CDATA[") == 0)
+        close = "]]>";
+      else
+        return false;
+
+      end = _xml.find(close, pos + 4);
+      if (end == npos)
+        return false;
+      pos = _xml.find('<', end + close.size());
+      continue;
+    }
+    if (next == '/')
+    {
+      end = _xml.find('>', pos + 2);
+      if (end == npos || stack.empty())
+        return false;
+      std::string_view name = _xml.substr(pos + 2, end - pos - 2);
+      while (!name.empty() && isSpace(name.back()))
+        name.remove_suffix(1);
+      if (name != stack.back().name)
+        return false;
+      stack.pop_back();
+      pos = _xml.find('<', end + 1);
+      continue;
+    }
+
+    // Start tag
+    std::size_t nameEnd = pos + 1;
+    while (nameEnd < _xml.size() && !isSpace(_xml[nameEnd]) &&
+           _xml[nameEnd] != '/' && _xml[nameEnd] != '>')
+    {
+      ++nameEnd;
+    }
+    if (nameEnd == pos + 1)
+      return false;
+    std::string_view name = _xml.substr(pos + 1, nameEnd - pos - 1);
+
+    Scope scope = Scope::NONE;
+    if (!stack.empty())
+      scope = childScope(stack.back(), name);
+    else if (!rootSeen)
+      scope = rootScope(name);
+    rootSeen = true;
+
+    // Attributes, their values may hold '>'
+    bool empty = false;
+    end = nameEnd;
+    while (true)
+    {
+      while (end < _xml.size() && isSpace(_xml[end]))
+        ++end;
+      if (end >= _xml.size())
+        return false;
+      if (_xml[end] == '>')
+        break;
+      if (_xml.compare(end, 2, "/>") == 0)
+      {
+        empty = true;
+        ++end;
+        break;
+      }
+
+      std::size_t attrStart = end;
+      while (end < _xml.size() && !isSpace(_xml[end]) && _xml[end] != '=' &&
+             _xml[end] != '>' && _xml[end] != '/')
+      {
+        ++end;
+      }
+      std::string_view attr = _xml.substr(attrStart, end - attrStart);
+      while (end < _xml.size() && isSpace(_xml[end]))
+        ++end;
+      if (attr.empty() || end >= _xml.size() || _xml[end] != '=')
+        return false;
+      ++end;
+      while (end < _xml.size() && isSpace(_xml[end]))
+        ++end;
+      if (end >= _xml.size() || (_xml[end] != '"' && _xml[end] != '\''))
+        return false;
+      std::size_t valueEnd = _xml.find(_xml[end], end + 1);
+      if (valueEnd == npos)
+        return false;
+
+      if (scope == Scope::FILENAME && attr == "filename")
+      {
+        std::string_view value = _xml.substr(end + 1, valueEnd - end - 1);
+        if (value.find_first_of("&\r\n\t") != npos)
+          return false;
+        replace(end + 1, valueEnd, SdfUriType::FILE);
+      }
+      end = valueEnd + 1;
+    }
+
+    pos = _xml.find('<', end + 1);
+    if (empty)
+      continue;
+    stack.push_back({name, scope, 0});
+    if (scope != Scope::FILE_URI && scope != Scope::MODEL_URI)
+      continue;
+
+    // The URI is the text leading the element. White space alone isn't
+    // text, then the element has no URI unless something else follows.
+    if (pos == npos)
+      return false;
+    std::string_view text = _xml.substr(end + 1, pos - end - 1);
+    bool blank = true;
+    for (char c : text)
+      blank = blank && isSpace(c);
+    if (blank)
+    {
+      if (_xml.compare(pos, 2, "</") != 0)
+        return false;
+      continue;
+    }
+    if (text.find_first_of("&\r") != npos)
+      return false;
+
+    replace(end + 1, pos, scope == Scope::FILE_URI ?
+        SdfUriType::FILE : SdfUriType::MODEL);
+  }
+
+  if (!stack.empty())
+    return false;
+
+  _out.append(_xml.data() + copied, _xml.size() - copied);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SdfUriRewriter::RewriteDom(std::string_view _xml, const UriMap &_map,
+    std::string &_out, std::size_t &_rewritten)
+{
+  _out.clear();
+  _rewritten = 0;
+
+  tinyxml2::XMLDocument doc;
+  if (doc.Parse(_xml.data(), _xml.size()) != tinyxml2::XML_SUCCESS ||
+      !doc.RootElement())
+  {
+    return false;
+  }
+
+  tinyxml2::XMLElement *root = doc.RootElement();
+  fixElement(root, rootScope(root->Name()), _map, _rewritten);
+
+  tinyxml2::XMLPrinter printer;
+  doc.Print(&printer);
+  _out.assign(printer.CStr(),
+      static_cast<std::size_t>(printer.CStrSize() - 1));
+  return true;
+}
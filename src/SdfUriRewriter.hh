@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_SDFURIREWRITER_HH_
+#define GZ_FUEL_TOOLS_SDFURIREWRITER_HH_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "gz/fuel_tools/Export.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Kinds of URIs found in SDF and URDF files.
+  enum class SdfUriType
+  {
+    /// \brief A file of a model, such as a mesh or a texture, e.g.
+    /// model://box/meshes/box.dae
+    FILE,
+
+    /// \brief A model included by a world or another model, e.g.
+    /// model://box
+    MODEL,
+  };
+
+  /// \brief Rewrites the model:// URIs of SDF and URDF files, so that a
+  /// cached model or world refers to its files on the Fuel server.
+  ///
+  /// The URIs rewritten are the mesh URIs of collisions and visuals, the
+  /// material script URIs and PBR maps of visuals, the skin and animation
+  /// files of actors, and the URIs of included models. They're looked for
+  /// in the models and actors at the top of a model file or of its worlds,
+  /// and in nested models. In URDF files, the file names of meshes and
+  /// textures are rewritten. Where an element can only appear once, only
+  /// its first occurrence is considered.
+  ///
+  /// Rewrite scans the document once and patches the text of those URIs,
+  /// leaving every other byte as it is. RewriteDom loads the document into
+  /// a DOM and prints it back, it handles any XML but reformats the whole
+  /// document. Both select the same URIs.
+  class GZ_FUEL_TOOLS_VISIBLE SdfUriRewriter
+  {
+    /// \brief Function returning the replacement of a URI, or the URI
+    /// itself to keep it.
+    public: using UriMap =
+        std::function<std::string(const std::string &, SdfUriType)>;
+
+    /// \brief Quick check for URIs that may need a rewrite. Documents
+    /// without any can be left alone without being parsed.
+    /// \param[in] _xml Document.
+    /// \return True if the document contains "model://".
+    public: static bool HasModelUri(std::string_view _xml);
+
+    /// \brief Rewrite the URIs of a document in place.
+    /// \param[in] _xml Document.
+    /// \param[in] _map Replacement of each URI.
+    /// \param[out] _out Rewritten document, identical to _xml but for the
+    /// replaced URIs.
+    /// \param[out] _rewritten Number of URIs replaced.
+    /// \return False if the document is malformed, or uses XML this scan
+    /// doesn't handle: a DOCTYPE, entities or carriage returns in a URI,
+    /// or comments or CDATA sections leading the text of a URI. RewriteDom
+    /// handles those.
+    public: static bool Rewrite(std::string_view _xml, const UriMap &_map,
+                std::string &_out, std::size_t &_rewritten);
+
+    /// \brief Rewrite the URIs of a document through a DOM.
+    /// \param[in] _xml Document.
+    /// \param[in] _map Replacement of each URI.
+    /// \param[out] _out Rewritten document, printed from the DOM.
+    /// \param[out] _rewritten Number of URIs replaced.
+    /// \return False if the document can't be parsed.
+    public: static bool RewriteDom(std::string_view _xml,
+                const UriMap &_map, std::string &_out,
+                std::size_t &_rewritten);
+  };
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_SDFURIREWRITER_HH_
@@ -0,0 +1,379 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <tinyxml2.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SdfUriRewriter.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+/// \brief Replace model:// URIs with a server URL.
+std::string toUrl(const std::string &_uri, SdfUriType _type)
+{
+  auto pos = _uri.find("model://");
+  if (pos == std::string::npos)
+    return _uri;
+  return (_type == SdfUriType::FILE ? "https://fuel.org/files/" :
+      "https://fuel.org/models/") + _uri.substr(pos + 8);
+}
+
+/////////////////////////////////////////////////
+/// \brief Model touching every rewritten element, along with elements
+/// that look alike but aren't rewritten.
+const char kModel[] = R"(<?xml version="1.0" ?>
+<!-- model://comment/is/kept -->
+<sdf version="1.6">
+  <model name="box">
+    <link name="link">
+      <collision name="collision">
+        <geometry>
+          <mesh><uri>model://box/meshes/box.dae</uri></mesh>
+        </geometry>
+        <geometry>
+          <mesh><uri>model://box/meshes/second_geometry.dae</uri></mesh>
+        </geometry>
+      </collision>
+      <visual name="visual" note="a > b">
+        <geometry>
+          <mesh>
+            <uri>
+              model://box/meshes/spaced.dae
+            </uri>
+            <uri>model://box/meshes/second_uri.dae</uri>
+          </mesh>
+        </geometry>
+        <material>
+          <script>
+            <uri>model://box/materials/scripts</uri>
+            <uri>model://box/materials/textures</uri>
+            <name>Box/Diffuse</name>
+          </script>
+          <pbr>
+            <metal>
+              <albedo_map>model://box/materials/albedo.png</albedo_map>
+              <metalness_map>model://box/materials/metal.png</metalness_map>
+              <specular_map>model://box/materials/not_metal.png</specular_map>
+            </metal>
+            <specular>
+              <normal_map>model://box/materials/normal.png</normal_map>
+              <glossiness_map>model://box/gloss.png</glossiness_map>
+              <roughness_map>model://box/not_specular.png</roughness_map>
+            </specular>
+          </pbr>
+        </material>
+      </visual>
+      <visual name="empty"><geometry><mesh><uri/></mesh></geometry></visual>
+    </link>
+    <model name="nested">
+      <link name="link">
+        <visual name="visual">
+          <geometry><mesh><uri>model://box/nested.dae</uri></mesh></geometry>
+        </visual>
+      </link>
+    </model>
+    <include><uri>model://other</uri></include>
+  </model>
+  <actor name="actor">
+    <skin><filename>model://actor/skin.dae</filename></skin>
+    <animation name="walk">
+      <filename>model://actor/walk.dae</filename>
+    </animation>
+  </actor>
+</sdf>
+)";
+
+/////////////////////////////////////////////////
+/// \brief Compare two elements and their descendants.
+/// \param[in] _a First element.
+/// \param[in] _b Second element.
+/// \return True if both have the same names, attributes and texts.
+bool sameElement(const tinyxml2::XMLElement *_a,
+    const tinyxml2::XMLElement *_b)
+{
+  if (!_a || !_b)
+    return _a == _b;
+  if (std::string(_a->Name()) != _b->Name())
+    return false;
+
+  std::string textA = _a->GetText() ? _a->GetText() : "";
+  std::string textB = _b->GetText() ? _b->GetText() : "";
+  if (textA != textB)
+    return false;
+
+  const tinyxml2::XMLAttribute *attrA = _a->FirstAttribute();
+  const tinyxml2::XMLAttribute *attrB = _b->FirstAttribute();
+  for (; attrA && attrB; attrA = attrA->Next(), attrB = attrB->Next())
+  {
+    if (std::string(attrA->Name()) != attrB->Name() ||
+        std::string(attrA->Value()) != attrB->Value())
+    {
+      return false;
+    }
+  }
+  if (attrA || attrB)
+    return false;
+
+  const tinyxml2::XMLElement *childA = _a->FirstChildElement();
+  const tinyxml2::XMLElement *childB = _b->FirstChildElement();
+  for (; childA && childB; childA = childA->NextSiblingElement(),
+       childB = childB->NextSiblingElement())
+  {
+    if (!sameElement(childA, childB))
+      return false;
+  }
+  return !childA && !childB;
+}
+
+/////////////////////////////////////////////////
+TEST(SdfUriRewriter, HasModelUri)
+{
+  EXPECT_TRUE(SdfUriRewriter::HasModelUri(kModel));
+  EXPECT_FALSE(SdfUriRewriter::HasModelUri(
+      "<sdf><model><link/></model></sdf>"));
+  EXPECT_FALSE(SdfUriRewriter::HasModelUri(""));
+}
+
+/////////////////////////////////////////////////
+TEST(SdfUriRewriter, Rewrite)
+{
+  std::string out;
+  std::size_t count = 0;
+  ASSERT_TRUE(SdfUriRewriter::Rewrite(kModel, toUrl, out, count));
+  EXPECT_EQ(12u, count);
+
+  // Only the URIs change
+  std::string expected = kModel;
+  for (const std::string uri : {
+      "model://box/nested.dae",
+      "model://box/meshes/box.dae",
+      "model://box/materials/scripts",
+      "model://box/materials/textures",
+      "model://box/materials/albedo.png",
+      "model://box/materials/metal.png",
+      "model://box/materials/normal.png",
+      "model://box/gloss.png",
+      "model://actor/skin.dae",
+      "model://actor/walk.dae"})
+  {
+    auto pos = expected.find(">" + uri + "<");
+    ASSERT_NE(std::string::npos, pos) << uri;
+    expected.replace(pos + 1, uri.size(), toUrl(uri, SdfUriType::FILE));
+  }
+  expected.replace(expected.find("model://other"), 13,
+      "https://fuel.org/models/other");
+
+  // The text leading an element is replaced whole
+  std::string spaced =
+      "\n              model://box/meshes/spaced.dae\n            ";
+  auto pos = expected.find(spaced);
+  ASSERT_NE(std::string::npos, pos);
+  expected.replace(pos, spaced.size(), "https://fuel.org/files/box/meshes/"
+      "spaced.dae\n            ");
+  EXPECT_EQ(expected, out);
+
+  // Replacements are escaped
+  ASSERT_TRUE(SdfUriRewriter::Rewrite(
+      "<sdf><actor><skin><filename>model://a/b</filename></skin></actor>"
+      "</sdf>",
+      [](const std::string &, SdfUriType) {return std::string("a<b&c");},
+      out, count));
+  EXPECT_EQ("<sdf><actor><skin><filename>a&lt;b&amp;c</filename></skin>"
+      "</actor></sdf>", out);
+
+  // Nothing to rewrite
+  ASSERT_TRUE(SdfUriRewriter::Rewrite(kModel,
+      [](const std::string &_uri, SdfUriType) {return _uri;}, out, count));
+  EXPECT_EQ(0u, count);
+  EXPECT_EQ(kModel, out);
+}
+
+/////////////////////////////////////////////////
+/// \brief World including models.
+const char kWorld[] = R"(<sdf version="1.9">
+  <world name="world">
+    <include><uri>model://ground_plane</uri></include>
+    <include>
+      <name>box</name>
+      <uri>model://box</uri>
+    </include>
+    <model name="inline">
+      <include><uri>model://nested</uri></include>
+      <link name="link">
+        <visual name="visual">
+          <geometry><mesh><uri>model://box/a.dae</uri></mesh></geometry>
+        </visual>
+      </link>
+    </model>
+    <actor name="actor">
+      <skin><filename>model://actor/skin.dae</filename></skin>
+    </actor>
+    <light name="light"><uri>model://light/kept</uri></light>
+  </world>
+</sdf>)";
+
+/////////////////////////////////////////////////
+/// \brief URDF robot.
+const char kRobot[] = R"(<robot name="robot">
+  <material name="shared"><texture filename="model://r/t.png"/></material>
+  <link name="link">
+    <visual>
+      <geometry><mesh filename='model://r/a.dae' scale="1 1 1"/></geometry>
+      <material name="m"><texture filename="model://r/u.png"></texture>
+      </material>
+    </visual>
+    <collision>
+      <geometry><mesh scale="1 1 1" filename = "model://r/c.dae"/></geometry>
+    </collision>
+    <inertial><origin xyz="0 0 0" file="model://r/kept"/></inertial>
+  </link>
+</robot>)";
+
+/////////////////////////////////////////////////
+TEST(SdfUriRewriter, WorldsAndUrdf)
+{
+  std::string out;
+  std::size_t count = 0;
+  ASSERT_TRUE(SdfUriRewriter::Rewrite(kWorld, toUrl, out, count));
+  EXPECT_EQ(5u, count);
+
+  std::string expected = kWorld;
+  for (const auto &[from, to] : std::vector<std::pair<std::string,
+      std::string>>{
+      {"model://ground_plane", "https://fuel.org/models/ground_plane"},
+      {"model://box<", "https://fuel.org/models/box<"},
+      {"model://nested", "https://fuel.org/models/nested"},
+      {"model://box/a.dae", "https://fuel.org/files/box/a.dae"},
+      {"model://actor/skin.dae", "https://fuel.org/files/actor/skin.dae"}})
+  {
+    auto pos = expected.find(from);
+    ASSERT_NE(std::string::npos, pos) << from;
+    expected.replace(pos, from.size(), to);
+  }
+  EXPECT_EQ(expected, out);
+
+  ASSERT_TRUE(SdfUriRewriter::Rewrite(kRobot, toUrl, out, count));
+  EXPECT_EQ(4u, count);
+
+  expected = kRobot;
+  for (const std::string file : {"t.png", "a.dae", "u.png", "c.dae"})
+  {
+    auto pos = expected.find("model://r/" + file);
+    ASSERT_NE(std::string::npos, pos) << file;
+    expected.replace(pos, 10 + file.size(), "https://fuel.org/files/r/" +
+        file);
+  }
+  EXPECT_EQ(expected, out);
+
+  // Rewritten documents have nothing left to rewrite
+  std::string again;
+  ASSERT_TRUE(SdfUriRewriter::Rewrite(out, toUrl, again, count));
+  EXPECT_EQ(0u, count);
+  EXPECT_EQ(out, again);
+
+  // Attribute values are escaped
+  ASSERT_TRUE(SdfUriRewriter::Rewrite(
+      "<robot><material><texture filename=\"model://a\"/></material></robot>",
+      [](const std::string &, SdfUriType) {return std::string("\"'&");},
+      out, count));
+  EXPECT_EQ("<robot><material><texture filename=\"&quot;&apos;&amp;\"/>"
+      "</material></robot>", out);
+}
+
+/////////////////////////////////////////////////
+TEST(SdfUriRewriter, Unsupported)
+{
+  std::string out;
+  std::size_t count = 0;
+  const std::string geometry =
+      "<sdf><model><link><visual><geometry><mesh>";
+  const std::string end = "</mesh></geometry></visual></link></model></sdf>";
+
+  // The DOM handles these
+  for (const std::string &xml : std::vector<std::string>{
+      "<!DOCTYPE sdf><sdf/>",
+      geometry + "<uri>model://a/b&amp;c</uri>" + end,
+      geometry + "<uri>model://a/b\r\n</uri>" + end,
+      geometry + "<uri><!-- a -->model://a/b</uri>" + end,
+      geometry + "<uri><![CDATA[model://a/b]]></uri>" + end})
+  {
+    EXPECT_FALSE(SdfUriRewriter::Rewrite(xml, toUrl, out, count)) << xml;
+  }
+
+  // Malformed documents
+  for (const std::string xml : {
+      "<sdf><model></sdf>",
+      "<sdf><model>",
+      "<sdf><model name=\"a></model></sdf>",
+      "<sdf><!-- a </sdf>"})
+  {
+    EXPECT_FALSE(SdfUriRewriter::Rewrite(xml, toUrl, out, count)) << xml;
+    EXPECT_FALSE(SdfUriRewriter::RewriteDom(xml, toUrl, out, count)) << xml;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SdfUriRewriter, DomParity)
+{
+  const std::string geometry =
+      "<sdf><model><link><visual><geometry><mesh>";
+  const std::string end = "</mesh></geometry></visual></link></model></sdf>";
+
+  std::vector<std::string> documents = {
+      kModel,
+      kWorld,
+      kRobot,
+      geometry + "<uri>model://a/b</uri>" + end,
+      geometry + "<uri> model://a/b </uri>" + end,
+      geometry + "<uri>model://a</uri>" + end,
+      geometry + "<uri>  </uri>" + end,
+      geometry + "<uri>file://a/b</uri>" + end,
+      "<sdf><model><link><visual><geometry><mesh><uri>model://a/b</uri>"
+      "</mesh></geometry></visual></link></model><model><link><collision>"
+      "<geometry><mesh><uri>model://c/d</uri></mesh></geometry></collision>"
+      "</link></model></sdf>",
+      "<world><model><link><visual><material><script><uri>model://a/b</uri>"
+      "</script><script><uri>model://a/c</uri></script></material></visual>"
+      "</link></model></world>",
+  };
+
+  for (const auto &xml : documents)
+  {
+    std::string streamed;
+    std::string printed;
+    std::size_t streamedCount = 0;
+    std::size_t printedCount = 0;
+    ASSERT_TRUE(SdfUriRewriter::Rewrite(xml, toUrl, streamed,
+        streamedCount)) << xml;
+    ASSERT_TRUE(SdfUriRewriter::RewriteDom(xml, toUrl, printed,
+        printedCount)) << xml;
+    EXPECT_EQ(printedCount, streamedCount) << xml;
+
+    tinyxml2::XMLDocument streamedDoc;
+    tinyxml2::XMLDocument printedDoc;
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, streamedDoc.Parse(streamed.c_str()));
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, printedDoc.Parse(printed.c_str()));
+    EXPECT_TRUE(sameElement(streamedDoc.RootElement(),
+        printedDoc.RootElement())) << streamed << "\n" << printed;
+  }
+}
@@ -17,9 +17,11 @@
 
 #include <yaml.h>
 #include <cstdio>
+#include <memory>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <utility>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
@@ -30,17 +32,9 @@
 namespace gz::fuel_tools
 {
 //////////////////////////////////////////////////
-/// \brief Private data class
-class ServerConfigPrivate
+/// \brief Values of a server config, never modified once shared.
+class ServerConfigData
 {
-  /// \brief Clear values.
-  public: void Clear()
-          {
-            this->url.Clear();
-            this->key = "";
-            this->version = "1.0";
-          }
-
   /// \brief URL to reach server
   public: common::URI url{"https://fuel.gazebosim.org", true};
 
@@ -51,29 +45,59 @@ class ServerConfigPrivate
   public: std::string version = "1.0";
 };
 
+//////////////////////////////////////////////////
+/// \brief Private data class
+class ServerConfigPrivate
+{
+  /// \brief Get the data shared by default constructed configs.
+  /// \return Default data.
+  public: static const std::shared_ptr<const ServerConfigData> &Default()
+          {
+            static const std::shared_ptr<const ServerConfigData> data =
+              std::make_shared<ServerConfigData>();
+            return data;
+          }
+
+  /// \brief Replace the data by a copy, to be modified. The data is
+  /// always copied, since other configs may share it.
+  /// \return The copy.
+  public: ServerConfigData &Modify()
+          {
+            auto copy = std::make_shared<ServerConfigData>(*this->data);
+            ServerConfigData &result = *copy;
+            this->data = std::move(copy);
+            return result;
+          }
+
+  /// \brief Values, shared with the copies of the config.
+  public: std::shared_ptr<const ServerConfigData> data = Default();
+};
+
 //////////////////////////////////////////////////
 ServerConfig::ServerConfig()
-  : dataPtr (new ServerConfigPrivate)
+  : dataPtr(new ServerConfigPrivate)
 {
 }
 
 //////////////////////////////////////////////////
 ServerConfig::ServerConfig(const ServerConfig &_orig)
-  : dataPtr(new ServerConfigPrivate)
+  : dataPtr(new ServerConfigPrivate(*_orig.dataPtr))
 {
-  *(this->dataPtr) = *(_orig.dataPtr);
 }
 
 //////////////////////////////////////////////////
 void ServerConfig::Clear()
 {
-  this->dataPtr->Clear();
+  ServerConfigData &data = this->dataPtr->Modify();
+  data.url.Clear();
+  data.key = "";
+  data.version = "1.0";
 }
 
 //////////////////////////////////////////////////
 ServerConfig &ServerConfig::operator=(const ServerConfig &_orig)
 {
-  *(this->dataPtr) = *(_orig.dataPtr);
+  this->dataPtr->data = _orig.dataPtr->data;
   return *this;
 }
 
@@ -85,37 +109,37 @@ ServerConfig::~ServerConfig()
 //////////////////////////////////////////////////
 common::URI ServerConfig::Url() const
 {
-  return this->dataPtr->url;
+  return this->dataPtr->data->url;
 }
 
 //////////////////////////////////////////////////
 void ServerConfig::SetUrl(const common::URI &_url)
 {
-  this->dataPtr->url = _url;
+  this->dataPtr->Modify().url = _url;
 }
 
 //////////////////////////////////////////////////
 std::string ServerConfig::ApiKey() const
 {
-  return this->dataPtr->key;
+  return this->dataPtr->data->key;
 }
 
 //////////////////////////////////////////////////
 void ServerConfig::SetApiKey(const std::string &_key)
 {
-  this->dataPtr->key = _key;
+  this->dataPtr->Modify().key = _key;
 }
 
 //////////////////////////////////////////////////
 std::string ServerConfig::Version() const
 {
-  return this->dataPtr->version;
+  return this->dataPtr->data->version;
 }
 
 //////////////////////////////////////////////////
 void ServerConfig::SetVersion(const std::string &_version)
 {
-  this->dataPtr->version = _version;
+  this->dataPtr->Modify().version = _version;
 }
 
 //////////////////////////////////////////////////
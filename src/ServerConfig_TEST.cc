@@ -64,6 +64,44 @@ class ServerConfigTest: public ::testing::Test
   public: std::shared_ptr<gz::common::TempDirectory> tempDir;
 };
 
+/////////////////////////////////////////////////
+TEST_F(ServerConfigTest, CopiesAreIndependent)
+{
+  ServerConfig config;
+  config.SetUrl(common::URI("http://localhost:8007", true));
+  config.SetApiKey("key");
+
+  // Modifying a copy doesn't change the original
+  ServerConfig copy(config);
+  EXPECT_EQ(config.Url().Str(), copy.Url().Str());
+  copy.SetApiKey("other_key");
+  copy.SetVersion("2.0");
+  EXPECT_EQ("key", config.ApiKey());
+  EXPECT_EQ("1.0", config.Version());
+  EXPECT_EQ("other_key", copy.ApiKey());
+  EXPECT_EQ("2.0", copy.Version());
+
+  // Nor the other way around
+  ServerConfig assigned;
+  assigned = config;
+  config.SetUrl(common::URI("http://localhost:8008", true));
+  EXPECT_EQ("http://localhost:8007", assigned.Url().Str());
+  EXPECT_EQ("http://localhost:8008", config.Url().Str());
+
+  assigned.Clear();
+  EXPECT_TRUE(assigned.Url().Str().empty());
+  EXPECT_EQ("key", config.ApiKey());
+
+  // Default configs don't affect each other
+  ServerConfig first;
+  ServerConfig second;
+  first.SetVersion("3.0");
+  first.Clear();
+  EXPECT_EQ("https://fuel.gazebosim.org", second.Url().Str());
+  EXPECT_EQ("https://fuel.gazebosim.org", ServerConfig().Url().Str());
+  EXPECT_EQ("1.0", ServerConfig().Version());
+}
+
 /////////////////////////////////////////////////
 TEST_F(ServerConfigTest, ApiKey)
 {
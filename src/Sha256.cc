@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "Sha256.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /// \brief Round constants.
+  constexpr uint32_t kRound[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+  /// \brief Size of the chunks read when hashing a file. Large reads keep
+  /// the hashing I/O bound.
+  constexpr std::size_t kFileChunkSize = 1u << 20;
+
+  /// \brief Rotate right.
+  inline uint32_t rotr(uint32_t _x, unsigned int _n)
+  {
+    return (_x >> _n) | (_x << (32u - _n));
+  }
+}
+
+//////////////////////////////////////////////////
+Sha256::Sha256()
+  : state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+          0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}
+{
+}
+
+//////////////////////////////////////////////////
+void Sha256::Transform(const uint8_t *_block)
+{
+  uint32_t w[64];
+  for (int i = 0; i < 16; ++i)
+  {
+    w[i] = (static_cast<uint32_t>(_block[i * 4]) << 24) |
+           (static_cast<uint32_t>(_block[i * 4 + 1]) << 16) |
+           (static_cast<uint32_t>(_block[i * 4 + 2]) << 8) |
+           (static_cast<uint32_t>(_block[i * 4 + 3]));
+  }
+  for (int i = 16; i < 64; ++i)
+  {
+    uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = this->state[0];
+  uint32_t b = this->state[1];
+  uint32_t c = this->state[2];
+  uint32_t d = this->state[3];
+  uint32_t e = this->state[4];
+  uint32_t f = this->state[5];
+  uint32_t g = this->state[6];
+  uint32_t h = this->state[7];
+
+  for (int i = 0; i < 64; ++i)
+  {
+    uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+    uint32_t ch = (e & f) ^ (~e & g);
+    uint32_t t1 = h + s1 + ch + kRound[i] + w[i];
+    uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+    uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+    uint32_t t2 = s0 + maj;
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  this->state[0] += a;
+  this->state[1] += b;
+  this->state[2] += c;
+  this->state[3] += d;
+  this->state[4] += e;
+  this->state[5] += f;
+  this->state[6] += g;
+  this->state[7] += h;
+}
+
+//////////////////////////////////////////////////
+void Sha256::Update(const void *_data, std::size_t _size)
+{
+  const uint8_t *data = static_cast<const uint8_t *>(_data);
+  this->totalSize += _size;
+
+  // Complete a pending partial block first
+  if (this->bufferSize > 0)
+  {
+    std::size_t n = std::min(_size, this->buffer.size() - this->bufferSize);
+    std::memcpy(this->buffer.data() + this->bufferSize, data, n);
+    this->bufferSize += n;
+    data += n;
+    _size -= n;
+
+    if (this->bufferSize < this->buffer.size())
+      return;
+
+    this->Transform(this->buffer.data());
+    this->bufferSize = 0;
+  }
+
+  // Hash full blocks straight from the input
+  while (_size >= this->buffer.size())
+  {
+    this->Transform(data);
+    data += this->buffer.size();
+    _size -= this->buffer.size();
+  }
+
+  if (_size > 0)
+  {
+    std::memcpy(this->buffer.data(), data, _size);
+    this->bufferSize = _size;
+  }
+}
+
+//////////////////////////////////////////////////
+std::string Sha256::HexDigest()
+{
+  uint64_t bitSize = this->totalSize * 8u;
+
+  // Pad with 0x80, zeros, and the message length in bits
+  uint8_t pad[72] = {0x80};
+  std::size_t padSize = (this->bufferSize < 56) ?
+    56 - this->bufferSize : 120 - this->bufferSize;
+  for (int i = 0; i < 8; ++i)
+    pad[padSize + i] = static_cast<uint8_t>(bitSize >> (56 - i * 8));
+  this->Update(pad, padSize + 8);
+
+  static const char *kHex = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(64);
+  for (uint32_t word : this->state)
+  {
+    for (int shift = 28; shift >= 0; shift -= 4)
+      hex.push_back(kHex[(word >> shift) & 0xf]);
+  }
+  return hex;
+}
+
+//////////////////////////////////////////////////
+std::string Sha256::Hash(const std::string &_data)
+{
+  Sha256 sha;
+  sha.Update(_data.data(), _data.size());
+  return sha.HexDigest();
+}
+
+//////////////////////////////////////////////////
+bool Sha256::HashFile(const std::string &_path, std::string &_hex)
+{
+  std::ifstream file(_path, std::ios::binary);
+  if (!file)
+    return false;
+
+  Sha256 sha;
+  std::unique_ptr<char[]> chunk(new char[kFileChunkSize]);
+  while (file)
+  {
+    file.read(chunk.get(), kFileChunkSize);
+    std::streamsize n = file.gcount();
+    if (n > 0)
+      sha.Update(chunk.get(), static_cast<std::size_t>(n));
+  }
+
+  if (file.bad())
+    return false;
+
+  _hex = sha.HexDigest();
+  return true;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_SHA256_HH_
+#define GZ_FUEL_TOOLS_SHA256_HH_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gz/fuel_tools/Export.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Incremental SHA-256 hasher (FIPS 180-4).
+  ///
+  /// Data can be fed in chunks of any size, which makes it possible to hash
+  /// large files without loading them in memory.
+  class GZ_FUEL_TOOLS_VISIBLE Sha256
+  {
+    /// \brief Constructor.
+    public: Sha256();
+
+    /// \brief Add data to the hash.
+    /// \param[in] _data Pointer to the data.
+    /// \param[in] _size Number of bytes.
+    public: void Update(const void *_data, std::size_t _size);
+
+    /// \brief Finish the hash. The hasher must not be updated afterwards.
+    /// \return Lowercase hexadecimal digest (64 characters).
+    public: std::string HexDigest();
+
+    /// \brief Hash a string in one call.
+    /// \param[in] _data Data to hash.
+    /// \return Lowercase hexadecimal digest.
+    public: static std::string Hash(const std::string &_data);
+
+    /// \brief Hash a file, reading it in large chunks.
+    /// \param[in] _path Path to the file.
+    /// \param[out] _hex Lowercase hexadecimal digest.
+    /// \return True if the file could be read.
+    public: static bool HashFile(const std::string &_path, std::string &_hex);
+
+    /// \brief Process one 64 byte block.
+    /// \param[in] _block Block to process.
+    private: void Transform(const uint8_t *_block);
+
+    /// \brief Intermediate hash value.
+    private: std::array<uint32_t, 8> state;
+
+    /// \brief Partial block waiting for more data.
+    private: std::array<uint8_t, 64> buffer;
+
+    /// \brief Number of bytes in buffer.
+    private: std::size_t bufferSize{0};
+
+    /// \brief Total number of bytes hashed.
+    private: uint64_t totalSize{0};
+  };
+}
+
+#endif  // GZ_FUEL_TOOLS_SHA256_HH_
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "Sha256.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+TEST(Sha256, KnownVectors)
+{
+  EXPECT_EQ(
+    "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+    Sha256::Hash(""));
+  EXPECT_EQ(
+    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+    Sha256::Hash("abc"));
+  EXPECT_EQ(
+    "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+    Sha256::Hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+  EXPECT_EQ(
+    "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+    Sha256::Hash(std::string(1000000, 'a')));
+}
+
+/////////////////////////////////////////////////
+TEST(Sha256, Incremental)
+{
+  std::string data;
+  for (int i = 0; i < 1000; ++i)
+    data += std::to_string(i);
+
+  // Feed the data in uneven chunks that straddle block boundaries
+  Sha256 sha;
+  std::size_t pos = 0;
+  std::size_t chunk = 1;
+  while (pos < data.size())
+  {
+    std::size_t n = std::min(chunk, data.size() - pos);
+    sha.Update(data.data() + pos, n);
+    pos += n;
+    chunk = (chunk * 7) % 131 + 1;
+  }
+  EXPECT_EQ(Sha256::Hash(data), sha.HexDigest());
+}
+
+/////////////////////////////////////////////////
+TEST(Sha256, HashFile)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  std::string path = common::joinPaths(tempDir->Path(), "file.bin");
+  std::string data(3 * 1024 * 1024 + 17, 'x');
+  {
+    std::ofstream fout(path, std::ios::binary);
+    fout << data;
+  }
+
+  std::string hex;
+  EXPECT_TRUE(Sha256::HashFile(path, hex));
+  EXPECT_EQ(Sha256::Hash(data), hex);
+
+  EXPECT_FALSE(Sha256::HashFile(
+      common::joinPaths(tempDir->Path(), "missing"), hex));
+}
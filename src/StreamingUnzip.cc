@@ -0,0 +1,679 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <zip.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/StringUtils.hh>
+
+#include "CacheStatisticsRecorder.hh"
+#include "FileWriter.hh"
+#include "StreamingUnzip.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace
+{
+  /// \brief Signature of a local file header.
+  constexpr std::uint32_t kLocalHeaderSignature = 0x04034b50;
+
+  /// \brief Signature of a central directory record.
+  constexpr std::uint32_t kCentralHeaderSignature = 0x02014b50;
+
+  /// \brief Signature of the end of central directory record.
+  constexpr std::uint32_t kEndSignature = 0x06054b50;
+
+  /// \brief Optional signature of a data descriptor.
+  constexpr std::uint32_t kDescriptorSignature = 0x08074b50;
+
+  /// \brief Size of a local file header after its signature.
+  constexpr std::size_t kLocalHeaderSize = 26;
+
+  /// \brief Size of the buffer entries are inflated into.
+  constexpr std::size_t kInflateBufferSize = 256 * 1024;
+
+  /// \brief Marker of a size stored in a Zip64 extra field.
+  constexpr std::uint32_t kZip64Marker = 0xffffffff;
+
+  //////////////////////////////////////////////////
+  /// \brief Read a little endian integer.
+  /// \param[in] _data Bytes.
+  /// \param[in] _bytes Size of the integer.
+  /// \return Integer.
+  std::uint64_t readLe(const char *_data, std::size_t _bytes)
+  {
+    std::uint64_t value = 0;
+    for (std::size_t i = _bytes; i-- > 0;)
+      value = (value << 8) | static_cast<unsigned char>(_data[i]);
+    return value;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Whether an entry name stays inside the extraction directory.
+  /// \param[in] _name Entry name.
+  /// \return True if the name is relative and has no ".." component.
+  bool safeName(const std::string &_name)
+  {
+    if (_name.empty() || _name[0] == '/' || _name[0] == '\\' ||
+        _name.find(':') != std::string::npos)
+    {
+      return false;
+    }
+    for (const auto &part : common::Split(_name, '/'))
+    {
+      if (part == "..")
+        return false;
+    }
+    return true;
+  }
+}
+
+/// \brief Private data.
+class gz::fuel_tools::StreamingUnzipPrivate
+{
+  /// \brief Parser states.
+  public: enum class State
+  {
+    /// \brief Reading the signature of the next record.
+    SIGNATURE,
+
+    /// \brief Reading a local file header.
+    LOCAL_HEADER,
+
+    /// \brief Reading the data of an entry.
+    DATA,
+
+    /// \brief Reading the data descriptor of an entry.
+    DESCRIPTOR,
+
+    /// \brief Reached the central directory.
+    DONE,
+
+    /// \brief Gave up.
+    FAILED,
+  };
+
+  /// \brief Extracted entry.
+  public: struct Entry
+  {
+    /// \brief Whether the entry is a directory.
+    bool directory = false;
+
+    /// \brief CRC-32 of the data.
+    std::uint32_t crc = 0;
+
+    /// \brief Uncompressed size.
+    std::uint64_t size = 0;
+  };
+
+  /// \brief Give up streaming.
+  /// \param[in] _reason Why.
+  /// \return False.
+  public: bool Fail(const std::string &_reason);
+
+  /// \brief Move bytes from the input to the pending buffer until it holds
+  /// a number of bytes.
+  /// \param[in, out] _data Input, advanced past the moved bytes.
+  /// \param[in, out] _size Size of the input.
+  /// \param[in] _needed Number of bytes needed in the pending buffer.
+  /// \return True once the pending buffer holds _needed bytes.
+  public: bool Fill(const char *&_data, std::size_t &_size,
+              std::size_t _needed);
+
+  /// \brief Parse the local header in the pending buffer and start the
+  /// entry.
+  /// \return False if streaming gave up.
+  public: bool BeginEntry();
+
+  /// \brief Process entry data.
+  /// \param[in, out] _data Input, advanced past the consumed bytes.
+  /// \param[in, out] _size Size of the input.
+  /// \return False if streaming gave up.
+  public: bool ReadData(const char *&_data, std::size_t &_size);
+
+  /// \brief Write decompressed bytes of the current entry.
+  /// \param[in] _data Bytes.
+  /// \param[in] _size Number of bytes.
+  /// \return False if streaming gave up.
+  public: bool Output(const char *_data, std::size_t _size);
+
+  /// \brief Parse the data descriptor in the pending buffer.
+  /// \return False if streaming gave up.
+  public: bool ReadDescriptor();
+
+  /// \brief Complete the current entry.
+  /// \param[in] _crc Expected CRC-32.
+  /// \param[in] _size Expected uncompressed size.
+  /// \param[in] _compressed Expected compressed size.
+  /// \return False if streaming gave up.
+  public: bool EndEntry(std::uint32_t _crc, std::uint64_t _size,
+              std::uint64_t _compressed);
+
+  /// \brief Release the decompressor, if any.
+  public: void EndInflate();
+
+  /// \brief Destination directory.
+  public: std::string dst;
+
+  /// \brief Parser state.
+  public: State state = State::SIGNATURE;
+
+  /// \brief Bytes of the record being read.
+  public: std::string pending;
+
+  /// \brief Extracted entries, by name.
+  public: std::map<std::string, Entry> entries;
+
+  /// \brief Why streaming gave up.
+  public: std::string error;
+
+  /// \brief Name of the current entry.
+  public: std::string name;
+
+  /// \brief Writer of the current entry's file.
+  public: std::unique_ptr<FileWriter> writer;
+
+  /// \brief Whether the current entry is deflated, otherwise stored.
+  public: bool deflated = false;
+
+  /// \brief Whether the current entry is followed by a data descriptor.
+  public: bool descriptor = false;
+
+  /// \brief Whether the current entry has a Zip64 extra field.
+  public: bool zip64 = false;
+
+  /// \brief Whether the signature of the data descriptor was checked.
+  public: bool descriptorSignatureChecked = false;
+
+  /// \brief CRC-32 from the local header.
+  public: std::uint32_t expectedCrc = 0;
+
+  /// \brief Uncompressed size from the local header.
+  public: std::uint64_t expectedSize = 0;
+
+  /// \brief Compressed size from the local header.
+  public: std::uint64_t expectedCompressed = 0;
+
+  /// \brief Compressed bytes read so far.
+  public: std::uint64_t compressedRead = 0;
+
+  /// \brief CRC-32 of the data written so far.
+  public: std::uint32_t crc = 0;
+
+  /// \brief Uncompressed bytes written so far.
+  public: std::uint64_t written = 0;
+
+  /// \brief Decompressor.
+  public: z_stream zs{};
+
+  /// \brief Whether the decompressor is initialized.
+  public: bool inflating = false;
+
+  /// \brief Buffer entries are inflated into.
+  public: std::vector<char> buffer;
+};
+
+//////////////////////////////////////////////////
+bool StreamingUnzipPrivate::Fail(const std::string &_reason)
+{
+  if (this->state == State::FAILED)
+    return false;
+
+  gzdbg << "Streaming extraction into [" << this->dst << "] stopped: "
+        << _reason << std::endl;
+  this->error = _reason;
+  this->state = State::FAILED;
+  this->EndInflate();
+  this->writer->Discard();
+  this->pending.clear();
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool StreamingUnzipPrivate::Fill(const char *&_data, std::size_t &_size,
+    std::size_t _needed)
+{
+  if (this->pending.size() < _needed)
+  {
+    std::size_t n = std::min(_size, _needed - this->pending.size());
+    this->pending.append(_data, n);
+    _data += n;
+    _size -= n;
+  }
+  return this->pending.size() >= _needed;
+}
+
+//////////////////////////////////////////////////
+bool StreamingUnzipPrivate::BeginEntry()
+{
+  const char *h = this->pending.data();
+  auto flags = readLe(h + 2, 2);
+  auto method = readLe(h + 4, 2);
+  this->expectedCrc = static_cast<std::uint32_t>(readLe(h + 10, 4));
+  this->expectedCompressed = readLe(h + 14, 4);
+  this->expectedSize = readLe(h + 18, 4);
+  auto nameLength = readLe(h + 22, 2);
+  auto extraLength = readLe(h + 24, 2);
+  this->name.assign(h + kLocalHeaderSize, nameLength);
+
+  // Sizes too large for the header are in the Zip64 extra field
+  this->zip64 = false;
+  const char *extra = h + kLocalHeaderSize + nameLength;
+  for (std::size_t pos = 0; pos + 4 <= extraLength;)
+  {
+    auto id = readLe(extra + pos, 2);
+    auto length = readLe(extra + pos + 2, 2);
+    if (pos + 4 + length > extraLength)
+      break;
+    if (id == 0x0001)
+    {
+      this->zip64 = true;
+      std::size_t field = pos + 4;
+      if (this->expectedSize == kZip64Marker && field + 8 <= pos + 4 + length)
+      {
+        this->expectedSize = readLe(extra + field, 8);
+        field += 8;
+      }
+      if (this->expectedCompressed == kZip64Marker &&
+          field + 8 <= pos + 4 + length)
+      {
+        this->expectedCompressed = readLe(extra + field, 8);
+      }
+    }
+    pos += 4 + length;
+  }
+  this->pending.clear();
+
+  if (flags & 0x1)
+    return this->Fail("encrypted entry [" + this->name + "]");
+  if (method != 0 && method != Z_DEFLATED)
+  {
+    return this->Fail("entry [" + this->name + "] uses compression method " +
+        std::to_string(method));
+  }
+  this->deflated = method == Z_DEFLATED;
+  this->descriptor = (flags & 0x8) != 0;
+  if (!safeName(this->name))
+    return this->Fail("unsafe entry name [" + this->name + "]");
+  if (this->entries.count(this->name))
+    return this->Fail("duplicate entry [" + this->name + "]");
+
+  std::string entryName = this->name;
+  common::changeFromUnixPath(entryName);
+  std::string path = common::joinPaths(this->dst, entryName);
+
+  this->crc = static_cast<std::uint32_t>(crc32(0L, Z_NULL, 0));
+  this->written = 0;
+  this->compressedRead = 0;
+  this->descriptorSignatureChecked = false;
+
+  // Directories have no data, though some writers still follow them with
+  // a data descriptor
+  if (this->name.back() == '/')
+  {
+    if (this->deflated || (!this->descriptor && this->expectedCompressed))
+      return this->Fail("directory [" + this->name + "] has data");
+    if (!common::createDirectories(path))
+      return this->Fail("unable to create directory [" + path + "]");
+    this->entries[this->name].directory = true;
+    this->state = this->descriptor ? State::DESCRIPTOR : State::SIGNATURE;
+    return true;
+  }
+
+  if (this->descriptor && !this->deflated)
+    return this->Fail("stored entry [" + this->name + "] has no size");
+
+  if (!common::createDirectories(common::parentPath(path)))
+    return this->Fail("unable to create directory for [" + path + "]");
+  if (!this->writer->Open(path, this->descriptor ? 0u : this->expectedSize))
+    return this->Fail("unable to create file [" + path + "]");
+
+  if (this->deflated)
+  {
+    this->zs = z_stream{};
+    if (inflateInit2(&this->zs, -MAX_WBITS) != Z_OK)
+      return this->Fail("unable to initialize zlib");
+    this->inflating = true;
+  }
+
+  this->state = State::DATA;
+
+  // Empty stored entries have no data to wait for
+  if (!this->deflated && this->expectedCompressed == 0)
+  {
+    return this->EndEntry(this->expectedCrc, this->expectedSize,
+        this->expectedCompressed);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool StreamingUnzipPrivate::Output(const char *_data, std::size_t _size)
+{
+  if (_size == 0)
+    return true;
+
+  if (!this->writer->Write(_data, _size))
+    return this->Fail("unable to write [" + this->name + "]");
+
+  this->crc = static_cast<std::uint32_t>(crc32(this->crc,
+      reinterpret_cast<const Bytef *>(_data), static_cast<uInt>(_size)));
+  this->written += _size;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool StreamingUnzipPrivate::ReadData(const char *&_data, std::size_t &_size)
+{
+  // With a data descriptor the compressed size is unknown, the deflate
+  // stream marks its own end
+  std::uint64_t left = this->descriptor ? UINT64_MAX :
+      this->expectedCompressed - this->compressedRead;
+  std::size_t available = static_cast<std::size_t>(
+      std::min<std::uint64_t>({_size, left, UINT_MAX}));
+
+  if (!this->deflated)
+  {
+    if (!this->Output(_data, available))
+      return false;
+    _data += available;
+    _size -= available;
+    this->compressedRead += available;
+    if (this->compressedRead == this->expectedCompressed)
+    {
+      return this->EndEntry(this->expectedCrc, this->expectedSize,
+          this->expectedCompressed);
+    }
+    return true;
+  }
+
+  if (this->buffer.empty())
+    this->buffer.resize(kInflateBufferSize);
+
+  this->zs.next_in =
+      reinterpret_cast<Bytef *>(const_cast<char *>(_data));
+  this->zs.avail_in = static_cast<uInt>(available);
+  int ret = Z_OK;
+  do
+  {
+    this->zs.next_out = reinterpret_cast<Bytef *>(this->buffer.data());
+    this->zs.avail_out = static_cast<uInt>(this->buffer.size());
+    ret = inflate(&this->zs, Z_NO_FLUSH);
+    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+      return this->Fail("corrupt data in [" + this->name + "]");
+
+    std::size_t produced = this->buffer.size() - this->zs.avail_out;
+    if (!this->Output(this->buffer.data(), produced))
+      return false;
+    if (ret == Z_BUF_ERROR && produced == 0)
+      break;
+  }
+  while (ret != Z_STREAM_END &&
+         (this->zs.avail_in > 0 || this->zs.avail_out == 0));
+
+  std::size_t consumed = available - this->zs.avail_in;
+  _data += consumed;
+  _size -= consumed;
+  this->compressedRead += consumed;
+
+  if (ret == Z_STREAM_END)
+  {
+    this->EndInflate();
+    if (this->descriptor)
+    {
+      this->state = State::DESCRIPTOR;
+      return true;
+    }
+    return this->EndEntry(this->expectedCrc, this->expectedSize,
+        this->expectedCompressed);
+  }
+
+  if (!this->descriptor && this->compressedRead == this->expectedCompressed)
+    return this->Fail("truncated data in [" + this->name + "]");
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool StreamingUnzipPrivate::ReadDescriptor()
+{
+  const char *d = this->pending.data();
+  auto descCrc = static_cast<std::uint32_t>(readLe(d, 4));
+  std::uint64_t compressed;
+  std::uint64_t size;
+  if (this->pending.size() == 20u)
+  {
+    compressed = readLe(d + 4, 8);
+    size = readLe(d + 12, 8);
+  }
+  else
+  {
+    compressed = readLe(d + 4, 4);
+    size = readLe(d + 8, 4);
+  }
+  this->pending.clear();
+  return this->EndEntry(descCrc, size, compressed);
+}
+
+//////////////////////////////////////////////////
+bool StreamingUnzipPrivate::EndEntry(std::uint32_t _crc, std::uint64_t _size,
+    std::uint64_t _compressed)
+{
+  if (this->writer->IsOpen() && !this->writer->Close())
+    return this->Fail("unable to write [" + this->name + "]");
+  if (this->crc != _crc || this->written != _size ||
+      this->compressedRead != _compressed)
+  {
+    return this->Fail("entry [" + this->name + "] doesn't match its header");
+  }
+
+  auto &entry = this->entries[this->name];
+  entry.crc = this->crc;
+  entry.size = this->written;
+  this->state = State::SIGNATURE;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void StreamingUnzipPrivate::EndInflate()
+{
+  if (this->inflating)
+  {
+    inflateEnd(&this->zs);
+    this->inflating = false;
+  }
+}
+
+//////////////////////////////////////////////////
+StreamingUnzip::StreamingUnzip(const std::string &_dst,
+    unsigned int _syncBatch)
+  : dataPtr(std::make_unique<StreamingUnzipPrivate>())
+{
+  this->dataPtr->dst = _dst;
+  this->dataPtr->writer = std::make_unique<FileWriter>(_syncBatch);
+  if (!common::createDirectories(_dst))
+    this->dataPtr->Fail("unable to create directory [" + _dst + "]");
+}
+
+//////////////////////////////////////////////////
+StreamingUnzip::~StreamingUnzip()
+{
+  this->dataPtr->EndInflate();
+}
+
+//////////////////////////////////////////////////
+bool StreamingUnzip::Write(const char *_data, std::size_t _size)
+{
+  using State = StreamingUnzipPrivate::State;
+  auto &d = *this->dataPtr;
+
+  while (_size > 0)
+  {
+    switch (d.state)
+    {
+      case State::SIGNATURE:
+      {
+        if (!d.Fill(_data, _size, 4))
+          return true;
+        auto signature = readLe(d.pending.data(), 4);
+        d.pending.clear();
+        if (signature == kLocalHeaderSignature)
+          d.state = State::LOCAL_HEADER;
+        else if (signature == kCentralHeaderSignature ||
+                 signature == kEndSignature)
+          d.state = State::DONE;
+        else
+          return d.Fail("not a zip archive");
+        break;
+      }
+      case State::LOCAL_HEADER:
+      {
+        if (!d.Fill(_data, _size, kLocalHeaderSize))
+          return true;
+        std::size_t needed = kLocalHeaderSize +
+            readLe(d.pending.data() + 22, 2) + readLe(d.pending.data() + 24, 2);
+        if (!d.Fill(_data, _size, needed))
+          return true;
+        if (!d.BeginEntry())
+          return false;
+        break;
+      }
+      case State::DATA:
+      {
+        if (!d.ReadData(_data, _size))
+          return false;
+        break;
+      }
+      case State::DESCRIPTOR:
+      {
+        // The signature of a data descriptor is optional
+        if (!d.descriptorSignatureChecked)
+        {
+          if (!d.Fill(_data, _size, 4))
+            return true;
+          d.descriptorSignatureChecked = true;
+          if (readLe(d.pending.data(), 4) == kDescriptorSignature)
+            d.pending.clear();
+        }
+
+        // Sizes are 8 bytes for Zip64 entries
+        bool large = d.zip64 || d.written >= kZip64Marker ||
+            d.compressedRead >= kZip64Marker;
+        if (!d.Fill(_data, _size, large ? 20 : 12))
+          return true;
+        if (!d.ReadDescriptor())
+          return false;
+        break;
+      }
+      case State::DONE:
+        return true;
+      case State::FAILED:
+      default:
+        return false;
+    }
+  }
+  return d.state != State::FAILED;
+}
+
+//////////////////////////////////////////////////
+bool StreamingUnzip::Finish(const char *_archive, std::size_t _size)
+{
+  using State = StreamingUnzipPrivate::State;
+  auto &d = *this->dataPtr;
+
+  if (d.state == State::FAILED)
+    return false;
+  if (d.state != State::DONE)
+    return d.Fail("archive ended before its central directory");
+  if (!d.writer->Sync())
+    return d.Fail("unable to flush the extracted files to disk");
+
+  // The central directory is authoritative, every entry it lists must have
+  // been extracted as is, and nothing else
+  zip_error_t error;
+  zip_error_init(&error);
+  zip_source_t *source = zip_source_buffer_create(_archive, _size, 0, &error);
+  zip *archive = source ?
+      zip_open_from_source(source, ZIP_RDONLY, &error) : nullptr;
+  if (!archive)
+  {
+    if (source)
+      zip_source_free(source);
+    std::string reason = zip_error_strerror(&error);
+    zip_error_fini(&error);
+    return d.Fail("invalid central directory: " + reason);
+  }
+  zip_error_fini(&error);
+
+  bool matches = true;
+  std::uint64_t bytes = 0;
+  std::uint64_t files = 0;
+  zip_int64_t count = zip_get_num_entries(archive, 0);
+  if (count < 0 || static_cast<std::size_t>(count) != d.entries.size())
+    matches = false;
+  for (zip_int64_t i = 0; matches && i < count; ++i)
+  {
+    struct zip_stat sb;
+    if (zip_stat_index(archive, static_cast<zip_uint64_t>(i), 0, &sb) != 0)
+    {
+      matches = false;
+      break;
+    }
+    auto it = d.entries.find(sb.name);
+    if (it == d.entries.end())
+    {
+      matches = false;
+      break;
+    }
+    const auto &entry = it->second;
+    if (entry.directory)
+      continue;
+    if (((sb.valid & ZIP_STAT_SIZE) && sb.size != entry.size) ||
+        ((sb.valid & ZIP_STAT_CRC) && sb.crc != entry.crc))
+    {
+      matches = false;
+      break;
+    }
+    bytes += entry.size;
+    ++files;
+  }
+  zip_discard(archive);
+
+  if (!matches)
+    return d.Fail("local headers don't match the central directory");
+
+  auto &stats = CacheStatisticsRecorder::Instance();
+  stats.Add(CacheStatisticsRecorder::Counter::FILES_EXTRACTED, files);
+  stats.Add(CacheStatisticsRecorder::Counter::BYTES_EXTRACTED, bytes);
+  return true;
+}
+
+//////////////////////////////////////////////////
+const std::string &StreamingUnzip::Error() const
+{
+  return this->dataPtr->error;
+}
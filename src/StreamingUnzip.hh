@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_FUEL_TOOLS_STREAMINGUNZIP_HH_
+#define GZ_FUEL_TOOLS_STREAMINGUNZIP_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "gz/fuel_tools/Export.hh"
+
+namespace gz::fuel_tools
+{
+  /// \brief Private data.
+  class StreamingUnzipPrivate;
+
+  /// \brief Extracts a zip archive while it's being received.
+  ///
+  /// Bytes are parsed as they arrive, following the local file headers,
+  /// and entries are decompressed straight into a directory. Stored and
+  /// deflated entries are supported, including deflated entries followed
+  /// by a data descriptor, whose end is found by the deflate stream itself.
+  ///
+  /// Local headers aren't authoritative, so once the whole archive has been
+  /// received, Finish checks every entry against the central directory.
+  /// When streaming gives up (encryption, another compression method, a
+  /// stored entry of unknown size) or the check fails, the caller should
+  /// discard the directory and extract the archive the regular way.
+  class GZ_FUEL_TOOLS_VISIBLE StreamingUnzip
+  {
+    /// \brief Constructor.
+    /// \param[in] _dst Directory to extract to, created if needed.
+    /// \param[in] _syncBatch Number of extracted files flushed to disk
+    /// together, 0 to leave it to the operating system.
+    /// \sa FileWriter
+    public: explicit StreamingUnzip(const std::string &_dst,
+                unsigned int _syncBatch = 0u);
+
+    /// \brief Destructor.
+    public: ~StreamingUnzip();
+
+    /// \brief Process the next bytes of the archive.
+    /// \param[in] _data Bytes.
+    /// \param[in] _size Number of bytes.
+    /// \return False once streaming gave up, later bytes are ignored.
+    public: bool Write(const char *_data, std::size_t _size);
+
+    /// \brief Check the extracted entries against the central directory of
+    /// the complete archive.
+    /// \param[in] _archive Complete archive, as received.
+    /// \param[in] _size Size of the archive.
+    /// \return True if every entry of the archive was extracted and
+    /// matches its central directory record.
+    public: bool Finish(const char *_archive, std::size_t _size);
+
+    /// \brief Get why streaming gave up.
+    /// \return Reason, empty while streaming works.
+    public: const std::string &Error() const;
+
+    /// \brief Private data.
+    private: std::unique_ptr<StreamingUnzipPrivate> dataPtr;
+  };
+}  // namespace gz::fuel_tools
+
+#endif  // GZ_FUEL_TOOLS_STREAMINGUNZIP_HH_
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/Zip.hh"
+
+#include "StreamingUnzip.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/////////////////////////////////////////////////
+/// \brief Write a file, creating its parent directories.
+void writeFile(const std::string &_path, const std::string &_content)
+{
+  common::createDirectories(common::parentPath(_path));
+  std::ofstream out(_path, std::ios::binary);
+  out << _content;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file.
+std::string readFile(const std::string &_path)
+{
+  std::ifstream in(_path, std::ios::binary);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief CRC-32 of some data, as zip computes it.
+std::uint32_t crc32Of(const std::string &_data)
+{
+  std::uint32_t crc = 0xffffffff;
+  for (unsigned char c : _data)
+  {
+    crc ^= c;
+    for (int k = 0; k < 8; ++k)
+      crc = (crc >> 1) ^ (0xedb88320 & (0u - (crc & 1u)));
+  }
+  return ~crc;
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a little endian integer.
+void appendLe(std::string &_out, std::uint64_t _value, int _bytes)
+{
+  for (int i = 0; i < _bytes; ++i)
+    _out.push_back(static_cast<char>((_value >> (8 * i)) & 0xff));
+}
+
+/////////////////////////////////////////////////
+/// \brief Build an archive the way streaming writers do: sizes and CRCs
+/// are only known from the data descriptor after each entry. Data is
+/// deflated into stored deflate blocks, which any inflater accepts.
+/// \param[in] _entries Names and contents.
+/// \return Archive.
+std::string descriptorArchive(
+    const std::vector<std::pair<std::string, std::string>> &_entries)
+{
+  std::string out;
+  std::string central;
+  for (const auto &[name, content] : _entries)
+  {
+    // Deflate stream made of stored blocks, the last one final
+    std::string deflated;
+    std::size_t pos = 0;
+    do
+    {
+      std::size_t n = std::min<std::size_t>(content.size() - pos, 65535);
+      bool last = pos + n == content.size();
+      deflated.push_back(last ? 1 : 0);
+      appendLe(deflated, n, 2);
+      appendLe(deflated, ~n & 0xffff, 2);
+      deflated.append(content, pos, n);
+      pos += n;
+    }
+    while (pos < content.size());
+
+    std::uint32_t crc = crc32Of(content);
+    std::size_t offset = out.size();
+
+    appendLe(out, 0x04034b50, 4);
+    appendLe(out, 20, 2);
+    appendLe(out, 0x8, 2);
+    appendLe(out, 8, 2);
+    appendLe(out, 0, 4);
+    appendLe(out, 0, 4);
+    appendLe(out, 0, 4);
+    appendLe(out, 0, 4);
+    appendLe(out, name.size(), 2);
+    appendLe(out, 0, 2);
+    out += name;
+    out += deflated;
+    appendLe(out, 0x08074b50, 4);
+    appendLe(out, crc, 4);
+    appendLe(out, deflated.size(), 4);
+    appendLe(out, content.size(), 4);
+
+    appendLe(central, 0x02014b50, 4);
+    appendLe(central, 20, 2);
+    appendLe(central, 20, 2);
+    appendLe(central, 0x8, 2);
+    appendLe(central, 8, 2);
+    appendLe(central, 0, 4);
+    appendLe(central, crc, 4);
+    appendLe(central, deflated.size(), 4);
+    appendLe(central, content.size(), 4);
+    appendLe(central, name.size(), 2);
+    appendLe(central, 0, 2);
+    appendLe(central, 0, 2);
+    appendLe(central, 0, 2);
+    appendLe(central, 0, 2);
+    appendLe(central, 0, 4);
+    appendLe(central, offset, 4);
+    central += name;
+  }
+
+  std::size_t centralOffset = out.size();
+  out += central;
+  appendLe(out, 0x06054b50, 4);
+  appendLe(out, 0, 2);
+  appendLe(out, 0, 2);
+  appendLe(out, _entries.size(), 2);
+  appendLe(out, _entries.size(), 2);
+  appendLe(out, central.size(), 4);
+  appendLe(out, centralOffset, 4);
+  appendLe(out, 0, 2);
+  return out;
+}
+
+/////////////////////////////////////////////////
+/// \brief Stream an archive in chunks of a given size.
+/// \return Result of Finish, false if Write already gave up.
+bool stream(const std::string &_archive, const std::string &_dst,
+    std::size_t _chunk)
+{
+  StreamingUnzip unzip(_dst);
+  for (std::size_t pos = 0; pos < _archive.size(); pos += _chunk)
+  {
+    if (!unzip.Write(_archive.data() + pos,
+        std::min(_chunk, _archive.size() - pos)))
+    {
+      EXPECT_FALSE(unzip.Error().empty());
+      return false;
+    }
+  }
+  return unzip.Finish(_archive.data(), _archive.size());
+}
+
+/////////////////////////////////////////////////
+TEST(StreamingUnzip, Compressed)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  std::string src = common::joinPaths(tempDir->Path(), "model");
+  std::string mesh;
+  for (int i = 0; i < 100000; ++i)
+    mesh += std::to_string(i * 7919 % 1000);
+  writeFile(common::joinPaths(src, "model.config"), "<model/>");
+  writeFile(common::joinPaths(src, "meshes", "box.dae"), mesh);
+  writeFile(common::joinPaths(src, "empty.txt"), "");
+
+  std::string zipFile = common::joinPaths(tempDir->Path(), "model.zip");
+  ASSERT_TRUE(Zip::Compress(src, zipFile));
+  std::string archive = readFile(zipFile);
+
+  for (std::size_t chunk : {1u, 7u, 4096u, 1u << 20})
+  {
+    std::string dst = common::joinPaths(tempDir->Path(),
+        "out" + std::to_string(chunk));
+    ASSERT_TRUE(stream(archive, dst, chunk)) << chunk;
+    EXPECT_EQ("<model/>",
+        readFile(common::joinPaths(dst, "model", "model.config")));
+    EXPECT_EQ(mesh,
+        readFile(common::joinPaths(dst, "model", "meshes", "box.dae")));
+    EXPECT_TRUE(common::isFile(common::joinPaths(dst, "model", "empty.txt")));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(StreamingUnzip, DataDescriptor)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  std::string mesh(150000, 'm');
+  std::string archive = descriptorArchive({
+      {"model.config", "<model/>"},
+      {"meshes/box.dae", mesh},
+  });
+
+  for (std::size_t chunk : {1u, 5u, 65536u})
+  {
+    std::string dst = common::joinPaths(tempDir->Path(),
+        "out" + std::to_string(chunk));
+    ASSERT_TRUE(stream(archive, dst, chunk)) << chunk;
+    EXPECT_EQ("<model/>", readFile(common::joinPaths(dst, "model.config")));
+    EXPECT_EQ(mesh, readFile(common::joinPaths(dst, "meshes", "box.dae")));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(StreamingUnzip, Invalid)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  std::string dst = common::joinPaths(tempDir->Path(), "out");
+
+  // Not an archive
+  EXPECT_FALSE(stream("<html>Not found</html>", dst, 4096));
+
+  // Entries escaping the destination
+  EXPECT_FALSE(stream(descriptorArchive({{"../escape", "x"}}), dst, 4096));
+  EXPECT_FALSE(common::exists(common::joinPaths(tempDir->Path(), "escape")));
+
+  // Corrupt data doesn't match its data descriptor
+  std::string archive = descriptorArchive({{"a.txt", "content"}});
+  std::string corrupt = archive;
+  corrupt[30 + 5 + 5] = 'C';
+  EXPECT_FALSE(stream(corrupt, dst, 4096));
+
+  // A central directory that disagrees with the local headers
+  std::string tampered = archive;
+  std::size_t central = tampered.find("PK\x01\x02");
+  ASSERT_NE(std::string::npos, central);
+  tampered[central + 16] ^= 0x01;
+  EXPECT_FALSE(stream(tampered, dst, 4096));
+
+  // Download interrupted in the middle of the entry's data
+  StreamingUnzip unzip(dst);
+  EXPECT_TRUE(unzip.Write(archive.data(), 40));
+  EXPECT_FALSE(unzip.Finish(archive.data(), archive.size()));
+  EXPECT_FALSE(unzip.Error().empty());
+}
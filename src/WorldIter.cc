@@ -18,6 +18,7 @@
 #include <memory>
 #include <regex>
 #include <string>
+#include <utility>
 #include <vector>
 #include <gz/common/Console.hh>
 
@@ -39,6 +40,13 @@ WorldIter WorldIterFactory::Create(const std::vector<WorldIdentifier> &_ids)
   return WorldIter(std::move(priv));
 }
 
+//////////////////////////////////////////////////
+WorldIter WorldIterFactory::Create(std::vector<WorldIdentifier> &&_ids)
+{
+  std::unique_ptr<WorldIterPrivate> priv(new WorldIterIds(std::move(_ids)));
+  return WorldIter(std::move(priv));
+}
+
 //////////////////////////////////////////////////
 WorldIter WorldIterFactory::Create(const Rest &_rest,
     const ServerConfig &_server, const std::string &_path)
@@ -67,7 +75,7 @@ WorldIterIds::~WorldIterIds()
 
 //////////////////////////////////////////////////
 WorldIterIds::WorldIterIds(std::vector<WorldIdentifier> _ids)
-  : ids(_ids)
+  : ids(std::move(_ids))
 {
   this->idIter = this->ids.begin();
   if (!this->ids.empty())
@@ -45,6 +45,12 @@ namespace gz::fuel_tools
     /// \return World iterator
     public: static WorldIter Create(const std::vector<WorldIdentifier> &_ids);
 
+    /// \brief Create a world iterator that takes over a vector of world
+    /// identifiers, without copying it
+    /// \param[in] _ids World identifiers
+    /// \return World iterator
+    public: static WorldIter Create(std::vector<WorldIdentifier> &&_ids);
+
     /// \brief Create a world iter that will make REST api calls
     /// \param[in] _rest a REST request
     /// \param[in] _server The server to request the operation
@@ -17,71 +17,748 @@
 
 #include <sys/stat.h>
 #include <zip.h>
+#include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
+#include <gz/common/StringUtils.hh>
 
 #include "gz/fuel_tools/Zip.hh"
 
+#include "CacheStatisticsRecorder.hh"
+#include "FileWriter.hh"
+#include "Parallel.hh"
+
 using namespace gz;
 using namespace fuel_tools;
 
-
-/////////////////////////////////////////////////
-bool CompressFile(zip *_archive, const std::string &_file,
-    const std::string &_entry)
+namespace
 {
-  if (gz::common::isDirectory(_file))
+  /// \brief Size of the buffer entries are extracted through.
+  constexpr std::size_t kExtractBufferSize = 1024 * 1024;
+
+  //////////////////////////////////////////////////
+  /// \brief Archive entries extracted in parallel only add up to more
+  /// than this many bytes, smaller archives aren't worth the threads.
+  constexpr std::uint64_t kParallelExtractMinBytes = 4 * 1024 * 1024;
+
+  /// \brief Files deflated in parallel only add up to more than this many
+  /// bytes, smaller archives aren't worth the threads.
+  constexpr std::uint64_t kParallelCompressMinBytes = 4 * 1024 * 1024;
+
+  /// \brief Entry of an archive to create.
+  struct CompressEntry
+  {
+    /// \brief Path of the file or directory.
+    std::string src;
+
+    /// \brief Name in the archive.
+    std::string name;
+
+    /// \brief Whether the entry is a directory.
+    bool directory;
+
+    /// \brief Size of the file.
+    std::uint64_t size;
+
+    /// \brief Whether the file is stored without compression.
+    bool store;
+  };
+
+  /// \brief Bytes of files deflated ahead of libzip writing them. Files
+  /// are released once written, so memory use doesn't grow with the size
+  /// of the archive. A larger file is still deflated on its own.
+  constexpr std::uint64_t kCompressWindowBytes = 64 * 1024 * 1024;
+
+  class DeflatePipeline;
+
+  /// \brief File deflated in memory, handed to libzip as is.
+  struct DeflatedFile
+  {
+    /// \brief Constructor.
+    DeflatedFile()
+    {
+      zip_error_init(&this->error);
+    }
+
+    /// \brief Destructor.
+    ~DeflatedFile()
+    {
+      zip_error_fini(&this->error);
+    }
+
+    /// \brief Path of the file.
+    std::string src;
+
+    /// \brief Size of the file when it was listed, used to budget memory.
+    std::uint64_t cost = 0;
+
+    /// \brief Pipeline deflating the file.
+    DeflatePipeline *pipeline = nullptr;
+
+    /// \brief Position in the pipeline, which is the archive order.
+    std::size_t position = 0;
+
+    /// \brief Whether the file was deflated, successfully or not.
+    bool ready = false;
+
+    /// \brief Whether the file was deflated successfully.
+    bool ok = false;
+
+    /// \brief Whether libzip is done with the data, which was freed.
+    bool released = false;
+
+    /// \brief Whether the file counts against the window of the pipeline.
+    bool budgeted = false;
+
+    /// \brief Raw deflate stream.
+    std::string data;
+
+    /// \brief Uncompressed size.
+    std::uint64_t size = 0;
+
+    /// \brief CRC-32 of the uncompressed data.
+    std::uint32_t crc = 0;
+
+    /// \brief Modification time of the file.
+    time_t mtime = 0;
+
+    /// \brief Read position in data.
+    std::size_t offset = 0;
+
+    /// \brief Last error, reported to libzip.
+    zip_error_t error;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief List the entries of an archive, in the order they're added.
+  /// \param[in] _src Path of a file or directory.
+  /// \param[in] _name Name of the entry.
+  /// \param[in] _options Compression options.
+  /// \param[out] _entries Entries of _src and, for a directory, of
+  /// everything inside it.
+  void listEntries(const std::string &_src, const std::string &_name,
+      const ZipCompressOptions &_options, std::vector<CompressEntry> &_entries)
+  {
+    if (gz::common::isDirectory(_src))
+    {
+      _entries.push_back({_src, _name, true, 0u, false});
+      gz::common::DirIter endIt;
+      for (gz::common::DirIter dirIt(_src); dirIt != endIt; ++dirIt)
+      {
+        std::string file = *dirIt;
+        listEntries(file, gz::common::joinPaths(_name,
+            gz::common::basename(file)), _options, _entries);
+      }
+    }
+    else if (gz::common::isFile(_src))
+    {
+      std::ifstream in(_src, std::ifstream::ate | std::ifstream::binary);
+      auto size = static_cast<std::uint64_t>(
+          std::max<std::streamoff>(in.tellg(), 0));
+
+      std::string base = gz::common::basename(_src);
+      auto dot = base.rfind('.');
+      bool store = _options.level == 0 || (dot != std::string::npos &&
+          _options.storedExtensions.count(
+              gz::common::lowercase(base.substr(dot))) > 0);
+      _entries.push_back({_src, _name, false, size, store});
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Deflate a file in memory. The file is read through a buffer,
+  /// so only its deflated data is held.
+  /// \param[in] _path Path of the file.
+  /// \param[in] _level Deflate level, from 1 to 9, or -1 for the default.
+  /// \param[out] _file Deflated file.
+  /// \return True on success.
+  bool deflateFile(const std::string &_path, int _level, DeflatedFile &_file)
   {
-    if (zip_dir_add(_archive, _entry.c_str(), 0) < 0)
+    std::ifstream in(_path, std::ios::binary);
+    if (!in.is_open())
     {
-      gzerr << "Error adding directory to zip: " << _file << std::endl;
+      gzerr << "Unable to read [" << _path << "]" << std::endl;
       return false;
     }
 
-    gz::common::DirIter endIt;
-    for (gz::common::DirIter dirIt(_file); dirIt != endIt; ++dirIt)
+    struct stat st;
+    if (stat(_path.c_str(), &st) == 0)
+      _file.mtime = st.st_mtime;
+
+    z_stream zs{};
+    if (deflateInit2(&zs, _level, Z_DEFLATED, -MAX_WBITS, 8,
+        Z_DEFAULT_STRATEGY) != Z_OK)
     {
-      std::string file = *dirIt;
-      std::string entryName = gz::common::joinPaths(_entry,
-          gz::common::basename(file));
+      return false;
+    }
+
+    // zlib counts in 32 bits, so output is handed over in slices
+    constexpr std::size_t kSlice = 1u << 30;
+    std::vector<char> input(kExtractBufferSize);
+    _file.crc = static_cast<std::uint32_t>(crc32(0L, Z_NULL, 0));
+    _file.size = 0;
+    _file.data.clear();
+    std::size_t produced = 0;
+    int flush = Z_NO_FLUSH;
+    int ret = Z_OK;
+    while (ret != Z_STREAM_END)
+    {
+      if (zs.avail_in == 0 && flush != Z_FINISH)
+      {
+        in.read(input.data(), static_cast<std::streamsize>(input.size()));
+        auto n = static_cast<std::size_t>(in.gcount());
+        if (in.bad())
+        {
+          gzerr << "Unable to read [" << _path << "]" << std::endl;
+          deflateEnd(&zs);
+          return false;
+        }
+        zs.next_in = reinterpret_cast<Bytef *>(input.data());
+        zs.avail_in = static_cast<uInt>(n);
+        _file.crc = static_cast<std::uint32_t>(crc32(_file.crc, zs.next_in,
+            zs.avail_in));
+        _file.size += n;
+        if (n < input.size())
+          flush = Z_FINISH;
+      }
 
-      if (!CompressFile(_archive, file, entryName))
+      // Grow geometrically, so large files aren't copied over and over
+      if (_file.data.size() - produced < kExtractBufferSize)
       {
-        gzerr << "Error compressing file: " << file << std::endl;
+        _file.data.resize(_file.data.size() + std::max(kExtractBufferSize,
+            _file.data.size() / 2));
       }
+
+      std::size_t room = std::min(_file.data.size() - produced, kSlice);
+      zs.next_out = reinterpret_cast<Bytef *>(&_file.data[produced]);
+      zs.avail_out = static_cast<uInt>(room);
+      ret = deflate(&zs, flush);
+      if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+      {
+        deflateEnd(&zs);
+        return false;
+      }
+      produced += room - zs.avail_out;
     }
+    _file.data.resize(produced);
+    _file.data.shrink_to_fit();
+    deflateEnd(&zs);
+    return true;
   }
-  else if (gz::common::isFile(_file))
+
+  //////////////////////////////////////////////////
+  /// \brief Deflates files ahead of libzip writing them, on worker
+  /// threads, while libzip writes the archive on the calling thread.
+  /// Workers take files in archive order and stop once the files waiting
+  /// to be written add up to kCompressWindowBytes. Without workers, each
+  /// file is deflated when libzip asks for it.
+  class DeflatePipeline
   {
-    std::ifstream in(_file.c_str(),
-        std::ifstream::ate | std::ifstream::binary);
-    auto end = in.tellg();
+    /// \brief Constructor.
+    /// \param[in] _level Deflate level.
+    /// \param[in] _workers Number of worker threads, 0 for none.
+    public: DeflatePipeline(int _level, unsigned int _workers)
+      : level(_level), workers(_workers)
+    {
+    }
+
+    /// \brief Destructor, stops the workers.
+    public: ~DeflatePipeline()
+    {
+      this->Stop();
+    }
+
+    /// \brief Add a file to deflate. Files must be added before Start.
+    /// \param[in] _src Path of the file.
+    /// \param[in] _size Size of the file.
+    /// \return The file, owned by the pipeline.
+    public: DeflatedFile *Add(const std::string &_src, std::uint64_t _size)
+    {
+      auto file = std::make_unique<DeflatedFile>();
+      file->src = _src;
+      file->cost = _size;
+      file->pipeline = this;
+      file->position = this->files.size();
+      this->files.push_back(std::move(file));
+      return this->files.back().get();
+    }
+
+    /// \brief Start the workers, if any.
+    public: void Start()
+    {
+      if (this->workers == 0u || this->files.empty())
+        return;
+      this->pool = std::thread([this]
+      {
+        parallelFor(this->workers, this->workers, [this](std::size_t)
+        {
+          this->Work();
+        });
+      });
+    }
+
+    /// \brief Stop the workers once their current file is deflated.
+    public: void Stop()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopped = true;
+      }
+      this->cv.notify_all();
+      if (this->pool.joinable())
+        this->pool.join();
+    }
+
+    /// \brief Wait for a file to be deflated, deflating it on the calling
+    /// thread if there are no workers or it was released already.
+    /// \param[in] _file File libzip asks for.
+    /// \return True if the file was deflated successfully.
+    public: bool Wait(DeflatedFile &_file)
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if (!this->pool.joinable() || _file.released)
+      {
+        lock.unlock();
+        if (!_file.ready || _file.released)
+        {
+          _file.ok = deflateFile(_file.src, this->level, _file);
+          _file.ready = true;
+          _file.released = false;
+        }
+        return _file.ok;
+      }
+
+      // The file libzip waits for is always admitted, whatever the
+      // window holds
+      this->wanted = std::max(this->wanted, _file.position);
+      this->cv.notify_all();
+      this->cv.wait(lock, [&]
+      {
+        return _file.ready || this->stopped;
+      });
+      return _file.ready && _file.ok;
+    }
+
+    /// \brief Free the data of a file libzip is done with.
+    /// \param[in] _file File to release.
+    public: void Release(DeflatedFile &_file)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (_file.released)
+          return;
+        _file.released = true;
+        if (_file.budgeted)
+          this->inFlight -= _file.cost;
+        _file.budgeted = false;
+      }
+      std::string().swap(_file.data);
+      this->cv.notify_all();
+    }
+
+    /// \brief Worker loop.
+    private: void Work()
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      while (true)
+      {
+        this->cv.wait(lock, [this]
+        {
+          return this->stopped || this->next >= this->files.size() ||
+              this->inFlight == 0 || this->wanted >= this->next ||
+              this->inFlight + this->files[this->next]->cost <=
+                  kCompressWindowBytes;
+        });
+        if (this->stopped || this->next >= this->files.size())
+          return;
+
+        DeflatedFile &file = *this->files[this->next++];
+        this->inFlight += file.cost;
+        file.budgeted = true;
+        lock.unlock();
+        bool ok = deflateFile(file.src, this->level, file);
+        lock.lock();
+        file.ok = ok;
+        file.ready = true;
+        this->cv.notify_all();
+      }
+    }
+
+    /// \brief Deflate level.
+    private: const int level;
+
+    /// \brief Number of worker threads.
+    private: const unsigned int workers;
+
+    /// \brief Files to deflate, in archive order.
+    private: std::vector<std::unique_ptr<DeflatedFile>> files;
+
+    /// \brief Thread running the workers.
+    private: std::thread pool;
+
+    /// \brief Protects the fields below and the state of the files.
+    private: std::mutex mutex;
+
+    /// \brief Signaled when a file is deflated or released.
+    private: std::condition_variable cv;
+
+    /// \brief Position of the next file to deflate.
+    private: std::size_t next = 0;
+
+    /// \brief Position of the last file libzip asked for.
+    private: std::size_t wanted = 0;
+
+    /// \brief Bytes of files deflated or being deflated, not released.
+    private: std::uint64_t inFlight = 0;
+
+    /// \brief Whether the workers must stop.
+    private: bool stopped = false;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief libzip source serving a file deflated in memory. The stat
+  /// reports the data as deflated, so libzip copies it as is. The file is
+  /// deflated when libzip first asks for it, and freed once read.
+  zip_int64_t deflatedSource(void *_userdata, void *_data, zip_uint64_t _len,
+      zip_source_cmd_t _cmd)
+  {
+    auto *file = static_cast<DeflatedFile *>(_userdata);
+    switch (_cmd)
+    {
+      case ZIP_SOURCE_OPEN:
+        if (!file->pipeline->Wait(*file))
+        {
+          zip_error_set(&file->error, ZIP_ER_READ, 0);
+          return -1;
+        }
+        file->offset = 0;
+        return 0;
+      case ZIP_SOURCE_READ:
+      {
+        std::size_t n = static_cast<std::size_t>(std::min<zip_uint64_t>(
+            _len, file->data.size() - file->offset));
+        std::memcpy(_data, file->data.data() + file->offset, n);
+        file->offset += n;
+        return static_cast<zip_int64_t>(n);
+      }
+      case ZIP_SOURCE_CLOSE:
+        file->pipeline->Release(*file);
+        return 0;
+      case ZIP_SOURCE_STAT:
+      {
+        if (_len < sizeof(zip_stat_t))
+        {
+          zip_error_set(&file->error, ZIP_ER_INVAL, 0);
+          return -1;
+        }
+        if (!file->pipeline->Wait(*file))
+        {
+          zip_error_set(&file->error, ZIP_ER_READ, 0);
+          return -1;
+        }
+        auto *st = static_cast<zip_stat_t *>(_data);
+        zip_stat_init(st);
+        st->valid = ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE | ZIP_STAT_COMP_METHOD |
+            ZIP_STAT_CRC | ZIP_STAT_MTIME;
+        st->size = file->size;
+        st->comp_size = file->data.size();
+        st->comp_method = ZIP_CM_DEFLATE;
+        st->crc = file->crc;
+        st->mtime = file->mtime;
+        return sizeof(zip_stat_t);
+      }
+      case ZIP_SOURCE_ERROR:
+        return zip_error_to_data(&file->error, _data, _len);
+      case ZIP_SOURCE_FREE:
+        // Owned by the pipeline
+        return 0;
+      case ZIP_SOURCE_SUPPORTS:
+        return zip_source_make_command_bitmap(ZIP_SOURCE_OPEN,
+            ZIP_SOURCE_READ, ZIP_SOURCE_CLOSE, ZIP_SOURCE_STAT,
+            ZIP_SOURCE_ERROR, ZIP_SOURCE_FREE, -1);
+      default:
+        zip_error_set(&file->error, ZIP_ER_OPNOTSUPP, 0);
+        return -1;
+    }
+  }
+
+  /// \brief File entry of an archive to extract.
+  struct FileEntry
+  {
+    /// \brief Index in the archive.
+    zip_uint64_t index;
+
+    /// \brief Name in the archive.
+    std::string name;
+
+    /// \brief Path of the file to write.
+    std::string dst;
+
+    /// \brief Uncompressed size.
+    std::uint64_t size;
+
+    /// \brief Whether the archive records the size.
+    bool sizeKnown;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Extract one file entry, streaming it through a buffer.
+  /// \param[in] _archive Open archive.
+  /// \param[in] _entry Entry to extract.
+  /// \param[in] _buffer Buffer to read the entry through.
+  /// \param[in] _writer Writer of the extracted file.
+  /// \return True if the whole entry was written.
+  bool extractEntry(zip *_archive, const FileEntry &_entry,
+      std::vector<char> &_buffer, FileWriter &_writer)
+  {
+    const std::string &dst = _entry.dst;
+
+    zip_file *zf = zip_fopen_index(_archive, _entry.index, 0);
+    if (!zf)
+    {
+      gzerr << "Error opening: " << _entry.name << std::endl;
+      return false;
+    }
+
+    // Formatting a debug message per file is measurable on archives with
+    // thousands of small files, only do it when it's printed
+    bool debug = gz::common::Console::Verbosity() >= 4;
+    auto start = debug ? std::chrono::steady_clock::now() :
+        std::chrono::steady_clock::time_point();
+
+    // Existing files are replaced instead of written through, they may be
+    // hard links shared with other cached resources.
+    std::uint64_t total = 0;
+    bool ok = _writer.Open(dst, _entry.sizeKnown ? _entry.size : 0u);
+    while (ok)
+    {
+      zip_int64_t len = zip_fread(zf, _buffer.data(), _buffer.size());
+      if (len < 0)
+      {
+        gzerr << "Error reading " << _entry.name << ": "
+              << zip_file_strerror(zf) << std::endl;
+        ok = false;
+      }
+      else if (len == 0)
+      {
+        break;
+      }
+      else
+      {
+        ok = _writer.Write(_buffer.data(), static_cast<std::size_t>(len));
+        total += static_cast<std::uint64_t>(len);
+      }
+    }
+    zip_fclose(zf);
+
+    // A short read means the archive is truncated or corrupt
+    if (ok && _entry.sizeKnown && total != _entry.size)
+    {
+      gzerr << "Read " << total << " bytes of " << _entry.size << " from "
+            << _entry.name << std::endl;
+      ok = false;
+    }
 
-    zip_source* source = zip_source_file(_archive, _file.c_str(), 0, end);
-    if (!source)
+    if (!ok)
+      _writer.Discard();
+    if (!ok || !_writer.Close())
     {
-      gzerr << "Error adding file to zip: " << _file << std::endl;
+      gzerr << "Failed to write file [" << dst << "]" << std::endl;
       return false;
     }
 
-    if (zip_file_add(_archive, _entry.c_str(), source, 0)
-        < 0)
+    auto &stats = CacheStatisticsRecorder::Instance();
+    stats.Add(CacheStatisticsRecorder::Counter::FILES_EXTRACTED);
+    stats.Add(CacheStatisticsRecorder::Counter::BYTES_EXTRACTED, total);
+
+    if (debug)
+    {
+      std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - start;
+      gzdbg << "Created file [" << dst << "], " << total << " bytes, "
+            << total / std::max(elapsed.count(), 1e-9) / (1024 * 1024)
+            << " MiB/s" << std::endl;
+    }
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Extract all the entries of an archive.
+  /// \param[in] _archive Open archive, closed by the call.
+  /// \param[in] _open Function opening another handle to the same archive,
+  /// for the workers. Returns null on error.
+  /// \param[in] _dst Output directory.
+  /// \param[in] _options Number of threads, filter and flushing.
+  /// \return True on success.
+  bool extractArchive(zip *_archive, const std::function<zip *()> &_open,
+      const std::string &_dst, const ZipExtractOptions &_options)
+  {
+    // Create all the directories first, so files can be written in any
+    // order
+    std::vector<FileEntry> files;
+    std::set<std::string> dirs;
+    std::uint64_t totalBytes = 0;
+    std::uint64_t skipped = 0;
+    std::uint64_t skippedBytes = 0;
+    bool result = true;
+    zip_int64_t count = zip_get_num_entries(_archive, 0);
+    for (zip_uint64_t i = 0;
+         count > 0 && i < static_cast<zip_uint64_t>(count); ++i)
+    {
+      struct zip_stat sb;
+      if (zip_stat_index(_archive, i, 0, &sb) != 0)
+      {
+        gzerr << "Error get stats on archive index: " << i << std::endl;
+        result = false;
+        continue;
+      }
+
+      auto entryname = std::string(sb.name);
+      bool directory = !entryname.empty() && entryname.back() == '/';
+      if (_options.filter && !_options.filter(entryname))
+      {
+        // Only files count, a skipped directory is still created when an
+        // extracted file is below it
+        if (!directory)
+        {
+          ++skipped;
+          skippedBytes += (sb.valid & ZIP_STAT_SIZE) != 0 ? sb.size : 0u;
+        }
+        continue;
+      }
+
+      common::changeFromUnixPath(entryname);
+      std::string dst = gz::common::joinPaths(_dst, entryname);
+
+      // Check if the entryname contains a / at the end. if so it's a
+      // directory
+      auto pos = entryname.rfind(gz::common::separator(""));
+      if (pos != std::string::npos && pos == (entryname.size() - 1))
+      {
+        dirs.insert(dst);
+        continue;
+      }
+
+      dirs.insert(gz::common::parentPath(dst));
+      bool sizeKnown = (sb.valid & ZIP_STAT_SIZE) != 0;
+      files.push_back({i, sb.name, dst, sizeKnown ? sb.size : 0u, sizeKnown});
+      totalBytes += files.back().size;
+    }
+
+    if (skipped > 0)
+    {
+      auto &stats = CacheStatisticsRecorder::Instance();
+      stats.Add(CacheStatisticsRecorder::Counter::FILES_SKIPPED, skipped);
+      stats.Add(CacheStatisticsRecorder::Counter::BYTES_SKIPPED,
+          skippedBytes);
+      gzdbg << "Skipped " << skipped << " files, " << skippedBytes
+            << " bytes, extracting into [" << _dst << "]" << std::endl;
+    }
+
+    for (const auto &dir : dirs)
+    {
+      if (!gz::common::createDirectories(dir))
+      {
+        gzerr << "Error creating directory [" << dir << "]. "
+               << "Do you have the right permissions?" << std::endl;
+        zip_discard(_archive);
+        return false;
+      }
+    }
+
+    unsigned int workers = _options.jobs > 0 ? _options.jobs : defaultJobs();
+    workers = static_cast<unsigned int>(
+        std::min<std::size_t>(workers, files.size()));
+    if (totalBytes < kParallelExtractMinBytes)
+      workers = 1u;
+
+    // One failed entry fails the whole extraction, the remaining entries
+    // aren't extracted
+    if (workers <= 1u)
     {
-      gzerr << "Error adding file to zip: " << _file << std::endl;
-      zip_source_free(source);
+      // One buffer for all the entries, so memory use doesn't depend on
+      // their size
+      std::vector<char> buffer(kExtractBufferSize);
+      FileWriter writer(_options.syncBatch);
+      for (std::size_t i = 0; i < files.size() && result; ++i)
+        result = extractEntry(_archive, files[i], buffer, writer);
+      result = writer.Sync() && result;
+    }
+    else
+    {
+      // Hand out the largest entries first, so a big mesh doesn't end up
+      // alone on one thread at the end
+      std::sort(files.begin(), files.end(),
+          [](const FileEntry &_a, const FileEntry &_b)
+          {
+            return _a.size > _b.size;
+          });
+
+      // libzip handles can't be shared between threads, so each worker
+      // opens the archive once and then takes entries from a shared queue.
+      std::atomic<std::size_t> next{0};
+      std::atomic<bool> ok{result};
+      parallelFor(workers, workers, [&](std::size_t)
+      {
+        zip *handle = _open();
+        if (!handle)
+        {
+          ok = false;
+          return;
+        }
+
+        std::vector<char> buffer(kExtractBufferSize);
+        FileWriter writer(_options.syncBatch);
+        for (std::size_t i = next++; i < files.size() && ok; i = next++)
+        {
+          if (!extractEntry(handle, files[i], buffer, writer))
+            ok = false;
+        }
+        if (!writer.Sync())
+          ok = false;
+
+        zip_discard(handle);
+      });
+      result = ok;
+    }
+
+    if (zip_close(_archive) < 0)
+    {
+      gzerr << "Error closing zip archive" << std::endl;
       return false;
     }
+
+    return result;
   }
-  return true;
 }
 
 /////////////////////////////////////////////////
 bool Zip::Compress(const std::string &_src, const std::string &_dst)
+{
+  return Compress(_src, _dst, ZipCompressOptions());
+}
+
+/////////////////////////////////////////////////
+bool Zip::Compress(const std::string &_src, const std::string &_dst,
+    const ZipCompressOptions &_options)
 {
   if (!gz::common::exists(_src))
   {
@@ -97,21 +774,107 @@ bool Zip::Compress(const std::string &_src, const std::string &_dst)
     return false;
   }
 
-  std::string entry = gz::common::basename(_src);
-  if (!CompressFile(archive, _src, entry))
+  std::vector<CompressEntry> entries;
+  listEntries(_src, gz::common::basename(_src), _options, entries);
+  // Level 0 stores every file, see listEntries
+  int level = std::clamp(_options.level, Z_DEFAULT_COMPRESSION,
+      Z_BEST_COMPRESSION);
+
+  // Files are deflated on worker threads when there's enough data to be
+  // worth them, otherwise when libzip writes them
+  std::uint64_t deflateBytes = 0;
+  for (const auto &entry : entries)
+  {
+    if (!entry.directory && !entry.store)
+      deflateBytes += entry.size;
+  }
+  unsigned int workers = _options.jobs > 0 ? _options.jobs : defaultJobs();
+  if (workers <= 1u || deflateBytes < kParallelCompressMinBytes)
+    workers = 0u;
+  DeflatePipeline pipeline(level, workers);
+
+  // Entries are added in order, libzip writes them when the archive is
+  // closed
+  bool result = true;
+  for (std::size_t i = 0; i < entries.size() && result; ++i)
+  {
+    const auto &entry = entries[i];
+    if (entry.directory)
+    {
+      result = zip_dir_add(archive, entry.name.c_str(), 0) >= 0;
+    }
+    else if (entry.store)
+    {
+      zip_source *source = zip_source_file(archive, entry.src.c_str(), 0,
+          static_cast<zip_int64_t>(entry.size));
+      zip_int64_t index = source ?
+          zip_file_add(archive, entry.name.c_str(), source, 0) : -1;
+      if (source && index < 0)
+        zip_source_free(source);
+      result = index >= 0 && zip_set_file_compression(archive,
+          static_cast<zip_uint64_t>(index), ZIP_CM_STORE, 0u) == 0;
+    }
+    else
+    {
+      // Sources of deflated data already say how they're compressed
+      DeflatedFile *file = pipeline.Add(entry.src, entry.size);
+      zip_source *source = zip_source_function(archive, deflatedSource,
+          file);
+      zip_int64_t index = source ?
+          zip_file_add(archive, entry.name.c_str(), source, 0) : -1;
+      if (source && index < 0)
+        zip_source_free(source);
+      result = index >= 0;
+    }
+
+    if (!result)
+      gzerr << "Error adding file to zip: " << entry.src << std::endl;
+  }
+
+  if (!result)
   {
     gzerr << "Error compressing file: " << _src << std::endl;
-    zip_close(archive);
+    zip_discard(archive);
     return false;
   }
 
-  zip_close(archive);
+  pipeline.Start();
+  bool closed = zip_close(archive) == 0;
+  pipeline.Stop();
+  if (!closed)
+  {
+    gzerr << "Error writing zip archive [" << _dst << "]: "
+          << zip_strerror(archive) << std::endl;
+    zip_discard(archive);
+    return false;
+  }
   return true;
 }
 
+/////////////////////////////////////////////////
+const std::set<std::string> &Zip::StoredExtensions()
+{
+  static const std::set<std::string> extensions = {
+    // Images and compressed textures
+    ".png", ".jpg", ".jpeg", ".webp", ".ktx", ".ktx2", ".basis",
+    // Audio and video
+    ".mp3", ".ogg", ".mp4", ".webm",
+    // Archives
+    ".zip", ".gz", ".tgz", ".bz2", ".xz", ".7z", ".zst",
+  };
+  return extensions;
+}
+
 /////////////////////////////////////////////////
 bool Zip::Extract(const std::string &_src,
     const std::string &_dst)
+{
+  return Extract(_src, _dst, ZipExtractOptions());
+}
+
+/////////////////////////////////////////////////
+bool Zip::Extract(const std::string &_src, const std::string &_dst,
+    const ZipExtractOptions &_options)
 {
   if (!gz::common::exists(_src))
   {
@@ -127,70 +890,49 @@ bool Zip::Extract(const std::string &_src,
     return false;
   }
 
-  for (unsigned int i = 0; i < zip_get_num_entries(archive, 0); ++i)
+  return extractArchive(archive, [&]()
   {
-    struct zip_stat sb;
-    if (zip_stat_index(archive, i, 0, &sb) != 0)
-    {
-      gzerr << "Error get stats on archive index: " << i << std::endl;
-      continue;
-    }
-
-    auto entryname = std::string(sb.name);
-    common::changeFromUnixPath(entryname);
-    std::string dst = gz::common::joinPaths(_dst, entryname);
-
-    // Check if the entryname contains a / at the end. if so it's a directory
-    auto pos = entryname.rfind(gz::common::separator(""));
-    if (pos != std::string::npos && pos == (entryname.size() - 1))
-    {
-      if (!gz::common::createDirectories(dst))
-      {
-        gzerr << "Error creating directory [" << dst << "]. "
-               << "Do you have the right permissions?" << std::endl;
-        return false;
-      }
-      continue;
-    }
-
-    // Create and write the files.
-    zip_file * zf = zip_fopen_index(archive, i, 0);
-    if (!zf)
-    {
-      gzerr << "Error opening: " << sb.name << std::endl;
-      continue;
-    }
+    int workerErr;
+    zip *handle = zip_open(_src.c_str(), ZIP_RDONLY, &workerErr);
+    if (!handle)
+      gzerr << "Error opening zip archive: '" << _src << "'" << std::endl;
+    return handle;
+  }, _dst, _options);
+}
 
-    std::ofstream file(dst);
-    int readSize = sb.size;
-    char *buf = new char[readSize];
-    int len = zip_fread(zf, buf, readSize);
+/////////////////////////////////////////////////
+bool Zip::ExtractFromMemory(const char *_data, std::size_t _size,
+    const std::string &_dst)
+{
+  return ExtractFromMemory(_data, _size, _dst, ZipExtractOptions());
+}
 
-    if (len <= 0)
-      gzerr << "Error reading " << sb.name << std::endl;
-    else
+/////////////////////////////////////////////////
+bool Zip::ExtractFromMemory(const char *_data, std::size_t _size,
+    const std::string &_dst, const ZipExtractOptions &_options)
+{
+  // The archive reads the buffer in place, without copying it
+  auto open = [&]() -> zip *
+  {
+    zip_error_t error;
+    zip_error_init(&error);
+    zip_source_t *source = zip_source_buffer_create(_data, _size, 0, &error);
+    zip *archive = source ?
+        zip_open_from_source(source, ZIP_RDONLY, &error) : nullptr;
+    if (!archive)
     {
-      file.write(buf, len);
-      if (file.fail())
-      {
-        gzerr << "Failed to write file [" << dst << "]" << std::endl;
-      }
-      else
-      {
-        gzdbg << "Created file [" << dst << "]" << std::endl;
-      }
+      gzerr << "Error opening zip archive from memory: "
+            << zip_error_strerror(&error) << std::endl;
+      if (source)
+        zip_source_free(source);
     }
+    zip_error_fini(&error);
+    return archive;
+  };
 
-    delete[] buf;
-    file.close();
-    zip_fclose(zf);
-  }
-
-  if (zip_close(archive) < 0)
-  {
-    gzerr << "Error closing zip archive" << std::endl;
+  zip *archive = open();
+  if (!archive)
     return false;
-  }
 
-  return true;
+  return extractArchive(archive, open, _dst, _options);
 }
@@ -138,6 +138,11 @@ bool createNewEmptyFile(const std::string &_filename)
 #endif
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include "gz/fuel_tools/Zip.hh"
@@ -195,3 +200,357 @@ TEST_F(ZipTest, CompressAndExtract)
   // Clean.
   gz::common::removeAll(newTempDir);
 }
+
+/////////////////////////////////////////////////
+/// \brief Test that entries larger than the extraction buffer come out
+/// whole
+TEST_F(ZipTest, ExtractLargeEntry)
+{
+  std::string newTempDir;
+  ASSERT_TRUE(createAndSwitchToTempDir(newTempDir));
+  auto d = gz::common::joinPaths(newTempDir, "d1");
+  ASSERT_TRUE(gz::common::createDirectories(d));
+
+  // A few MiB that don't compress to nothing, with a size that isn't a
+  // multiple of the buffer
+  std::string content;
+  content.reserve(3 * 1024 * 1024 + 17);
+  unsigned int state = 1;
+  while (content.size() < 3 * 1024 * 1024 + 17)
+  {
+    state = state * 1103515245u + 12345u;
+    content.push_back(static_cast<char>(state >> 24));
+  }
+  {
+    std::ofstream out(gz::common::joinPaths(d, "large.bin"),
+        std::ios::binary);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+
+  auto zipOutFile = gz::common::joinPaths(newTempDir, "large.zip");
+  ASSERT_TRUE(Zip::Compress(d, zipOutFile));
+
+  auto extractOutDir = gz::common::joinPaths(newTempDir, "extract");
+  EXPECT_TRUE(Zip::Extract(zipOutFile, extractOutDir));
+
+  std::ifstream in(gz::common::joinPaths(extractOutDir, "d1", "large.bin"),
+      std::ios::binary);
+  ASSERT_TRUE(in.is_open());
+  std::string extracted((std::istreambuf_iterator<char>(in)),
+      std::istreambuf_iterator<char>());
+  EXPECT_EQ(content.size(), extracted.size());
+  EXPECT_TRUE(content == extracted);
+
+  // Clean.
+  gz::common::removeAll(newTempDir);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that extracting with several threads gives the same files
+TEST_F(ZipTest, ExtractParallel)
+{
+  std::string newTempDir;
+  ASSERT_TRUE(createAndSwitchToTempDir(newTempDir));
+  auto textures = gz::common::joinPaths(newTempDir, "world", "materials",
+      "textures");
+  auto meshes = gz::common::joinPaths(newTempDir, "world", "meshes");
+  ASSERT_TRUE(gz::common::createDirectories(textures));
+  ASSERT_TRUE(gz::common::createDirectories(meshes));
+
+  // Enough data to be worth several threads
+  std::vector<std::pair<std::string, std::string>> files;
+  unsigned int state = 7;
+  for (int i = 0; i < 24; ++i)
+  {
+    std::string content;
+    while (content.size() < 256 * 1024u + i)
+    {
+      state = state * 1103515245u + 12345u;
+      content.push_back(static_cast<char>(state >> 24));
+    }
+    std::string dir = i % 3 == 0 ? meshes : textures;
+    files.emplace_back(
+        gz::common::joinPaths(dir, "file" + std::to_string(i)), content);
+    std::ofstream out(files.back().first, std::ios::binary);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+
+  auto zipOutFile = gz::common::joinPaths(newTempDir, "world.zip");
+  ASSERT_TRUE(Zip::Compress(gz::common::joinPaths(newTempDir, "world"),
+      zipOutFile));
+
+  for (unsigned int jobs : {0u, 1u, 4u})
+  {
+    auto extractOutDir = gz::common::joinPaths(newTempDir,
+        "extract" + std::to_string(jobs));
+    ZipExtractOptions options;
+    options.jobs = jobs;
+    EXPECT_TRUE(Zip::Extract(zipOutFile, extractOutDir, options));
+
+    for (const auto &[path, content] : files)
+    {
+      std::string relative = path.substr(newTempDir.size() + 1);
+      std::ifstream in(gz::common::joinPaths(extractOutDir, relative),
+          std::ios::binary);
+      ASSERT_TRUE(in.is_open()) << relative;
+      std::string extracted((std::istreambuf_iterator<char>(in)),
+          std::istreambuf_iterator<char>());
+      EXPECT_TRUE(content == extracted) << relative << " jobs " << jobs;
+    }
+  }
+
+  // Clean.
+  gz::common::removeAll(newTempDir);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test compression levels, stored extensions and parallel
+/// compression
+TEST_F(ZipTest, CompressOptions)
+{
+  std::string newTempDir;
+  ASSERT_TRUE(createAndSwitchToTempDir(newTempDir));
+  auto model = gz::common::joinPaths(newTempDir, "model");
+  ASSERT_TRUE(gz::common::createDirectories(
+      gz::common::joinPaths(model, "meshes")));
+
+  // Compressible meshes, enough to be worth several threads, and an image
+  // that doesn't compress
+  std::vector<std::pair<std::string, std::string>> files;
+  for (int i = 0; i < 6; ++i)
+  {
+    std::string content;
+    for (int v = 0; content.size() < 1024 * 1024u; ++v)
+      content += "<v>" + std::to_string(v * (i + 1) % 977) + "</v>\n";
+    files.emplace_back(gz::common::joinPaths(model, "meshes",
+        "mesh" + std::to_string(i) + ".dae"), content);
+  }
+  std::string image;
+  unsigned int state = 3;
+  while (image.size() < 300 * 1024u)
+  {
+    state = state * 1103515245u + 12345u;
+    image.push_back(static_cast<char>(state >> 24));
+  }
+  files.emplace_back(gz::common::joinPaths(model, "texture.PNG"), image);
+  for (const auto &[path, content] : files)
+  {
+    std::ofstream out(path, std::ios::binary);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+
+  for (unsigned int jobs : {1u, 4u})
+  {
+    ZipCompressOptions options;
+    options.level = jobs == 1u ? 1 : 9;
+    options.storedExtensions = Zip::StoredExtensions();
+    options.jobs = jobs;
+
+    auto zipOutFile = gz::common::joinPaths(newTempDir,
+        "model" + std::to_string(jobs) + ".zip");
+    ASSERT_TRUE(Zip::Compress(model, zipOutFile, options));
+
+    // The image is stored as is, the meshes are deflated
+    std::ifstream zipIn(zipOutFile, std::ios::binary);
+    std::string archive((std::istreambuf_iterator<char>(zipIn)),
+        std::istreambuf_iterator<char>());
+    EXPECT_NE(std::string::npos, archive.find(image));
+    EXPECT_LT(archive.size(), 6 * 1024 * 1024u);
+
+    auto extractOutDir = gz::common::joinPaths(newTempDir,
+        "extract" + std::to_string(jobs));
+    EXPECT_TRUE(Zip::Extract(zipOutFile, extractOutDir));
+    for (const auto &[path, content] : files)
+    {
+      std::string relative = path.substr(newTempDir.size() + 1);
+      std::ifstream in(gz::common::joinPaths(extractOutDir, relative),
+          std::ios::binary);
+      ASSERT_TRUE(in.is_open()) << relative;
+      std::string extracted((std::istreambuf_iterator<char>(in)),
+          std::istreambuf_iterator<char>());
+      EXPECT_TRUE(content == extracted) << relative << " jobs " << jobs;
+    }
+  }
+
+  // Without options, every file is deflated, images included
+  auto zipOutFile = gz::common::joinPaths(newTempDir, "model.zip");
+  ASSERT_TRUE(Zip::Compress(model, zipOutFile));
+  std::ifstream zipIn(zipOutFile, std::ios::binary);
+  std::string archive((std::istreambuf_iterator<char>(zipIn)),
+      std::istreambuf_iterator<char>());
+  EXPECT_EQ(std::string::npos, archive.find(image));
+
+  // Level 0 stores every file, as in zlib
+  ZipCompressOptions storeOptions;
+  storeOptions.level = 0;
+  auto storedZip = gz::common::joinPaths(newTempDir, "stored.zip");
+  ASSERT_TRUE(Zip::Compress(model, storedZip, storeOptions));
+  std::ifstream storedIn(storedZip, std::ios::binary);
+  std::string stored((std::istreambuf_iterator<char>(storedIn)),
+      std::istreambuf_iterator<char>());
+  EXPECT_NE(std::string::npos, stored.find(image));
+  EXPECT_NE(std::string::npos, stored.find(files.front().second));
+  auto storedDir = gz::common::joinPaths(newTempDir, "extractStored");
+  EXPECT_TRUE(Zip::Extract(storedZip, storedDir));
+  EXPECT_TRUE(gz::common::isFile(gz::common::joinPaths(storedDir, "model",
+      "meshes", "mesh0.dae")));
+
+  // Clean.
+  gz::common::removeAll(newTempDir);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test extracting an archive held in memory
+TEST_F(ZipTest, ExtractFromMemory)
+{
+  std::string newTempDir;
+  ASSERT_TRUE(createAndSwitchToTempDir(newTempDir));
+  auto d = gz::common::joinPaths(newTempDir, "d1", "d2");
+  ASSERT_TRUE(gz::common::createDirectories(d));
+  {
+    std::ofstream out(gz::common::joinPaths(d, "new_file"));
+    out << "content";
+  }
+
+  auto zipOutFile = gz::common::joinPaths(newTempDir, "new_file.zip");
+  ASSERT_TRUE(Zip::Compress(gz::common::joinPaths(newTempDir, "d1"),
+      zipOutFile));
+
+  std::string data;
+  {
+    std::ifstream in(zipOutFile, std::ios::binary);
+    data.assign((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+  }
+  gz::common::removeFile(zipOutFile);
+
+  auto extractOutDir = gz::common::joinPaths(newTempDir, "extract");
+  EXPECT_TRUE(Zip::ExtractFromMemory(data.data(), data.size(),
+      extractOutDir));
+  std::ifstream in(
+      gz::common::joinPaths(extractOutDir, "d1", "d2", "new_file"));
+  std::string content;
+  in >> content;
+  EXPECT_EQ("content", content);
+
+  // Not an archive
+  std::string garbage = "not a zip archive";
+  EXPECT_FALSE(Zip::ExtractFromMemory(garbage.data(), garbage.size(),
+      extractOutDir));
+
+  // Clean.
+  gz::common::removeAll(newTempDir);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that a corrupt entry fails the whole extraction
+TEST_F(ZipTest, ExtractCorruptEntry)
+{
+  std::string newTempDir;
+  ASSERT_TRUE(createAndSwitchToTempDir(newTempDir));
+  auto d = gz::common::joinPaths(newTempDir, "d1");
+  ASSERT_TRUE(gz::common::createDirectories(d));
+
+  // Enough data to be extracted by several threads, the first entry is
+  // corrupted below
+  unsigned int state = 11;
+  for (int i = 0; i < 6; ++i)
+  {
+    std::string content;
+    while (content.size() < 1024 * 1024u)
+    {
+      state = state * 1103515245u + 12345u;
+      content.push_back(static_cast<char>(state >> 24));
+    }
+    std::ofstream out(gz::common::joinPaths(d, "file" + std::to_string(i)),
+        std::ios::binary);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+
+  auto zipOutFile = gz::common::joinPaths(newTempDir, "corrupt.zip");
+  ASSERT_TRUE(Zip::Compress(d, zipOutFile));
+
+  std::string data;
+  {
+    std::ifstream in(zipOutFile, std::ios::binary);
+    data.assign((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+  }
+
+  // Flip bytes in the middle of the data of the first file entry, after
+  // its local header: signature, fixed fields, name and extra field
+  std::size_t header = data.find("PK\x03\x04");
+  while (header != std::string::npos &&
+         data.compare(header + 30, 8, "d1/file0") != 0)
+  {
+    header = data.find("PK\x03\x04", header + 4);
+  }
+  ASSERT_NE(std::string::npos, header);
+  auto u16 = [&data](std::size_t _pos)
+  {
+    return static_cast<std::size_t>(static_cast<unsigned char>(data[_pos])) |
+        static_cast<std::size_t>(
+            static_cast<unsigned char>(data[_pos + 1])) << 8;
+  };
+  std::size_t start = header + 30 + u16(header + 26) + u16(header + 28);
+  for (std::size_t i = start + 512 * 1024; i < start + 512 * 1024 + 64; ++i)
+    data[i] = static_cast<char>(~data[i]);
+  {
+    std::ofstream out(zipOutFile, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+  }
+
+  for (unsigned int jobs : {1u, 4u})
+  {
+    auto extractOutDir = gz::common::joinPaths(newTempDir,
+        "extract" + std::to_string(jobs));
+    ZipExtractOptions options;
+    options.jobs = jobs;
+    EXPECT_FALSE(Zip::Extract(zipOutFile, extractOutDir, options)) << jobs;
+    EXPECT_FALSE(Zip::ExtractFromMemory(data.data(), data.size(),
+        extractOutDir + "mem", options)) << jobs;
+
+    // The corrupt file isn't left behind
+    EXPECT_FALSE(gz::common::exists(
+        gz::common::joinPaths(extractOutDir, "d1", "file0")));
+  }
+
+  // Clean.
+  gz::common::removeAll(newTempDir);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that entries rejected by a filter aren't extracted
+TEST_F(ZipTest, ExtractFiltered)
+{
+  std::string newTempDir;
+  ASSERT_TRUE(createAndSwitchToTempDir(newTempDir));
+  auto d = gz::common::joinPaths(newTempDir, "d1");
+  ASSERT_TRUE(gz::common::createDirectories(
+      gz::common::joinPaths(d, "thumbnails")));
+  ASSERT_TRUE(createNewEmptyFile(gz::common::joinPaths(d, "model.config")));
+  ASSERT_TRUE(createNewEmptyFile(
+      gz::common::joinPaths(d, "thumbnails", "1.png")));
+
+  auto zipOutFile = gz::common::joinPaths(newTempDir, "new_file.zip");
+  ASSERT_TRUE(Zip::Compress(d, zipOutFile));
+
+  std::vector<std::string> names;
+  auto extractOutDir = gz::common::joinPaths(newTempDir, "extract");
+  ZipExtractOptions options;
+  options.filter = [&names](const std::string &_name)
+  {
+    names.push_back(_name);
+    return _name.find("thumbnails") == std::string::npos;
+  };
+  EXPECT_TRUE(Zip::Extract(zipOutFile, extractOutDir, options));
+  EXPECT_NE(names.end(),
+      std::find(names.begin(), names.end(), "d1/thumbnails/1.png"));
+  EXPECT_TRUE(gz::common::exists(
+      gz::common::joinPaths(extractOutDir, "d1", "model.config")));
+  EXPECT_FALSE(gz::common::exists(
+      gz::common::joinPaths(extractOutDir, "d1", "thumbnails")));
+
+  // Clean.
+  gz::common::removeAll(newTempDir);
+}
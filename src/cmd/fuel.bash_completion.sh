@@ -21,6 +21,7 @@
 # top-level entry point in ign-tools.
 
 GZ_FUEL_SUBCOMMANDS="
+cache
 delete
 download
 edit
@@ -39,6 +40,33 @@ GZ_FUEL_COMPLETION_LIST="
   --versions
 "
 
+GZ_CACHE_ACTIONS="
+blobs
+export
+fix-paths
+gc
+import
+stats
+verify
+"
+
+GZ_CACHE_COMPLETION_LIST="
+  --days
+  --dry-run
+  --header
+  --keep
+  --list
+  -o --owner
+  -u --url
+  --prune
+  --repair
+  -c --config
+  -h --help
+  -j --jobs
+  --force-version
+  --versions
+"
+
 GZ_DELETE_COMPLETION_LIST="
   --header
   -c --config
@@ -117,6 +145,18 @@ function __get_comp_from_list {
   fi
 }
 
+function _gz_fuel_cache
+{
+  if [[ ${COMP_WORDS[COMP_CWORD]} != -* && \
+        ${COMP_WORDS[COMP_CWORD-1]} == "cache" ]]; then
+    # The first argument after cache is the action
+    COMPREPLY=($(compgen -W "$GZ_CACHE_ACTIONS" \
+      -- "${COMP_WORDS[COMP_CWORD]}" ))
+    return
+  fi
+  __get_comp_from_list "$GZ_CACHE_COMPLETION_LIST"
+}
+
 function _gz_fuel_delete
 {
   __get_comp_from_list "$GZ_DELETE_COMPLETION_LIST"
@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <chrono>
 #include <deque>
+#include <fstream>
 #include <future>
 #include <iostream>
 #include <map>
@@ -50,6 +51,7 @@
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include <gz/common/SignalHandler.hh>
+#include <gz/common/StringUtils.hh>
 #include <gz/common/URI.hh>
 
 #include "gz/fuel_tools/ClientConfig.hh"
@@ -59,6 +61,7 @@
 #include "gz/fuel_tools/Helpers.hh"
 #include "gz/fuel_tools/Result.hh"
 #include "gz.hh"
+#include "LocalCache.hh"
 #include "gz/fuel_tools/WorldIdentifier.hh"
 
 //////////////////////////////////////////////////
@@ -943,3 +946,362 @@ extern "C" GZ_FUEL_TOOLS_VISIBLE int update(
   }
   return 1;
 }
+
+//////////////////////////////////////////////////
+extern "C" GZ_FUEL_TOOLS_VISIBLE int verifyCache(const char *_repair,
+    int _jobs, const char *_header, const char *_configFile)
+{
+  // Add signal handler for SIGTERM and SIGINT. Ctrl-C doesn't work without this
+  // handler.
+  gz::common::SignalHandler sigHandler;
+  sigHandler.AddCallback([&](int _sig) {
+      if (SIGTERM == _sig || SIGINT == _sig)
+      {
+        std::exit(1);
+      }
+  });
+
+  bool repairBool = false;
+  if (_repair && std::strlen(_repair) != 0)
+  {
+    std::string str = gz::common::lowercase(_repair);
+    repairBool = str == "1" || str == "true";
+  }
+
+  // Client
+  gz::fuel_tools::ClientConfig conf;
+  if (_configFile && strlen(_configFile) > 0)
+  {
+    conf.Clear();
+    conf.LoadConfig(_configFile);
+  }
+
+  conf.SetUserAgent("FuelTools " GZ_FUEL_TOOLS_VERSION_FULL);
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  cache.SetJobs(_jobs > 0 ? static_cast<unsigned int>(_jobs) : 0u);
+
+  std::vector<gz::fuel_tools::ModelIdentifier> badModels;
+  std::vector<gz::fuel_tools::WorldIdentifier> badWorlds;
+  if (cache.Verify(badModels, badWorlds))
+  {
+    std::cout << "Cache is intact." << std::endl;
+    return 1;
+  }
+
+  for (const auto &model : badModels)
+    std::cout << "Damaged model: " << model.UniqueName() << " version "
+              << model.VersionStr() << std::endl;
+  for (const auto &world : badWorlds)
+    std::cout << "Damaged world: " << world.UniqueName() << " version "
+              << world.VersionStr() << std::endl;
+
+  if (!repairBool)
+    return 0;
+
+  // Headers
+  std::vector<std::string> headers;
+  if (_header && strlen(_header) > 0)
+    headers.push_back(_header);
+
+  gz::fuel_tools::FuelClient client(conf);
+  bool repaired = true;
+  for (const auto &model : badModels)
+  {
+    if (!client.DownloadModel(model, headers))
+    {
+      std::cout << "Failed to repair model: " << model.UniqueName()
+                << std::endl;
+      repaired = false;
+    }
+  }
+  for (auto world : badWorlds)
+  {
+    if (!client.DownloadWorld(world, headers))
+    {
+      std::cout << "Failed to repair world: " << world.UniqueName()
+                << std::endl;
+      repaired = false;
+    }
+  }
+
+  if (repaired)
+    std::cout << "Repaired all damaged resources." << std::endl;
+  return repaired ? 1 : 0;
+}
+
+//////////////////////////////////////////////////
+extern "C" GZ_FUEL_TOOLS_VISIBLE int cacheBlobs(const char *_prune,
+    const char *_configFile)
+{
+  bool pruneBool = false;
+  if (_prune && std::strlen(_prune) != 0)
+  {
+    std::string str = gz::common::lowercase(_prune);
+    pruneBool = str == "1" || str == "true";
+  }
+
+  // Client
+  gz::fuel_tools::ClientConfig conf;
+  if (_configFile && strlen(_configFile) > 0)
+  {
+    conf.Clear();
+    conf.LoadConfig(_configFile);
+  }
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  if (pruneBool)
+    cache.PruneBlobs();
+
+  auto stats = cache.BlobStoreStats();
+  std::cout << "Deduplication: "
+            << (conf.CacheDeduplication() ? "enabled" : "disabled")
+            << std::endl
+            << "Blobs: " << stats.blobs << std::endl
+            << "Blob bytes: " << stats.bytes << std::endl
+            << "Bytes saved: " << stats.savedBytes << std::endl
+            << "Unreferenced blobs: " << stats.unreferenced << std::endl;
+  return 1;
+}
+
+//////////////////////////////////////////////////
+extern "C" GZ_FUEL_TOOLS_VISIBLE int fixCachePaths(const char *_configFile)
+{
+  // Client
+  gz::fuel_tools::ClientConfig conf;
+  if (_configFile && strlen(_configFile) > 0)
+  {
+    conf.Clear();
+    conf.LoadConfig(_configFile);
+  }
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  std::size_t fixed = 0;
+  bool result = cache.FixAllPaths(fixed);
+  std::cout << "Rewrote the URIs of " << fixed << " resources." << std::endl;
+  return result ? 1 : 0;
+}
+
+//////////////////////////////////////////////////
+/// \brief Collect the URLs passed on the command line.
+/// \param[in] _url Optional URL.
+/// \param[in] _listFile Optional file listing URLs, one per line. Empty
+/// lines and lines starting with '#' are ignored.
+/// \param[out] _urls The URLs.
+/// \return False if the list file can't be read.
+static bool readUrls(const char *_url, const char *_listFile,
+    std::vector<std::string> &_urls)
+{
+  if (_url && strlen(_url) > 0)
+    _urls.push_back(_url);
+
+  if (_listFile && strlen(_listFile) > 0)
+  {
+    std::ifstream in(_listFile);
+    if (!in)
+    {
+      std::cout << "Unable to read [" << _listFile << "]" << std::endl;
+      return false;
+    }
+    std::string line;
+    while (std::getline(in, line))
+    {
+      line = gz::common::trimmed(line);
+      if (!line.empty() && line[0] != '#')
+        _urls.push_back(line);
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+extern "C" GZ_FUEL_TOOLS_VISIBLE int exportCache(const char *_pack,
+    const char *_url, const char *_owner, const char *_listFile,
+    const char *_configFile)
+{
+  if (!_pack || strlen(_pack) == 0)
+  {
+    std::cout << "Missing pack file" << std::endl;
+    return 0;
+  }
+
+  // Client
+  gz::fuel_tools::ClientConfig conf;
+  if (_configFile && strlen(_configFile) > 0)
+  {
+    conf.Clear();
+    conf.LoadConfig(_configFile);
+  }
+  conf.SetUserAgent("FuelTools " GZ_FUEL_TOOLS_VERSION_FULL);
+
+  gz::fuel_tools::FuelClient client(conf);
+  gz::fuel_tools::LocalCache cache(&conf);
+
+  std::vector<std::string> urls;
+  if (!readUrls(_url, _listFile, urls))
+    return 0;
+
+  std::vector<gz::fuel_tools::ModelIdentifier> models;
+  std::vector<gz::fuel_tools::WorldIdentifier> worlds;
+  for (const auto &urlStr : urls)
+  {
+    gz::common::URI url(urlStr);
+    gz::fuel_tools::ModelIdentifier model;
+    gz::fuel_tools::WorldIdentifier world;
+    gz::fuel_tools::CollectionIdentifier collection;
+    if (client.ParseModelUrl(url, model))
+    {
+      models.push_back(model);
+    }
+    else if (client.ParseWorldUrl(url, world))
+    {
+      worlds.push_back(world);
+    }
+    else if (client.ParseCollectionUrl(url, collection))
+    {
+      // Export whatever version of the collection items is cached
+      for (auto iter = client.Models(collection); iter; ++iter)
+      {
+        auto id = iter->Identification();
+        id.SetVersion(0);
+        models.push_back(id);
+      }
+      for (auto iter = client.Worlds(collection); iter; ++iter)
+      {
+        gz::fuel_tools::WorldIdentifier id = iter;
+        id.SetVersion(0);
+        worlds.push_back(id);
+      }
+    }
+    else
+    {
+      std::cout << "Invalid URL [" << urlStr << "]: only models, worlds and "
+                << "collections can be exported." << std::endl;
+      return 0;
+    }
+  }
+
+  // Every cached version of the owner's resources, or of the whole cache
+  // when nothing else was selected.
+  bool hasOwner = _owner && strlen(_owner) > 0;
+  if (hasOwner || urls.empty())
+  {
+    for (auto iter = cache.AllModels(); iter; ++iter)
+    {
+      if (!hasOwner || iter->Identification().Owner() == _owner)
+        models.push_back(iter->Identification());
+    }
+    for (auto iter = cache.AllWorlds(); iter; ++iter)
+    {
+      if (!hasOwner || iter->Owner() == _owner)
+        worlds.push_back(iter);
+    }
+  }
+
+  if (models.empty() && worlds.empty())
+  {
+    std::cout << "Nothing to export" << std::endl;
+    return 0;
+  }
+
+  if (!cache.ExportPack(_pack, models, worlds))
+  {
+    std::cout << "Failed to write pack [" << _pack << "]" << std::endl;
+    return 0;
+  }
+
+  std::cout << "Exported " << models.size() << " models and "
+            << worlds.size() << " worlds to [" << _pack << "]" << std::endl;
+  return 1;
+}
+
+//////////////////////////////////////////////////
+extern "C" GZ_FUEL_TOOLS_VISIBLE int importCache(const char *_pack,
+    int _jobs, const char *_configFile)
+{
+  if (!_pack || strlen(_pack) == 0)
+  {
+    std::cout << "Missing pack file" << std::endl;
+    return 0;
+  }
+
+  // Client
+  gz::fuel_tools::ClientConfig conf;
+  if (_configFile && strlen(_configFile) > 0)
+  {
+    conf.Clear();
+    conf.LoadConfig(_configFile);
+  }
+
+  gz::fuel_tools::LocalCache cache(&conf);
+  cache.SetJobs(_jobs > 0 ? static_cast<unsigned int>(_jobs) : 0u);
+
+  std::size_t installed = 0;
+  std::size_t skipped = 0;
+  bool result = cache.ImportPack(_pack, installed, skipped);
+  std::cout << "Installed " << installed << " resources, skipped "
+            << skipped << " already cached." << std::endl;
+  if (!result)
+    std::cout << "Failed to import [" << _pack << "]" << std::endl;
+  return result ? 1 : 0;
+}
+
+//////////////////////////////////////////////////
+extern "C" GZ_FUEL_TOOLS_VISIBLE int collectCache(int _keep, int _days,
+    const char *_dryRun, const char *_url, const char *_listFile, int _jobs,
+    const char *_configFile)
+{
+  // Client
+  gz::fuel_tools::ClientConfig conf;
+  if (_configFile && strlen(_configFile) > 0)
+  {
+    conf.Clear();
+    conf.LoadConfig(_configFile);
+  }
+
+  gz::fuel_tools::FuelClient client(conf);
+  gz::fuel_tools::LocalCache cache(&conf);
+  cache.SetJobs(_jobs > 0 ? static_cast<unsigned int>(_jobs) : 0u);
+
+  gz::fuel_tools::CacheGcPolicy policy;
+  if (_keep >= 0)
+    policy.keepVersions = static_cast<std::size_t>(_keep);
+  if (_days >= 0)
+    policy.keepUsedWithin = std::chrono::hours(24 * _days);
+  if (_dryRun && std::strlen(_dryRun) != 0)
+  {
+    std::string str = gz::common::lowercase(_dryRun);
+    policy.dryRun = str == "1" || str == "true";
+  }
+
+  std::vector<std::string> urls;
+  if (!readUrls(_url, _listFile, urls))
+    return 0;
+
+  for (const auto &urlStr : urls)
+  {
+    gz::common::URI url(urlStr);
+    gz::fuel_tools::ModelIdentifier model;
+    gz::fuel_tools::WorldIdentifier world;
+    if (client.ParseModelUrl(url, model))
+    {
+      policy.pinnedModels.push_back(model);
+    }
+    else if (client.ParseWorldUrl(url, world))
+    {
+      policy.pinnedWorlds.push_back(world);
+    }
+    else
+    {
+      std::cout << "Invalid URL [" << urlStr << "]: only models and worlds "
+                << "can be kept." << std::endl;
+      return 0;
+    }
+  }
+
+  auto report = cache.CollectGarbage(policy);
+  if (policy.dryRun)
+    std::cout << "Dry run, nothing was removed." << std::endl;
+  std::cout << report.AsString();
+  return 1;
+}
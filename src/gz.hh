@@ -137,4 +137,74 @@ extern "C" GZ_FUEL_TOOLS_VISIBLE int update(
     const char *_onlyModels = nullptr, const char *_onlyWorlds = nullptr,
     const char *_header = nullptr);
 
+/// \brief External hook to execute 'gz fuel cache verify [options]' from the
+/// command line.
+/// \param[in] _repair "1" to download damaged resources again.
+/// \param[in] _jobs Number of threads used to hash files, 0 to use all cores.
+/// \param[in] _header An HTTP header, used when repairing.
+/// \param[in] _configFile Path to a YAML configuration file.
+/// \return 1 if no damaged resource remains, 0 if not.
+extern "C" GZ_FUEL_TOOLS_VISIBLE int verifyCache(
+    const char *_repair = nullptr, int _jobs = 0,
+    const char *_header = nullptr, const char *_configFile = nullptr);
+
+/// \brief External hook to execute 'gz fuel cache blobs [options]' from the
+/// command line. Prints statistics of the blob store used to deduplicate
+/// cached files.
+/// \param[in] _prune "1" to remove blobs that are no longer used.
+/// \param[in] _configFile Path to a YAML configuration file.
+/// \return 1 if successful, 0 if not.
+extern "C" GZ_FUEL_TOOLS_VISIBLE int cacheBlobs(
+    const char *_prune = nullptr, const char *_configFile = nullptr);
+
+/// \brief External hook to execute 'gz fuel cache fix-paths [options]' from
+/// the command line. Rewrites the model:// URIs of the cached resources that
+/// aren't rewritten yet, such as resources cached by earlier versions.
+/// \param[in] _configFile Path to a YAML configuration file.
+/// \return 1 if every resource is rewritten, 0 if not.
+extern "C" GZ_FUEL_TOOLS_VISIBLE int fixCachePaths(
+    const char *_configFile = nullptr);
+
+/// \brief External hook to execute 'gz fuel cache export [options]' from the
+/// command line. Writes cached models and worlds to a pack file.
+/// \param[in] _pack Path of the pack file to write.
+/// \param[in] _url Optional model, world or collection URL to export.
+/// \param[in] _owner Optional owner whose cached resources are exported.
+/// \param[in] _listFile Optional file listing model, world or collection
+/// URLs to export, one per line. Empty lines and lines starting with '#'
+/// are ignored.
+/// \param[in] _configFile Path to a YAML configuration file.
+/// \return 1 if successful, 0 if not.
+extern "C" GZ_FUEL_TOOLS_VISIBLE int exportCache(
+    const char *_pack, const char *_url = nullptr,
+    const char *_owner = nullptr, const char *_listFile = nullptr,
+    const char *_configFile = nullptr);
+
+/// \brief External hook to execute 'gz fuel cache import [options]' from the
+/// command line. Installs the resources of a pack file in the cache.
+/// \param[in] _pack Path of the pack file to read.
+/// \param[in] _jobs Number of parallel jobs, 0 for the default.
+/// \param[in] _configFile Path to a YAML configuration file.
+/// \return 1 if successful, 0 if not.
+extern "C" GZ_FUEL_TOOLS_VISIBLE int importCache(
+    const char *_pack, int _jobs = 0, const char *_configFile = nullptr);
+
+/// \brief External hook to execute 'gz fuel cache gc [options]' from the
+/// command line. Removes superseded versions of the cached resources.
+/// \param[in] _keep Number of versions kept per resource, negative for the
+/// default.
+/// \param[in] _days Versions used within this many days are kept, negative
+/// for the default.
+/// \param[in] _dryRun "1" to only report what would be removed.
+/// \param[in] _url Optional model or world URL to keep.
+/// \param[in] _listFile Optional file listing model or world URLs to keep,
+/// one per line.
+/// \param[in] _jobs Number of parallel jobs, 0 for the default.
+/// \param[in] _configFile Path to a YAML configuration file.
+/// \return 1 if successful, 0 if not.
+extern "C" GZ_FUEL_TOOLS_VISIBLE int collectCache(
+    int _keep = -1, int _days = -1, const char *_dryRun = nullptr,
+    const char *_url = nullptr, const char *_listFile = nullptr,
+    int _jobs = 0, const char *_configFile = nullptr);
+
 #endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/ClientConfig.hh"
+#include "gz/fuel_tools/WorldIdentifier.hh"
+#include "gz/fuel_tools/Zip.hh"
+
+#include "LocalCache.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of worlds saved per run.
+static constexpr int kWorlds = 100;
+
+/// \brief Number of asset files in each world.
+static constexpr int kAssets = 50;
+
+/// \brief Size of each asset file, in bytes.
+static constexpr std::size_t kAssetSize = 64u * 1024u;
+
+/////////////////////////////////////////////////
+class CacheArchiveModePerformance : public ::testing::Test
+{
+  public: void SetUp() override
+  {
+    common::Console::SetVerbosity(3);
+
+    this->tempDir = common::testing::MakeTestTempDirectory();
+    ASSERT_TRUE(this->tempDir->Valid()) << this->tempDir->Path();
+
+    // A world with a description file and many assets
+    std::string srcDir = common::joinPaths(this->tempDir->Path(), "world");
+    ASSERT_TRUE(common::createDirectories(
+        common::joinPaths(srcDir, "meshes")));
+    {
+      std::ofstream fout(common::joinPaths(srcDir, "world.sdf"));
+      fout << "<?xml version=\"1.0\"?><sdf version=\"1.6\"></sdf>";
+    }
+    for (int a = 0; a < kAssets; ++a)
+    {
+      std::ofstream fout(common::joinPaths(srcDir, "meshes",
+          "mesh" + std::to_string(a) + ".dae"), std::ios::binary);
+      std::string data(kAssetSize, '\0');
+      for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<char>((i * 31u + a) % 251u);
+      fout << data;
+    }
+
+    std::string zipPath = common::joinPaths(this->tempDir->Path(),
+        "world.zip");
+    ASSERT_TRUE(Zip::Compress(srcDir, zipPath));
+    std::ifstream zipFile(zipPath, std::ios::binary);
+    this->zipData.assign(std::istreambuf_iterator<char>(zipFile),
+        std::istreambuf_iterator<char>());
+  }
+
+  /// \brief Save kWorlds worlds into a fresh cache.
+  /// \param[in] _archiveMode True to keep the archives.
+  /// \param[out] _bytes Bytes on disk under the cache.
+  /// \return Elapsed time in ms.
+  public: double Install(bool _archiveMode, std::uintmax_t &_bytes)
+  {
+    ClientConfig config;
+    std::string cacheDir = common::joinPaths(this->tempDir->Path(),
+        _archiveMode ? "archive" : "extract");
+    config.SetCacheLocation(cacheDir);
+    config.SetCacheArchiveMode(_archiveMode);
+    LocalCache cache(&config);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int w = 0; w < kWorlds; ++w)
+    {
+      WorldIdentifier id;
+      id.SetServer(config.Servers().front());
+      id.SetOwner("owner");
+      id.SetName("world" + std::to_string(w));
+      id.SetVersion(1);
+      EXPECT_TRUE(cache.SaveWorld(id, this->zipData, true));
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    _bytes = 0;
+    std::error_code ec;
+    for (const auto &entry :
+         std::filesystem::recursive_directory_iterator(cacheDir, ec))
+    {
+      if (entry.is_regular_file(ec))
+        _bytes += entry.file_size(ec);
+    }
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  }
+
+  public: std::shared_ptr<common::TempDirectory> tempDir;
+
+  /// \brief Compressed world.
+  public: std::string zipData;
+};
+
+/////////////////////////////////////////////////
+TEST_F(CacheArchiveModePerformance, Install)
+{
+  for (bool archiveMode : {false, true})
+  {
+    std::uintmax_t bytes{0};
+    double ms = this->Install(archiveMode, bytes);
+    EXPECT_GT(bytes, 0u);
+
+    std::cout << "Installed " << kWorlds << " worlds "
+              << (archiveMode ? "in archive mode" : "extracted") << " in "
+              << ms << " ms, " << bytes / 1024u << " KiB on disk"
+              << std::endl;
+  }
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "FuelUrlParser.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of allocations made by the process.
+static std::atomic<std::size_t> gAllocations{0};
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  ++gAllocations;
+  if (void *ptr = std::malloc(_size ? _size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/// \brief Number of passes over the URLs per measurement.
+static constexpr int kPasses = 2000;
+
+/// \brief Model regular expression FuelClient used before the parser.
+static const char kModelRegexStr[] =
+    "^([[:alnum:]\\.\\+\\-]+):\\/\\/"
+    "([^\\/\\s]+)\\/+"
+    "([0-9]+[.][0-9]+)?\\/*"
+    "([^\\/\\s]+)\\/+"
+    "models\\/+([^\\/]+)\\/*([0-9]*|tip)/?";
+
+/// \brief Model file regular expression FuelClient used before the parser.
+static const char kModelFileRegexStr[] =
+    "^([[:alnum:]\\.\\+\\-]+):\\/\\/"
+    "([^\\/\\s]+)\\/+"
+    "([0-9]+[.][0-9]+)?\\/*"
+    "([^\\/\\s]+)\\/+"
+    "models\\/+([^\\/]+)\\/+([0-9]*|tip)\\/+files\\/+(.*)/?";
+
+/////////////////////////////////////////////////
+/// \brief Report allocations and time per URL of a parse function.
+/// \param[in] _label Name of the measurement.
+/// \param[in] _urls URLs to parse.
+/// \param[in] _parse Function parsing one URL, returns true on a match.
+template<typename Parse>
+void measure(const std::string &_label, const std::vector<std::string> &_urls,
+    Parse _parse)
+{
+  std::size_t matches = 0;
+  auto allocations = gAllocations.load();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kPasses; ++i)
+  {
+    for (const auto &url : _urls)
+    {
+      if (_parse(url))
+        ++matches;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  auto count = gAllocations.load() - allocations;
+  double parses = static_cast<double>(kPasses) * _urls.size();
+
+  EXPECT_GT(matches, 0u);
+  std::cout << _label << ": "
+            << static_cast<double>(count) / parses << " allocations, "
+            << std::chrono::duration<double, std::nano>(end - start).count() /
+               parses << " ns per URL" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(FuelUrlParsingPerformance, RegexAndParser)
+{
+  // Mix of model URLs, file URLs and URLs of other shapes, like the
+  // resources of a world referencing Fuel models
+  const std::vector<std::string> urls = {
+    "https://fuel.gazebosim.org/1.0/OpenRobotics/models/Ambulance/2",
+    "https://fuel.gazebosim.org/1.0/OpenRobotics/models/Ambulance",
+    "https://fuel.gazebosim.org/OpenRobotics/models/Construction Cone/tip",
+    "https://fuel.gazebosim.org/1.0/OpenRobotics/models/Ambulance/2/files/"
+        "meshes/ambulance.obj",
+    "https://fuel.gazebosim.org/1.0/OpenRobotics/models/Ambulance/tip/files/"
+        "materials/textures/ambulance.png",
+    "https://fuel.gazebosim.org/1.0/OpenRobotics/worlds/Empty/1",
+    "https://fuel.gazebosim.org/1.0/OpenRobotics/collections/Tunnel",
+    "model://Ambulance/meshes/ambulance.obj",
+  };
+
+  const std::regex modelRegex(kModelRegexStr);
+  const std::regex modelFileRegex(kModelFileRegexStr);
+
+  measure("std::regex, model and model file", urls, [&](const std::string &_u)
+  {
+    std::smatch match;
+    return std::regex_match(_u, match, modelRegex) ||
+        std::regex_match(_u, match, modelFileRegex);
+  });
+
+  measure("FuelUrlParser, model and model file", urls,
+      [&](const std::string &_u)
+  {
+    FuelUrlParts parts;
+    return FuelUrlParser::Match(FuelUrlType::MODEL, _u, parts) ||
+        FuelUrlParser::Match(FuelUrlType::MODEL_FILE, _u, parts);
+  });
+
+  // Constructing a FuelClient used to compile all five expressions
+  auto allocations = gAllocations.load();
+  auto start = std::chrono::steady_clock::now();
+  std::regex compiled(kModelFileRegexStr);
+  auto end = std::chrono::steady_clock::now();
+  std::cout << "Compiling one expression: "
+            << gAllocations.load() - allocations << " allocations, "
+            << std::chrono::duration<double, std::micro>(end - start).count()
+            << " us" << std::endl;
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "gz/fuel_tools/ModelIdentifier.hh"
+#include "gz/fuel_tools/ServerConfig.hh"
+
+#include "IdentifierKey.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of allocations made by the process.
+static std::atomic<std::size_t> gAllocations{0};
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  ++gAllocations;
+  if (void *ptr = std::malloc(_size ? _size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/// \brief Number of identifiers in the set.
+static constexpr int kModels = 1000;
+
+/// \brief Number of lookups per measurement.
+static constexpr int kLookups = 100000;
+
+/////////////////////////////////////////////////
+/// \brief Hash used by FuelClient before identifiers had keys.
+struct AsStringHash
+{
+  std::size_t operator()(const ModelIdentifier &_id) const
+  {
+    return std::hash<std::string>{}(_id.AsString());
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Equality used before identifiers compared their members.
+struct UniqueNameEqual
+{
+  bool operator()(const ModelIdentifier &_a, const ModelIdentifier &_b) const
+  {
+    return _a.UniqueName() == _b.UniqueName();
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Report allocations and time per lookup of a lookup function.
+/// \param[in] _label Name of the measurement.
+/// \param[in] _lookup Function doing one lookup, returns true on a hit.
+template<typename Lookup>
+void measure(const std::string &_label, Lookup _lookup)
+{
+  std::size_t hits = 0;
+  auto allocations = gAllocations.load();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kLookups; ++i)
+  {
+    if (_lookup(i % kModels))
+      ++hits;
+  }
+  auto end = std::chrono::steady_clock::now();
+  auto count = gAllocations.load() - allocations;
+
+  EXPECT_EQ(static_cast<std::size_t>(kLookups), hits);
+  std::cout << _label << ": "
+            << static_cast<double>(count) / kLookups << " allocations, "
+            << std::chrono::duration<double, std::nano>(end - start).count() /
+               kLookups << " ns per lookup" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(IdentifierLookupPerformance, Allocations)
+{
+  ServerConfig server;
+  server.SetUrl(common::URI("https://fuel.gazebosim.org", true));
+
+  std::vector<ModelIdentifier> ids;
+  for (int i = 0; i < kModels; ++i)
+  {
+    ModelIdentifier id;
+    id.SetServer(server);
+    id.SetOwner("owner" + std::to_string(i % 10));
+    id.SetName("model" + std::to_string(i));
+    ids.push_back(id);
+  }
+
+  // Set of DownloadModels
+  std::unordered_set<ModelIdentifier, AsStringHash, UniqueNameEqual> before(
+      ids.begin(), ids.end());
+  measure("unordered_set<ModelIdentifier>, AsString hash", [&](int _i)
+  {
+    return before.count(ids[_i]) > 0;
+  });
+
+  std::unordered_set<IdentifierKey, IdentifierKeyHash> after;
+  std::vector<IdentifierKey> keys;
+  for (const auto &id : ids)
+  {
+    after.emplace(id);
+    keys.emplace_back(id);
+  }
+  measure("unordered_set<IdentifierKey>", [&](int _i)
+  {
+    return after.count(keys[_i]) > 0;
+  });
+
+  // Linear search of LocalCache::MatchingModel, over the models of one owner
+  auto linear = [&](int _i, auto _equal)
+  {
+    int owner = _i % 10;
+    for (int j = owner; j < kModels; j += 10)
+    {
+      if (_equal(ids[j], ids[_i]))
+        return true;
+    }
+    return false;
+  };
+  measure("Linear search, UniqueName equality", [&](int _i)
+  {
+    return linear(_i, UniqueNameEqual());
+  });
+  measure("Linear search, ModelIdentifier::operator==", [&](int _i)
+  {
+    return linear(_i, std::equal_to<ModelIdentifier>());
+  });
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/ClientConfig.hh"
+#include "gz/fuel_tools/Helpers.hh"
+
+#include "LocalCache.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of owners in the synthetic cache.
+static constexpr int kOwners = 500;
+
+/// \brief Number of models per owner in the synthetic cache.
+static constexpr int kModelsPerOwner = 100;
+
+/////////////////////////////////////////////////
+class LocalCacheScanPerformance : public ::testing::Test
+{
+  public: void SetUp() override
+  {
+    common::Console::SetVerbosity(3);
+
+    this->tempDir = common::testing::MakeTestTempDirectory();
+    ASSERT_TRUE(this->tempDir->Valid()) << this->tempDir->Path();
+
+    this->config.SetCacheLocation(
+        common::joinPaths(this->tempDir->Path(), "cache"));
+
+    // Only scan the default server
+    auto serverPath = common::joinPaths(this->config.CacheLocation(),
+        uriToPath(this->config.Servers().front().Url()));
+
+    for (int o = 0; o < kOwners; ++o)
+    {
+      std::string owner = "owner" + std::to_string(o);
+      for (int m = 0; m < kModelsPerOwner; ++m)
+      {
+        std::string versionPath = common::joinPaths(serverPath, owner,
+            "models", "model" + std::to_string(m), "1");
+        ASSERT_TRUE(common::createDirectories(versionPath));
+        std::ofstream fout(common::joinPaths(versionPath, "model.config"));
+        fout << "<?xml version=\"1.0\"?>";
+      }
+    }
+  }
+
+  /// \brief Scan the whole cache and return the elapsed time in ms.
+  /// \param[in] _jobs Number of threads.
+  /// \param[out] _count Number of models found.
+  public: double Scan(unsigned int _jobs, std::size_t &_count)
+  {
+    LocalCache cache(&this->config);
+    cache.SetJobs(_jobs);
+
+    auto start = std::chrono::steady_clock::now();
+    _count = 0;
+    for (auto iter = cache.AllModels(); iter; ++iter)
+      ++_count;
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  }
+
+  public: std::shared_ptr<common::TempDirectory> tempDir;
+
+  public: ClientConfig config;
+};
+
+/////////////////////////////////////////////////
+TEST_F(LocalCacheScanPerformance, AllModels)
+{
+  const std::size_t expected = kOwners * kModelsPerOwner;
+
+  for (unsigned int jobs : {1u, 2u, 4u, 8u, 0u})
+  {
+    std::size_t count{0};
+    double ms = this->Scan(jobs, count);
+    EXPECT_EQ(expected, count);
+
+    std::cout << "Scanned " << count << " models with "
+              << (jobs == 0u ? std::string("default") : std::to_string(jobs))
+              << " jobs in " << ms << " ms" << std::endl;
+  }
+}
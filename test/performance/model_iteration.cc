@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/fuel_tools/ModelIdentifier.hh"
+#include "gz/fuel_tools/ModelIter.hh"
+#include "gz/fuel_tools/ServerConfig.hh"
+
+#include "ModelIterPrivate.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of allocations made by the process.
+static std::atomic<std::size_t> gAllocations{0};
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  ++gAllocations;
+  if (void *ptr = std::malloc(_size ? _size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/// \brief Number of models in the cache.
+static constexpr std::size_t kModels = 50000;
+
+/////////////////////////////////////////////////
+/// \brief Print allocations per model since a starting count.
+/// \param[in] _label Name of the measurement.
+/// \param[in] _start Allocation count at the start.
+void report(const std::string &_label, std::size_t _start)
+{
+  std::cout << _label << ": "
+            << static_cast<double>(gAllocations.load() - _start) / kModels
+            << " allocations per model" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(ModelIterationPerformance, Allocations)
+{
+  ServerConfig server;
+  server.SetUrl(common::URI("https://fuel.gazebosim.org", true));
+
+  std::vector<ModelIdentifier> ids;
+  ids.reserve(kModels);
+  for (std::size_t i = 0; i < kModels; ++i)
+  {
+    ModelIdentifier id;
+    id.SetServer(server);
+    id.SetOwner("OpenRobotics");
+    id.SetName("model" + std::to_string(i));
+    ids.push_back(std::move(id));
+  }
+
+  auto start = gAllocations.load();
+  {
+    ModelIter iter = ModelIterFactory::Create(ids);
+    report("Create, copying the identifiers", start);
+  }
+
+  start = gAllocations.load();
+  ModelIter iter = ModelIterFactory::Create(std::move(ids));
+  report("Create, moving the identifiers", start);
+
+  start = gAllocations.load();
+  std::size_t count = 0;
+  for (; iter; ++iter)
+  {
+    if (!iter->Identification().Owner().empty())
+      ++count;
+  }
+  EXPECT_EQ(kModels, count);
+  report("Iteration, including Identification() copies", start);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "SdfUriRewriter.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of links of the generated model, about 40 MB of SDF.
+static constexpr int kLinks = 50000;
+
+/////////////////////////////////////////////////
+/// \brief Generate a large model, as exported by tools that make one link
+/// per part.
+/// \param[in] _prefix Prefix of the mesh URIs.
+/// \return SDF document.
+std::string generateModel(const std::string &_prefix)
+{
+  std::string sdf = "<?xml version=\"1.0\" ?>\n<sdf version=\"1.9\">\n"
+      "  <model name=\"plant\">\n";
+  for (int i = 0; i < kLinks; ++i)
+  {
+    std::string n = std::to_string(i);
+    std::string mesh = "<geometry><mesh><uri>" + _prefix +
+        "meshes/part" + n + ".dae</uri></mesh></geometry>\n";
+    sdf += "    <link name=\"part" + n + "\">\n"
+        "      <pose>" + n + " 0 0 0 0 0</pose>\n"
+        "      <inertial><mass>1.0</mass><inertia><ixx>1</ixx><iyy>1</iyy>"
+        "<izz>1</izz></inertia></inertial>\n"
+        "      <collision name=\"collision\">" + mesh + "      </collision>\n"
+        "      <visual name=\"visual\">" + mesh +
+        "        <material><pbr><metal><albedo_map>" + _prefix +
+        "materials/part" + n + ".png</albedo_map></metal></pbr>"
+        "</material>\n      </visual>\n    </link>\n";
+  }
+  return sdf + "  </model>\n</sdf>\n";
+}
+
+/////////////////////////////////////////////////
+/// \brief Replace model:// URIs with a server URL.
+std::string toUrl(const std::string &_uri, SdfUriType)
+{
+  if (_uri.rfind("model://", 0) != 0)
+    return _uri;
+  return "https://fuel.gazebosim.org/1.0/owner/models/plant/1/files/" +
+      _uri.substr(14);
+}
+
+/////////////////////////////////////////////////
+/// \brief Report the time of a measurement.
+/// \param[in] _label Name of the measurement.
+/// \param[in] _start Start of the measurement.
+/// \param[in] _bytes Size of the document.
+void report(const std::string &_label,
+    std::chrono::steady_clock::time_point _start, std::size_t _bytes)
+{
+  double ms = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - _start).count();
+  std::cout << _label << ": " << ms << " ms, "
+            << _bytes / (1024.0 * 1024.0) / (ms / 1000.0) << " MB/s"
+            << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(SdfUriRewritePerformance, Rewrite)
+{
+  std::string sdf = generateModel("model://plant/");
+  std::cout << "Document of " << sdf.size() / (1024 * 1024) << " MB"
+            << std::endl;
+
+  std::string streamed;
+  std::size_t streamedCount = 0;
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(SdfUriRewriter::Rewrite(sdf, toUrl, streamed, streamedCount));
+  report("Streaming rewrite", start, sdf.size());
+
+  std::string printed;
+  std::size_t printedCount = 0;
+  start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(SdfUriRewriter::RewriteDom(sdf, toUrl, printed,
+      printedCount));
+  report("DOM load and print", start, sdf.size());
+
+  EXPECT_EQ(3u * kLinks, streamedCount);
+  EXPECT_EQ(printedCount, streamedCount);
+}
+
+/////////////////////////////////////////////////
+TEST(SdfUriRewritePerformance, Record)
+{
+  // Lazy URI rewriting only records the URL of each URI
+  std::string sdf = generateModel("model://plant/");
+  std::map<std::string, std::string> uris;
+  auto record = [&](const std::string &_uri, SdfUriType _type)
+  {
+    uris[_uri] = toUrl(_uri, _type);
+    return _uri;
+  };
+
+  std::string unchanged;
+  std::size_t count = 0;
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(SdfUriRewriter::Rewrite(sdf, record, unchanged, count));
+  report("Streaming record", start, sdf.size());
+
+  EXPECT_EQ(0u, count);
+  EXPECT_EQ(sdf, unchanged);
+  EXPECT_FALSE(uris.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SdfUriRewritePerformance, NothingToRewrite)
+{
+  // Relative URIs only, the document isn't parsed at all
+  std::string sdf = generateModel("");
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(SdfUriRewriter::HasModelUri(sdf));
+  report("Pre-scan", start, sdf.size());
+
+  std::string printed;
+  std::size_t count = 0;
+  start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(SdfUriRewriter::RewriteDom(sdf, toUrl, printed, count));
+  report("DOM load and print", start, sdf.size());
+  EXPECT_EQ(0u, count);
+}
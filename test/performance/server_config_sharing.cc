@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gz/fuel_tools/ClientConfig.hh"
+#include "gz/fuel_tools/ModelIdentifier.hh"
+#include "gz/fuel_tools/ServerConfig.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of allocations made by the process.
+static std::atomic<std::size_t> gAllocations{0};
+
+/// \brief Bytes currently allocated by the process.
+static std::atomic<std::size_t> gLiveBytes{0};
+
+/// \brief Room kept in front of every allocation for its size.
+static constexpr std::size_t kHeader = alignof(std::max_align_t);
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  auto *ptr = static_cast<char *>(std::malloc(_size + kHeader));
+  if (!ptr)
+    throw std::bad_alloc();
+  *reinterpret_cast<std::size_t *>(ptr) = _size;
+  ++gAllocations;
+  gLiveBytes += _size;
+  return ptr + kHeader;
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  if (!_ptr)
+    return;
+  auto *ptr = static_cast<char *>(_ptr) - kHeader;
+  gLiveBytes -= *reinterpret_cast<std::size_t *>(ptr);
+  std::free(ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  operator delete(_ptr);
+}
+
+/// \brief Number of models in a listing.
+static constexpr std::size_t kModels = 50000;
+
+/////////////////////////////////////////////////
+/// \brief Build a listing the way iterators and the cache do, and report
+/// allocations and memory held per model.
+/// \param[in] _label Name of the measurement.
+/// \param[in] _server Server of every model.
+/// \param[in] _deepCopy True to give every model a config of its own, as
+/// when every copy owned its data.
+void measure(const std::string &_label, const ServerConfig &_server,
+    bool _deepCopy)
+{
+  auto allocations = gAllocations.load();
+  auto liveBytes = gLiveBytes.load();
+  {
+    std::vector<ModelIdentifier> ids(kModels);
+    for (std::size_t i = 0; i < kModels; ++i)
+    {
+      if (_deepCopy)
+      {
+        ServerConfig server;
+        server.SetUrl(_server.Url());
+        server.SetApiKey(_server.ApiKey());
+        server.SetVersion(_server.Version());
+        ids[i].SetServer(server);
+      }
+      else
+      {
+        ids[i].SetServer(_server);
+      }
+    }
+
+    std::cout << _label << ": "
+              << static_cast<double>(gAllocations.load() - allocations) /
+                 kModels << " allocations, "
+              << static_cast<double>(gLiveBytes.load() - liveBytes) /
+                 kModels << " bytes held per model" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ServerConfigSharingPerformance, Listing)
+{
+  ServerConfig server;
+  server.SetUrl(common::URI("https://fuel.gazebosim.org", true));
+  server.SetApiKey("0123456789abcdef0123456789abcdef");
+
+  measure("Deep copied servers", server, true);
+  measure("Shared servers", server, false);
+
+  // Servers() copies the list on every call
+  ClientConfig config;
+  config.AddServer(server);
+  auto allocations = gAllocations.load();
+  for (std::size_t i = 0; i < kModels; ++i)
+    EXPECT_FALSE(config.Servers().empty());
+  std::cout << "ClientConfig::Servers(): "
+            << static_cast<double>(gAllocations.load() - allocations) /
+               kModels << " allocations per call" << std::endl;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/FuelClient.hh"
+#include "gz/fuel_tools/Interface.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of cached models resolved per measurement.
+static constexpr int kModels = 1000;
+
+/////////////////////////////////////////////////
+class SharedClientPerformance : public ::testing::Test
+{
+  public: void SetUp() override
+  {
+    common::Console::SetVerbosity(3);
+
+    this->tempDir = common::testing::MakeTestTempDirectory();
+    ASSERT_TRUE(this->tempDir->Valid()) << this->tempDir->Path();
+
+    std::string cachePath = common::joinPaths(this->tempDir->Path(), "cache");
+    ASSERT_TRUE(common::setenv("GZ_FUEL_CACHE_PATH", cachePath));
+    resetSharedClient();
+
+    for (int m = 0; m < kModels; ++m)
+    {
+      std::string owner = "owner" + std::to_string(m % 10);
+      std::string name = "model" + std::to_string(m);
+      std::string versionPath = common::joinPaths(cachePath,
+          "fuel.gazebosim.org", owner, "models", name, "1");
+      ASSERT_TRUE(common::createDirectories(versionPath));
+      std::ofstream fout(common::joinPaths(versionPath, "model.config"));
+      fout << "<?xml version=\"1.0\"?>";
+
+      this->uris.push_back("https://fuel.gazebosim.org/1.0/" + owner +
+          "/models/" + name + "/1");
+    }
+  }
+
+  public: void TearDown() override
+  {
+    resetSharedClient();
+    EXPECT_TRUE(common::unsetenv("GZ_FUEL_CACHE_PATH"));
+  }
+
+  /// \brief Resolve all the URIs and report the elapsed time.
+  /// \param[in] _label Name of the measurement.
+  /// \param[in] _resolve Function resolving one URI to a path.
+  public: template<typename Resolve>
+  void Measure(const std::string &_label, Resolve _resolve)
+  {
+    std::size_t resolved = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &uri : this->uris)
+    {
+      if (!_resolve(uri).empty())
+        ++resolved;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(this->uris.size(), resolved);
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    std::cout << _label << ": " << ms << " ms for " << this->uris.size()
+              << " URIs, " << ms * 1000.0 / this->uris.size()
+              << " us per URI" << std::endl;
+  }
+
+  /// \brief URIs of the cached models.
+  public: std::vector<std::string> uris;
+
+  /// \brief Directory holding the cache.
+  public: std::shared_ptr<common::TempDirectory> tempDir;
+};
+
+/////////////////////////////////////////////////
+TEST_F(SharedClientPerformance, ResolveCachedUris)
+{
+  // What fetchResource did before, a new client for each URI
+  this->Measure("New FuelClient per URI", [](const std::string &_uri)
+  {
+    FuelClient client;
+    return fetchResourceWithClient(_uri, client);
+  });
+
+  // The first call also creates the shared client
+  this->Measure("fetchResource, shared client", [](const std::string &_uri)
+  {
+    return fetchResource(_uri);
+  });
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/Zip.hh"
+
+#include "StreamingUnzip.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of files in the archive.
+static constexpr int kFiles = 32;
+
+/// \brief Size of each file, before compression.
+static constexpr std::size_t kFileSize = 4 * 1024 * 1024;
+
+/// \brief Size of the chunks the simulated network delivers.
+static constexpr std::size_t kChunkSize = 64 * 1024;
+
+/// \brief Simulated network bandwidth, in bytes per second.
+static constexpr double kBandwidth = 100.0 * 1024 * 1024;
+
+/////////////////////////////////////////////////
+class StreamingExtractPerformance : public ::testing::Test
+{
+  public: void SetUp() override
+  {
+    common::Console::SetVerbosity(3);
+
+    this->tempDir = common::testing::MakeTestTempDirectory();
+    ASSERT_TRUE(this->tempDir->Valid()) << this->tempDir->Path();
+
+    // Text-like content, so decompression has real work to do
+    std::string model = common::joinPaths(this->tempDir->Path(), "model");
+    ASSERT_TRUE(common::createDirectories(model));
+    unsigned int state = 1;
+    std::string content;
+    for (int i = 0; i < kFiles; ++i)
+    {
+      content.clear();
+      while (content.size() < kFileSize)
+      {
+        state = state * 1103515245u + 12345u;
+        content += "<vertex>" + std::to_string((state >> 16) % 1000) +
+            "</vertex>\n";
+      }
+      std::ofstream out(common::joinPaths(model,
+          "file" + std::to_string(i)), std::ios::binary);
+      out << content;
+    }
+
+    std::string zipFile = common::joinPaths(this->tempDir->Path(), "dl.zip");
+    ASSERT_TRUE(Zip::Compress(model, zipFile));
+    std::ifstream in(zipFile, std::ios::binary);
+    this->data.assign((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    common::removeFile(zipFile);
+    common::removeAll(model);
+  }
+
+  /// \brief Deliver the archive in chunks at the simulated bandwidth.
+  /// \param[in] _chunk Called with each chunk as it arrives.
+  /// \return Bytes received.
+  public: std::string Download(
+      const std::function<void(const char *, std::size_t)> &_chunk)
+  {
+    std::string received;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t pos = 0; pos < this->data.size(); pos += kChunkSize)
+    {
+      std::size_t n = std::min(kChunkSize, this->data.size() - pos);
+      std::this_thread::sleep_until(start +
+          std::chrono::duration<double>((pos + n) / kBandwidth));
+      received.append(this->data, pos, n);
+      _chunk(this->data.data() + pos, n);
+    }
+    return received;
+  }
+
+  /// \brief Report the time from the start of a download until its files
+  /// are on disk, and how long that takes after the last byte arrived.
+  /// \param[in] _label Name of the measurement.
+  /// \param[in] _start Start of the download.
+  /// \param[in] _received Time the last byte arrived.
+  public: void Report(const std::string &_label,
+      std::chrono::steady_clock::time_point _start,
+      std::chrono::steady_clock::time_point _received)
+  {
+    auto end = std::chrono::steady_clock::now();
+    std::cout << _label << ": "
+              << std::chrono::duration<double>(end - _start).count()
+              << " s total, "
+              << std::chrono::duration<double>(end - _received).count()
+              << " s after the last byte" << std::endl;
+  }
+
+  /// \brief Archive data.
+  public: std::string data;
+
+  /// \brief Directory holding the extracted files.
+  public: std::shared_ptr<common::TempDirectory> tempDir;
+};
+
+/////////////////////////////////////////////////
+TEST_F(StreamingExtractPerformance, DownloadThenExtract)
+{
+  std::cout << "Archive of " << this->data.size() / (1024 * 1024)
+            << " MiB, received at " << kBandwidth / (1024 * 1024)
+            << " MiB/s" << std::endl;
+
+  std::string dst = common::joinPaths(this->tempDir->Path(), "serial");
+  auto start = std::chrono::steady_clock::now();
+  std::string received = this->Download([](const char *, std::size_t) {});
+  auto receivedTime = std::chrono::steady_clock::now();
+  EXPECT_TRUE(Zip::ExtractFromMemory(received.data(), received.size(), dst));
+  this->Report("Download, then extract", start, receivedTime);
+  EXPECT_TRUE(common::isFile(common::joinPaths(dst, "model", "file0")));
+
+  dst = common::joinPaths(this->tempDir->Path(), "streaming");
+  start = std::chrono::steady_clock::now();
+  StreamingUnzip unzip(dst);
+  received = this->Download([&](const char *_data, std::size_t _size)
+  {
+    unzip.Write(_data, _size);
+  });
+  receivedTime = std::chrono::steady_clock::now();
+  EXPECT_TRUE(unzip.Finish(received.data(), received.size()))
+      << unzip.Error();
+  this->Report("Extract while downloading", start, receivedTime);
+  EXPECT_TRUE(common::isFile(common::joinPaths(dst, "model", "file0")));
+}
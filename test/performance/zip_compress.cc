@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/Zip.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Size of each file of the model.
+static constexpr std::size_t kFileSize = 2 * 1024 * 1024;
+
+/////////////////////////////////////////////////
+class ZipCompressPerformance : public ::testing::Test
+{
+  public: void SetUp() override
+  {
+    common::Console::SetVerbosity(3);
+
+    this->tempDir = common::testing::MakeTestTempDirectory();
+    ASSERT_TRUE(this->tempDir->Valid()) << this->tempDir->Path();
+
+    // A texture-heavy model: images that are compressed already, and a few
+    // text meshes
+    this->model = common::joinPaths(this->tempDir->Path(), "model");
+    std::string textures =
+        common::joinPaths(this->model, "materials", "textures");
+    std::string meshes = common::joinPaths(this->model, "meshes");
+    ASSERT_TRUE(common::createDirectories(textures));
+    ASSERT_TRUE(common::createDirectories(meshes));
+
+    unsigned int state = 1;
+    std::string content;
+    for (int i = 0; i < 48; ++i)
+    {
+      content.clear();
+      while (content.size() < kFileSize)
+      {
+        state = state * 1103515245u + 12345u;
+        content.push_back(static_cast<char>(state >> 24));
+      }
+      std::string ext = i % 4 == 0 ? ".ktx2" : (i % 2 ? ".png" : ".jpg");
+      std::ofstream out(common::joinPaths(textures,
+          "texture" + std::to_string(i) + ext), std::ios::binary);
+      out << content;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+      content.clear();
+      while (content.size() < kFileSize)
+      {
+        state = state * 1103515245u + 12345u;
+        content += "<p>" + std::to_string((state >> 16) % 1000) + "</p>\n";
+      }
+      std::ofstream out(common::joinPaths(meshes,
+          "mesh" + std::to_string(i) + ".dae"), std::ios::binary);
+      out << content;
+    }
+  }
+
+  /// \brief Compress the model and report the time and archive size.
+  /// \param[in] _label Name of the measurement.
+  /// \param[in] _options Compression options.
+  public: void Measure(const std::string &_label,
+      const ZipCompressOptions &_options)
+  {
+    std::string zipFile = common::joinPaths(this->tempDir->Path(), "m.zip");
+    common::removeFile(zipFile);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(Zip::Compress(this->model, zipFile, _options));
+    auto end = std::chrono::steady_clock::now();
+
+    std::ifstream in(zipFile, std::ios::binary | std::ios::ate);
+    std::cout << _label << ": "
+              << std::chrono::duration<double>(end - start).count() << " s, "
+              << static_cast<double>(in.tellg()) / (1024 * 1024) << " MiB"
+              << std::endl;
+  }
+
+  /// \brief Path of the model.
+  public: std::string model;
+
+  /// \brief Directory holding the model and the archives.
+  public: std::shared_ptr<common::TempDirectory> tempDir;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ZipCompressPerformance, TextureHeavyModel)
+{
+  ZipCompressOptions options;
+  this->Measure("Deflate everything, 1 thread", options);
+
+  options.storedExtensions = Zip::StoredExtensions();
+  this->Measure("Store images, 1 thread", options);
+
+  options.jobs = 0u;
+  this->Measure("Store images, all threads", options);
+
+  options.storedExtensions.clear();
+  this->Measure("Deflate everything, all threads", options);
+
+  options.level = 1;
+  this->Measure("Deflate everything at level 1, all threads", options);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "gz/fuel_tools/Zip.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+namespace fs = std::filesystem;
+
+/// \brief One MiB.
+static constexpr std::uintmax_t kMiB = 1024 * 1024;
+
+/////////////////////////////////////////////////
+/// \brief Peak resident memory of the process in MiB, 0 if unknown.
+double peakMemory()
+{
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    return static_cast<double>(usage.ru_maxrss) / kMiB;
+#else
+    return static_cast<double>(usage.ru_maxrss) / 1024;
+#endif
+  }
+#endif
+  return 0;
+}
+
+/////////////////////////////////////////////////
+class ZipLargeEntryPerformance : public ::testing::Test
+{
+  public: void SetUp() override
+  {
+    common::Console::SetVerbosity(3);
+
+    this->tempDir = common::testing::MakeTestTempDirectory();
+    ASSERT_TRUE(this->tempDir->Valid()) << this->tempDir->Path();
+  }
+
+  /// \brief Archive a sparse file of a size, extract it and check the
+  /// result.
+  /// \param[in] _size Size of the file.
+  public: void RoundTrip(std::uintmax_t _size)
+  {
+    // The sparse source takes no space, the extracted copy does
+    std::error_code ec;
+    auto space = fs::space(this->tempDir->Path(), ec);
+    if (ec || space.available < _size + 512 * kMiB)
+    {
+      GTEST_SKIP() << "Not enough disk space for a " << _size / kMiB
+                   << " MiB entry";
+    }
+
+    std::string srcDir = common::joinPaths(this->tempDir->Path(),
+        "src" + std::to_string(_size));
+    ASSERT_TRUE(common::createDirectories(srcDir));
+    std::string srcFile = common::joinPaths(srcDir, "cloud.pcd");
+    {
+      std::ofstream out(srcFile, std::ios::binary);
+    }
+    fs::resize_file(srcFile, _size, ec);
+    ASSERT_FALSE(ec) << ec.message();
+
+    std::string zipFile = srcDir + ".zip";
+    ASSERT_TRUE(Zip::Compress(srcDir, zipFile));
+    fs::remove(srcFile, ec);
+
+    std::string dstDir = common::joinPaths(this->tempDir->Path(), "dst");
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(Zip::Extract(zipFile, dstDir));
+    auto end = std::chrono::steady_clock::now();
+
+    std::string dstFile = common::joinPaths(dstDir,
+        "src" + std::to_string(_size), "cloud.pcd");
+    EXPECT_EQ(_size, fs::file_size(dstFile, ec));
+
+    // Spot check the end of the file, past any 32 bit offset
+    {
+      std::ifstream in(dstFile, std::ios::binary);
+      in.seekg(static_cast<std::streamoff>(_size - 1));
+      char c = 'x';
+      in.read(&c, 1);
+      EXPECT_TRUE(in.good());
+      EXPECT_EQ('\0', c);
+    }
+
+    double s = std::chrono::duration<double>(end - start).count();
+    std::cout << _size / kMiB << " MiB entry: " << s << " s, "
+              << _size / kMiB / s << " MiB/s, peak memory "
+              << peakMemory() << " MiB" << std::endl;
+
+    fs::remove_all(dstDir, ec);
+    fs::remove(zipFile, ec);
+  }
+
+  /// \brief Directory holding the archives.
+  public: std::shared_ptr<common::TempDirectory> tempDir;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ZipLargeEntryPerformance, Over2GiB)
+{
+  // Larger than a signed 32 bit size
+  this->RoundTrip(2560 * kMiB);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ZipLargeEntryPerformance, Zip64)
+{
+  // Larger than 4 GiB, stored with Zip64 extensions
+  this->RoundTrip(4608 * kMiB);
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/Zip.hh"
+
+#include "FileWriter.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of files in the synthetic world.
+static constexpr int kFiles = 20000;
+
+/// \brief Number of directories the files are spread over.
+static constexpr int kDirs = 100;
+
+/////////////////////////////////////////////////
+class ZipManyFilesPerformance : public ::testing::Test
+{
+  public: void SetUp() override
+  {
+    common::Console::SetVerbosity(3);
+
+    this->tempDir = common::testing::MakeTestTempDirectory();
+    ASSERT_TRUE(this->tempDir->Valid()) << this->tempDir->Path();
+
+    // A world made of many small files, such as a heightmap split in
+    // tiles or a scanned environment
+    std::string world = common::joinPaths(this->tempDir->Path(), "world");
+    for (int d = 0; d < kDirs; ++d)
+    {
+      ASSERT_TRUE(common::createDirectories(
+          common::joinPaths(world, "tiles", std::to_string(d))));
+    }
+    for (int i = 0; i < kFiles; ++i)
+    {
+      std::string content;
+      for (int n = 0; n < 64 + (i * 7919) % 192; ++n)
+        content += std::to_string((n * 31 + i) % 1000) + " ";
+      this->names.push_back(common::joinPaths("tiles",
+          std::to_string(i % kDirs), "tile" + std::to_string(i) + ".txt"));
+      this->contents.push_back(content);
+      std::ofstream out(common::joinPaths(world, this->names.back()),
+          std::ios::binary);
+      out << content;
+    }
+
+    this->zipFile = common::joinPaths(this->tempDir->Path(), "world.zip");
+    ASSERT_TRUE(Zip::Compress(world, this->zipFile));
+    common::removeAll(world);
+  }
+
+  /// \brief Report the time of a measurement.
+  /// \param[in] _label Name of the measurement.
+  /// \param[in] _start Start of the measurement.
+  public: static void Report(const std::string &_label,
+      std::chrono::steady_clock::time_point _start)
+  {
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - _start).count();
+    std::cout << _label << ": " << ms << " ms, "
+              << ms * 1000.0 / kFiles << " us per file" << std::endl;
+  }
+
+  /// \brief Create the directories of the files below a directory.
+  /// \param[in] _dst Directory.
+  public: static void CreateDirectories(const std::string &_dst)
+  {
+    for (int d = 0; d < kDirs; ++d)
+    {
+      common::createDirectories(
+          common::joinPaths(_dst, "tiles", std::to_string(d)));
+    }
+  }
+
+  /// \brief Relative paths of the files.
+  public: std::vector<std::string> names;
+
+  /// \brief Contents of the files.
+  public: std::vector<std::string> contents;
+
+  /// \brief Path to the archive.
+  public: std::string zipFile;
+
+  /// \brief Directory holding the archive and the extracted files.
+  public: std::shared_ptr<common::TempDirectory> tempDir;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ZipManyFilesPerformance, WriteFiles)
+{
+  // What extraction used to do for each file: check for an existing file,
+  // then write it through a file stream
+  std::string dst = common::joinPaths(this->tempDir->Path(), "stream");
+  CreateDirectories(dst);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kFiles; ++i)
+  {
+    std::string path = common::joinPaths(dst, this->names[i]);
+    if (common::isFile(path))
+      common::removeFile(path);
+    std::ofstream out(path, std::ios::out | std::ios::binary);
+    out.write(this->contents[i].data(),
+        static_cast<std::streamsize>(this->contents[i].size()));
+  }
+  Report("std::ofstream", start);
+
+  for (unsigned int batch : {0u, 64u})
+  {
+    dst = common::joinPaths(this->tempDir->Path(),
+        "writer" + std::to_string(batch));
+    CreateDirectories(dst);
+    start = std::chrono::steady_clock::now();
+    {
+      FileWriter writer(batch);
+      for (int i = 0; i < kFiles; ++i)
+      {
+        EXPECT_TRUE(writer.Open(common::joinPaths(dst, this->names[i]),
+            this->contents[i].size()));
+        writer.Write(this->contents[i].data(), this->contents[i].size());
+        EXPECT_TRUE(writer.Close());
+      }
+    }
+    Report("FileWriter, flushing batches of " + std::to_string(batch),
+        start);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ZipManyFilesPerformance, Extract)
+{
+  for (unsigned int jobs : {1u, 0u})
+  {
+    for (unsigned int batch : {0u, 64u})
+    {
+      std::string dst = common::joinPaths(this->tempDir->Path(),
+          "extract" + std::to_string(jobs) + "-" + std::to_string(batch));
+      ZipExtractOptions options;
+      options.jobs = jobs;
+      options.syncBatch = batch;
+
+      auto start = std::chrono::steady_clock::now();
+      EXPECT_TRUE(Zip::Extract(this->zipFile, dst, options));
+      Report(std::string(jobs == 1u ? "1 thread" : "All threads") +
+          ", flushing batches of " + std::to_string(batch), start);
+
+      EXPECT_TRUE(common::isFile(common::joinPaths(dst, "world",
+          this->names.back())));
+      common::removeAll(dst);
+    }
+  }
+}
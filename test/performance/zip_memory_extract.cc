@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/Zip.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of files in the archive.
+static constexpr int kFiles = 64;
+
+/// \brief Size of each file, which barely compresses.
+static constexpr std::size_t kFileSize = 4 * 1024 * 1024;
+
+/// \brief Bytes in a GiB.
+static constexpr double kGiB = 1024.0 * 1024.0 * 1024.0;
+
+/////////////////////////////////////////////////
+/// \brief Bytes read and written by the process so far, as counted by
+/// Linux in /proc/self/io. Zero where that isn't available.
+/// \param[out] _read Bytes read.
+/// \param[out] _written Bytes written.
+void processIo(std::uint64_t &_read, std::uint64_t &_written)
+{
+  _read = 0;
+  _written = 0;
+  std::ifstream in("/proc/self/io");
+  std::string key;
+  std::uint64_t value;
+  while (in >> key >> value)
+  {
+    if (key == "rchar:")
+      _read = value;
+    else if (key == "wchar:")
+      _written = value;
+  }
+}
+
+/////////////////////////////////////////////////
+class ZipMemoryExtractPerformance : public ::testing::Test
+{
+  public: void SetUp() override
+  {
+    common::Console::SetVerbosity(3);
+
+    this->tempDir = common::testing::MakeTestTempDirectory();
+    ASSERT_TRUE(this->tempDir->Valid()) << this->tempDir->Path();
+
+    std::string model = common::joinPaths(this->tempDir->Path(), "model");
+    ASSERT_TRUE(common::createDirectories(model));
+    unsigned int state = 1;
+    std::string content;
+    for (int i = 0; i < kFiles; ++i)
+    {
+      content.clear();
+      while (content.size() < kFileSize)
+      {
+        state = state * 1103515245u + 12345u;
+        content.push_back(static_cast<char>(state >> 24));
+      }
+      std::ofstream out(common::joinPaths(model,
+          "file" + std::to_string(i)), std::ios::binary);
+      out << content;
+    }
+
+    // The download, as FuelClient holds it
+    std::string zipFile = common::joinPaths(this->tempDir->Path(), "dl.zip");
+    ASSERT_TRUE(Zip::Compress(model, zipFile));
+    std::ifstream in(zipFile, std::ios::binary);
+    this->data.assign((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    common::removeFile(zipFile);
+    common::removeAll(model);
+  }
+
+  /// \brief Run an extraction and report its I/O and time per GiB of
+  /// archive.
+  /// \param[in] _label Name of the measurement.
+  /// \param[in] _extract Function extracting the archive into a directory.
+  public: template<typename Extract>
+  void Measure(const std::string &_label, Extract _extract)
+  {
+    std::string dst = common::joinPaths(this->tempDir->Path(), "dst");
+    std::uint64_t read0, written0, read1, written1;
+    processIo(read0, written0);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(_extract(dst));
+    auto end = std::chrono::steady_clock::now();
+    processIo(read1, written1);
+
+    double gib = this->data.size() / kGiB;
+    std::cout << _label << ", per GiB downloaded: "
+              << (read1 - read0) / kGiB / gib << " GiB read, "
+              << (written1 - written0) / kGiB / gib << " GiB written, "
+              << std::chrono::duration<double>(end - start).count() / gib
+              << " s" << std::endl;
+
+    EXPECT_TRUE(common::isFile(common::joinPaths(dst, "model", "file0")));
+    common::removeAll(dst);
+  }
+
+  /// \brief Archive data.
+  public: std::string data;
+
+  /// \brief Directory holding the extracted files.
+  public: std::shared_ptr<common::TempDirectory> tempDir;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ZipMemoryExtractPerformance, TemporaryFileAndMemory)
+{
+  // What LocalCache::SaveModel used to do
+  this->Measure("Temporary zip file", [&](const std::string &_dst)
+  {
+    std::string zipFile = common::joinPaths(this->tempDir->Path(), "m.zip");
+    std::ofstream ofs(zipFile, std::ofstream::out | std::ofstream::binary);
+    ofs << this->data;
+    ofs.close();
+    bool result = Zip::Extract(zipFile, _dst);
+    common::removeFile(zipFile);
+    return result;
+  });
+
+  this->Measure("From memory", [&](const std::string &_dst)
+  {
+    return Zip::ExtractFromMemory(this->data.data(), this->data.size(),
+        _dst);
+  });
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+#include "gz/fuel_tools/Zip.hh"
+
+using namespace gz;
+using namespace fuel_tools;
+
+/// \brief Number of textures in the synthetic world.
+static constexpr int kTextures = 600;
+
+/// \brief Size of each texture, which barely compresses.
+static constexpr std::size_t kTextureSize = 128 * 1024;
+
+/// \brief Number of meshes in the synthetic world.
+static constexpr int kMeshes = 40;
+
+/// \brief Size of each mesh, which compresses well.
+static constexpr std::size_t kMeshSize = 1024 * 1024;
+
+/////////////////////////////////////////////////
+class ZipParallelExtractPerformance : public ::testing::Test
+{
+  public: void SetUp() override
+  {
+    common::Console::SetVerbosity(3);
+
+    this->tempDir = common::testing::MakeTestTempDirectory();
+    ASSERT_TRUE(this->tempDir->Valid()) << this->tempDir->Path();
+
+    // A world laid out like the archives in test/media, with thousands of
+    // textures and a few meshes
+    std::string world = common::joinPaths(this->tempDir->Path(), "world");
+    std::string textures = common::joinPaths(world, "materials", "textures");
+    std::string meshes = common::joinPaths(world, "meshes");
+    ASSERT_TRUE(common::createDirectories(textures));
+    ASSERT_TRUE(common::createDirectories(meshes));
+    {
+      std::ofstream out(common::joinPaths(world, "model.config"));
+      out << "<?xml version=\"1.0\"?>";
+    }
+
+    unsigned int state = 1;
+    std::string content;
+    for (int i = 0; i < kTextures; ++i)
+    {
+      content.clear();
+      while (content.size() < kTextureSize)
+      {
+        state = state * 1103515245u + 12345u;
+        content.push_back(static_cast<char>(state >> 24));
+      }
+      std::ofstream out(common::joinPaths(textures,
+          "texture" + std::to_string(i) + ".png"), std::ios::binary);
+      out << content;
+    }
+    for (int i = 0; i < kMeshes; ++i)
+    {
+      std::ofstream out(common::joinPaths(meshes,
+          "mesh" + std::to_string(i) + ".dae"));
+      for (std::size_t n = 0; n < kMeshSize / 32; ++n)
+        out << "<p>" << (n * 7919 + i) % 100000 << " 1 2 3 4 5 6</p>\n";
+    }
+
+    this->zipFile = common::joinPaths(this->tempDir->Path(), "world.zip");
+    ASSERT_TRUE(Zip::Compress(world, this->zipFile));
+  }
+
+  /// \brief Path to the archive.
+  public: std::string zipFile;
+
+  /// \brief Directory holding the archive and the extracted files.
+  public: std::shared_ptr<common::TempDirectory> tempDir;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ZipParallelExtractPerformance, Scaling)
+{
+  double baseline = 0;
+  for (unsigned int jobs : {1u, 2u, 4u, 8u, 16u})
+  {
+    std::string dst = common::joinPaths(this->tempDir->Path(),
+        "extract" + std::to_string(jobs));
+
+    ZipExtractOptions options;
+    options.jobs = jobs;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(Zip::Extract(this->zipFile, dst, options));
+    auto end = std::chrono::steady_clock::now();
+
+    EXPECT_TRUE(common::isFile(common::joinPaths(dst, "world", "meshes",
+        "mesh" + std::to_string(kMeshes - 1) + ".dae")));
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    if (jobs == 1u)
+      baseline = ms;
+    std::cout << jobs << " threads: " << ms << " ms, speedup "
+              << baseline / ms << "x" << std::endl;
+
+    common::removeAll(dst);
+  }
+}